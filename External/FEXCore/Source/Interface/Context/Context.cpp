@@ -3,6 +3,7 @@
 #include "Interface/Core/Core.h"
 #include "Interface/Core/OpcodeDispatcher.h"
 #include "Interface/Core/X86Tables/X86Tables.h"
+#include "Interface/HLE/Thunks/Thunks.h"
 
 #include <FEXCore/Core/CoreState.h>
 #include <FEXCore/Core/Context.h>
@@ -67,6 +68,10 @@ namespace FEXCore::Context {
     Thread->CTX->CompileBlock(Thread->CurrentFrame, GuestRIP);
   }
 
+  bool BenchmarkCompileRIP(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, CompileBenchmarkResult *Result) {
+    return Thread->CTX->BenchmarkCompileRIP(Thread, GuestRIP, Result);
+  }
+
   FEXCore::Context::ExitReason RunUntilExit(FEXCore::Context::Context *CTX) {
     return CTX->RunUntilExit();
   }
@@ -198,6 +203,14 @@ namespace FEXCore::Context {
     return CTX->AddCustomIREntrypoint(Entrypoint, Handler, Creator, Data);
   }
 
+  void RemoveCustomIREntrypoint(FEXCore::Context::Context *CTX, uintptr_t Entrypoint) {
+    CTX->RemoveCustomIREntrypoint(Entrypoint);
+  }
+
+  void RegisterHostThunk(FEXCore::Context::Context *CTX, FEXCore::IR::SHA256Sum const &Sum, void (*Func)(void *ArgsRv)) {
+    CTX->ThunkHandler->RegisterThunk(Sum, Func);
+  }
+
 namespace Debug {
   void CompileRIP(FEXCore::Context::Context *CTX, uint64_t RIP) {
     CTX->CompileRIP(CTX->ParentThread, RIP);
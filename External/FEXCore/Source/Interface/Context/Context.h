@@ -35,6 +35,8 @@ namespace FEXCore {
 class CodeLoader;
 class ThunkHandler;
 class GdbServer;
+class SamplingProfiler;
+class SharedStats;
 
 namespace CodeSerialize {
   class CodeObjectSerializeService;
@@ -88,6 +90,7 @@ namespace FEXCore::Context {
       bool ValidateIRarser { false };
 
       FEX_CONFIG_OPT(Multiblock, MULTIBLOCK);
+      FEX_CONFIG_OPT(EnableAVX, ENABLEAVX);
       FEX_CONFIG_OPT(SingleStepConfig, SINGLESTEP);
       FEX_CONFIG_OPT(GdbServer, GDBSERVER);
       FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
@@ -110,9 +113,16 @@ namespace FEXCore::Context {
       FEX_CONFIG_OPT(LibraryJITNaming, LIBRARYJITNAMING);
       FEX_CONFIG_OPT(BlockJITNaming, BLOCKJITNAMING);
       FEX_CONFIG_OPT(GDBSymbols, GDBSYMBOLS);
+      FEX_CONFIG_OPT(SampleProfile, SAMPLEPROFILE);
+      FEX_CONFIG_OPT(SampleProfileHz, SAMPLEPROFILEHZ);
+      FEX_CONFIG_OPT(SharedStats, SHAREDSTATS);
       FEX_CONFIG_OPT(ParanoidTSO, PARANOIDTSO);
       FEX_CONFIG_OPT(CacheObjectCodeCompilation, CACHEOBJECTCODECOMPILATION);
       FEX_CONFIG_OPT(x87ReducedPrecision, X87REDUCEDPRECISION);
+      FEX_CONFIG_OPT(CompilerPoolSize, COMPILERPOOLSIZE);
+      FEX_CONFIG_OPT(HugePages, HUGEPAGES);
+      FEX_CONFIG_OPT(SplitColdCode, SPLITCOLDCODE);
+      FEX_CONFIG_OPT(CodeBufferSize, CODEBUFFERSIZE);
     } Config;
 
     FEXCore::HostFeatures HostFeatures;
@@ -143,6 +153,8 @@ namespace FEXCore::Context {
 #ifdef BLOCKSTATS
     std::unique_ptr<FEXCore::BlockSamplingData> BlockData;
 #endif
+    std::unique_ptr<FEXCore::SamplingProfiler> Profiler;
+    std::unique_ptr<FEXCore::SharedStats> StatsRegion;
 
     SignalDelegator *SignalDelegation{};
     X86GeneratedCode X86CodeGen;
@@ -213,6 +225,8 @@ namespace FEXCore::Context {
     [[nodiscard]] CompileCodeResult CompileCode(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP);
     uintptr_t CompileBlock(FEXCore::Core::CpuStateFrame *Frame, uint64_t GuestRIP);
 
+    bool BenchmarkCompileRIP(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, FEXCore::Context::CompileBenchmarkResult *Result);
+
     // same as CompileBlock, but aborts on failure
     void CompileBlockJit(FEXCore::Core::CpuStateFrame *Frame, uint64_t GuestRIP);
 
@@ -315,6 +329,14 @@ namespace FEXCore::Context {
   protected:
     void ClearCodeCache(FEXCore::Core::InternalThreadState *Thread);
 
+    /**
+     * @brief Makes space for new code by reusing a segment of the thread's code buffer
+     *
+     * Blocks in the chosen segment are removed from the lookup cache and unlinked.
+     * Falls back to ClearCodeCache when segments can't be reused.
+     */
+    void EvictCodeSegment(FEXCore::Core::InternalThreadState *Thread);
+
   private:
     /**
      * @brief Does some final thread initialization
@@ -334,6 +356,20 @@ namespace FEXCore::Context {
      */
     void InitializeCompiler(FEXCore::Core::InternalThreadState* Thread);
 
+    /**
+     * @brief Hands a pooled compiler bundle to the thread if one is available
+     *
+     * @return true if the thread was given recycled compiler objects
+     */
+    bool AcquirePooledCompiler(FEXCore::Core::InternalThreadState* Thread);
+
+    /**
+     * @brief Moves the thread's compiler objects in to the pool for a future thread to reuse
+     *
+     * Code caches are cleared and their backing pages released, but nothing is unmapped
+     */
+    void ReleaseCompilerToPool(FEXCore::Core::InternalThreadState* Thread);
+
     void WaitForIdleWithTimeout();
 
     void NotifyPause();
@@ -355,6 +391,21 @@ namespace FEXCore::Context {
     std::unordered_map<uint64_t, std::tuple<std::function<void(uintptr_t Entrypoint, FEXCore::IR::IREmitter *)>, void *, void *>> CustomIRHandlers;
     FEXCore::CPU::CPUBackendFeatures BackendFeatures;
     FEXCore::CPU::DispatcherConfig DispatcherConfig;
+
+    // Everything InitializeCompiler creates for a thread
+    // The backend holds a pointer to the RA pass in the PassManager, so these can only be recycled together
+    struct PooledCompiler {
+      std::unique_ptr<FEXCore::IR::OpDispatchBuilder> OpDispatcher;
+      std::unique_ptr<FEXCore::CPU::CPUBackend> CPUBackend;
+      std::unique_ptr<FEXCore::LookupCache> LookupCache;
+      std::unique_ptr<FEXCore::Frontend::Decoder> FrontendDecoder;
+      std::unique_ptr<FEXCore::IR::PassManager> PassManager;
+      // JIT pointers the backend filled in to its original thread's frame
+      FEXCore::Core::JITPointers Pointers;
+    };
+
+    std::mutex CompilerPoolMutex;
+    std::vector<PooledCompiler> CompilerPool;
   };
 
   uint64_t HandleSyscall(FEXCore::HLE::SyscallHandler *Handler, FEXCore::Core::CpuStateFrame *Frame, FEXCore::HLE::SyscallArguments *Args);
@@ -3,12 +3,16 @@
 
 #include <aarch64/cpu-aarch64.h>
 
+#include <FEXCore/Core/CPUBackend.h>
+#include <FEXCore/Core/CoreState.h>
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/Telemetry.h>
 
 #include <atomic>
 #include <csignal>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 namespace FEXCore::ArchHelpers::Arm64 {
 FEXCORE_TELEMETRY_STATIC_INIT(SplitLock, TYPE_HAS_SPLIT_LOCKS);
@@ -2113,7 +2117,259 @@ uint64_t HandleAtomicLoadstoreExclusive(void *_ucontext, void *_info) {
   return NumInstructionsToSkip * 4;
 }
 
-bool HandleSIGBUS(bool ParanoidTSO, int Signal, void *info, void *ucontext) {
+namespace {
+// Long enough for any of the emulation paths to decode their sequence from a copy of the site
+constexpr size_t MAX_ATOMIC_SEQUENCE = 12;
+
+/**
+ * Out of line code that a backpatched atomic site branches to
+ *
+ * Keeps x16, x17 and lr of the site on the stack and calls the trampoline with x16 pointing at Instrs,
+ * then continues after the emulated sequence.
+ */
+struct alignas(16) AtomicStub {
+  uint32_t Code[8];
+  uint64_t Trampoline;
+  // The site as it was before being patched
+  uint32_t Instrs[MAX_ATOMIC_SEQUENCE];
+};
+
+// Register state of the site, built on the stack by Arm64AtomicStubTrampoline
+struct AtomicStubFrame {
+  uint64_t Regs[31];
+  uint64_t SP;
+  uint64_t NZCV;
+  uint64_t FPSR;
+  __uint128_t V[32];
+};
+static_assert(offsetof(AtomicStubFrame, V) == 272 && sizeof(AtomicStubFrame) == 784, "Arm64AtomicStubTrampoline hardcodes the frame layout");
+
+// stp x16, x17, [sp, #-32]!
+constexpr uint32_t STUB_SAVE_X16_X17 = 0xA980'0000 | (0x7C << 15) | (17 << 10) | (31 << 5) | 16;
+// str lr, [sp, #16]
+constexpr uint32_t STUB_SAVE_LR = 0xF900'0000 | (2 << 10) | (31 << 5) | 30;
+// adr x16, Instrs
+constexpr uint32_t STUB_ADR_INSTRS = 0x1000'0000 | (((offsetof(AtomicStub, Instrs) - 2 * sizeof(uint32_t)) >> 2) << 5) | 16;
+// ldr x17, Trampoline
+constexpr uint32_t STUB_LOAD_TRAMPOLINE = 0x5800'0000 | (((offsetof(AtomicStub, Trampoline) - 3 * sizeof(uint32_t)) >> 2) << 5) | 17;
+// blr x17
+constexpr uint32_t STUB_CALL_TRAMPOLINE = 0xD63F'0000 | (17 << 5);
+// ldr lr, [sp, #16]
+constexpr uint32_t STUB_RESTORE_LR = 0xF940'0000 | (2 << 10) | (31 << 5) | 30;
+// ldp x16, x17, [sp], #32
+constexpr uint32_t STUB_RESTORE_X16_X17 = 0xA8C0'0000 | (4 << 15) | (17 << 10) | (31 << 5) | 16;
+
+uint32_t EncodeBranch(void const *From, void const *To) {
+  const auto Offset = reinterpret_cast<intptr_t>(To) - reinterpret_cast<intptr_t>(From);
+  return 0x1400'0000 | ((Offset >> 2) & 0x03FF'FFFF);
+}
+}
+
+/**
+ * Emulates the atomic sequence at the context's PC
+ *
+ * @return Number of bytes the sequence spans, zero if it wasn't handled
+ */
+static uint64_t EmulateAtomic(void *info, void *ucontext) {
+  uint32_t *PC = (uint32_t*)ArchHelpers::Context::GetPc(ucontext);
+  uint32_t Instr = PC[0];
+
+  if ((Instr & 0x3F'FF'FC'00) == 0x08'DF'FC'00 || // LDAR*
+      (Instr & 0x3F'FF'FC'00) == 0x38'BF'C0'00) { // LDAPR*
+    return FEXCore::ArchHelpers::Arm64::HandleAtomicLoad(ucontext, info, Instr, 0) ? 4 : 0;
+  }
+  else if ((Instr & 0x3F'FF'FC'00) == 0x08'9F'FC'00) { // STLR*
+    return FEXCore::ArchHelpers::Arm64::HandleAtomicStore(ucontext, info, Instr, 0) ? 4 : 0;
+  }
+  else if ((Instr & RCPC2_MASK) == LDAPUR_INST) { // LDAPUR*
+    // Extract the 9-bit offset from the instruction
+    int32_t Offset = static_cast<int32_t>(Instr) << 11 >> 23;
+    return FEXCore::ArchHelpers::Arm64::HandleAtomicLoad(ucontext, info, Instr, Offset) ? 4 : 0;
+  }
+  else if ((Instr & RCPC2_MASK) == STLUR_INST) { // STLUR*
+    // Extract the 9-bit offset from the instruction
+    int32_t Offset = static_cast<int32_t>(Instr) << 11 >> 23;
+    return FEXCore::ArchHelpers::Arm64::HandleAtomicStore(ucontext, info, Instr, Offset) ? 4 : 0;
+  }
+  else if ((Instr & FEXCore::ArchHelpers::Arm64::LDAXP_MASK) == FEXCore::ArchHelpers::Arm64::LDAXP_INST) { // LDAXP
+    //Should be compare and swap pair only. LDAXP not used elsewhere
+    return FEXCore::ArchHelpers::Arm64::HandleCASPAL_ARMv8(ucontext, info, Instr);
+  }
+  else if ((Instr & FEXCore::ArchHelpers::Arm64::CASPAL_MASK) == FEXCore::ArchHelpers::Arm64::CASPAL_INST) { // CASPAL
+    return FEXCore::ArchHelpers::Arm64::HandleCASPAL(ucontext, info, Instr) ? 4 : 0;
+  }
+  else if ((Instr & FEXCore::ArchHelpers::Arm64::CASAL_MASK) == FEXCore::ArchHelpers::Arm64::CASAL_INST) { // CASAL
+    return FEXCore::ArchHelpers::Arm64::HandleCASAL(ucontext, info, Instr) ? 4 : 0;
+  }
+  else if ((Instr & FEXCore::ArchHelpers::Arm64::ATOMIC_MEM_MASK) == FEXCore::ArchHelpers::Arm64::ATOMIC_MEM_INST) { // Atomic memory op
+    return FEXCore::ArchHelpers::Arm64::HandleAtomicMemOp(ucontext, info, Instr) ? 4 : 0;
+  }
+  else if ((Instr & FEXCore::ArchHelpers::Arm64::LDAXR_MASK) == FEXCore::ArchHelpers::Arm64::LDAXR_INST) { // LDAXR*
+    return FEXCore::ArchHelpers::Arm64::HandleAtomicLoadstoreExclusive(ucontext, info);
+  }
+
+  return 0;
+}
+
+/*
+ * Called from Arm64AtomicStubTrampoline, runs the same emulation as the signal handler
+ * on the copy of the site that the stub carries.
+ */
+extern "C" __attribute__((used)) void Arm64AtomicStubHandler(uint32_t const *Instrs, AtomicStubFrame *Frame) {
+  // Only the parts of the signal context that the emulation looks at are filled in
+  ucontext_t Context;
+  mcontext_t *mcontext = &Context.uc_mcontext;
+  memcpy(mcontext->regs, Frame->Regs, sizeof(Frame->Regs));
+  mcontext->sp = Frame->SP;
+  mcontext->pc = reinterpret_cast<uint64_t>(Instrs);
+  mcontext->pstate = Frame->NZCV;
+
+  siginfo_t Info{};
+  Info.si_code = BUS_ADRALN;
+
+  [[maybe_unused]] const uint64_t BytesToSkip = EmulateAtomic(&Info, &Context);
+  LOGMAN_THROW_A_FMT(BytesToSkip != 0, "Backpatched atomic failed to emulate: Instruction: 0x{:08x}", Instrs[0]);
+
+  memcpy(Frame->Regs, mcontext->regs, sizeof(Frame->Regs));
+}
+
+/*
+ * Common tail of every AtomicStub. Builds an AtomicStubFrame under the
+ * three registers the stub saved and calls Arm64AtomicStubHandler.
+ * Every register is preserved apart from what the emulation writes,
+ * so the stub can return straight in to the middle of a block.
+ * STATE (x28) is assumed to be live like it is everywhere in JIT code.
+ */
+__attribute__((naked))
+static
+void Arm64AtomicStubTrampoline()
+{
+    asm("sub    sp, sp, #784");
+    asm("stp    x0, x1,   [sp, #0]");
+    asm("stp    x2, x3,   [sp, #16]");
+    asm("stp    x4, x5,   [sp, #32]");
+    asm("stp    x6, x7,   [sp, #48]");
+    asm("stp    x8, x9,   [sp, #64]");
+    asm("stp    x10, x11, [sp, #80]");
+    asm("stp    x12, x13, [sp, #96]");
+    asm("stp    x14, x15, [sp, #112]");
+    asm("stp    x18, x19, [sp, #144]");
+    asm("stp    x20, x21, [sp, #160]");
+    asm("stp    x22, x23, [sp, #176]");
+    asm("stp    x24, x25, [sp, #192]");
+    asm("stp    x26, x27, [sp, #208]");
+    asm("stp    x28, x29, [sp, #224]");
+
+    // x16, x17 and lr were saved by the stub right above the frame, the site's SP is above those
+    asm("add    x2, sp, #784");
+    asm("ldp    x0, x1,   [x2]");
+    asm("stp    x0, x1,   [sp, #128]");
+    asm("ldr    x0,       [x2, #16]");
+    asm("add    x1, x2, #32");
+    asm("stp    x0, x1,   [sp, #240]");
+
+    asm("mrs    x0, nzcv");
+    asm("mrs    x1, fpsr");
+    asm("stp    x0, x1,   [sp, #256]");
+
+    asm("add    x0, sp, #272");
+    asm("st1    {v0.2d, v1.2d, v2.2d, v3.2d}, [x0], #64");
+    asm("st1    {v4.2d, v5.2d, v6.2d, v7.2d}, [x0], #64");
+    asm("st1    {v8.2d, v9.2d, v10.2d, v11.2d}, [x0], #64");
+    asm("st1    {v12.2d, v13.2d, v14.2d, v15.2d}, [x0], #64");
+    asm("st1    {v16.2d, v17.2d, v18.2d, v19.2d}, [x0], #64");
+    asm("st1    {v20.2d, v21.2d, v22.2d, v23.2d}, [x0], #64");
+    asm("st1    {v24.2d, v25.2d, v26.2d, v27.2d}, [x0], #64");
+    asm("st1    {v28.2d, v29.2d, v30.2d, v31.2d}, [x0], #64");
+
+    asm("mov    x19, lr");
+    asm("mov    x20, x16");
+
+    // Like any other call out of JIT code, the guest state needs to be in the frame
+    // in case a signal lands while we are in C++
+    asm("ldp    x16, x17, [sp, #128]");
+    __asm__ __volatile__( "ldr x3, [x28, %[a]]" : : [a]"i"(offsetof(FEXCore::Core::CpuStateFrame, Pointers.AArch64.StaticRegsSpiller)));
+    asm("blr    x3");
+
+    asm("mov    x0, x20");
+    asm("mov    x1, sp");
+    asm("bl     Arm64AtomicStubHandler");
+    asm("mov    lr, x19");
+
+    // x16, x17 and lr go back through the stub's slots
+    asm("add    x2, sp, #784");
+    asm("ldp    x0, x1,   [sp, #128]");
+    asm("stp    x0, x1,   [x2]");
+    asm("ldr    x0,       [sp, #240]");
+    asm("str    x0,       [x2, #16]");
+
+    asm("add    x0, sp, #272");
+    asm("ld1    {v0.2d, v1.2d, v2.2d, v3.2d}, [x0], #64");
+    asm("ld1    {v4.2d, v5.2d, v6.2d, v7.2d}, [x0], #64");
+    asm("ld1    {v8.2d, v9.2d, v10.2d, v11.2d}, [x0], #64");
+    asm("ld1    {v12.2d, v13.2d, v14.2d, v15.2d}, [x0], #64");
+    asm("ld1    {v16.2d, v17.2d, v18.2d, v19.2d}, [x0], #64");
+    asm("ld1    {v20.2d, v21.2d, v22.2d, v23.2d}, [x0], #64");
+    asm("ld1    {v24.2d, v25.2d, v26.2d, v27.2d}, [x0], #64");
+    asm("ld1    {v28.2d, v29.2d, v30.2d, v31.2d}, [x0], #64");
+
+    asm("ldp    x0, x1,   [sp, #256]");
+    asm("msr    nzcv, x0");
+    asm("msr    fpsr, x1");
+
+    asm("ldp    x0, x1,   [sp, #0]");
+    asm("ldp    x2, x3,   [sp, #16]");
+    asm("ldp    x4, x5,   [sp, #32]");
+    asm("ldp    x6, x7,   [sp, #48]");
+    asm("ldp    x8, x9,   [sp, #64]");
+    asm("ldp    x10, x11, [sp, #80]");
+    asm("ldp    x12, x13, [sp, #96]");
+    asm("ldp    x14, x15, [sp, #112]");
+    asm("ldp    x18, x19, [sp, #144]");
+    asm("ldp    x20, x21, [sp, #160]");
+    asm("ldp    x22, x23, [sp, #176]");
+    asm("ldp    x24, x25, [sp, #192]");
+    asm("ldp    x26, x27, [sp, #208]");
+    asm("ldp    x28, x29, [sp, #224]");
+    asm("add    sp, sp, #784");
+    asm("ret");
+}
+
+/**
+ * Redirects the emulated atomic at PC to an AtomicStub
+ *
+ * The site then runs the emulation with a plain branch instead of taking a SIGBUS every time.
+ * Stubs live in the site's own code segment so a direct branch always reaches and they go away together.
+ */
+static void BackpatchAtomic(FEXCore::CPU::CPUBackend *Backend, uint32_t *PC, uint64_t BytesToSkip) {
+  if (!Backend) {
+    return;
+  }
+
+  auto Stub = reinterpret_cast<AtomicStub*>(Backend->AllocateCodeStub(reinterpret_cast<uintptr_t>(PC), sizeof(AtomicStub)));
+  if (!Stub) {
+    // No room left in this segment, the site keeps being emulated from the signal handler
+    return;
+  }
+
+  memcpy(Stub->Instrs, PC, sizeof(Stub->Instrs));
+  Stub->Trampoline = reinterpret_cast<uint64_t>(&Arm64AtomicStubTrampoline);
+  Stub->Code[0] = STUB_SAVE_X16_X17;
+  Stub->Code[1] = STUB_SAVE_LR;
+  Stub->Code[2] = STUB_ADR_INSTRS;
+  Stub->Code[3] = STUB_LOAD_TRAMPOLINE;
+  Stub->Code[4] = STUB_CALL_TRAMPOLINE;
+  Stub->Code[5] = STUB_RESTORE_LR;
+  Stub->Code[6] = STUB_RESTORE_X16_X17;
+  Stub->Code[7] = EncodeBranch(&Stub->Code[7], reinterpret_cast<uint8_t*>(PC) + BytesToSkip);
+  vixl::aarch64::CPU::EnsureIAndDCacheCoherency(Stub, sizeof(AtomicStub));
+
+  // Code buffers are per thread, nothing else can be executing the site while it changes
+  PC[0] = EncodeBranch(PC, Stub);
+  vixl::aarch64::CPU::EnsureIAndDCacheCoherency(PC, sizeof(uint32_t));
+}
+
+bool HandleSIGBUS(bool ParanoidTSO, int Signal, void *info, void *ucontext, FEXCore::CPU::CPUBackend *Backend) {
 #ifdef _M_ARM_64
   constexpr bool is_arm64 = true;
 #else
@@ -2130,181 +2386,81 @@ bool HandleSIGBUS(bool ParanoidTSO, int Signal, void *info, void *ucontext) {
     uint32_t Size = (Instr & 0xC000'0000) >> 30;
     uint32_t AddrReg = (Instr >> 5) & 0x1F;
     uint32_t DataReg = Instr & 0x1F;
-    if ((Instr & 0x3F'FF'FC'00) == 0x08'DF'FC'00 || // LDAR*
-        (Instr & 0x3F'FF'FC'00) == 0x38'BF'C0'00) { // LDAPR*
-      if (ParanoidTSO) {
-        if (FEXCore::ArchHelpers::Arm64::HandleAtomicLoad(ucontext, info, Instr, 0)) {
-          // Skip this instruction now
-          ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) + 4);
-          return true;
-        }
-        else {
-          LogMan::Msg::EFmt("Unhandled JIT SIGBUS LDAR*: PC: {} Instruction: 0x{:08x}\n", fmt::ptr(PC), PC[0]);
-          return false;
-        }
-      }
-      else {
-        uint32_t LDR = 0b0011'1000'0111'1111'0110'1000'0000'0000;
-        LDR |= Size << 30;
-        LDR |= AddrReg << 5;
-        LDR |= DataReg;
-        PC[-1] = DMB;
-        PC[0] = LDR;
-        PC[1] = DMB;
-        // Back up one instruction and have another go
-        ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) - 4);
-      }
-    }
-    else if ( (Instr & 0x3F'FF'FC'00) == 0x08'9F'FC'00) { // STLR*
-      if (ParanoidTSO) {
-        if (FEXCore::ArchHelpers::Arm64::HandleAtomicStore(ucontext, info, Instr, 0)) {
-          // Skip this instruction now
-          ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) + 4);
-          return true;
-        }
-        else {
-          LogMan::Msg::EFmt("Unhandled JIT SIGBUS STLR*: PC: {} Instruction: 0x{:08x}\n", fmt::ptr(PC), PC[0]);
-          return false;
-        }
-      }
-      else {
-        uint32_t STR = 0b0011'1000'0011'1111'0110'1000'0000'0000;
-        STR |= Size << 30;
-        STR |= AddrReg << 5;
-        STR |= DataReg;
-        PC[-1] = DMB;
-        PC[0] = STR;
-        PC[1] = DMB;
-        // Back up one instruction and have another go
-        ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) - 4);
-      }
+
+    // Without paranoid TSO the RCPC loads and stores are swapped for plain ones between barriers in place
+    if (!ParanoidTSO &&
+        ((Instr & 0x3F'FF'FC'00) == 0x08'DF'FC'00 || // LDAR*
+         (Instr & 0x3F'FF'FC'00) == 0x38'BF'C0'00)) { // LDAPR*
+      uint32_t LDR = 0b0011'1000'0111'1111'0110'1000'0000'0000;
+      LDR |= Size << 30;
+      LDR |= AddrReg << 5;
+      LDR |= DataReg;
+      PC[-1] = DMB;
+      PC[0] = LDR;
+      PC[1] = DMB;
+      // Back up one instruction and have another go
+      ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) - 4);
     }
-    else if ((Instr & RCPC2_MASK) == LDAPUR_INST) { // LDAPUR*
-      // Extract the 9-bit offset from the instruction
-      int32_t Offset = static_cast<int32_t>(Instr) << 11 >> 23;
-      if (ParanoidTSO) {
-        if (FEXCore::ArchHelpers::Arm64::HandleAtomicLoad(ucontext, info, Instr, Offset)) {
-          // Skip this instruction now
-          ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) + 4);
-          return true;
-        }
-        else {
-          LogMan::Msg::EFmt("Unhandled JIT SIGBUS LDAPUR*: PC: {} Instruction: 0x{:08x}\n", fmt::ptr(PC), PC[0]);
-          return false;
-        }
-      }
-      else {
-        uint32_t LDUR = 0b0011'1000'0100'0000'0000'0000'0000'0000;
-        LDUR |= Size << 30;
-        LDUR |= AddrReg << 5;
-        LDUR |= DataReg;
-        LDUR |= Instr & (0b1'1111'1111 << 9);
-        PC[-1] = DMB;
-        PC[0] = LDUR;
-        PC[1] = DMB;
-        // Back up one instruction and have another go
-        ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) - 4);
-      }
+    else if (!ParanoidTSO && (Instr & 0x3F'FF'FC'00) == 0x08'9F'FC'00) { // STLR*
+      uint32_t STR = 0b0011'1000'0011'1111'0110'1000'0000'0000;
+      STR |= Size << 30;
+      STR |= AddrReg << 5;
+      STR |= DataReg;
+      PC[-1] = DMB;
+      PC[0] = STR;
+      PC[1] = DMB;
+      // Back up one instruction and have another go
+      ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) - 4);
     }
-    else if ((Instr & RCPC2_MASK) == STLUR_INST) { // STLUR*
-      // Extract the 9-bit offset from the instruction
-      int32_t Offset = static_cast<int32_t>(Instr) << 11 >> 23;
-      if (ParanoidTSO) {
-        if (FEXCore::ArchHelpers::Arm64::HandleAtomicStore(ucontext, info, Instr, Offset)) {
-          // Skip this instruction now
-          ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) + 4);
-          return true;
-        }
-        else {
-          LogMan::Msg::EFmt("Unhandled JIT SIGBUS LDLUR*: PC: {} Instruction: 0x{:08x}\n", fmt::ptr(PC), PC[0]);
-          return false;
-        }
-      }
-      else {
-        uint32_t STUR = 0b0011'1000'0000'0000'0000'0000'0000'0000;
-        STUR |= Size << 30;
-        STUR |= AddrReg << 5;
-        STUR |= DataReg;
-        STUR |= Instr & (0b1'1111'1111 << 9);
-        PC[-1] = DMB;
-        PC[0] = STUR;
-        PC[1] = DMB;
-        // Back up one instruction and have another go
-        ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) - 4);
-      }
+    else if (!ParanoidTSO && (Instr & RCPC2_MASK) == LDAPUR_INST) { // LDAPUR*
+      uint32_t LDUR = 0b0011'1000'0100'0000'0000'0000'0000'0000;
+      LDUR |= Size << 30;
+      LDUR |= AddrReg << 5;
+      LDUR |= DataReg;
+      LDUR |= Instr & (0b1'1111'1111 << 9);
+      PC[-1] = DMB;
+      PC[0] = LDUR;
+      PC[1] = DMB;
+      // Back up one instruction and have another go
+      ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) - 4);
     }
-    else if ((Instr & FEXCore::ArchHelpers::Arm64::LDAXP_MASK) == FEXCore::ArchHelpers::Arm64::LDAXP_INST) { // LDAXP
-      //Should be compare and swap pair only. LDAXP not used elsewhere
-      uint64_t BytesToSkip = FEXCore::ArchHelpers::Arm64::HandleCASPAL_ARMv8(ucontext, info, Instr);
-      if (BytesToSkip) {
-        // Skip this instruction now
-        ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) + BytesToSkip);
-        return true;
-      }
-      else {
-        if (FEXCore::ArchHelpers::Arm64::HandleAtomicVectorStore(ucontext, info, Instr)) {
-          return true;
-        }
-        else {
-          LogMan::Msg::EFmt("Unhandled JIT SIGBUS LDAXP: PC: {} Instruction: 0x{:08x}\n", fmt::ptr(PC), PC[0]);
-          return false;
-        }
-      }
+    else if (!ParanoidTSO && (Instr & RCPC2_MASK) == STLUR_INST) { // STLUR*
+      uint32_t STUR = 0b0011'1000'0000'0000'0000'0000'0000'0000;
+      STUR |= Size << 30;
+      STUR |= AddrReg << 5;
+      STUR |= DataReg;
+      STUR |= Instr & (0b1'1111'1111 << 9);
+      PC[-1] = DMB;
+      PC[0] = STUR;
+      PC[1] = DMB;
+      // Back up one instruction and have another go
+      ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) - 4);
     }
     else if ((Instr & FEXCore::ArchHelpers::Arm64::STLXP_MASK) == FEXCore::ArchHelpers::Arm64::STLXP_INST) { // STLXP
       //Should not trigger - middle of an LDAXP/STAXP pair.
       LogMan::Msg::EFmt("Unhandled JIT SIGBUS STLXP: PC: {} Instruction: 0x{:08x}\n", fmt::ptr(PC), PC[0]);
       return false;
     }
-    else if ((Instr & FEXCore::ArchHelpers::Arm64::CASPAL_MASK) == FEXCore::ArchHelpers::Arm64::CASPAL_INST) { // CASPAL
-      if (FEXCore::ArchHelpers::Arm64::HandleCASPAL(ucontext, info, Instr)) {
-        // Skip this instruction now
-        ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) + 4);
-        return true;
-      }
-      else {
-        LogMan::Msg::EFmt("Unhandled JIT SIGBUS CASPAL: PC: {} Instruction: 0x{:08x}\n", fmt::ptr(PC), PC[0]);
-        return false;
-      }
-    }
-    else if ((Instr & FEXCore::ArchHelpers::Arm64::CASAL_MASK) == FEXCore::ArchHelpers::Arm64::CASAL_INST) { // CASAL
-      if (FEXCore::ArchHelpers::Arm64::HandleCASAL(ucontext, info, Instr)) {
-        // Skip this instruction now
-        ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) + 4);
-        return true;
-      }
-      else {
-        LogMan::Msg::EFmt("Unhandled JIT SIGBUS CASAL: PC: {} Instruction: 0x{:08x}\n", fmt::ptr(PC), PC[0]);
-        return false;
-      }
-    }
-    else if ((Instr & FEXCore::ArchHelpers::Arm64::ATOMIC_MEM_MASK) == FEXCore::ArchHelpers::Arm64::ATOMIC_MEM_INST) { // Atomic memory op
-      if (FEXCore::ArchHelpers::Arm64::HandleAtomicMemOp(ucontext, info, Instr)) {
-        // Skip this instruction now
-        ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) + 4);
-        return true;
-      }
-      else {
-        uint8_t Op = (PC[0] >> 12) & 0xF;
-        LogMan::Msg::EFmt("Unhandled JIT SIGBUS Atomic mem op 0x{:02x}: PC: {} Instruction: 0x{:08x}\n", Op, fmt::ptr(PC), PC[0]);
-        return false;
-      }
-    }
-    else if ((Instr & FEXCore::ArchHelpers::Arm64::LDAXR_MASK) == FEXCore::ArchHelpers::Arm64::LDAXR_INST) { // LDAXR*
-      uint64_t BytesToSkip = FEXCore::ArchHelpers::Arm64::HandleAtomicLoadstoreExclusive(ucontext, info);
-      if (BytesToSkip) {
-        // Skip this instruction now
-        ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) + BytesToSkip);
-        return true;
-      }
-      else {
-        LogMan::Msg::EFmt("Unhandled JIT SIGBUS LDAXR: PC: {} Instruction: 0x{:08x}\n", fmt::ptr(PC), PC[0]);
+    else {
+      // Everything else gets emulated
+      uint64_t BytesToSkip = EmulateAtomic(info, ucontext);
+      if (!BytesToSkip) {
+        if ((Instr & FEXCore::ArchHelpers::Arm64::LDAXP_MASK) == FEXCore::ArchHelpers::Arm64::LDAXP_INST &&
+            FEXCore::ArchHelpers::Arm64::HandleAtomicVectorStore(ucontext, info, Instr)) {
+          // Patched in place
+          return true;
+        }
+
+        LogMan::Msg::EFmt("Unhandled JIT SIGBUS: PC: {} Instruction: 0x{:08x}\n", fmt::ptr(PC), PC[0]);
         return false;
       }
-    }
-    else {
-      LogMan::Msg::EFmt("Unhandled JIT SIGBUS: PC: {} Instruction: 0x{:08x}\n", fmt::ptr(PC), PC[0]);
-      return false;
+
+      // A site that was misaligned once likely stays that way, send it straight to the emulation from now on
+      BackpatchAtomic(Backend, PC, BytesToSkip);
+
+      // Skip this instruction now
+      ArchHelpers::Context::SetPc(ucontext, ArchHelpers::Context::GetPc(ucontext) + BytesToSkip);
+      return true;
     }
 
     vixl::aarch64::CPU::EnsureIAndDCacheCoherency(&PC[-1], 16);
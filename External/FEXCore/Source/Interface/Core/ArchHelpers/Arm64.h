@@ -2,6 +2,10 @@
 
 #include <stdint.h>
 
+namespace FEXCore::CPU {
+  class CPUBackend;
+}
+
 namespace FEXCore::ArchHelpers::Arm64 {
   constexpr uint32_t CASPAL_MASK = 0xBF'E0'FC'00;
   constexpr uint32_t CASPAL_INST = 0x08'60'FC'00;
@@ -105,5 +109,12 @@ namespace FEXCore::ArchHelpers::Arm64 {
   bool HandleAtomicVectorStore(void *_ucontext, void *_info, uint32_t Instr);
   bool HandleCASAL(void *_ucontext, void *_info, uint32_t Instr);
   bool HandleAtomicMemOp(void *_ucontext, void *_info, uint32_t Instr);
-  [[nodiscard]] bool HandleSIGBUS(bool ParanoidTSO, int Signal, void *info, void *ucontext);
+
+  /**
+   * @brief Handles a SIGBUS from a misaligned atomic
+   *
+   * @param Backend - Owner of the faulting code, sites are backpatched to branch to an out of line emulation in its stub area.
+   *                  nullptr if the faulting code can't be patched, it then gets emulated on every fault.
+   */
+  [[nodiscard]] bool HandleSIGBUS(bool ParanoidTSO, int Signal, void *info, void *ucontext, FEXCore::CPU::CPUBackend *Backend);
 }
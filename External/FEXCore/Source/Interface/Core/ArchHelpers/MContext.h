@@ -210,6 +210,23 @@ static inline void SetState(void* ucontext, uint64_t val) {
   GetMContext(ucontext)->gregs[REG_R14] = val;
 }
 
+/**
+ * @brief Reads a host GPR by its x86 encoding index, which doesn't match the order of mcontext gregs
+ */
+static inline uint64_t GetX86Reg(void* ucontext, uint32_t id) {
+  constexpr static int EncodingToGReg[16] = {
+    REG_RAX, REG_RCX, REG_RDX, REG_RBX, REG_RSP, REG_RBP, REG_RSI, REG_RDI,
+    REG_R8,  REG_R9,  REG_R10, REG_R11, REG_R12, REG_R13, REG_R14, REG_R15,
+  };
+  return GetMContext(ucontext)->gregs[EncodingToGReg[id]];
+}
+
+static inline __uint128_t GetX86XMM(void* ucontext, uint32_t id) {
+  __uint128_t Result;
+  memcpy(&Result, &GetMContext(ucontext)->fpregs->_xmm[id], sizeof(Result));
+  return Result;
+}
+
 static inline uint64_t GetArmReg(void* ucontext, uint32_t id) {
   ERROR_AND_DIE_FMT("Not impelented for x86 host");
 }
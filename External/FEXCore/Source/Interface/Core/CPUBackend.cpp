@@ -1,12 +1,29 @@
 #include "Interface/Context/Context.h"
 #include "Interface/Core/Dispatcher/Dispatcher.h"
 #include <FEXCore/Core/CPUBackend.h>
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/MathUtils.h>
+
+#include <algorithm>
+#include <sys/mman.h>
 
 namespace FEXCore {
 namespace CPU {
 
-CPUBackend::CPUBackend(FEXCore::Core::InternalThreadState *ThreadState, size_t InitialCodeSize, size_t MaxCodeSize)
-    : ThreadState(ThreadState), InitialCodeSize(InitialCodeSize), MaxCodeSize(MaxCodeSize) {}
+CPUBackend::CPUBackend(FEXCore::Core::InternalThreadState *ThreadState, size_t SegmentSize, size_t MaxCodeSize, size_t StubAreaSize)
+    : ThreadState(ThreadState), SegmentSize(SegmentSize), MaxCodeSize(MaxCodeSize), StubAreaSize(StubAreaSize) {
+  if (const uint64_t BufferSize = ThreadState->CTX->Config.CodeBufferSize()) {
+    // Code buffers are mapped in huge page multiples, and can't grow past what the backend's branches reach
+    this->MaxCodeSize = std::min<size_t>(FEXCore::AlignUp(BufferSize << 20, FEXCore::Allocator::HUGE_PAGE_SIZE), MaxCodeSize);
+    this->SegmentSize = this->MaxCodeSize / NUM_RESIZED_SEGMENTS;
+    this->StubAreaSize = std::min(StubAreaSize, this->SegmentSize / 4);
+  }
+
+  LOGMAN_THROW_A_FMT(this->MaxCodeSize % this->SegmentSize == 0 && this->MaxCodeSize / this->SegmentSize >= 2, "Code buffer needs at least two segments");
+  LOGMAN_THROW_A_FMT(this->StubAreaSize % 16 == 0 && this->StubAreaSize < this->SegmentSize / 2, "Stub area doesn't fit in a segment");
+}
 
 CPUBackend::~CPUBackend() {
   for (auto CodeBuffer : CodeBuffers) {
@@ -18,7 +35,8 @@ CPUBackend::~CPUBackend() {
 auto CPUBackend::GetEmptyCodeBuffer() -> CodeBuffer * {
   if (ThreadState->CurrentFrame->SignalHandlerRefCounter == 0) {
     if (CodeBuffers.empty()) {
-      auto NewCodeBuffer = AllocateNewCodeBuffer(InitialCodeSize);
+      // The full size is reserved up front, pages only get committed as segments are filled
+      auto NewCodeBuffer = AllocateNewCodeBuffer(MaxCodeSize);
       EmplaceNewCodeBuffer(NewCodeBuffer);
     } else {
       if (CodeBuffers.size() > 1) {
@@ -31,34 +49,167 @@ auto CPUBackend::GetEmptyCodeBuffer() -> CodeBuffer * {
       }
       // Set the current code buffer to the initial
       CurrentCodeBuffer = &CodeBuffers[0];
-
-      if (CurrentCodeBuffer->Size != MaxCodeSize) {
-        FreeCodeBuffer(*CurrentCodeBuffer);
-
-        // Resize the code buffer and reallocate our code size
-        CurrentCodeBuffer->Size *= 1.5;
-        CurrentCodeBuffer->Size = std::min(CurrentCodeBuffer->Size, MaxCodeSize);
-
-        *CurrentCodeBuffer = AllocateNewCodeBuffer(CurrentCodeBuffer->Size);
-      }
     }
+
+    ResetCodeSegments();
+    CurrentCodeRegion = {CodeSegments[0].Ptr, CodeSegments[0].Size - StubAreaSize};
+    ResetColdCode();
   } else {
     // We have signal handlers that have generated code
     // This means that we can not safely clear the code at this point in time
     // Allocate some new code buffers that we can switch over to instead
-    auto NewCodeBuffer = AllocateNewCodeBuffer(InitialCodeSize);
+    auto NewCodeBuffer = AllocateNewCodeBuffer(std::max(SegmentSize, FEXCore::Allocator::HUGE_PAGE_SIZE));
     EmplaceNewCodeBuffer(NewCodeBuffer);
+    CurrentCodeRegion = *CurrentCodeBuffer;
+    ResetColdCode();
+  }
+
+  return &CurrentCodeRegion;
+}
+
+void CPUBackend::ResetCodeSegments() {
+  const size_t NumSegments = MaxCodeSize / SegmentSize;
+  CodeSegments.resize(NumSegments);
+
+  for (size_t i = 0; i < NumSegments; ++i) {
+    auto &Segment = CodeSegments[i];
+    Segment.Ptr = CodeBuffers[0].Ptr + i * SegmentSize;
+    Segment.Size = SegmentSize;
+    Segment.Blocks.clear();
+    Segment.LiveBlocks = 0;
+    Segment.CodeBytes = 0;
+    Segment.Referenced = false;
+    Segment.StubBytes = 0;
+    Segment.EvictedBlocks.clear();
   }
 
-  return CurrentCodeBuffer;
+  ClockHand = 0;
+
+  // Anything compiled after a full clear is because of the clear, not because of eviction
+  EvictedBlocks.clear();
+}
+
+void CPUBackend::ResetColdCode() {
+  // No cold chunk until the first block needs one
+  ColdCodeBegin = CurrentCodeRegion.Size;
+  ColdCodeEnd = ColdCodeBegin;
+  ColdCodeCursor = ColdCodeBegin;
+}
+
+bool CPUBackend::ShouldSplitColdCode() const {
+  auto &Config = ThreadState->CTX->Config;
+  return Config.SplitColdCode() &&
+    Config.CacheObjectCodeCompilation() == FEXCore::Config::ConfigObjectCodeHandler::CONFIG_NONE;
+}
+
+bool CPUBackend::ReserveCodeRegionSpace(size_t HotOffset, size_t Size) {
+  if (SplitColdCode && ColdCodeCursor + Size > ColdCodeEnd) {
+    // Start a new chunk below the current one, the unused tail of the current chunk is lost
+    const size_t ChunkSize = std::max(Size, COLD_CODE_CHUNK_SIZE);
+    if (HotOffset + Size + ChunkSize > ColdCodeBegin) {
+      return false;
+    }
+
+    ColdCodeEnd = ColdCodeBegin;
+    ColdCodeBegin -= ChunkSize;
+    ColdCodeCursor = ColdCodeBegin;
+  }
+
+  return HotOffset + Size <= ColdCodeBegin;
+}
+
+void CPUBackend::FindColdCodeBlocks(FEXCore::IR::IRListView const *IR, std::unordered_set<FEXCore::IR::NodeID> *ColdBlocks) {
+  ColdBlocks->clear();
+
+  bool EntryBlock = true;
+  for (auto [BlockNode, BlockHeader] : IR->GetBlocks()) {
+    if (EntryBlock) {
+      EntryBlock = false;
+      continue;
+    }
+
+    for (auto [CodeNode, IROp] : IR->GetCode(BlockNode)) {
+      if (IROp->Op == FEXCore::IR::OP_REMOVETHREADCODEENTRY ||
+          IROp->Op == FEXCore::IR::OP_BREAK) {
+        ColdBlocks->insert(IR->GetID(BlockNode));
+        break;
+      }
+    }
+  }
+}
+
+bool CPUBackend::CanReuseCodeSegments() const {
+  return ThreadState->CurrentFrame->SignalHandlerRefCounter == 0 &&
+    CodeBuffers.size() == 1 &&
+    !CodeSegments.empty();
+}
+
+auto CPUBackend::NextCodeSegment() -> CodeSegment * {
+  ClockHand = (ClockHand + 1) % CodeSegments.size();
+  return &CodeSegments[ClockHand];
+}
+
+auto CPUBackend::FindDeadCodeSegment() -> CodeSegment * {
+  for (size_t i = 0; i < CodeSegments.size(); ++i) {
+    auto &Segment = CodeSegments[i];
+    if (i != ClockHand && !Segment.Blocks.empty() && Segment.LiveBlocks == 0) {
+      return &Segment;
+    }
+  }
+
+  return nullptr;
+}
+
+void CPUBackend::BeginCodeSegment(CodeSegment *Segment) {
+  Segment->Blocks.clear();
+  Segment->LiveBlocks = 0;
+  Segment->CodeBytes = 0;
+  Segment->Referenced = false;
+  Segment->StubBytes = 0;
+
+  ClockHand = Segment - CodeSegments.data();
+  CurrentCodeRegion = {Segment->Ptr, Segment->Size - StubAreaSize};
+  ResetColdCode();
+  SetCodeRegion(CurrentCodeRegion);
+}
+
+bool CPUBackend::AddBlockToSegment(uint64_t GuestRIP, uintptr_t HostCode, size_t HostCodeSize) {
+  if (auto Segment = GetCodeSegment(HostCode)) {
+    Segment->Blocks.emplace_back(GuestRIP);
+    ++Segment->LiveBlocks;
+    Segment->CodeBytes += HostCodeSize;
+  }
+
+  return EvictedBlocks.erase(GuestRIP) != 0;
+}
+
+void CPUBackend::RemoveBlockFromSegment(uintptr_t HostCode) {
+  auto Segment = GetCodeSegment(HostCode);
+  if (Segment && Segment->LiveBlocks) {
+    --Segment->LiveBlocks;
+  }
+}
+
+uint8_t *CPUBackend::AllocateCodeStub(uintptr_t HostCode, size_t Size) {
+  auto Segment = GetCodeSegment(HostCode);
+  Size = (Size + 15) & ~size_t(15);
+  if (!Segment || Segment->StubBytes + Size > StubAreaSize) {
+    return nullptr;
+  }
+
+  // Stubs are handed out from the end of the segment down
+  Segment->StubBytes += Size;
+  return Segment->Ptr + Segment->Size - Segment->StubBytes;
 }
 
 auto CPUBackend::AllocateNewCodeBuffer(size_t Size) -> CodeBuffer {
   CodeBuffer Buffer;
   Buffer.Size = Size;
-  Buffer.Ptr = static_cast<uint8_t *>(
-      FEXCore::Allocator::mmap(nullptr, Buffer.Size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
-  LOGMAN_THROW_A_FMT(!!Buffer.Ptr, "Couldn't allocate code buffer");
+  // ConfigHugePages and HugePageType line up
+  const auto HugePages = static_cast<FEXCore::Allocator::HugePageType>(ThreadState->CTX->Config.HugePages());
+  auto Ptr = FEXCore::Allocator::MapHugePageAligned(Buffer.Size, PROT_READ | PROT_WRITE | PROT_EXEC, HugePages);
+  LOGMAN_THROW_A_FMT(Ptr != MAP_FAILED, "Couldn't allocate code buffer");
+  Buffer.Ptr = static_cast<uint8_t *>(Ptr);
   
   if (ThreadState->CTX->Config.GlobalJITNaming()) {
     ThreadState->CTX->Symbols.RegisterJITSpace(Buffer.Ptr, Buffer.Size);
@@ -70,6 +221,17 @@ void CPUBackend::FreeCodeBuffer(CodeBuffer Buffer) {
   FEXCore::Allocator::munmap(Buffer.Ptr, Buffer.Size);
 }
 
+void CPUBackend::ReleaseCodeBuffers() {
+  for (auto &Buffer : CodeBuffers) {
+    madvise(Buffer.Ptr, Buffer.Size, MADV_DONTNEED);
+  }
+}
+
+void CPUBackend::ResetForThread(FEXCore::Core::InternalThreadState *NewThreadState) {
+  ThreadState = NewThreadState;
+  ClearCache();
+}
+
 bool CPUBackend::IsAddressInCodeBuffer(uintptr_t Address) const {
   for (auto &Buffer: CodeBuffers) {
     auto start = (uintptr_t)Buffer.Ptr;
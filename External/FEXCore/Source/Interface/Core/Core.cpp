@@ -17,6 +17,8 @@ $end_info$
 #include "Interface/Core/ObjectCache/ObjectCacheService.h"
 #include "Interface/Core/OpcodeDispatcher.h"
 #include "Interface/Core/Interpreter/InterpreterCore.h"
+#include "Interface/Core/SamplingProfiler.h"
+#include "Interface/Core/SharedStats.h"
 #include "Interface/Core/JIT/JITCore.h"
 #include "Interface/Core/Dispatcher/Dispatcher.h"
 #include "Interface/HLE/Thunks/Thunks.h"
@@ -154,6 +156,13 @@ namespace FEXCore::Context {
     if (Config.CacheObjectCodeCompilation() != FEXCore::Config::ConfigObjectCodeHandler::CONFIG_NONE) {
       CodeObjectCacheService = std::make_unique<FEXCore::CodeSerialize::CodeObjectSerializeService>(this);
     }
+
+    if (Config.SharedStats()) {
+      StatsRegion = FEXCore::SharedStats::Create();
+    }
+
+    // Created up front so the frontend can register host thunks before InitCore
+    ThunkHandler.reset(FEXCore::ThunkHandler::Create());
   }
 
   Context::~Context() {
@@ -172,6 +181,8 @@ namespace FEXCore::Context {
         delete Thread;
       }
       Threads.clear();
+
+      CompilerPool.clear();
     }
   }
 
@@ -242,6 +253,11 @@ namespace FEXCore::Context {
 
     SignalDelegation->RegisterHostSignalHandler(SignalDelegator::SIGNAL_FOR_PAUSE, PauseHandler, true);
 
+    if (!Config.SampleProfile().empty()) {
+      Profiler = std::make_unique<FEXCore::SamplingProfiler>(this, Config.SampleProfile(), Config.SampleProfileHz());
+      SignalDelegation->RegisterHostSignalHandler(SignalDelegator::SIGNAL_FOR_PROFILE, FEXCore::SamplingProfiler::HandleSignal, true);
+    }
+
     auto GuestSignalHandler = [](FEXCore::Core::InternalThreadState *Thread, int Signal, void *info, void *ucontext, GuestSigAction *GuestAction, stack_t *GuestStack) -> bool {
       return Thread->CTX->Dispatcher->HandleGuestSignal(Thread, Signal, info, ucontext, GuestAction, GuestStack);
     };
@@ -259,8 +275,6 @@ namespace FEXCore::Context {
       StopGdbServer();
     }
 
-    ThunkHandler.reset(FEXCore::ThunkHandler::Create());
-
     using namespace FEXCore::Core;
 
     FEXCore::Core::CPUState NewThreadState = CreateDefaultCPUState();
@@ -507,6 +521,18 @@ namespace FEXCore::Context {
     Thread->ThreadManager.PID = ::getpid();
     SignalDelegation->RegisterTLSState(Thread);
     ThunkHandler->RegisterTLSState(Thread);
+
+    if (StatsRegion) {
+      StatsRegion->AllocateSlot(Thread);
+      Thread->PassManager->RegisterStats(Thread->Stats);
+
+      Thread->PassManager->RegisterPassTimingHandler([Region = StatsRegion.get(), Thread](std::string_view Name, uint64_t Nanoseconds) {
+        const auto Index = Region->GetPassIndex(Name);
+        if (Index < FEXCore::Core::RuntimeStats::MAX_PASSES) {
+          FEXCore::Core::IncrementStat(Thread->Stats->PassNanoseconds[Index], Nanoseconds);
+        }
+      });
+    }
   }
 
   void Context::RunThread(FEXCore::Core::InternalThreadState *Thread) {
@@ -514,7 +540,75 @@ namespace FEXCore::Context {
     Thread->StartRunning.NotifyAll();
   }
 
+  bool Context::AcquirePooledCompiler(FEXCore::Core::InternalThreadState* Thread) {
+    std::unique_lock lk(CompilerPoolMutex);
+    if (CompilerPool.empty()) {
+      return false;
+    }
+
+    auto Compiler = std::move(CompilerPool.back());
+    CompilerPool.pop_back();
+    lk.unlock();
+
+    Thread->OpDispatcher = std::move(Compiler.OpDispatcher);
+    Thread->CPUBackend = std::move(Compiler.CPUBackend);
+    Thread->LookupCache = std::move(Compiler.LookupCache);
+    Thread->FrontendDecoder = std::move(Compiler.FrontendDecoder);
+    Thread->PassManager = std::move(Compiler.PassManager);
+
+    // The process specific pointers are identical for every thread, thread specific ones get refilled below
+    Thread->CurrentFrame->Pointers = Compiler.Pointers;
+    Thread->CurrentFrame->Pointers.Common.L1Pointer = Thread->LookupCache->GetL1Pointer();
+    Thread->CurrentFrame->Pointers.Common.L2Pointer = Thread->LookupCache->GetPagePointer();
+
+    Dispatcher->InitThreadPointers(Thread);
+
+    Thread->CTX = this;
+
+    // AOT generation may have configured the previous owner's decoder
+    Thread->FrontendDecoder->SetExternalBranches(nullptr);
+    Thread->FrontendDecoder->SetSectionMaxAddress(~0ULL);
+
+    Thread->CPUBackend->ResetForThread(Thread);
+    return true;
+  }
+
+  void Context::ReleaseCompilerToPool(FEXCore::Core::InternalThreadState* Thread) {
+    if (!Thread->CPUBackend) {
+      return;
+    }
+
+    std::lock_guard lk(CompilerPoolMutex);
+    if (CompilerPool.size() >= Config.CompilerPoolSize) {
+      return;
+    }
+
+    {
+      std::lock_guard<std::recursive_mutex> lkLookupCache(Thread->LookupCache->WriteLock);
+      Thread->LookupCache->ClearCache();
+      Thread->LookupCache->CodePages.clear();
+    }
+
+    Thread->CPUBackend->ReleaseCodeBuffers();
+    Thread->FrontendDecoder->ClearDecodeCache();
+    Thread->PassManager->RegisterPassTimingHandler({});
+    Thread->PassManager->RegisterStats(nullptr);
+
+    CompilerPool.emplace_back(PooledCompiler {
+      .OpDispatcher = std::move(Thread->OpDispatcher),
+      .CPUBackend = std::move(Thread->CPUBackend),
+      .LookupCache = std::move(Thread->LookupCache),
+      .FrontendDecoder = std::move(Thread->FrontendDecoder),
+      .PassManager = std::move(Thread->PassManager),
+      .Pointers = Thread->CurrentFrame->Pointers,
+    });
+  }
+
   void Context::InitializeCompiler(FEXCore::Core::InternalThreadState* Thread) {
+    if (AcquirePooledCompiler(Thread)) {
+      return;
+    }
+
     Thread->OpDispatcher = std::make_unique<FEXCore::IR::OpDispatchBuilder>(this);
     Thread->OpDispatcher->SetMultiblock(Config.Multiblock);
     Thread->LookupCache = std::make_unique<FEXCore::LookupCache>(this);
@@ -533,7 +627,7 @@ namespace FEXCore::Context {
 
     bool DoSRA = DispatcherConfig.StaticRegisterAllocation;
 
-    Thread->PassManager->AddDefaultPasses(this, Config.Core == FEXCore::Config::CONFIG_IRJIT, DoSRA);
+    Thread->PassManager->AddDefaultPasses(this, Config.Core == FEXCore::Config::CONFIG_IRJIT, DoSRA, BackendFeatures.NumStaticGPRs, BackendFeatures.NumStaticFPRs);
     Thread->PassManager->AddDefaultValidationPasses();
 
     Thread->PassManager->RegisterSyscallHandler(SyscallHandler);
@@ -572,6 +666,7 @@ namespace FEXCore::Context {
     // Copy over the new thread state to the new object
     memcpy(Thread->CurrentFrame, NewThreadState, sizeof(FEXCore::Core::CPUState));
     Thread->CurrentFrame->Thread = Thread;
+    Thread->CurrentFrame->Stats = Thread->Stats;
 
     // Set up the thread manager state
     Thread->ThreadManager.parent_tid = ParentTID;
@@ -604,6 +699,9 @@ namespace FEXCore::Context {
       // To be able to delete a thread from itself, we need to detached the std::thread object
       Thread->ExecutionThread->detach();
     }
+
+    // Keep the compiler objects around so the next thread created doesn't need to rebuild them
+    ReleaseCompilerToPool(Thread);
     delete Thread;
   }
 
@@ -644,6 +742,14 @@ namespace FEXCore::Context {
 
     // Clean up dead stacks
     FEXCore::Threads::Thread::CleanupAfterFork();
+
+    if (Profiler) {
+      Profiler->CleanupAfterFork(LiveThread);
+    }
+
+    if (StatsRegion) {
+      StatsRegion->CleanupAfterFork(LiveThread);
+    }
   }
 
   void Context::AddBlockMapping(FEXCore::Core::InternalThreadState *Thread, uint64_t Address, void *Ptr) {
@@ -661,6 +767,78 @@ namespace FEXCore::Context {
     Thread->LookupCache->ClearCache();
     Thread->CPUBackend->ClearCache();
     Thread->DebugStore.clear();
+
+    // May be called from another thread when single stepping
+    Thread->Stats->CodeCacheClears.fetch_add(1, std::memory_order_relaxed);
+    Thread->Stats->CodeBufferBytes.store(0, std::memory_order_relaxed);
+
+    if (Thread->Sampler) {
+      Thread->Sampler->ClearBlocks();
+    }
+  }
+
+  void Context::EvictCodeSegment(FEXCore::Core::InternalThreadState *Thread) {
+    auto Backend = Thread->CPUBackend.get();
+    if (!Backend->CanReuseCodeSegments()) {
+      ClearCodeCache(Thread);
+      return;
+    }
+
+    {
+      // The object cache might still be serializing code that lives in the segment we are about to reuse
+      CodeSerialize::CodeObjectSerializeService::WaitForEmptyJobQueue(&Thread->ObjectCacheRefCounter);
+    }
+    std::lock_guard<std::recursive_mutex> lk(Thread->LookupCache->WriteLock);
+
+    // Segments that only hold invalidated blocks get reclaimed first
+    auto Segment = Backend->FindDeadCodeSegment();
+
+    if (!Segment) {
+      Segment = Backend->NextCodeSegment();
+      while (Segment->Referenced) {
+        // Second chance. Unlink the blocks so that if they are still in use
+        // they get looked up again and mark the segment before the hand comes back around
+        Segment->Referenced = false;
+        for (auto GuestRIP : Segment->Blocks) {
+          Thread->LookupCache->Unlink(GuestRIP);
+        }
+        Segment = Backend->NextCodeSegment();
+      }
+    }
+
+    const auto Start = reinterpret_cast<uintptr_t>(Segment->Ptr);
+    const auto End = Start + Segment->Size;
+
+    Backend->AgeEvictedBlocks(Segment);
+
+    uint64_t NumEvicted{};
+    for (auto GuestRIP : Segment->Blocks) {
+      // The block might have been invalidated and compiled again in to another segment
+      const auto HostCode = Thread->LookupCache->GetHostCode(GuestRIP);
+      if (HostCode >= Start && HostCode < End) {
+        Thread->LookupCache->Erase(GuestRIP);
+        Thread->DebugStore.erase(GuestRIP);
+        Backend->MarkBlockEvicted(Segment, GuestRIP);
+        ++NumEvicted;
+      }
+    }
+
+    // Links out of the evicted code can't be undone once it has been overwritten
+    Thread->LookupCache->EraseLinksFrom(Start, End);
+
+    if (Thread->Sampler) {
+      Thread->Sampler->RemoveBlocks(Start, End);
+    }
+
+    // The first lap of the clock hand only hands out unused segments
+    if (!Segment->Blocks.empty()) {
+      FEXCore::Core::IncrementStat(Thread->Stats->CodeSegmentEvictions);
+    }
+    FEXCore::Core::IncrementStat(Thread->Stats->BlocksEvicted, NumEvicted);
+    const auto CodeBytes = Thread->Stats->CodeBufferBytes.load(std::memory_order_relaxed);
+    Thread->Stats->CodeBufferBytes.store(CodeBytes - std::min<uint64_t>(CodeBytes, Segment->CodeBytes), std::memory_order_relaxed);
+
+    Backend->BeginCodeSegment(Segment);
   }
 
   static void IRDumper(FEXCore::Core::InternalThreadState *Thread, IR::IREmitter *IREmitter, uint64_t GuestRIP, IR::RegisterAllocationData* RA) {
@@ -746,6 +924,9 @@ namespace FEXCore::Context {
         }
       });
 
+      FEXCore::Core::IncrementStat(Thread->Stats->DecodeCacheHits, Thread->FrontendDecoder->DecodeCacheHits);
+      FEXCore::Core::IncrementStat(Thread->Stats->DecodeCacheMisses, Thread->FrontendDecoder->DecodeCacheMisses);
+
       auto CodeBlocks = Thread->FrontendDecoder->GetDecodedBlocks();
 
       Thread->OpDispatcher->BeginFunction(GuestRIP, CodeBlocks);
@@ -873,9 +1054,17 @@ namespace FEXCore::Context {
     }
 
     auto RAData = Thread->PassManager->HasPass("RA") ? Thread->PassManager->GetPass<IR::RegisterAllocationPass>("RA")->PullAllocationData() : nullptr;
-    auto IRList = IREmitter->CreateIRCopy();
 
-    IREmitter->DelayedDisownBuffer();
+    // The IR only needs its own storage if something holds on to it past the backend
+    // Otherwise lend out the emitter's buffer, the caller disowns it once the backend is done
+    FEXCore::IR::IRListView *IRList{};
+    if (GetGdbServerStatus() || Config.AOTIRCapture() || Config.AOTIRGenerate()) {
+      IRList = IREmitter->CreateIRCopy();
+      IREmitter->DelayedDisownBuffer();
+    }
+    else {
+      IRList = IREmitter->CreateIRView();
+    }
 
     return {
       .IRList = IRList,
@@ -892,6 +1081,7 @@ namespace FEXCore::Context {
     FEXCore::Core::DebugData *DebugData {};
     FEXCore::IR::RegisterAllocationData::UniquePtr RAData {};
     bool GeneratedIR {};
+    bool IREmitterView {};
     uint64_t StartAddr {};
     uint64_t Length {};
 
@@ -901,6 +1091,7 @@ namespace FEXCore::Context {
       if (CodeCacheEntry) {
         auto CompiledCode = Thread->CPUBackend->RelocateJITObjectCode(GuestRIP, CodeCacheEntry);
         if (CompiledCode) {
+          FEXCore::Core::IncrementStat(Thread->Stats->BlocksFromObjectCache);
           return {
               .CompiledCode = CompiledCode,
               .IRData = nullptr,    // No IR data generated
@@ -933,22 +1124,28 @@ namespace FEXCore::Context {
         StartAddr = _StartAddr;
         Length = _Length;
         GeneratedIR = _GeneratedIR;
+
+        FEXCore::Core::IncrementStat(Thread->Stats->BlocksFromAOTIR);
       }
     }
 
     if (IRList == nullptr) {
       // Generate IR + Meta Info
+      const auto IRStart = std::chrono::steady_clock::now();
       auto [IRCopy, RACopy, TotalInstructions, TotalInstructionsLength, _StartAddr, _Length] = GenerateIR(Thread, GuestRIP, Config.GDBSymbols());
+      const auto IRNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - IRStart).count();
 
       // Setup pointers to internal structures
       IRList = IRCopy;
+      IREmitterView = IRCopy && !IRCopy->IsCopy();
       RAData = std::move(RACopy);
       DebugData = new FEXCore::Core::DebugData();
       StartAddr = _StartAddr;
       Length = _Length;
 
       // Increment stats
-      Thread->Stats.BlocksCompiled.fetch_add(1);
+      FEXCore::Core::IncrementStat(Thread->Stats->BlocksCompiled);
+      FEXCore::Core::IncrementStat(Thread->Stats->IRGenNanoseconds, IRNanoseconds);
 
       // These blocks aren't already in the cache
       GeneratedIR = true;
@@ -957,9 +1154,22 @@ namespace FEXCore::Context {
     if (IRList == nullptr) {
       return {};
     }
+
     // Attempt to get the CPU backend to compile this code
+    const auto CodegenStart = std::chrono::steady_clock::now();
+    auto CompiledCode = Thread->CPUBackend->CompileCode(GuestRIP, IRList, DebugData, RAData.get(), GetGdbServerStatus());
+    const auto CodegenNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - CodegenStart).count();
+    FEXCore::Core::IncrementStat(Thread->Stats->CodegenNanoseconds, CodegenNanoseconds);
+
+    if (IREmitterView) {
+      // Nothing retains borrowed IR, hand the emitter's buffer back
+      delete IRList;
+      IRList = nullptr;
+      Thread->OpDispatcher->DelayedDisownBuffer();
+    }
+
     return {
-      .CompiledCode = Thread->CPUBackend->CompileCode(GuestRIP, IRList, DebugData, RAData.get(), GetGdbServerStatus()),
+      .CompiledCode = CompiledCode,
       .IRData = IRList,
       .DebugData = DebugData,
       .RAData = std::move(RAData),
@@ -969,6 +1179,70 @@ namespace FEXCore::Context {
     };
   }
 
+  bool Context::BenchmarkCompileRIP(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, FEXCore::Context::CompileBenchmarkResult *Result) {
+    using namespace std::chrono;
+    *Result = {};
+
+    std::shared_lock lk(CustomIRMutex);
+    const bool IsCustomIR = CustomIRHandlers.contains(GuestRIP);
+    lk.unlock();
+
+    // Both decodes below need to do the full work for the decode and opcode dispatcher timings to be meaningful
+    Thread->FrontendDecoder->SetDecodeCacheEnabled(false);
+
+    if (!IsCustomIR) {
+      const auto Start = steady_clock::now();
+      Thread->FrontendDecoder->DecodeInstructionsAtEntry(reinterpret_cast<uint8_t const*>(GuestRIP), GuestRIP, [](uint64_t, uint64_t, uint64_t) {});
+      Result->DecodeNanoseconds = duration_cast<nanoseconds>(steady_clock::now() - Start).count();
+      Thread->FrontendDecoder->DelayedDisownBuffer();
+    }
+
+    uint64_t PassNanoseconds{};
+    Thread->PassManager->RegisterPassTimingHandler([Result, &PassNanoseconds](std::string_view Name, uint64_t Nanoseconds) {
+      Result->PassNanoseconds.emplace_back(Name, Nanoseconds);
+      PassNanoseconds += Nanoseconds;
+    });
+
+    const auto IRStart = steady_clock::now();
+    auto [IRList, RAData, TotalInstructions, TotalInstructionsLength, StartAddr, Length] = GenerateIR(Thread, GuestRIP, false);
+    const uint64_t IRNanoseconds = duration_cast<nanoseconds>(steady_clock::now() - IRStart).count();
+
+    Thread->PassManager->RegisterPassTimingHandler({});
+    Thread->FrontendDecoder->SetDecodeCacheEnabled(true);
+
+    if (IRList == nullptr) {
+      return false;
+    }
+
+    Result->GuestInstructions = TotalInstructions;
+    Result->GuestInstructionBytes = TotalInstructionsLength;
+    // GenerateIR decodes again and runs the passes, what remains is the opcode dispatcher
+    Result->IRGenNanoseconds = IRNanoseconds - std::min(IRNanoseconds, Result->DecodeNanoseconds + PassNanoseconds);
+
+    FEXCore::Core::DebugData DebugData{};
+    const auto CodegenStart = steady_clock::now();
+    void *CodePtr = Thread->CPUBackend->CompileCode(GuestRIP, IRList, &DebugData, RAData.get(), false);
+    Result->CodegenNanoseconds = duration_cast<nanoseconds>(steady_clock::now() - CodegenStart).count();
+    Result->HostCodeBytes = DebugData.HostCodeSize + DebugData.HostColdCodeSize;
+
+    Thread->CPUBackend->ClearRelocations();
+
+    // The copy that lending the emitter's IR to the backend avoids
+    Result->IRBytes = IRList->GetDataSize() + IRList->GetListSize();
+    const auto CopyStart = steady_clock::now();
+    delete IRList->CreateCopy();
+    Result->IRCopyNanoseconds = duration_cast<nanoseconds>(steady_clock::now() - CopyStart).count();
+
+    const bool IREmitterView = !IRList->IsCopy();
+    Result->IRLent = IREmitterView;
+    delete IRList;
+    if (IREmitterView) {
+      Thread->OpDispatcher->DelayedDisownBuffer();
+    }
+
+    return CodePtr != nullptr;
+  }
+
   void Context::CompileBlockJit(FEXCore::Core::CpuStateFrame *Frame, uint64_t GuestRIP) {
     auto NewBlock = CompileBlock(Frame, GuestRIP);
 
@@ -1011,6 +1285,18 @@ namespace FEXCore::Context {
       return 0;
     }
 
+    const uint64_t HostCodeBytes = DebugData ? DebugData->HostCodeSize + DebugData->HostColdCodeSize : 0;
+    FEXCore::Core::IncrementStat(Thread->Stats->CodeBufferBytes, HostCodeBytes);
+
+    if (Thread->CPUBackend->AddBlockToSegment(GuestRIP, reinterpret_cast<uintptr_t>(CodePtr), HostCodeBytes)) {
+      FEXCore::Core::IncrementStat(Thread->Stats->CapacityRecompiles);
+    }
+
+    // Copy out what the profiler needs before DebugData gets moved in to the cache
+    if (Thread->Sampler && DebugData) {
+      Thread->Sampler->AddBlock(GuestRIP, reinterpret_cast<uintptr_t>(CodePtr), DebugData);
+    }
+
     // The core managed to compile the code.
     if (Config.BlockJITNaming()) {
       auto FragmentBasePtr = reinterpret_cast<uint8_t *>(CodePtr);
@@ -1034,6 +1320,16 @@ namespace FEXCore::Context {
           Symbols.Register(FragmentBasePtr, GuestRIP, DebugData->HostCodeSize);
           }
         }
+
+        // Cold code lives elsewhere in the segment and needs its own symbol
+        if (DebugData->HostColdCodeSize) {
+          auto ColdBasePtr = FragmentBasePtr + DebugData->HostColdCodeOffset;
+          if (GuestRIPLookup.Entry) {
+            Symbols.Register(ColdBasePtr, DebugData->HostColdCodeSize, GuestRIPLookup.Entry->Filename, GuestRIP - GuestRIPLookup.VAFileStart);
+          } else {
+            Symbols.Register(ColdBasePtr, GuestRIP, DebugData->HostColdCodeSize);
+          }
+        }
       }
     }
 
@@ -1085,6 +1381,10 @@ namespace FEXCore::Context {
 
     InitializeThreadTLSData(Thread);
 
+    if (Profiler) {
+      Profiler->StartThread(Thread);
+    }
+
     ++IdleWaitRefCount;
 
     // Now notify the thread that we are initialized
@@ -1113,11 +1413,20 @@ namespace FEXCore::Context {
       CodeSerialize::CodeObjectSerializeService::WaitForEmptyJobQueue(&Thread->ObjectCacheRefCounter);
     }
 
+    if (Profiler) {
+      Profiler->StopThread(Thread);
+    }
+
     // If it is the parent thread that died then just leave
     FEX_TODO("This doesn't make sense when the parent thread doesn't outlive its children");
 
     if (Thread->ThreadManager.parent_tid == 0) {
       CoreShuttingDown.store(true);
+
+      if (Profiler) {
+        // Children may still be running, they get merged as-is
+        Profiler->WriteProfile();
+      }
       Thread->ExitReason = FEXCore::Context::ExitReason::EXIT_SHUTDOWN;
 
       if (CustomExitHandler) {
@@ -1128,6 +1437,10 @@ namespace FEXCore::Context {
     --IdleWaitRefCount;
     IdleWaitCV.notify_all();
 
+    if (StatsRegion) {
+      StatsRegion->FreeSlot(Thread);
+    }
+
     SignalDelegation->UninstallTLSState(Thread);
 
     // If the parent thread is waiting to join, then we can't destroy our thread object
@@ -1139,6 +1452,9 @@ namespace FEXCore::Context {
   static void InvalidateGuestThreadCodeRange(FEXCore::Core::InternalThreadState *Thread, uint64_t Start, uint64_t Length) {
     std::lock_guard<std::recursive_mutex> lk(Thread->LookupCache->WriteLock);
 
+    // Called for every thread, not only the current one
+    Thread->Stats->CodeInvalidations.fetch_add(1, std::memory_order_relaxed);
+
     auto lower = Thread->LookupCache->CodePages.lower_bound(Start >> 12);
     auto upper = Thread->LookupCache->CodePages.upper_bound((Start + Length - 1) >> 12);
 
@@ -1148,6 +1464,8 @@ namespace FEXCore::Context {
       }
       it->second.clear();
     }
+
+    Thread->FrontendDecoder->InvalidateDecodeCache(Start, Length);
   }
 
   void InvalidateGuestCodeRange(FEXCore::Context::Context *CTX, uint64_t Start, uint64_t Length) {
@@ -1195,7 +1513,9 @@ namespace FEXCore::Context {
     std::lock_guard<std::recursive_mutex> lk(Thread->LookupCache->WriteLock);
 
     Thread->DebugStore.erase(GuestRIP);
-    Thread->LookupCache->Erase(GuestRIP);
+    if (auto HostCode = Thread->LookupCache->Erase(GuestRIP)) {
+      Thread->CPUBackend->RemoveBlockFromSegment(HostCode);
+    }
   }
 
   CustomIRResult Context::AddCustomIREntrypoint(uintptr_t Entrypoint, std::function<void(uintptr_t Entrypoint, FEXCore::IR::IREmitter *)> Handler, void *Creator, void *Data) {
@@ -1243,7 +1563,7 @@ namespace FEXCore::Context {
   }
 
   FEXCore::Core::RuntimeStats *Context::GetRuntimeStatsForThread(uint64_t Thread) {
-    return &Threads[Thread]->Stats;
+    return Threads[Thread]->Stats;
   }
 
   bool Context::GetDebugDataForRIP(uint64_t RIP, FEXCore::Core::DebugData *Data) {
@@ -384,7 +384,7 @@ uint64_t Arm64CoreDispatchCode( FEXCore::Core::CpuStateFrame *Frame )
   auto &L1Entry = reinterpret_cast<LookupCache::LookupCacheEntry*>(Frame->Pointers.Common.L1Pointer)[Address & LookupCache::L1_ENTRIES_MASK];
 
   if (L1Entry.GuestCode != Address) {
-    uintptr_t  HostCode= Thread->LookupCache->FindBlock(Address);
+    uintptr_t  HostCode= Thread->LookupCache->FindBlock(Address, CTX->StatsRegion ? Thread->Stats : nullptr);
   
     if ( !HostCode ) {
       // When compiling code, mask all signals to reduce the chance of reentrant allocations
@@ -395,10 +395,16 @@ uint64_t Arm64CoreDispatchCode( FEXCore::Core::CpuStateFrame *Frame )
 
       HostCode= Thread->LookupCache->FindBlock(Address);
     }
+    else {
+      Thread->CPUBackend->MarkCodeReferenced(HostCode);
+    }
 
     L1Entry.HostCode  = HostCode;
     L1Entry.GuestCode = Address;
   }
+  else if (CTX->StatsRegion) {
+    FEXCore::Core::IncrementStat(Frame->Stats->LookupL1Hits);
+  }
 
   return L1Entry.HostCode;
 }
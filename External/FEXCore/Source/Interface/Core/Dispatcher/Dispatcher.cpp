@@ -64,8 +64,8 @@ ArchHelpers::Context::ContextBackup* Dispatcher::StoreThreadState(FEXCore::Core:
 
   // Save guest state
   // We can't guarantee if registers are in context or host GPRs
-  // So we need to save everything
-  memcpy(&Context->GuestState, Thread->CurrentFrame, sizeof(FEXCore::Core::CPUState));
+  // So we need to save everything the guest can reach
+  CopySignalGuestState(&Context->GuestState, &Thread->CurrentFrame->State);
 
   // Set the new SP
   ArchHelpers::Context::SetSp(ucontext, NewSP);
@@ -88,6 +88,54 @@ ArchHelpers::Context::ContextBackup* Dispatcher::StoreThreadState(FEXCore::Core:
   return Context;
 }
 
+// Fills in the XSAVE area after a frame's FXSAVE data like the kernel does with AVX enabled
+// LegacySize is the size of the fsave state in front of the FXSAVE data, only 32-bit frames have one
+static void StoreGuestXState(uint64_t FXSaveLocation, uint32_t LegacySize, FEXCore::Core::CPUState const &State) {
+  using namespace FEXCore::x86_64;
+
+  _fpx_sw_bytes SWBytes{};
+  SWBytes.magic1 = FEX_FP_XSTATE_MAGIC1;
+  SWBytes.extended_size = LegacySize + sizeof(xstate) + sizeof(FEX_FP_XSTATE_MAGIC2);
+  SWBytes.xfeatures = FEX_XSTATE_FEATURES;
+  SWBytes.xstate_size = sizeof(xstate);
+  memcpy(reinterpret_cast<void*>(FXSaveLocation + offsetof(_libc_fpstate, _res[12])), &SWBytes, sizeof(SWBytes));
+
+  xstate_header Header{};
+  Header.xfeatures = FEX_XSTATE_FEATURES;
+  memcpy(reinterpret_cast<void*>(FXSaveLocation + offsetof(xstate, xstate_hdr)), &Header, sizeof(Header));
+
+  memcpy(reinterpret_cast<void*>(FXSaveLocation + offsetof(xstate, ymmh)), State.ymm_upper, sizeof(State.ymm_upper));
+  memcpy(reinterpret_cast<void*>(FXSaveLocation + sizeof(xstate)), &FEX_FP_XSTATE_MAGIC2, sizeof(FEX_FP_XSTATE_MAGIC2));
+}
+
+// Picks up upper YMM halves the guest handler may have changed, frames without a valid XSAVE area are left alone
+static void LoadGuestXState(uint64_t FXSaveLocation, FEXCore::Core::CPUState &State) {
+  using namespace FEXCore::x86_64;
+
+  _fpx_sw_bytes SWBytes;
+  memcpy(&SWBytes, reinterpret_cast<void const*>(FXSaveLocation + offsetof(_libc_fpstate, _res[12])), sizeof(SWBytes));
+  if (SWBytes.magic1 != FEX_FP_XSTATE_MAGIC1 || SWBytes.xstate_size != sizeof(xstate)) {
+    return;
+  }
+
+  uint32_t Magic2;
+  memcpy(&Magic2, reinterpret_cast<void const*>(FXSaveLocation + sizeof(xstate)), sizeof(Magic2));
+  if (Magic2 != FEX_FP_XSTATE_MAGIC2) {
+    return;
+  }
+
+  xstate_header Header;
+  memcpy(&Header, reinterpret_cast<void const*>(FXSaveLocation + offsetof(xstate, xstate_hdr)), sizeof(Header));
+
+  // A cleared AVX bit means the upper halves are in their init state
+  if (Header.xfeatures & SWBytes.xfeatures & (1U << 2)) {
+    memcpy(State.ymm_upper, reinterpret_cast<void const*>(FXSaveLocation + offsetof(xstate, ymmh)), sizeof(State.ymm_upper));
+  }
+  else {
+    memset(State.ymm_upper, 0, sizeof(State.ymm_upper));
+  }
+}
+
 void Dispatcher::RestoreThreadState(FEXCore::Core::InternalThreadState *Thread, void *ucontext) {
   uint64_t OldSP{};
   if (CTX->Config.Core() == FEXCore::Config::CONFIG_IRJIT) {
@@ -103,7 +151,7 @@ void Dispatcher::RestoreThreadState(FEXCore::Core::InternalThreadState *Thread,
   auto Context = reinterpret_cast<ArchHelpers::Context::ContextBackup*>(NewSP);
 
   // First thing, reset the guest state
-  memcpy(Thread->CurrentFrame, &Context->GuestState, sizeof(FEXCore::Core::CPUState));
+  CopySignalGuestState(&Thread->CurrentFrame->State, &Context->GuestState);
 
   // Now restore host state
   ArchHelpers::Context::RestoreContext(ucontext, Context);
@@ -163,6 +211,7 @@ void Dispatcher::RestoreThreadState(FEXCore::Core::InternalThreadState *Thread,
         // Copy float registers
         memcpy(Frame->State.mm, fpstate->_st, sizeof(Frame->State.mm));
         memcpy(Frame->State.xmm, fpstate->_xmm, sizeof(Frame->State.xmm));
+        LoadGuestXState(reinterpret_cast<uint64_t>(fpstate), Frame->State);
 
         // FCW store default
         Frame->State.FCW = fpstate->fcw;
@@ -225,7 +274,10 @@ void Dispatcher::RestoreThreadState(FEXCore::Core::InternalThreadState *Thread,
         }
 
         // Extended XMM state
-        memcpy(fpstate->_xmm, Frame->State.xmm, sizeof(Frame->State.xmm));
+        memcpy(Frame->State.xmm, fpstate->_xmm, sizeof(Frame->State.xmm));
+        if (fpstate->status == FEXCore::x86::fpstate_magic::MAGIC_XFPSTATE) {
+          LoadGuestXState(reinterpret_cast<uint64_t>(fpstate) + FEXCore::x86::FXSAVE_OFFSET, Frame->State);
+        }
 
         // FCW store default
         Frame->State.FCW = fpstate->fcw;
@@ -242,6 +294,30 @@ void Dispatcher::RestoreThreadState(FEXCore::Core::InternalThreadState *Thread,
   }
 }
 
+void Dispatcher::CopySignalGuestState(FEXCore::Core::CPUState *Dst, FEXCore::Core::CPUState const *Src) const {
+  using FEXCore::Core::CPUState;
+  static_assert(offsetof(CPUState, gdt) == offsetof(CPUState, ymm_upper) + sizeof(CPUState::ymm_upper), "Unexpected CPUState layout");
+  static_assert(offsetof(CPUState, FCW) == offsetof(CPUState, gdt) + sizeof(CPUState::gdt), "Unexpected CPUState layout");
+
+  auto DstBytes = reinterpret_cast<uint8_t*>(Dst);
+  auto SrcBytes = reinterpret_cast<uint8_t const*>(Src);
+
+  // Everything up to the upper YMM halves is always live
+  memcpy(DstBytes, SrcBytes, offsetof(CPUState, ymm_upper));
+
+  // Upper YMM halves can only be touched with AVX exposed to the guest
+  if (CTX->Config.EnableAVX) {
+    memcpy(DstBytes + offsetof(CPUState, ymm_upper), SrcBytes + offsetof(CPUState, ymm_upper), sizeof(CPUState::ymm_upper));
+  }
+
+  // Segment descriptors are only consulted by 32-bit guests
+  if (!CTX->Config.Is64BitMode) {
+    memcpy(DstBytes + offsetof(CPUState, gdt), SrcBytes + offsetof(CPUState, gdt), sizeof(CPUState::gdt));
+  }
+
+  memcpy(DstBytes + offsetof(CPUState, FCW), SrcBytes + offsetof(CPUState, FCW), sizeof(CPUState) - offsetof(CPUState, FCW));
+}
+
 static uint32_t ConvertSignalToTrapNo(int Signal, siginfo_t *HostSigInfo) {
   switch (Signal) {
     case SIGSEGV:
@@ -283,6 +359,8 @@ bool Dispatcher::HandleGuestSignal(FEXCore::Core::InternalThreadState *Thread, i
   // We use this to track if it is safe to clear cache
   ++Thread->CurrentFrame->SignalHandlerRefCounter;
 
+  FEXCore::Core::IncrementStat(Thread->Stats->SignalsDelivered);
+
   uint64_t OldPC = ArchHelpers::Context::GetPc(ucontext);
   // Set the new PC
   ArchHelpers::Context::SetPc(ucontext, AbsoluteLoopTopAddressFillSRA);
@@ -294,6 +372,8 @@ bool Dispatcher::HandleGuestSignal(FEXCore::Core::InternalThreadState *Thread, i
 
   // Pulling from context here
   bool Is64BitMode = CTX->Config.Is64BitMode;
+  // With AVX exposed the frame carries the upper YMM halves in an XSAVE area like the kernel's
+  const bool HasXState = CTX->Config.EnableAVX;
   uint64_t SignalReturn = CTX->X86CodeGen.SignalReturn;
 
   // Spill the SRA regardless of signal handler type
@@ -374,8 +454,15 @@ bool Dispatcher::HandleGuestSignal(FEXCore::Core::InternalThreadState *Thread, i
   if (GuestAction->sa_flags & SA_SIGINFO) {
     // Setup ucontext a bit
     if (Is64BitMode) {
-      NewGuestSP -= sizeof(FEXCore::x86_64::_libc_fpstate);
-      NewGuestSP = AlignDown(NewGuestSP, alignof(FEXCore::x86_64::_libc_fpstate));
+      if (HasXState) {
+        // The XSAVE area needs 64 byte alignment
+        NewGuestSP -= sizeof(FEXCore::x86_64::xstate) + sizeof(FEXCore::x86_64::FEX_FP_XSTATE_MAGIC2);
+        NewGuestSP = AlignDown(NewGuestSP, 64);
+      }
+      else {
+        NewGuestSP -= sizeof(FEXCore::x86_64::_libc_fpstate);
+        NewGuestSP = AlignDown(NewGuestSP, alignof(FEXCore::x86_64::_libc_fpstate));
+      }
       uint64_t FPStateLocation = NewGuestSP;
 
       NewGuestSP -= sizeof(FEXCore::x86_64::ucontext_t);
@@ -446,6 +533,9 @@ bool Dispatcher::HandleGuestSignal(FEXCore::Core::InternalThreadState *Thread, i
       // Copy float registers
       memcpy(fpstate->_st, Frame->State.mm, sizeof(Frame->State.mm));
       memcpy(fpstate->_xmm, Frame->State.xmm, sizeof(Frame->State.xmm));
+      if (HasXState) {
+        StoreGuestXState(FPStateLocation, 0, Frame->State);
+      }
 
       // FCW store default
       fpstate->fcw = Frame->State.FCW;
@@ -470,8 +560,16 @@ bool Dispatcher::HandleGuestSignal(FEXCore::Core::InternalThreadState *Thread, i
     else {
       ContextBackup->Flags |= ArchHelpers::Context::ContextFlags::CONTEXT_FLAG_32BIT;
 
-      NewGuestSP -= sizeof(FEXCore::x86::_libc_fpstate);
-      NewGuestSP = AlignDown(NewGuestSP, alignof(FEXCore::x86::_libc_fpstate));
+      if (HasXState) {
+        // The XSAVE area starts at the FXSAVE data and needs 64 byte alignment, the fsave state sits in front of it
+        NewGuestSP -= sizeof(FEXCore::x86::xstate) - FEXCore::x86::FXSAVE_OFFSET + sizeof(FEXCore::x86_64::FEX_FP_XSTATE_MAGIC2);
+        NewGuestSP = AlignDown(NewGuestSP, 64);
+        NewGuestSP -= FEXCore::x86::FXSAVE_OFFSET;
+      }
+      else {
+        NewGuestSP -= sizeof(FEXCore::x86::_libc_fpstate);
+        NewGuestSP = AlignDown(NewGuestSP, alignof(FEXCore::x86::_libc_fpstate));
+      }
       uint64_t FPStateLocation = NewGuestSP;
 
       NewGuestSP -= sizeof(FEXCore::x86::ucontext_t);
@@ -537,6 +635,9 @@ bool Dispatcher::HandleGuestSignal(FEXCore::Core::InternalThreadState *Thread, i
       // Extended XMM state
       fpstate->status = FEXCore::x86::fpstate_magic::MAGIC_XFPSTATE;
       memcpy(fpstate->_xmm, Frame->State.xmm, sizeof(Frame->State.xmm));
+      if (HasXState) {
+        StoreGuestXState(FPStateLocation + FEXCore::x86::FXSAVE_OFFSET, FEXCore::x86::FXSAVE_OFFSET, Frame->State);
+      }
 
       // FCW store default
       fpstate->fcw = Frame->State.FCW;
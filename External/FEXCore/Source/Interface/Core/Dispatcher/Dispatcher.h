@@ -92,6 +92,7 @@ protected:
 
   ArchHelpers::Context::ContextBackup* StoreThreadState(FEXCore::Core::InternalThreadState *Thread, int Signal, void *ucontext);
   void RestoreThreadState(FEXCore::Core::InternalThreadState *Thread, void *ucontext);
+  void CopySignalGuestState(FEXCore::Core::CPUState *Dst, FEXCore::Core::CPUState const *Src) const;
   std::stack<uint64_t, std::vector<uint64_t>> SignalFrames;
 
   bool SRAEnabled = false;
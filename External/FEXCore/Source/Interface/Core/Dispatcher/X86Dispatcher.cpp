@@ -1,3 +1,4 @@
+#include "Interface/Core/ArchHelpers/MContext.h"
 #include "Interface/Core/LookupCache.h"
 #include "Interface/Core/JIT/x86_64/JITClass.h"
 
@@ -49,13 +50,72 @@ static constexpr bool SignalSafeCompile = true;
  * names.
  */
 extern "C" {
+    __attribute__((used)) void X86SpillAllStaticRegs( FEXCore::Core::CpuStateFrame *Frame );
+    __attribute__((used)) void X86FillAllStaticRegs( FEXCore::Core::CpuStateFrame *Frame );
+
     __attribute__((used)) uint64_t X86CoreDispatchCode( FEXCore::Core::CpuStateFrame *Frame );
     __attribute__((used)) uint64_t X86ExitFunctionLinkerCode( FEXCore::Core::CpuStateFrame *Frame, uint64_t *record );
     __attribute__((used)) void X86ThreadStopHandlerCode( FEXCore::Core::CpuStateFrame *Frame );
+    __attribute__((used)) void X86ThreadPauseHandlerAddressCode( FEXCore::Core::CpuStateFrame *Frame );
     __attribute__((used)) void X86IntCallbackReturnCode( FEXCore::Core::CpuStateFrame *Frame );
 }
 
 
+/* ---------------------------------------------------------------------------------- */
+
+/*
+ * Static register allocation spill and fill. Only touches
+ * STATE relative memory and the static registers themselves,
+ * so these can be called from any of the sequences below
+ * without disturbing rax or the stack alignment.
+ * The register order needs to match SRA64 and SRAXMM_x in JITClass.h.
+ */
+#define STATIC_GPR(Reg, Index) \
+    __asm__ __volatile__( "mov %%" Reg ", %c[a](%%" STATE_STR ")" : : [a]"i"(offsetof(FEXCore::Core::CpuStateFrame, State.gregs[Index])))
+#define STATIC_XMM(Reg, Index) \
+    __asm__ __volatile__( "movaps %%" Reg ", %c[a](%%" STATE_STR ")" : : [a]"i"(offsetof(FEXCore::Core::CpuStateFrame, State.xmm[Index][0])))
+#define FILL_STATIC_GPR(Reg, Index) \
+    __asm__ __volatile__( "mov %c[a](%%" STATE_STR "), %%" Reg : : [a]"i"(offsetof(FEXCore::Core::CpuStateFrame, State.gregs[Index])))
+#define FILL_STATIC_XMM(Reg, Index) \
+    __asm__ __volatile__( "movaps %c[a](%%" STATE_STR "), %%" Reg : : [a]"i"(offsetof(FEXCore::Core::CpuStateFrame, State.xmm[Index][0])))
+
+__attribute__((naked))
+//static
+void X86SpillAllStaticRegs( FEXCore::Core::CpuStateFrame *Frame )
+{
+    STATIC_GPR("rbp", 0);
+    STATIC_GPR("r12", 1);
+    STATIC_GPR("r13", 2);
+    STATIC_GPR("r15", 3);
+
+    STATIC_XMM("xmm8",  0);
+    STATIC_XMM("xmm9",  1);
+    STATIC_XMM("xmm10", 2);
+    STATIC_XMM("xmm11", 3);
+    asm("ret");
+}
+
+__attribute__((naked))
+//static
+void X86FillAllStaticRegs( FEXCore::Core::CpuStateFrame *Frame )
+{
+    FILL_STATIC_GPR("rbp", 0);
+    FILL_STATIC_GPR("r12", 1);
+    FILL_STATIC_GPR("r13", 2);
+    FILL_STATIC_GPR("r15", 3);
+
+    FILL_STATIC_XMM("xmm8",  0);
+    FILL_STATIC_XMM("xmm9",  1);
+    FILL_STATIC_XMM("xmm10", 2);
+    FILL_STATIC_XMM("xmm11", 3);
+    asm("ret");
+}
+
+#undef STATIC_GPR
+#undef STATIC_XMM
+#undef FILL_STATIC_GPR
+#undef FILL_STATIC_XMM
+
 /* ---------------------------------------------------------------------------------- */
 
 __attribute__((naked))
@@ -78,6 +138,16 @@ void X86UnimplementedInstructionAddressCodeAsm( FEXCore::Core::CpuStateFrame *Fi
     asm("ud2");
 }
 
+__attribute__((naked))
+__attribute__((noreturn))
+static
+void X86UnimplementedInstructionAddressCodeAsmSpillSRA( FEXCore::Core::CpuStateFrame *FillMe )
+{
+    // The fault happens outside of the code buffer, so the signal handler won't spill for us
+    asm("callq X86SpillAllStaticRegs");
+    asm("ud2");
+}
+
 // ---
 
 __attribute__((naked))
@@ -110,6 +180,28 @@ void X86ThreadStopHandlerCodeAsm( FEXCore::Core::CpuStateFrame *FillMe )
     asm("jmp X86ThreadStopHandlerCode");
 }
 
+__attribute__((naked))
+__attribute__((noreturn))
+static
+void X86ThreadStopHandlerCodeAsmSpillSRA( FEXCore::Core::CpuStateFrame *FillMe )
+{
+    asm("callq X86SpillAllStaticRegs");
+    asm("sub $8,%rsp");  // Misalign SP
+    asm("mov %" STATE_STR ",%rdi");
+    asm("jmp X86ThreadStopHandlerCode");
+}
+
+__attribute__((naked))
+__attribute__((noreturn))
+static
+void X86ThreadPauseHandlerAddressCodeAsmSpillSRA( FEXCore::Core::CpuStateFrame *FillMe )
+{
+    asm("callq X86SpillAllStaticRegs");
+    asm("sub $8,%rsp");  // Misalign SP
+    asm("mov %" STATE_STR ",%rdi");
+    asm("jmp X86ThreadPauseHandlerAddressCode");
+}
+
 
 /*
  * Jump back to start of X86CoreDispatchCode from within JIT code.
@@ -129,6 +221,35 @@ void X86CoreDispatchCodeAsm( FEXCore::Core::CpuStateFrame *FillMe )
     asm("jmpq *%rax");
 }
 
+/*
+ * SRA variants of the above. Entering from JIT code
+ * the static registers hold the guest state, so they
+ * get spilled first. The FillSRA entry is used when
+ * the context is already up to date, like after a signal.
+ */
+__attribute__((naked))
+__attribute__((noreturn))
+static inline
+void X86CoreDispatchCodeAsmSpillSRA( FEXCore::Core::CpuStateFrame *FillMe )
+{
+    asm("callq X86SpillAllStaticRegs");
+    asm("mov %" STATE_STR ",%rdi");
+    asm("callq X86CoreDispatchCode");
+    asm("callq X86FillAllStaticRegs");
+    asm("jmpq *%rax");
+}
+
+__attribute__((naked))
+__attribute__((noreturn))
+static inline
+void X86CoreDispatchCodeAsmFillSRA( FEXCore::Core::CpuStateFrame *FillMe )
+{
+    asm("mov %" STATE_STR ",%rdi");
+    asm("callq X86CoreDispatchCode");
+    asm("callq X86FillAllStaticRegs");
+    asm("jmpq *%rax");
+}
+
 __attribute__((naked))
 __attribute__((noreturn))
 static inline
@@ -140,6 +261,18 @@ void X86CallCoreDispatchCodeAsm( FEXCore::Core::CpuStateFrame *Frame )
     asm("jmpq *%rax");
 }
 
+__attribute__((naked))
+__attribute__((noreturn))
+static inline
+void X86CallCoreDispatchCodeAsmFillSRA( FEXCore::Core::CpuStateFrame *Frame )
+{
+    asm("push %rdi;");                 // Align SP
+    asm("callq X86CoreDispatchCode");
+    asm("movq (%rsp), %" STATE_STR);   // Keep SP aligned
+    asm("callq X86FillAllStaticRegs");
+    asm("jmpq *%rax");
+}
+
 
 /*
  * JIT to C++ calling interface. Copy STATE register
@@ -164,6 +297,19 @@ void X86ExitFunctionLinkerCodeAsm( FEXCore::Core::CpuStateFrame *FillMe, uint64_
     asm("jmpq *%rax");
 }
 
+__attribute__((naked))
+__attribute__((noreturn))
+static
+void X86ExitFunctionLinkerCodeAsmSpillSRA( FEXCore::Core::CpuStateFrame *FillMe, uint64_t *record )
+{
+    // Static XMMs are caller saved, and a signal in the linker needs to see the guest state
+    asm("callq X86SpillAllStaticRegs");
+    asm("mov %" STATE_STR ",%rdi");
+    asm("callq X86ExitFunctionLinkerCode");
+    asm("callq X86FillAllStaticRegs");
+    asm("jmpq *%rax");
+}
+
 /* ---------------------------------------------------------------------------------- */
 
 /*
@@ -180,7 +326,7 @@ uint64_t X86CoreDispatchCode( FEXCore::Core::CpuStateFrame *Frame )
   auto &L1Entry = reinterpret_cast<LookupCache::LookupCacheEntry*>(Frame->Pointers.Common.L1Pointer)[Address & LookupCache::L1_ENTRIES_MASK];
 
   if (L1Entry.GuestCode != Address) {
-    uintptr_t  HostCode= Thread->LookupCache->FindBlock(Address);
+    uintptr_t  HostCode= Thread->LookupCache->FindBlock(Address, CTX->StatsRegion ? Thread->Stats : nullptr);
   
     if ( !HostCode ) {
       // When compiling code, mask all signals to reduce the chance of reentrant allocations
@@ -191,10 +337,16 @@ uint64_t X86CoreDispatchCode( FEXCore::Core::CpuStateFrame *Frame )
 
       HostCode= Thread->LookupCache->FindBlock(Address);
     }
+    else {
+      Thread->CPUBackend->MarkCodeReferenced(HostCode);
+    }
 
     L1Entry.HostCode  = HostCode;
     L1Entry.GuestCode = Address;
   }
+  else if (CTX->StatsRegion) {
+    FEXCore::Core::IncrementStat(Frame->Stats->LookupL1Hits);
+  }
 
   return L1Entry.HostCode;
 }
@@ -234,6 +386,7 @@ uint64_t X86ExitFunctionLinkerCode( FEXCore::Core::CpuStateFrame *Frame, uint64_
  * Call the dispatcher animation framework defined above, 
  * while providing a quick termination via a longjmp:
  */
+template<bool SRA>
 static 
 void X86DispatchCode( FEXCore::Core::CpuStateFrame *Frame )
 {
@@ -241,7 +394,12 @@ void X86DispatchCode( FEXCore::Core::CpuStateFrame *Frame )
       uint32_t aligner MIE_ALIGN(16);
       Frame->ReturningStackLocation = reinterpret_cast<uintptr_t>(&aligner);
 
-      X86CallCoreDispatchCodeAsm(Frame);
+      if constexpr (SRA) {
+        X86CallCoreDispatchCodeAsmFillSRA(Frame);
+      }
+      else {
+        X86CallCoreDispatchCodeAsm(Frame);
+      }
   }
 }
 
@@ -259,7 +417,7 @@ void X86ThreadStopHandlerCode( FEXCore::Core::CpuStateFrame *Frame )
 
 
 
-static 
+//static 
 void X86ThreadPauseHandlerAddressCode( FEXCore::Core::CpuStateFrame *Frame )
 #if 1
 {WaitUntilWeHitATestCase();}
@@ -343,18 +501,31 @@ X86Dispatcher::X86Dispatcher(FEXCore::Context::Context *ctx, const DispatcherCon
       FEXCore::Allocator::mmap(nullptr, MAX_DISPATCHER_CODE_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0),
       nullptr) {
 
-  LOGMAN_THROW_A_FMT(!config.StaticRegisterAllocation, "X86 dispatcher does not support SRA");
+  SRAEnabled = config.StaticRegisterAllocation;
 
-  DispatchPtr                         = reinterpret_cast<AsmDispatch>(X86DispatchCode);
-  AbsoluteLoopTopAddressFillSRA       = reinterpret_cast<uint64_t>(X86CoreDispatchCodeAsm);
-  AbsoluteLoopTopAddress              = reinterpret_cast<uint64_t>(X86CoreDispatchCodeAsm);
-  ExitFunctionLinkerAddress           = reinterpret_cast<uint64_t>(X86ExitFunctionLinkerCodeAsm);
   ThreadStopHandlerAddress            = reinterpret_cast<uint64_t>(X86ThreadStopHandlerCodeAsm);
   SignalHandlerReturnAddress          = reinterpret_cast<uint64_t>(X86SignalHandlerReturnAddressCodeAsm);
   PauseReturnInstruction              = reinterpret_cast<uint64_t>(X86PauseReturnInstructionCodeAsm);
-  UnimplementedInstructionAddress     = reinterpret_cast<uint64_t>(X86UnimplementedInstructionAddressCodeAsm);
-
   ThreadPauseHandlerAddress           = reinterpret_cast<uint64_t>(X86ThreadPauseHandlerAddressCode);
+
+  if (SRAEnabled) {
+    DispatchPtr                       = reinterpret_cast<AsmDispatch>(X86DispatchCode<true>);
+    AbsoluteLoopTopAddressFillSRA     = reinterpret_cast<uint64_t>(X86CoreDispatchCodeAsmFillSRA);
+    AbsoluteLoopTopAddress            = reinterpret_cast<uint64_t>(X86CoreDispatchCodeAsmSpillSRA);
+    ExitFunctionLinkerAddress         = reinterpret_cast<uint64_t>(X86ExitFunctionLinkerCodeAsmSpillSRA);
+    ThreadStopHandlerAddressSpillSRA  = reinterpret_cast<uint64_t>(X86ThreadStopHandlerCodeAsmSpillSRA);
+    ThreadPauseHandlerAddressSpillSRA = reinterpret_cast<uint64_t>(X86ThreadPauseHandlerAddressCodeAsmSpillSRA);
+    UnimplementedInstructionAddress   = reinterpret_cast<uint64_t>(X86UnimplementedInstructionAddressCodeAsmSpillSRA);
+  } else {
+    DispatchPtr                       = reinterpret_cast<AsmDispatch>(X86DispatchCode<false>);
+    AbsoluteLoopTopAddressFillSRA     = reinterpret_cast<uint64_t>(X86CoreDispatchCodeAsm);
+    AbsoluteLoopTopAddress            = reinterpret_cast<uint64_t>(X86CoreDispatchCodeAsm);
+    ExitFunctionLinkerAddress         = reinterpret_cast<uint64_t>(X86ExitFunctionLinkerCodeAsm);
+    ThreadStopHandlerAddressSpillSRA  = ThreadStopHandlerAddress;
+    ThreadPauseHandlerAddressSpillSRA = ThreadPauseHandlerAddress;
+    UnimplementedInstructionAddress   = reinterpret_cast<uint64_t>(X86UnimplementedInstructionAddressCodeAsm);
+  }
+
   OverflowExceptionInstructionAddress = reinterpret_cast<uint64_t>(X86OverflowExceptionInstructionAddressCode);
   CallbackPtr                         = reinterpret_cast<JITCallback>(X86CallbackPtrCode);
   IntCallbackReturnAddress            = reinterpret_cast<uint64_t>(X86IntCallbackReturnCodeAsm);
@@ -422,6 +593,18 @@ X86Dispatcher::~X86Dispatcher() {
   FEXCore::Allocator::munmap(top_, MAX_DISPATCHER_CODE_SIZE);
 }
 
+void X86Dispatcher::SpillSRA(FEXCore::Core::InternalThreadState *Thread, void *ucontext, uint32_t IgnoreMask) {
+  // Syscalls spill everything before leaving JIT code, so there is never a partial spill to skip here
+  for (size_t i = 0; i < SRA64.size(); ++i) {
+    Thread->CurrentFrame->State.gregs[i] = ArchHelpers::Context::GetX86Reg(ucontext, SRA64[i].getIdx());
+  }
+
+  for (size_t i = 0; i < SRAXMM_x.size(); ++i) {
+    auto FPR = ArchHelpers::Context::GetX86XMM(ucontext, SRAXMM_x[i].getIdx());
+    memcpy(&Thread->CurrentFrame->State.xmm[i][0], &FPR, sizeof(__uint128_t));
+  }
+}
+
 void X86Dispatcher::InitThreadPointers(FEXCore::Core::InternalThreadState *Thread) {
   // Setup dispatcher specific pointers that need to be accessed from JIT code
   {
@@ -430,8 +613,8 @@ void X86Dispatcher::InitThreadPointers(FEXCore::Core::InternalThreadState *Threa
     Common.DispatcherLoopTop = AbsoluteLoopTopAddress;
     Common.DispatcherLoopTopFillSRA = AbsoluteLoopTopAddressFillSRA;
     Common.ExitFunctionLinker = ExitFunctionLinkerAddress;
-    Common.ThreadStopHandlerSpillSRA = ThreadStopHandlerAddress;
-    Common.ThreadPauseHandlerSpillSRA = ThreadPauseHandlerAddress;
+    Common.ThreadStopHandlerSpillSRA = ThreadStopHandlerAddressSpillSRA;
+    Common.ThreadPauseHandlerSpillSRA = ThreadPauseHandlerAddressSpillSRA;
     Common.UnimplementedInstructionHandler = UnimplementedInstructionAddress;
     Common.OverflowExceptionHandler = OverflowExceptionInstructionAddress;
     Common.SignalReturnHandler = SignalHandlerReturnAddress;
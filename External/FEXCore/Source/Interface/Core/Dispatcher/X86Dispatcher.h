@@ -23,6 +23,9 @@ class X86Dispatcher final : public Dispatcher, public Xbyak::CodeGenerator {
     size_t GenerateInterpreterTrampoline(uint8_t *CodeBuffer) override;
 
     virtual ~X86Dispatcher() override;
+
+  protected:
+    void SpillSRA(FEXCore::Core::InternalThreadState *Thread, void *ucontext, uint32_t IgnoreMask) override;
 };
 
 }
@@ -20,6 +20,7 @@ $end_info$
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/Telemetry.h>
 #include <FEXHeaderUtils/TypeDefines.h>
+#include <mutex>
 #include <set>
 #include <sys/mman.h>
 
@@ -506,6 +507,19 @@ bool Decoder::NormalOp(FEXCore::X86Tables::X86InstInfo const *Info, uint16_t Op,
     else {
       DecodeInst->Flags |= DecodeFlags::GenSizeSrcSize(DecodeFlags::SIZE_32BIT);
     }
+
+    // VEX.L widens any 128-bit vector operand to 256-bit
+    if (Options.L) {
+      if (DstSizeFlag == FEXCore::X86Tables::InstFlags::SIZE_128BIT) {
+        DecodeInst->Flags &= ~DecodeFlags::GenSizeDstSize(DecodeFlags::SIZE_MASK);
+        DecodeInst->Flags |= DecodeFlags::GenSizeDstSize(DecodeFlags::SIZE_256BIT);
+        DestSize = 32;
+      }
+      if (SrcSizeFlag == FEXCore::X86Tables::InstFlags::SIZE_128BIT) {
+        DecodeInst->Flags &= ~DecodeFlags::GenSizeSrcSize(DecodeFlags::SIZE_MASK);
+        DecodeInst->Flags |= DecodeFlags::GenSizeSrcSize(DecodeFlags::SIZE_256BIT);
+      }
+    }
   }
 
   // This is used for ModRM register modification
@@ -781,6 +795,7 @@ bool Decoder::NormalOpHeader(FEXCore::X86Tables::X86InstInfo const *Info, uint16
     if (Op == 0xC5) { // Two byte VEX
       pp = Byte1 & 0b11;
       options.vvvv = 15 - ((Byte1 & 0b01111000) >> 3);
+      options.L = (Byte1 & 0b100) != 0;
     }
     else { // 0xC4 = Three byte VEX
       const uint8_t Byte2 = ReadByte();
@@ -788,6 +803,7 @@ bool Decoder::NormalOpHeader(FEXCore::X86Tables::X86InstInfo const *Info, uint16
       map_select = Byte1 & 0b11111;
       options.vvvv = 15 - ((Byte2 & 0b01111000) >> 3);
       options.w = (Byte2 & 0b10000000) != 0;
+      options.L = (Byte2 & 0b100) != 0;
       if ((Byte1 & 0b01000000) == 0) {
         LOGMAN_THROW_A_FMT(CTX->Config.Is64BitMode, "VEX.X shouldn't be 0 in 32-bit mode!");
         DecodeInst->Flags |= DecodeFlags::FLAG_REX_XGPR_X;
@@ -1117,6 +1133,136 @@ void Decoder::BranchTargetInMultiblockRange() {
   }
 }
 
+Decoder::CachedPage *Decoder::GetDecodeCachePage(uint64_t PC, bool Create) {
+  const uint64_t Page = PC >> FHU::FEX_PAGE_SHIFT;
+  if (Page == DecodeCacheLastPage) {
+    return DecodeCacheLast;
+  }
+
+  auto it = DecodeCache.find(Page);
+  if (it == DecodeCache.end()) {
+    if (!Create) {
+      return nullptr;
+    }
+
+    if (DecodeCache.size() >= MaxDecodeCachePages) {
+      DecodeCache.clear();
+    }
+    it = DecodeCache.emplace(Page, std::make_unique<CachedPage>()).first;
+  }
+
+  DecodeCacheLastPage = Page;
+  DecodeCacheLast = it->second.get();
+  return DecodeCacheLast;
+}
+
+bool Decoder::DecodeInstructionCached(uint64_t PC) {
+  if (!DecodeCacheEnabled) {
+    return DecodeInstruction(PC);
+  }
+
+  const size_t Offset = PC & (FHU::FEX_PAGE_SIZE - 1);
+  auto Page = GetDecodeCachePage(PC, false);
+  if (Page && Page->Offsets[Offset]) {
+    auto &Cached = Page->Entries[Page->Offsets[Offset] - 1];
+    if (memcmp(Cached.Bytes.data(), InstStream, Cached.Inst.InstSize) == 0) {
+      DecodeInst = &DecodedBuffer[DecodedSize];
+      *DecodeInst = Cached.Inst;
+      ++DecodeCacheHits;
+      return true;
+    }
+
+    // Guest code was rewritten without an invalidation reaching this thread, the slot is refilled below
+  }
+
+  ++DecodeCacheMisses;
+
+  if (!DecodeInstruction(PC)) {
+    return false;
+  }
+
+  if (DecodeInst->InstSize == 0) {
+    return true;
+  }
+
+  Page = GetDecodeCachePage(PC, true);
+  if (!Page->Offsets[Offset]) {
+    if (Page->Entries.size() >= MaxEntriesPerPage) {
+      Page->Clear();
+    }
+    Page->Entries.emplace_back();
+    Page->Offsets[Offset] = Page->Entries.size();
+  }
+
+  auto &Cached = Page->Entries[Page->Offsets[Offset] - 1];
+  Cached.Inst = *DecodeInst;
+  memcpy(Cached.Bytes.data(), InstStream, DecodeInst->InstSize);
+
+  return true;
+}
+
+void Decoder::InvalidateDecodeCache(uint64_t Start, uint64_t Length) {
+  std::lock_guard lk(PendingInvalidationsMutex);
+  if (PendingClear) {
+    return;
+  }
+
+  if (PendingInvalidations.size() >= MaxPendingInvalidations) {
+    PendingInvalidations.clear();
+    PendingClear = true;
+    return;
+  }
+
+  PendingInvalidations.emplace_back(Start, Length);
+}
+
+void Decoder::ClearDecodeCache() {
+  std::lock_guard lk(PendingInvalidationsMutex);
+  PendingInvalidations.clear();
+  PendingClear = true;
+}
+
+void Decoder::ApplyPendingDecodeCacheInvalidations() {
+  std::lock_guard lk(PendingInvalidationsMutex);
+  DecodeCacheLastPage = ~0ULL;
+  DecodeCacheLast = nullptr;
+
+  if (PendingClear) {
+    DecodeCache.clear();
+    PendingClear = false;
+    return;
+  }
+
+  for (auto [Start, Length] : PendingInvalidations) {
+    if (Length == 0) {
+      continue;
+    }
+
+    // Instructions starting just before the range can still extend in to it
+    uint64_t First = Start - std::min<uint64_t>(Start, MAX_INST_SIZE - 1);
+    uint64_t Last = Start + Length - 1;
+    if (Last < Start) {
+      Last = ~0ULL;
+    }
+
+    // Whole pages are dropped, SMC tends to rewrite a page at a time anyway
+    const uint64_t FirstPage = First >> FHU::FEX_PAGE_SHIFT;
+    const uint64_t LastPage = Last >> FHU::FEX_PAGE_SHIFT;
+    if (LastPage - FirstPage < DecodeCache.size()) {
+      for (uint64_t Page = FirstPage; Page <= LastPage; ++Page) {
+        DecodeCache.erase(Page);
+      }
+    }
+    else {
+      // Large unmaps cover far more pages than are cached
+      std::erase_if(DecodeCache, [FirstPage, LastPage](auto const &Entry) {
+        return Entry.first >= FirstPage && Entry.first <= LastPage;
+      });
+    }
+  }
+  PendingInvalidations.clear();
+}
+
 const uint8_t *Decoder::AdjustAddrForSpecialRegion(uint8_t const* _InstStream, uint64_t EntryPoint, uint64_t RIP) {
   constexpr uint64_t VSyscall_Base = 0xFFFF'FFFF'FF60'0000ULL;
   constexpr uint64_t VSyscall_End = VSyscall_Base + 0x1000;
@@ -1145,6 +1291,9 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
   MaxCondBranchForward = 0;
   MaxCondBranchBackwards = ~0ULL;
   DecodedBuffer = PoolObject.ReownOrClaimBuffer();
+  DecodeCacheHits = 0;
+  DecodeCacheMisses = 0;
+  ApplyPendingDecodeCacheInvalidations();
 
   // XXX: Load symbol data
   SymbolAvailable = false;
@@ -1212,7 +1361,7 @@ void Decoder::DecodeInstructionsAtEntry(uint8_t const* _InstStream, uint64_t PC,
         }
       }
 
-      bool ErrorDuringDecoding = !DecodeInstruction(RIPToDecode + PCOffset);
+      bool ErrorDuringDecoding = !DecodeInstructionCached(RIPToDecode + PCOffset);
 
       if (ErrorDuringDecoding) {
         LogMan::Msg::DFmt("Couldn't Decode something at 0x{:x}, Started at 0x{:x}", RIPToDecode + PCOffset, PC);
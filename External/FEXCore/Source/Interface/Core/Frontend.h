@@ -3,11 +3,16 @@
 #include <FEXCore/Debug/X86Tables.h>
 #include <FEXCore/HLE/SyscallHandler.h>
 #include <FEXCore/Utils/Telemetry.h>
+#include <FEXHeaderUtils/TypeDefines.h>
 
 #include <array>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <stddef.h>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace FEXCore::Context {
@@ -43,18 +48,32 @@ public:
     PoolObject.DelayedDisownBuffer();
   }
 
+  // Drops cached decodes of a guest range, safe to call from any thread
+  // Only takes effect when the owning thread next decodes
+  void InvalidateDecodeCache(uint64_t Start, uint64_t Length);
+  void ClearDecodeCache();
+  // Benchmarking needs to measure real decoding rather than cache hits
+  void SetDecodeCacheEnabled(bool Enabled) { DecodeCacheEnabled = Enabled; }
+
+  // Decode cache results of the last DecodeInstructionsAtEntry
+  uint64_t DecodeCacheHits {};
+  uint64_t DecodeCacheMisses {};
+
 private:
   // To pass any information from instruction prefixes
   // down into the actual instruction handling machinery.
   struct DecodedHeader {
     uint8_t vvvv; // Encoded operand in a VEX prefix.
     bool w;       // VEX.W bit.
+    bool L;       // VEX.L bit. Selects 256-bit vector operands.
   };
 
   FEXCore::Context::Context *CTX;
   const FEXCore::HLE::SyscallOSABI OSABI{};
 
   bool DecodeInstruction(uint64_t PC);
+  bool DecodeInstructionCached(uint64_t PC);
+  void ApplyPendingDecodeCacheInvalidations();
 
   void BranchTargetInMultiblockRange();
 
@@ -92,6 +111,46 @@ private:
   std::set<uint64_t> HasBlocks;
   std::set<uint64_t> *ExternalBranches {nullptr};
 
+  // Multiblock regions overlap heavily, every entrypoint in to a loop or function decodes the same instructions again.
+  // Decoded instructions are kept per guest page along with the bytes they were decoded from,
+  // a hit is only used if those bytes are still what is in guest memory.
+  // XXX: This only shares the decode. Entering an already compiled region part way through, instead of compiling
+  // the overlap again, needs per-block guest RIPs and JIT entry setup and is tracked as separate work.
+  struct CachedInst {
+    FEXCore::X86Tables::DecodedInst Inst;
+    std::array<uint8_t, MAX_INST_SIZE> Bytes;
+  };
+
+  // Both limits together give the same 0x8000 instruction bound as a single flat cache
+  static constexpr size_t MaxDecodeCachePages = 64;
+  static constexpr size_t MaxEntriesPerPage = 512;
+
+  struct CachedPage {
+    // Entry index + 1 of the instruction starting at each page offset, 0 if it isn't cached
+    std::array<uint16_t, FHU::FEX_PAGE_SIZE> Offsets {};
+    std::vector<CachedInst> Entries;
+
+    void Clear() {
+      Offsets.fill(0);
+      Entries.clear();
+    }
+  };
+
+  CachedPage *GetDecodeCachePage(uint64_t PC, bool Create);
+
+  std::unordered_map<uint64_t, std::unique_ptr<CachedPage>> DecodeCache;
+  bool DecodeCacheEnabled {true};
+  // Sequential decoding mostly stays on the same page as the previous instruction
+  uint64_t DecodeCacheLastPage {~0ULL};
+  CachedPage *DecodeCacheLast {};
+
+  // Invalidations come from other threads while this one might be decoding
+  // These are only queued so that the lock is never held while decoding
+  static constexpr size_t MaxPendingInvalidations = 64;
+  std::mutex PendingInvalidationsMutex;
+  std::vector<std::pair<uint64_t, uint64_t>> PendingInvalidations;
+  bool PendingClear {};
+
   // ModRM rm decoding
   using DecodeModRMPtr = void (FEXCore::Frontend::Decoder::*)(X86Tables::DecodedOperand *Operand, X86Tables::ModRMDecoded ModRM);
   void DecodeModRM_16(X86Tables::DecodedOperand *Operand, X86Tables::ModRMDecoded ModRM);
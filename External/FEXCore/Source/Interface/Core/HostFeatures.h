@@ -16,6 +16,7 @@ class HostFeatures final {
     uint32_t ICacheLineSize{};
     bool SupportsAES{};
     bool SupportsCRC{};
+    bool SupportsSHA{};
     bool SupportsCLZERO{};
     bool SupportsAtomics{};
     bool SupportsRCPC{};
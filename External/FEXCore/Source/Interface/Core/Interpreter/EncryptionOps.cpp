@@ -7,7 +7,10 @@ $end_info$
 #include "Interface/Core/Interpreter/InterpreterClass.h"
 #include "Interface/Core/Interpreter/InterpreterOps.h"
 #include "Interface/Core/Interpreter/InterpreterDefines.h"
+#include "Interface/Core/Interpreter/StringCompareOps.h"
 
+#include <array>
+#include <bit>
 #include <cstdint>
 
 namespace AES {
@@ -355,6 +358,124 @@ namespace CRC32 {
   }
 }
 
+namespace SHA {
+  // Vectors are in x86 element order, the first SHA word lives in element 3.
+  using Vector = std::array<uint32_t, 4>;
+
+  static Vector SHA1NEXTE(Vector const &Dest, Vector const &Src) {
+    Vector Res = Src;
+    Res[3] += std::rotl(Dest[3], 30);
+    return Res;
+  }
+
+  static Vector SHA1MSG1(Vector const &Dest, Vector const &Src) {
+    return {
+      Src[2] ^ Dest[0],
+      Src[3] ^ Dest[1],
+      Dest[0] ^ Dest[2],
+      Dest[1] ^ Dest[3],
+    };
+  }
+
+  static Vector SHA1MSG2(Vector const &Dest, Vector const &Src) {
+    const uint32_t W16 = std::rotl(Dest[3] ^ Src[2], 1);
+    const uint32_t W17 = std::rotl(Dest[2] ^ Src[1], 1);
+    const uint32_t W18 = std::rotl(Dest[1] ^ Src[0], 1);
+    const uint32_t W19 = std::rotl(Dest[0] ^ W16, 1);
+    return {W19, W18, W17, W16};
+  }
+
+  static Vector SHA1RNDS4(Vector const &Dest, Vector const &Src, uint8_t Function) {
+    constexpr std::array<uint32_t, 4> K {
+      0x5A827999U,
+      0x6ED9EBA1U,
+      0x8F1BBCDCU,
+      0xCA62C1D6U,
+    };
+
+    const auto F = [Function](uint32_t B, uint32_t C, uint32_t D) -> uint32_t {
+      switch (Function) {
+        case 0: return (B & C) ^ (~B & D);
+        case 2: return (B & C) ^ (B & D) ^ (C & D);
+        default: return B ^ C ^ D;
+      }
+    };
+
+    uint32_t A = Dest[3];
+    uint32_t B = Dest[2];
+    uint32_t C = Dest[1];
+    uint32_t D = Dest[0];
+    // The guest already added E in to the first message word.
+    uint32_t E = 0;
+
+    for (size_t i = 0; i < 4; ++i) {
+      const uint32_t ANext = F(B, C, D) + std::rotl(A, 5) + Src[3 - i] + E + K[Function];
+      E = D;
+      D = C;
+      C = std::rotl(B, 30);
+      B = A;
+      A = ANext;
+    }
+
+    return {D, C, B, A};
+  }
+
+  static Vector SHA256MSG1(Vector const &Dest, Vector const &Src) {
+    const auto Sigma0 = [](uint32_t W) -> uint32_t {
+      return std::rotr(W, 7) ^ std::rotr(W, 18) ^ (W >> 3);
+    };
+
+    return {
+      Dest[0] + Sigma0(Dest[1]),
+      Dest[1] + Sigma0(Dest[2]),
+      Dest[2] + Sigma0(Dest[3]),
+      Dest[3] + Sigma0(Src[0]),
+    };
+  }
+
+  static Vector SHA256MSG2(Vector const &Dest, Vector const &Src) {
+    const auto Sigma1 = [](uint32_t W) -> uint32_t {
+      return std::rotr(W, 17) ^ std::rotr(W, 19) ^ (W >> 10);
+    };
+
+    const uint32_t W16 = Dest[0] + Sigma1(Src[2]);
+    const uint32_t W17 = Dest[1] + Sigma1(Src[3]);
+    const uint32_t W18 = Dest[2] + Sigma1(W16);
+    const uint32_t W19 = Dest[3] + Sigma1(W17);
+    return {W16, W17, W18, W19};
+  }
+
+  static Vector SHA256RNDS2(Vector const &Dest, Vector const &Src, Vector const &WK) {
+    uint32_t A = Src[3];
+    uint32_t B = Src[2];
+    uint32_t C = Dest[3];
+    uint32_t D = Dest[2];
+    uint32_t E = Src[1];
+    uint32_t F = Src[0];
+    uint32_t G = Dest[1];
+    uint32_t H = Dest[0];
+
+    for (size_t i = 0; i < 2; ++i) {
+      const uint32_t Ch = (E & F) ^ (~E & G);
+      const uint32_t Major = (A & B) ^ (A & C) ^ (B & C);
+      const uint32_t Sigma0 = std::rotr(A, 2) ^ std::rotr(A, 13) ^ std::rotr(A, 22);
+      const uint32_t Sigma1 = std::rotr(E, 6) ^ std::rotr(E, 11) ^ std::rotr(E, 25);
+      const uint32_t T1 = Ch + Sigma1 + WK[i] + H;
+
+      H = G;
+      G = F;
+      F = E;
+      E = T1 + D;
+      D = C;
+      C = B;
+      B = A;
+      A = T1 + Major + Sigma0;
+    }
+
+    return {F, E, B, A};
+  }
+}
+
 namespace FEXCore::CPU {
 #define DEF_OP(x) void InterpreterOps::Op_##x(IR::IROp_Header *IROp, IROpData *Data, IR::NodeID Node)
 
@@ -551,6 +672,68 @@ DEF_OP(PCLMUL) {
   Dst[1] = make_hi(TMP1, TMP2);
 }
 
+DEF_OP(VPCMPSTRX) {
+  auto Op = IROp->C<IR::IROp_VPCMPSTRX>();
+
+  __uint128_t LHS{};
+  __uint128_t RHS{};
+  memcpy(&LHS, GetSrc<void*>(Data->SSAData, Op->LHS), sizeof(LHS));
+  memcpy(&RHS, GetSrc<void*>(Data->SSAData, Op->RHS), sizeof(RHS));
+
+  uint64_t Tmp{};
+  if (Op->ImplicitLength) {
+    Tmp = OpHandlers<IR::OP_VPCMPSTRX>::handleImplicit(LHS, RHS, Op->Control);
+  }
+  else {
+    const uint64_t RAX = *GetSrc<uint64_t*>(Data->SSAData, Op->RAX);
+    const uint64_t RDX = *GetSrc<uint64_t*>(Data->SSAData, Op->RDX);
+    Tmp = OpHandlers<IR::OP_VPCMPSTRX>::handleExplicit(RAX, RDX, LHS, RHS, Op->Control);
+  }
+  memcpy(GDP, &Tmp, sizeof(Tmp));
+}
+
+DEF_OP(VSHA) {
+  auto Op = IROp->C<IR::IROp_VSHA>();
+
+  SHA::Vector Src1{};
+  SHA::Vector Src2{};
+  SHA::Vector Src3{};
+  memcpy(Src1.data(), GetSrc<void*>(Data->SSAData, Op->Src1), sizeof(Src1));
+  memcpy(Src2.data(), GetSrc<void*>(Data->SSAData, Op->Src2), sizeof(Src2));
+  memcpy(Src3.data(), GetSrc<void*>(Data->SSAData, Op->Src3), sizeof(Src3));
+
+  SHA::Vector Tmp{};
+  if ((Op->Operation & ~0b11) == IR::SHA_OP_SHA1RNDS4) {
+    Tmp = SHA::SHA1RNDS4(Src1, Src2, Op->Operation & 0b11);
+  }
+  else {
+    switch (Op->Operation) {
+      case IR::SHA_OP_SHA1NEXTE:
+        Tmp = SHA::SHA1NEXTE(Src1, Src2);
+        break;
+      case IR::SHA_OP_SHA1MSG1:
+        Tmp = SHA::SHA1MSG1(Src1, Src2);
+        break;
+      case IR::SHA_OP_SHA1MSG2:
+        Tmp = SHA::SHA1MSG2(Src1, Src2);
+        break;
+      case IR::SHA_OP_SHA256MSG1:
+        Tmp = SHA::SHA256MSG1(Src1, Src2);
+        break;
+      case IR::SHA_OP_SHA256MSG2:
+        Tmp = SHA::SHA256MSG2(Src1, Src2);
+        break;
+      case IR::SHA_OP_SHA256RNDS2:
+        Tmp = SHA::SHA256RNDS2(Src1, Src2, Src3);
+        break;
+      default:
+        LOGMAN_MSG_A_FMT("Unknown SHA operation: {}", Op->Operation);
+        break;
+    }
+  }
+  memcpy(GDP, Tmp.data(), sizeof(Tmp));
+}
+
 #undef DEF_OP
 
 } // namespace FEXCore::CPU
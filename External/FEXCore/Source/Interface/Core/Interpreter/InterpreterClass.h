@@ -40,6 +40,8 @@ public:
   void ClearCache() override;
 
 private:
+  void SetCodeRegion(CPUBackend::CodeBuffer const &Region) override;
+
   size_t BufferUsed;
   Dispatcher *Dispatch;
 };
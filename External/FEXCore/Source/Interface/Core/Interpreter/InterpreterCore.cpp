@@ -26,7 +26,7 @@
   #error missing arch
 #endif
 
-static constexpr size_t INITIAL_CODE_SIZE = 1024 * 1024 * 16;
+static constexpr size_t CODE_SEGMENT_SIZE = 1024 * 1024 * 16;
 static constexpr size_t MAX_CODE_SIZE = 1024 * 1024 * 128;
 
 namespace FEXCore::IR {
@@ -38,7 +38,7 @@ namespace FEXCore::IR {
 namespace FEXCore::CPU {
 
 InterpreterCore::InterpreterCore(Dispatcher *Dispatcher, FEXCore::Core::InternalThreadState *Thread)
-  : CPUBackend(Thread, INITIAL_CODE_SIZE, MAX_CODE_SIZE)
+  : CPUBackend(Thread, CODE_SEGMENT_SIZE, MAX_CODE_SIZE)
   , Dispatch(Dispatcher)
   {
 
@@ -53,7 +53,9 @@ void InterpreterCore::InitializeSignalHandlers(FEXCore::Context::Context *CTX) {
 
 #ifdef _M_ARM_64
   CTX->SignalDelegation->RegisterHostSignalHandler(SIGBUS, [](FEXCore::Core::InternalThreadState *Thread, int Signal, void *info, void *ucontext) -> bool {
-    return FEXCore::ArchHelpers::Arm64::HandleSIGBUS(true, Signal, info, ucontext);
+    FEXCore::Core::IncrementStat(Thread->Stats->MisalignedAtomicFaults);
+    // Faults come from the interpreter's own code, nothing to patch
+    return FEXCore::ArchHelpers::Arm64::HandleSIGBUS(true, Signal, info, ucontext, nullptr);
   }, true);
 #endif
 }
@@ -61,13 +63,15 @@ void InterpreterCore::InitializeSignalHandlers(FEXCore::Context::Context *CTX) {
 void *InterpreterCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR::IRListView const *IR, [[maybe_unused]] FEXCore::Core::DebugData *DebugData, FEXCore::IR::RegisterAllocationData *RAData, bool GDBEnabled) {
 
   const auto IRSize = AlignUp(IR->GetInlineSize(), 16);
-  const auto MaxSize = IRSize + Dispatcher::MaxInterpreterTrampolineSize + GDBEnabled * Dispatcher::MaxGDBPauseCheckSize;
+  // The pre-decoded program is aligned after the IR
+  const auto DecodedSize = InterpreterOps::GetDecodedSize(IR) + 16;
+  const auto MaxSize = IRSize + DecodedSize + Dispatcher::MaxInterpreterTrampolineSize + GDBEnabled * Dispatcher::MaxGDBPauseCheckSize;
 
-  if ((BufferUsed + MaxSize) > CurrentCodeBuffer->Size) {
-    ThreadState->CTX->ClearCodeCache(ThreadState);
+  if ((BufferUsed + MaxSize) > CurrentCodeRegion.Size) {
+    ThreadState->CTX->EvictCodeSegment(ThreadState);
   }
 
-  const auto BufferStart = CurrentCodeBuffer->Ptr + BufferUsed;
+  const auto BufferStart = CurrentCodeRegion.Ptr + BufferUsed;
 
   auto DestBuffer = BufferStart;
 
@@ -86,6 +90,12 @@ void *InterpreterCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR:
   DestBuffer += IRSize;
   BufferUsed += IRSize;
 
+  // Decode the inline copy, the decoded ops point in to it
+  auto InlineIR = reinterpret_cast<FEXCore::IR::IRListView const*>(DestBuffer - IRSize);
+  InterpreterOps::DecodeIR(InlineIR);
+  DestBuffer += DecodedSize;
+  BufferUsed += DecodedSize;
+
   return BufferStart;
 }
 
@@ -95,6 +105,10 @@ void InterpreterCore::ClearCache() {
   BufferUsed = 0;
 }
 
+void InterpreterCore::SetCodeRegion(CPUBackend::CodeBuffer const &Region) {
+  BufferUsed = 0;
+}
+
 std::unique_ptr<CPUBackend> CreateInterpreterCore(FEXCore::Context::Context *ctx, FEXCore::Core::InternalThreadState *Thread) {
   return std::make_unique<InterpreterCore>(ctx->Dispatcher.get(), Thread);
 }
@@ -16,6 +16,7 @@
 #include <FEXCore/Utils/BitUtils.h>
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/MathUtils.h>
 
 #include "Interface/HLE/Thunks/Thunks.h"
 
@@ -32,10 +33,11 @@
 #include <ctime>
 #include <limits>
 #include <memory>
+#include <unordered_map>
 
 namespace FEXCore::CPU {
 
-using OpHandler = void (*)(IR::IROp_Header *IROp, InterpreterOps::IROpData *Data, IR::NodeID Node);
+using OpHandler = InterpreterOps::OpHandler;
 using OpHandlerArray = std::array<OpHandler, IR::IROps::OP_LAST + 1>;
 
 constexpr OpHandlerArray InterpreterOpHandlers = [] {
@@ -186,7 +188,6 @@ constexpr OpHandlerArray InterpreterOpHandlers = [] {
   REGISTER_OP(VECTORZERO,             VectorZero);
   REGISTER_OP(VECTORIMM,              VectorImm);
   REGISTER_OP(SPLATVECTOR2,           SplatVector);
-  REGISTER_OP(SPLATVECTOR4,           SplatVector);
   REGISTER_OP(VMOV,                   VMov);
   REGISTER_OP(VAND,                   VAnd);
   REGISTER_OP(VBIC,                   VBic);
@@ -284,6 +285,8 @@ constexpr OpHandlerArray InterpreterOpHandlers = [] {
   REGISTER_OP(VAESKEYGENASSIST,       AESKeyGenAssist);
   REGISTER_OP(CRC32,                  CRC32);
   REGISTER_OP(PCLMUL,                 PCLMUL);
+  REGISTER_OP(VSHA,                   VSHA);
+  REGISTER_OP(VPCMPSTRX,              VPCMPSTRX);
 
   // F80 ops
   REGISTER_OP(F80LOADFCW,             F80LOADFCW);
@@ -333,6 +336,75 @@ void InterpreterOps::Op_Unhandled(FEXCore::IR::IROp_Header *IROp, IROpData *Data
 void InterpreterOps::Op_NoOp(FEXCore::IR::IROp_Header *IROp, IROpData *Data, IR::NodeID Node) {
 }
 
+size_t InterpreterOps::GetDecodedSize(FEXCore::IR::IRListView const *IR) {
+  size_t NumOps{};
+  for (auto [BlockNode, BlockHeader] : IR->GetBlocks()) {
+    for (auto [CodeNode, IROp] : IR->GetCode(BlockNode)) {
+      ++NumOps;
+    }
+  }
+
+  return sizeof(DecodedProgram) + NumOps * sizeof(DecodedOp);
+}
+
+uintptr_t InterpreterOps::GetDecodedProgramAddress(FEXCore::IR::IRListView const *InlineIR) {
+  return AlignUp(reinterpret_cast<uintptr_t>(InlineIR) + InlineIR->GetInlineSize(), 16);
+}
+
+void InterpreterOps::DecodeIR(FEXCore::IR::IRListView const *InlineIR) {
+  using namespace FEXCore::IR;
+
+  auto Program = reinterpret_cast<DecodedProgram*>(GetDecodedProgramAddress(InlineIR));
+  auto Ops = const_cast<DecodedOp*>(Program->GetOps());
+
+  // Block ID -> index of its first op, branches are resolved once every block is laid out
+  std::unordered_map<uint32_t, uint32_t> BlockStart;
+  uint32_t NumOps{};
+
+  for (auto [BlockNode, BlockHeader] : InlineIR->GetBlocks()) {
+    BlockStart[InlineIR->GetID(BlockNode).Value] = NumOps;
+
+    for (auto [CodeNode, IROp] : InlineIR->GetCode(BlockNode)) {
+      auto &Op = Ops[NumOps++];
+      Op.Handler = InterpreterOpHandlers[IROp->Op];
+      Op.IROp = IROp;
+      Op.Node = InlineIR->GetID(CodeNode);
+      Op.Flags = IROp->HasDest ? DecodedOp::FLAG_CLEAR_DEST : 0;
+      // Falls through to the next block once it reaches the end of this one
+      Op.Targets[0] = NumOps;
+      Op.Targets[1] = NumOps;
+
+      switch (IROp->Op) {
+        case OP_EXITFUNCTION:
+        case OP_JUMP:
+        case OP_CONDJUMP:
+          Op.Flags |= DecodedOp::FLAG_CHECK_BLOCK;
+          break;
+        default: break;
+      }
+    }
+
+    if (NumOps) {
+      Ops[NumOps - 1].Flags |= DecodedOp::FLAG_CHECK_BLOCK;
+    }
+  }
+
+  for (uint32_t i = 0; i < NumOps; ++i) {
+    auto &Op = Ops[i];
+    if (Op.IROp->Op == OP_JUMP) {
+      Op.Targets[0] = BlockStart.at(Op.IROp->Args[0].ID().Value);
+    }
+    else if (Op.IROp->Op == OP_CONDJUMP) {
+      auto CondJump = Op.IROp->C<IROp_CondJump>();
+      Op.Targets[0] = BlockStart.at(CondJump->TrueBlock.ID().Value);
+      Op.Targets[1] = BlockStart.at(CondJump->FalseBlock.ID().Value);
+    }
+  }
+
+  Program->NumOps = NumOps;
+  Program->Pad = 0;
+}
+
 void InterpreterOps::InterpretIR(FEXCore::Core::CpuStateFrame *Frame, FEXCore::IR::IRListView const *CurrentIR) {
   volatile void *StackEntry = alloca(0);
 
@@ -341,56 +413,47 @@ void InterpreterOps::InterpretIR(FEXCore::Core::CpuStateFrame *Frame, FEXCore::I
   static_assert(sizeof(FEXCore::IR::IROp_Header) == 4);
   static_assert(sizeof(FEXCore::IR::OrderedNode) == 16);
 
-  auto BlockEnd = CurrentIR->GetBlocks().end();
+  auto Program = reinterpret_cast<DecodedProgram const*>(GetDecodedProgramAddress(CurrentIR));
+  auto Ops = Program->GetOps();
+  const uint32_t NumOps = Program->NumOps;
 
   InterpreterOps::IROpData OpData{};
   OpData.State = Frame->Thread;
+  // Not cleared up front, each op zeroes its own result slot before it is written
   OpData.SSAData = alloca(ListSize * 16);
   OpData.CurrentEntry = Frame->State.rip;
   OpData.CurrentIR = CurrentIR;
   OpData.StackEntry = StackEntry;
-  OpData.BlockIterator = CurrentIR->GetBlocks().begin();
-
-  // Clear them all to zero. Required for Zero-extend semantics
-  memset(OpData.SSAData, 0, ListSize * 16);
 
+  uint32_t PC{};
   while (1) {
-    using namespace FEXCore::IR;
-    auto [BlockNode, BlockHeader] = OpData.BlockIterator();
-    auto BlockIROp = BlockHeader->CW<IROp_CodeBlock>();
-    LOGMAN_THROW_A_FMT(BlockIROp->Header.Op == IR::OP_CODEBLOCK, "IR type failed to be a code block");
-
-    // Reset the block results per block
-    memset(&OpData.BlockResults, 0, sizeof(OpData.BlockResults));
+    auto &Op = Ops[PC];
 
-    auto CodeBegin = CurrentIR->at(BlockIROp->Begin);
-    auto CodeLast = CurrentIR->at(BlockIROp->Last);
-
-    for (auto [CodeNode, IROp] : CurrentIR->GetCode(BlockNode)) {
-      const auto ID = CurrentIR->GetID(CodeNode);
-      const uint32_t Op = IROp->Op;
-
-      // Execute handler
-      OpHandler Handler = InterpreterOpHandlers[Op];
+    if (Op.Flags & DecodedOp::FLAG_CLEAR_DEST) {
+      memset(&reinterpret_cast<__uint128_t*>(OpData.SSAData)[Op.Node.Value], 0, 16);
+    }
 
-      Handler(IROp, &OpData, ID);
+    Op.Handler(Op.IROp, &OpData, Op.Node);
 
-      if (OpData.BlockResults.Quit ||
-          OpData.BlockResults.Redo ||
-          CodeBegin == CodeLast) {
-        break;
-      }
+    if (!(Op.Flags & DecodedOp::FLAG_CHECK_BLOCK)) {
+      ++PC;
+      continue;
+    }
 
-      ++CodeBegin;
+    // If we have set to early exit then leave
+    if (OpData.BlockResults.Quit) {
+      break;
     }
 
-    // Iterator will have been set, go again
     if (OpData.BlockResults.Redo) {
+      PC = Op.Targets[OpData.BlockResults.FalseBlock];
+      OpData.BlockResults.Redo = false;
+      OpData.BlockResults.FalseBlock = false;
       continue;
     }
 
-    // If we have set to early exit or at the end block then leave
-    if (OpData.BlockResults.Quit || ++OpData.BlockIterator == BlockEnd) {
+    // Fell through the end of the last block
+    if (++PC == NumOps) {
       break;
     }
   }
@@ -1,4 +1,5 @@
 #pragma once
+#include <stddef.h>
 #include <stdint.h>
 
 #include <FEXCore/Core/CoreState.h>
@@ -36,6 +37,8 @@ namespace FEXCore::CPU {
     FABI_I64_F80_F80,
     FABI_F80_F80,
     FABI_F80_F80_F80,
+    FABI_I32_I64_I64_I128_I128_I16,
+    FABI_I32_I128_I128_I16,
   };
 
   struct FallbackInfo {
@@ -60,11 +63,51 @@ namespace FEXCore::CPU {
         struct {
           bool Quit;
           bool Redo;
+          // Set by CondJump when the false block is the one to run next
+          bool FalseBlock;
         } BlockResults{};
+      };
+
+      using OpHandler = void (*)(IR::IROp_Header *IROp, IROpData *Data, IR::NodeID Node);
 
-        IR::NodeIterator BlockIterator{0, 0};
+      /**
+       * @brief Pre-decoded IR op
+       *
+       * Every block is flattened in to an array of these when it is compiled, so
+       * executing it doesn't need to walk the IR list or look up the op handler.
+       */
+      struct DecodedOp {
+        enum Flags : uint32_t {
+          // Result slot needs zeroing before the handler runs, for zero-extend semantics
+          FLAG_CLEAR_DEST  = (1U << 0),
+          // Handler can change control flow or this is the last op of a block
+          FLAG_CHECK_BLOCK = (1U << 1),
+        };
+
+        OpHandler Handler;
+        IR::IROp_Header *IROp;
+        IR::NodeID Node;
+        uint32_t Flags;
+        // Op index to continue at, [0] for Jump, the true block and falling through; [1] for the false block
+        uint32_t Targets[2];
       };
 
+      struct DecodedProgram {
+        uint32_t NumOps;
+        uint32_t Pad;
+
+        DecodedOp const *GetOps() const {
+          return reinterpret_cast<DecodedOp const*>(this + 1);
+        }
+      };
+
+      ///< Size of the pre-decoded form of the IR, not including alignment
+      static size_t GetDecodedSize(FEXCore::IR::IRListView const *IR);
+      ///< Where the pre-decoded form lives, directly after the inline IR in the code buffer
+      static uintptr_t GetDecodedProgramAddress(FEXCore::IR::IRListView const *InlineIR);
+      ///< Pre-decodes InlineIR, which must be the copy that is going to be executed
+      static void DecodeIR(FEXCore::IR::IRListView const *InlineIR);
+
 #define DEF_OP(x) static void Op_##x(IR::IROp_Header *IROp, IROpData *Data, IR::NodeID Node)
 
   ///< Unhandled handler
@@ -303,6 +346,8 @@ namespace FEXCore::CPU {
   DEF_OP(AESKeyGenAssist);
   DEF_OP(CRC32);
   DEF_OP(PCLMUL);
+  DEF_OP(VSHA);
+  DEF_OP(VPCMPSTRX);
 
   ///< F80 ops
   DEF_OP(F80LOADFCW);
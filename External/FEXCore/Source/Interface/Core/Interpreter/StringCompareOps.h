@@ -0,0 +1,153 @@
+#pragma once
+#include "Interface/Core/Interpreter/F80Ops.h"
+
+#include <FEXCore/IR/IR.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace FEXCore::CPU {
+template<>
+struct OpHandlers<IR::OP_VPCMPSTRX> {
+  // Bits of the imm8 control byte that the IR operation consumes.
+  // Bit 6 only selects how the result is presented and is handled in the OpcodeDispatcher.
+  enum ControlBits : uint16_t {
+    CONTROL_WORD        = 0b00'00'01,
+    CONTROL_SIGNED      = 0b00'00'10,
+    CONTROL_AGGREGATION = 0b00'11'00,
+    CONTROL_POLARITY    = 0b11'00'00,
+  };
+
+  enum Aggregation : uint16_t {
+    AGG_EQUAL_ANY     = 0b00,
+    AGG_RANGES        = 0b01,
+    AGG_EQUAL_EACH    = 0b10,
+    AGG_EQUAL_ORDERED = 0b11,
+  };
+
+  static uint32_t GetElementCount(uint16_t Control) {
+    return (Control & CONTROL_WORD) ? 8 : 16;
+  }
+
+  static int32_t GetElement(__uint128_t Src, uint32_t Index, uint16_t Control) {
+    if (Control & CONTROL_WORD) {
+      const uint16_t Element = static_cast<uint16_t>(Src >> (Index * 16));
+      return (Control & CONTROL_SIGNED) ? static_cast<int16_t>(Element) : Element;
+    }
+
+    const uint8_t Element = static_cast<uint8_t>(Src >> (Index * 8));
+    return (Control & CONTROL_SIGNED) ? static_cast<int8_t>(Element) : Element;
+  }
+
+  // Explicit lengths are the absolute value of the signed register, saturated to the element count.
+  static uint32_t GetExplicitLength(uint64_t Src, uint16_t Control) {
+    const uint64_t Abs = static_cast<int64_t>(Src) < 0 ? (~Src + 1) : Src;
+    return static_cast<uint32_t>(std::min<uint64_t>(Abs, GetElementCount(Control)));
+  }
+
+  // Implicit lengths are the index of the first null element.
+  static uint32_t GetImplicitLength(__uint128_t Src, uint16_t Control) {
+    const uint32_t NumElements = GetElementCount(Control);
+    for (uint32_t i = 0; i < NumElements; ++i) {
+      if (GetElement(Src, i, Control) == 0) {
+        return i;
+      }
+    }
+    return NumElements;
+  }
+
+  // Returns IntRes2 in bits [15:0], RHS invalid (ZF) in bit 16 and LHS invalid (SF) in bit 17.
+  static uint32_t MainBody(__uint128_t LHS, uint32_t LHSLength, __uint128_t RHS, uint32_t RHSLength, uint16_t Control) {
+    const uint32_t NumElements = GetElementCount(Control);
+    const uint32_t ElementMask = (1U << NumElements) - 1;
+    const uint32_t ValidRHSMask = (1U << RHSLength) - 1;
+
+    int32_t A[16];
+    int32_t B[16];
+    for (uint32_t i = 0; i < NumElements; ++i) {
+      A[i] = GetElement(LHS, i, Control);
+      B[i] = GetElement(RHS, i, Control);
+    }
+
+    uint32_t IntRes1 = 0;
+    switch ((Control & CONTROL_AGGREGATION) >> 2) {
+      case AGG_EQUAL_ANY: {
+        for (uint32_t i = 0; i < RHSLength; ++i) {
+          for (uint32_t j = 0; j < LHSLength; ++j) {
+            if (A[j] == B[i]) {
+              IntRes1 |= 1U << i;
+              break;
+            }
+          }
+        }
+        break;
+      }
+      case AGG_RANGES: {
+        // Pairs of LHS elements form inclusive [Lower, Upper] ranges.
+        // A trailing unpaired element can never match since its upper bound is invalid.
+        for (uint32_t i = 0; i < RHSLength; ++i) {
+          for (uint32_t j = 0; j + 1 < LHSLength; j += 2) {
+            if (B[i] >= A[j] && B[i] <= A[j + 1]) {
+              IntRes1 |= 1U << i;
+              break;
+            }
+          }
+        }
+        break;
+      }
+      case AGG_EQUAL_EACH: {
+        for (uint32_t i = 0; i < NumElements; ++i) {
+          const bool LHSValid = i < LHSLength;
+          const bool RHSValid = i < RHSLength;
+          bool Result{};
+          if (LHSValid && RHSValid) {
+            Result = A[i] == B[i];
+          }
+          else {
+            // Both invalid compares as true, only one invalid compares as false
+            Result = !LHSValid && !RHSValid;
+          }
+          IntRes1 |= static_cast<uint32_t>(Result) << i;
+        }
+        break;
+      }
+      case AGG_EQUAL_ORDERED: {
+        // Searches for the LHS substring starting at each RHS element.
+        // Invalid LHS elements always match, a valid LHS element never matches an invalid RHS element.
+        for (uint32_t i = 0; i < NumElements; ++i) {
+          bool Result = true;
+          for (uint32_t k = 0; k < LHSLength && (i + k) < NumElements; ++k) {
+            if ((i + k) >= RHSLength || A[k] != B[i + k]) {
+              Result = false;
+              break;
+            }
+          }
+          IntRes1 |= static_cast<uint32_t>(Result) << i;
+        }
+        break;
+      }
+    }
+
+    uint32_t IntRes2{};
+    switch ((Control & CONTROL_POLARITY) >> 4) {
+      case 0b01: IntRes2 = IntRes1 ^ ElementMask; break;
+      case 0b11: IntRes2 = IntRes1 ^ ValidRHSMask; break;
+      default: IntRes2 = IntRes1; break;
+    }
+
+    uint32_t Result = IntRes2 & ElementMask;
+    Result |= static_cast<uint32_t>(RHSLength < NumElements) << 16;
+    Result |= static_cast<uint32_t>(LHSLength < NumElements) << 17;
+    return Result;
+  }
+
+  static uint32_t handleExplicit(uint64_t RAX, uint64_t RDX, __uint128_t LHS, __uint128_t RHS, uint16_t Control) {
+    return MainBody(LHS, GetExplicitLength(RAX, Control), RHS, GetExplicitLength(RDX, Control), Control);
+  }
+
+  static uint32_t handleImplicit(__uint128_t LHS, __uint128_t RHS, uint16_t Control) {
+    return MainBody(LHS, GetImplicitLength(LHS, Control), RHS, GetImplicitLength(RHS, Control), Control);
+  }
+};
+
+}
@@ -49,7 +49,6 @@ DEF_OP(SplatVector) {
   uint8_t Elements = 0;
 
   switch (Op->Header.Op) {
-    case IR::OP_SPLATVECTOR4: Elements = 4; break;
     case IR::OP_SPLATVECTOR2: Elements = 2; break;
     default: LOGMAN_MSG_A_FMT("Uknown Splat size"); break;
   }
@@ -138,7 +138,7 @@ static Condition MapBranchCC(IR::CondClassType Cond) {
 DEF_OP(CondJump) {
   auto Op = IROp->C<IR::IROp_CondJump>();
 
-  Label *TrueTargetLabel = &JumpTargets.try_emplace(Op->TrueBlock.ID()).first->second;
+  Label *TrueTargetLabel = GetConditionalBranchTarget(Op->TrueBlock.ID());
 
   uint64_t Const;
   const bool isConst = IsInlineConstant(Op->Cmp2, &Const);
@@ -379,6 +379,13 @@ DEF_OP(Thunk) {
 
   mov(x0, GetReg<RA_64>(Op->ArgPtr.ID()));
 
+  if (CTX->StatsRegion) {
+    ldr(x2, MemOperand(STATE, offsetof(FEXCore::Core::CpuStateFrame, Stats)));
+    ldr(x1, MemOperand(x2, offsetof(FEXCore::Core::RuntimeStats, ThunkCalls)));
+    add(x1, x1, 1);
+    str(x1, MemOperand(x2, offsetof(FEXCore::Core::RuntimeStats, ThunkCalls)));
+  }
+
   auto thunkFn = ThreadState->CTX->ThunkHandler->LookupThunk(Op->ThunkNameHash);
   LoadConstant(x2, (uintptr_t)thunkFn);
   blr(x2);
@@ -7,6 +7,8 @@ $end_info$
 #include "Interface/Core/JIT/Arm64/JITClass.h"
 #include "Interface/IR/Passes/RegisterAllocationPass.h"
 
+#include <array>
+
 namespace FEXCore::CPU {
 using namespace vixl;
 using namespace vixl::aarch64;
@@ -130,6 +132,107 @@ DEF_OP(PCLMUL) {
   }
 }
 
+DEF_OP(VSHA) {
+  auto Op = IROp->C<IR::IROp_VSHA>();
+
+  auto Dst  = GetDst(Node);
+  auto Src1 = GetSrc(Op->Src1.ID());
+  auto Src2 = GetSrc(Op->Src2.ID());
+
+  // x86 keeps the first SHA1 word in element 3 while ARMv8 keeps it in element 0
+  const auto ReverseElements = [this](aarch64::VRegister const &Dst, aarch64::VRegister const &Src) {
+    rev64(Dst.V4S(), Src.V4S());
+    ext(Dst.V16B(), Dst.V16B(), Dst.V16B(), 8);
+  };
+
+  if ((Op->Operation & ~0b11) == IR::SHA_OP_SHA1RNDS4) {
+    constexpr std::array<uint32_t, 4> K {
+      0x5A827999U,
+      0x6ED9EBA1U,
+      0x8F1BBCDCU,
+      0xCA62C1D6U,
+    };
+    const uint8_t Function = Op->Operation & 0b11;
+
+    // ARMv8 expects W+K, x86 adds K itself
+    ReverseElements(VTMP1, Src1);
+    ReverseElements(VTMP2, Src2);
+    LoadConstant(TMP1.W(), K[Function]);
+    dup(VTMP3.V4S(), TMP1.W());
+    add(VTMP2.V4S(), VTMP2.V4S(), VTMP3.V4S());
+
+    // The guest already added E in to the first message word
+    eor(VTMP3.V16B(), VTMP3.V16B(), VTMP3.V16B());
+    switch (Function) {
+      case 0: sha1c(VTMP1.Q(), VTMP3.S(), VTMP2.V4S()); break;
+      case 2: sha1m(VTMP1.Q(), VTMP3.S(), VTMP2.V4S()); break;
+      default: sha1p(VTMP1.Q(), VTMP3.S(), VTMP2.V4S()); break;
+    }
+    ReverseElements(Dst, VTMP1);
+    return;
+  }
+
+  switch (Op->Operation) {
+    case IR::SHA_OP_SHA1NEXTE:
+      mov(VTMP1.S(), Src1.V4S(), 3);
+      sha1h(VTMP1.S(), VTMP1.S());
+      mov(VTMP2.S(), Src2.V4S(), 3);
+      add(VTMP1.V4S(), VTMP1.V4S(), VTMP2.V4S());
+      mov(Dst.V16B(), Src2.V16B());
+      ins(Dst.V4S(), 3, VTMP1.V4S(), 0);
+      break;
+    case IR::SHA_OP_SHA1MSG1:
+      // sha1su0 also folds in W[i-8], the x86 variant only needs the W[i-16] ^ W[i-14] half
+      ext(VTMP1.V16B(), Src2.V16B(), Src1.V16B(), 8);
+      eor(Dst.V16B(), VTMP1.V16B(), Src1.V16B());
+      break;
+    case IR::SHA_OP_SHA1MSG2:
+      ReverseElements(VTMP1, Src1);
+      ReverseElements(VTMP2, Src2);
+      sha1su1(VTMP1.V4S(), VTMP2.V4S());
+      ReverseElements(Dst, VTMP1);
+      break;
+    case IR::SHA_OP_SHA256MSG1:
+      mov(VTMP1.V16B(), Src1.V16B());
+      sha256su0(VTMP1.V4S(), Src2.V4S());
+      mov(Dst.V16B(), VTMP1.V16B());
+      break;
+    case IR::SHA_OP_SHA256MSG2:
+      // sha256su1 also adds W[i-7], which x86 expects the guest to have done already.
+      // Zero every element that feeds in to that term.
+      mov(VTMP1.V16B(), Src1.V16B());
+      mov(VTMP2.V16B(), Src2.V16B());
+      ins(VTMP2.V4S(), 0, wzr);
+      eor(VTMP3.V16B(), VTMP3.V16B(), VTMP3.V16B());
+      sha256su1(VTMP1.V4S(), VTMP3.V4S(), VTMP2.V4S());
+      mov(Dst.V16B(), VTMP1.V16B());
+      break;
+    case IR::SHA_OP_SHA256RNDS2: {
+      auto WK = GetSrc(Op->Src3.ID());
+
+      // Rebuild {A, B, C, D} and {E, F, G, H} from x86's {A, B, E, F} and {C, D, G, H}
+      zip2(VTMP1.V2D(), Src2.V2D(), Src1.V2D());
+      rev64(VTMP1.V4S(), VTMP1.V4S());
+      zip1(VTMP2.V2D(), Src2.V2D(), Src1.V2D());
+      rev64(VTMP2.V4S(), VTMP2.V4S());
+
+      // ARMv8 always does four rounds.
+      // Each round only shifts the earlier round's results along, so after four rounds
+      // the top two elements of each half hold the state after the second round.
+      mov(VTMP3.V16B(), VTMP1.V16B());
+      sha256h(VTMP1.Q(), VTMP2.Q(), WK.V4S());
+      sha256h2(VTMP2.Q(), VTMP3.Q(), WK.V4S());
+
+      zip2(Dst.V2D(), VTMP2.V2D(), VTMP1.V2D());
+      rev64(Dst.V4S(), Dst.V4S());
+      break;
+    }
+    default:
+      LOGMAN_MSG_A_FMT("Unknown SHA operation: {}", Op->Operation);
+      break;
+  }
+}
+
 #undef DEF_OP
 void Arm64JITCore::RegisterEncryptionHandlers() {
 #define REGISTER_OP(op, x) OpHandlers[FEXCore::IR::IROps::OP_##op] = &Arm64JITCore::Op_##x
@@ -141,6 +244,8 @@ void Arm64JITCore::RegisterEncryptionHandlers() {
   REGISTER_OP(VAESKEYGENASSIST,  AESKeyGenAssist);
   REGISTER_OP(CRC32,             CRC32);
   REGISTER_OP(PCLMUL,            PCLMUL);
+  REGISTER_OP(VSHA,              VSHA);
+  // VPCMPSTRX is intentionally missing, it always goes through the interpreter fallback in Op_Unhandled
 #undef REGISTER_OP
 }
 }
@@ -35,9 +35,11 @@ $end_info$
 #include <unistd.h>
 #include <string.h>
 
-static constexpr size_t INITIAL_CODE_SIZE = 1024 * 1024 * 16;
+static constexpr size_t CODE_SEGMENT_SIZE = 1024 * 1024 * 16;
 // We don't want to move above 128MB atm because that means we will have to encode longer jumps
 static constexpr size_t MAX_CODE_SIZE = 1024 * 1024 * 128;
+// Per segment, room for the out of line atomics of a few hundred backpatched sites
+static constexpr size_t CODE_STUB_AREA_SIZE = 64 * 1024;
 
 namespace {
 static uint64_t LUDIV(uint64_t SrcHigh, uint64_t SrcLow, uint64_t Divisor) {
@@ -358,6 +360,62 @@ void Arm64JITCore::Op_Unhandled(IR::IROp_Header *IROp, IR::NodeID Node) {
       }
       break;
 
+      case FABI_I32_I64_I64_I128_I128_I16: {
+        auto Op = IROp->C<IR::IROp_VPCMPSTRX>();
+
+        SpillStaticRegs();
+
+        PushDynamicRegsAndLR();
+
+        // Move the GPR sources first, they may live in registers that the vector arguments use
+        mov(x0, GetReg<RA_64>(Op->RAX.ID()));
+        mov(x1, GetReg<RA_64>(Op->RDX.ID()));
+
+        umov(x2, GetSrc(Op->LHS.ID()).V2D(), 0);
+        umov(x3, GetSrc(Op->LHS.ID()).V2D(), 1);
+
+        umov(x4, GetSrc(Op->RHS.ID()).V2D(), 0);
+        umov(x5, GetSrc(Op->RHS.ID()).V2D(), 1);
+
+        movz(w6, Op->Control);
+
+        ldr(x7, MemOperand(STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.FallbackHandlerPointers[Info.HandlerIndex])));
+        blr(x7);
+
+        PopDynamicRegsAndLR();
+
+        FillStaticRegs();
+
+        mov(GetReg<RA_32>(Node), w0);
+      }
+      break;
+
+      case FABI_I32_I128_I128_I16: {
+        auto Op = IROp->C<IR::IROp_VPCMPSTRX>();
+
+        SpillStaticRegs();
+
+        PushDynamicRegsAndLR();
+
+        umov(x0, GetSrc(Op->LHS.ID()).V2D(), 0);
+        umov(x1, GetSrc(Op->LHS.ID()).V2D(), 1);
+
+        umov(x2, GetSrc(Op->RHS.ID()).V2D(), 0);
+        umov(x3, GetSrc(Op->RHS.ID()).V2D(), 1);
+
+        movz(w4, Op->Control);
+
+        ldr(x5, MemOperand(STATE, offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.FallbackHandlerPointers[Info.HandlerIndex])));
+        blr(x5);
+
+        PopDynamicRegsAndLR();
+
+        FillStaticRegs();
+
+        mov(GetReg<RA_32>(Node), w0);
+      }
+      break;
+
       case FABI_UNKNOWN:
       default:
 #if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
@@ -373,7 +431,7 @@ uint64_t Arm64JITCore::ExitFunctionLink(FEXCore::Core::CpuStateFrame *Frame, uin
   auto Thread = Frame->Thread;
   auto GuestRip = record[1];
 
-  auto HostCode = Thread->LookupCache->FindBlock(GuestRip);
+  auto HostCode = Thread->LookupCache->FindBlock(GuestRip, Thread->CTX->StatsRegion ? Thread->Stats : nullptr);
 
   if (!HostCode) {
     //fmt::print("ExitFunctionLink: Aborting, {:X} not in cache\n", GuestRip);
@@ -381,6 +439,8 @@ uint64_t Arm64JITCore::ExitFunctionLink(FEXCore::Core::CpuStateFrame *Frame, uin
     return Frame->Pointers.Common.DispatcherLoopTop;
   }
 
+  Thread->CPUBackend->MarkCodeReferenced(HostCode);
+
   uintptr_t branch = (uintptr_t)(record) - 8;
   auto LinkerAddress = Frame->Pointers.Common.ExitFunctionLinker;
 
@@ -422,10 +482,12 @@ void Arm64JITCore::Op_NoOp(IR::IROp_Header *IROp, IR::NodeID Node) {
 }
 
 Arm64JITCore::Arm64JITCore(FEXCore::Context::Context *ctx, FEXCore::Core::InternalThreadState *Thread)
-  : CPUBackend(Thread, INITIAL_CODE_SIZE, MAX_CODE_SIZE)
+  : CPUBackend(Thread, CODE_SEGMENT_SIZE, MAX_CODE_SIZE, CODE_STUB_AREA_SIZE)
   , Arm64Emitter(ctx, 0)
   , CTX {ctx} {
 
+  SplitColdCode = ShouldSplitColdCode();
+
   RAPass = Thread->PassManager->GetPass<IR::RegisterAllocationPass>("RA");
 
 #if DEBUG
@@ -514,7 +576,8 @@ void Arm64JITCore::InitializeSignalHandlers(FEXCore::Context::Context *CTX) {
       return false;
     }
 
-    return FEXCore::ArchHelpers::Arm64::HandleSIGBUS(Thread->CTX->Config.ParanoidTSO(), Signal, info, ucontext);
+    FEXCore::Core::IncrementStat(Thread->Stats->MisalignedAtomicFaults);
+    return FEXCore::ArchHelpers::Arm64::HandleSIGBUS(Thread->CTX->Config.ParanoidTSO(), Signal, info, ucontext, Thread->CPUBackend.get());
   }, true);
 }
 
@@ -529,10 +592,48 @@ void Arm64JITCore::ClearCache() {
   // Get the backing code buffer
   
   auto CodeBuffer = GetEmptyCodeBuffer();
-  *GetBuffer() = vixl::CodeBuffer(CodeBuffer->Ptr, CodeBuffer->Size);
+  SetCodeRegion(*CodeBuffer);
+}
+
+void Arm64JITCore::SetCodeRegion(CPUBackend::CodeBuffer const &Region) {
+  *GetBuffer() = vixl::CodeBuffer(Region.Ptr, Region.Size);
+  InColdCode = false;
   EmitDetectionString();
 }
 
+void Arm64JITCore::SwitchToColdCode() {
+  PlaceColdCodeVeneers();
+  HotCodeCursor = GetCursorOffset();
+  GetBuffer()->CursorForward(ColdCodeCursor - HotCodeCursor);
+  InColdCode = true;
+}
+
+void Arm64JITCore::SwitchToHotCode() {
+  PlaceColdCodeVeneers();
+  ColdCodeCursor = GetCursorOffset();
+  GetBuffer()->Rewind(HotCodeCursor);
+  InColdCode = false;
+}
+
+void Arm64JITCore::PlaceColdCodeVeneers() {
+  for (auto &Veneer : ColdCodeVeneers) {
+    bind(&Veneer.Veneer);
+    b(Veneer.Target);
+  }
+  ColdCodeVeneers.clear();
+}
+
+aarch64::Label *Arm64JITCore::GetConditionalBranchTarget(IR::NodeID Block) {
+  auto Target = &JumpTargets.try_emplace(Block).first->second;
+  if (!SplitColdCode || ColdBlocks.contains(Block) == InColdCode) {
+    return Target;
+  }
+
+  auto &Veneer = ColdCodeVeneers.emplace_back();
+  Veneer.Target = Target;
+  return &Veneer.Veneer;
+}
+
 Arm64JITCore::~Arm64JITCore() {
 
 }
@@ -682,8 +783,16 @@ void *Arm64JITCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR::IR
 
   // Fairly excessive buffer range to make sure we don't overflow
   uint32_t BufferRange = SSACount * 16 + GDBEnabled * Dispatcher::MaxGDBPauseCheckSize;
-  if ((GetCursorOffset() + BufferRange) > CurrentCodeBuffer->Size) {
-    CTX->ClearCodeCache(ThreadState);
+  if (!ReserveCodeRegionSpace(GetCursorOffset(), BufferRange)) {
+    CTX->EvictCodeSegment(ThreadState);
+    // An empty region always has room, this only takes its first cold chunk
+    [[maybe_unused]] const bool HasSpace = ReserveCodeRegionSpace(GetCursorOffset(), BufferRange);
+    LOGMAN_THROW_A_FMT(HasSpace, "Block doesn't fit in an empty code region");
+  }
+
+  const size_t ColdCodeStart = ColdCodeCursor;
+  if (SplitColdCode) {
+    FindColdCodeBlocks(IR, &ColdBlocks);
   }
 
   // AAPCS64
@@ -735,9 +844,25 @@ void *Arm64JITCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR::IR
     LOGMAN_THROW_A_FMT(BlockIROp->Header.Op == IR::OP_CODEBLOCK, "IR type failed to be a code block");
 #endif
 
+    const auto Node = IR->GetID(BlockNode);
+    const bool ColdBlock = SplitColdCode && ColdBlocks.contains(Node);
+    if (ColdBlock != InColdCode) {
+      // Can't fall through between the hot and cold parts of the region
+      if (PendingTargetLabel) {
+        b(PendingTargetLabel);
+        PendingTargetLabel = nullptr;
+      }
+
+      if (ColdBlock) {
+        SwitchToColdCode();
+      }
+      else {
+        SwitchToHotCode();
+      }
+    }
+
     auto BlockStartHostCode = GetCursorAddress<uint8_t *>();
     {
-      const auto Node = IR->GetID(BlockNode);
       const auto IsTarget = JumpTargets.try_emplace(Node).first;
 
       // if there's a pending branch, and it is not fall-through
@@ -773,13 +898,25 @@ void *Arm64JITCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR::IR
   }
   PendingTargetLabel = nullptr;
 
+  if (InColdCode) {
+    SwitchToHotCode();
+  }
+  else {
+    PlaceColdCodeVeneers();
+  }
+
   FinalizeCode();
 
   auto CodeEnd = GetCursorAddress<uint8_t *>();
   CPU.EnsureIAndDCacheCoherency(GuestEntry, CodeEnd - GuestEntry);
+  if (ColdCodeCursor != ColdCodeStart) {
+    CPU.EnsureIAndDCacheCoherency(CurrentCodeRegion.Ptr + ColdCodeStart, ColdCodeCursor - ColdCodeStart);
+  }
 
   if (DebugData) {
     DebugData->HostCodeSize = CodeEnd - GuestEntry;
+    DebugData->HostColdCodeOffset = (CurrentCodeRegion.Ptr + ColdCodeStart) - GuestEntry;
+    DebugData->HostColdCodeSize = ColdCodeCursor - ColdCodeStart;
     DebugData->Relocations = &Relocations;
   }
 
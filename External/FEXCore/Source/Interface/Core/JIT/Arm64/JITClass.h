@@ -19,7 +19,9 @@ $end_info$
 
 #include <array>
 #include <cstdint>
+#include <list>
 #include <map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -147,6 +149,38 @@ private:
 
   // This is purely a debugging aid for developers to see if they are in JIT code space when inspecting raw memory
   void EmitDetectionString();
+  void SetCodeRegion(CPUBackend::CodeBuffer const &Region) override;
+
+  /**
+   * @name Cold code
+   * @{ */
+    // Blocks of the current multiblock that get emitted in to the cold part of the code region
+    std::unordered_set<IR::NodeID> ColdBlocks;
+    bool InColdCode{};
+    size_t HotCodeCursor{};
+
+    /**
+     * @brief Conditional branch between the hot and cold parts of the region
+     *
+     * Conditional branches only reach +-1MB, so they branch to an unconditional branch
+     * placed after the code of the part they are in instead.
+     */
+    struct ColdCodeVeneer {
+      aarch64::Label Veneer;
+      aarch64::Label *Target;
+    };
+    // List so that labels don't move while branches are linked to them
+    std::list<ColdCodeVeneer> ColdCodeVeneers;
+
+    void SwitchToColdCode();
+    void SwitchToHotCode();
+    void PlaceColdCodeVeneers();
+
+    /**
+     * @brief Gets the label for a conditional branch to a block, going through a veneer if the block is in the other part
+     */
+    aarch64::Label *GetConditionalBranchTarget(IR::NodeID Block);
+  /**  @} */
   IR::RegisterAllocationPass *RAPass;
   IR::RegisterAllocationData *RAData;
   FEXCore::Core::DebugData *DebugData;
@@ -372,7 +406,6 @@ private:
   DEF_OP(VectorZero);
   DEF_OP(VectorImm);
   DEF_OP(SplatVector2);
-  DEF_OP(SplatVector4);
   DEF_OP(VMov);
   DEF_OP(VAnd);
   DEF_OP(VBic);
@@ -469,6 +502,7 @@ private:
   DEF_OP(AESKeyGenAssist);
   DEF_OP(CRC32);
   DEF_OP(PCLMUL);
+  DEF_OP(VSHA);
 #undef DEF_OP
 };
 
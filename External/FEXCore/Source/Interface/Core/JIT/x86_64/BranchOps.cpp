@@ -45,6 +45,9 @@ DEF_OP(CallbackReturn) {
     add(rsp, SpillSlots * 16); // + 8 to consume return address
   }
 
+  // Guest state needs to be in the context once we are back in the thunk
+  SpillStaticRegs();
+
   // Make sure to adjust the refcounter so we don't clear the cache now
   sub(qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, SignalHandlerRefCounter)], 1);
 
@@ -86,11 +89,14 @@ DEF_OP(ExitFunction) {
     
     jmp(qword[rsi]);
 
-    L(l_BranchHost);
-    //FEX_TODO(this is not per thread)
-    dq(ThreadState->CurrentFrame->Pointers.Common.ExitFunctionLinker);
-    L(l_BranchGuest);
-    dq(NewRIP);
+    // The record is data that gets rewritten on linking, keep it off the hot code's cache lines
+    EmitColdCode([&] {
+      L(l_BranchHost);
+      //FEX_TODO(this is not per thread)
+      dq(ThreadState->CurrentFrame->Pointers.Common.ExitFunctionLinker);
+      L(l_BranchGuest);
+      dq(NewRIP);
+    });
   } else {
     Xbyak::Reg RipReg = GetSrc<RA_64>(Op->NewRIP.ID());
 
@@ -105,12 +111,14 @@ DEF_OP(ExitFunction) {
     Xbyak::RegExp LookupBase = rcx + rax;
 
     cmp(qword[LookupBase + 8], RipReg);
-    jne(FullLookup);
+    jne(FullLookup, T_NEAR);
     jmp(qword[LookupBase + 0]);
 
-    L(FullLookup);
-    mov(qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, State.rip)], RipReg);
-    jmp(qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.DispatcherLoopTop)]);
+    EmitColdCode([&] {
+      L(FullLookup);
+      mov(qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, State.rip)], RipReg);
+      jmp(qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.DispatcherLoopTop)]);
+    });
   }
 
 #ifdef BLOCKSTATS
@@ -158,6 +166,9 @@ DEF_OP(Syscall) {
   auto Op = IROp->C<IR::IROp_Syscall>();
   // XXX: This is very terrible, but I don't care for right now
 
+  // The syscall handler works on the guest state in the context
+  SpillStaticRegs();
+
   auto NumPush = RA64.size();
 
   for (auto &Reg : RA64)
@@ -198,12 +209,75 @@ DEF_OP(Syscall) {
   for (uint32_t i = RA64.size(); i > 0; --i)
     pop(RA64[i - 1]);
 
+  // Fill after the pops, the static registers are in RA64 and the syscall may have changed guest state
+  FillStaticRegs();
+
   mov (GetDst<RA_64>(Node), rax);
 }
 
+DEF_OP(InlineSyscall) {
+  auto Op = IROp->C<IR::IROp_InlineSyscall>();
+  // Host syscall ABI for x86-64
+  // RAX: SyscallNumber & Return
+  // RDI, RSI, RDX, R10, R8, R9: Args
+  // RCX, R11: Clobbered by the syscall instruction
+  //
+  // Static registers and XMMs are untouched by the kernel so nothing needs to be spilled
+  // Only save the RA registers that the ABI is going to stomp on
+  const static std::array<Xbyak::Reg, 5> ClobberedRegs = {{
+    rsi, r8, r9, r10, r11
+  }};
+
+  // One argument is removed from the SyscallArguments::MAX_ARGS since the first argument was syscall number
+  const static std::array<Xbyak::Reg, FEXCore::HLE::SyscallArguments::MAX_ARGS-1> RegArgs = {{
+    rdi, rsi, rdx, r10, r8, r9
+  }};
+
+  for (auto &Reg : ClobberedRegs)
+    push(Reg);
+
+  // Sources can overlap the argument registers, go through the stack so the order doesn't matter
+  uint32_t NumArgs{};
+  for (uint32_t i = 0; i < FEXCore::HLE::SyscallArguments::MAX_ARGS-1; ++i) {
+    if (Op->Header.Args[i].IsInvalid()) break;
+    push(GetSrc<RA_64>(Op->Header.Args[i].ID()));
+    ++NumArgs;
+  }
+
+  const bool Is64BitMode = CTX->Config.Is64BitMode();
+  for (uint32_t i = NumArgs; i > 0; --i) {
+    auto Reg = RegArgs[i - 1];
+    pop(Reg);
+    if (!Is64BitMode) {
+      // 32-bit guests only pass the lower half
+      mov(Reg.cvt32(), Reg.cvt32());
+    }
+  }
+
+  mov(eax, Op->HostSyscallNumber);
+  syscall();
+  // On updated signal mask we can receive a signal RIGHT HERE
+
+  for (uint32_t i = ClobberedRegs.size(); i > 0; --i)
+    pop(ClobberedRegs[i - 1]);
+
+  if ((Op->Flags & FEXCore::IR::SyscallFlags::NORETURN) != FEXCore::IR::SyscallFlags::NORETURN) {
+    // Result is now in rax
+    // Move result to its destination register
+    if (Is64BitMode) {
+      mov(GetDst<RA_64>(Node), rax);
+    }
+    else {
+      mov(GetDst<RA_32>(Node), eax);
+    }
+  }
+}
+
 DEF_OP(Thunk) {
   auto Op = IROp->C<IR::IROp_Thunk>();
 
+  SpillStaticRegs();
+
   auto NumPush = RA64.size();
 
   for (auto &Reg : RA64)
@@ -214,6 +288,11 @@ DEF_OP(Thunk) {
 
   mov(rdi, GetSrc<RA_64>(Op->Header.Args[0].ID()));
 
+  if (CTX->StatsRegion) {
+    mov(rax, qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, Stats)]);
+    inc(qword [rax + offsetof(FEXCore::Core::RuntimeStats, ThunkCalls)]);
+  }
+
   auto thunkFn = ThreadState->CTX->ThunkHandler->LookupThunk(Op->ThunkNameHash);
 
   mov(rax, reinterpret_cast<uintptr_t>(thunkFn));
@@ -224,6 +303,8 @@ DEF_OP(Thunk) {
 
   for (uint32_t i = RA64.size(); i > 0; --i)
     pop(RA64[i - 1]);
+
+  FillStaticRegs();
 }
 
 DEF_OP(ValidateCode) {
@@ -257,6 +338,8 @@ DEF_OP(ValidateCode) {
 }
 
 DEF_OP(RemoveThreadCodeEntry) {
+  SpillStaticRegs();
+
   auto NumPush = RA64.size();
 
   for (auto &Reg : RA64)
@@ -276,11 +359,15 @@ DEF_OP(RemoveThreadCodeEntry) {
 
   for (uint32_t i = RA64.size(); i > 0; --i)
     pop(RA64[i - 1]);
+
+  FillStaticRegs();
 }
 
 DEF_OP(CPUID) {
   auto Op = IROp->C<IR::IROp_CPUID>();
 
+  SpillStaticRegs();
+
   for (auto &Reg : RA64)
     push(Reg);
 
@@ -309,6 +396,8 @@ DEF_OP(CPUID) {
   for (uint32_t i = RA64.size(); i > 0; --i)
     pop(RA64[i - 1]);
 
+  FillStaticRegs();
+
   auto Dst = GetSrcPair<RA_64>(Node);
   mov(Dst.first, rax);
   mov(Dst.second, rdx);
@@ -323,6 +412,7 @@ void X86JITCore::RegisterBranchHandlers() {
   REGISTER_OP(JUMP,              Jump);
   REGISTER_OP(CONDJUMP,          CondJump);
   REGISTER_OP(SYSCALL,           Syscall);
+  REGISTER_OP(INLINESYSCALL,     InlineSyscall);
   REGISTER_OP(THUNK,             Thunk);
   REGISTER_OP(VALIDATECODE,      ValidateCode);
   REGISTER_OP(REMOVETHREADCODEENTRY,   RemoveThreadCodeEntry);
@@ -95,6 +95,87 @@ DEF_OP(PCLMUL) {
   }
 }
 
+DEF_OP(VSHA) {
+  auto Op = IROp->C<IR::IROp_VSHA>();
+
+  // SHA-NI is destructive on the first source
+  movapd(xmm15, GetSrc(Op->Src1.ID()));
+  auto Src2 = GetSrc(Op->Src2.ID());
+
+  if ((Op->Operation & ~0b11) == IR::SHA_OP_SHA1RNDS4) {
+    sha1rnds4(xmm15, Src2, Op->Operation & 0b11);
+  }
+  else {
+    switch (Op->Operation) {
+      case IR::SHA_OP_SHA1NEXTE:   sha1nexte(xmm15, Src2); break;
+      case IR::SHA_OP_SHA1MSG1:    sha1msg1(xmm15, Src2); break;
+      case IR::SHA_OP_SHA1MSG2:    sha1msg2(xmm15, Src2); break;
+      case IR::SHA_OP_SHA256MSG1:  sha256msg1(xmm15, Src2); break;
+      case IR::SHA_OP_SHA256MSG2:  sha256msg2(xmm15, Src2); break;
+      case IR::SHA_OP_SHA256RNDS2:
+        // xmm0 is the implicit operand and is never allocated
+        movapd(xmm0, GetSrc(Op->Src3.ID()));
+        sha256rnds2(xmm15, Src2);
+        break;
+      default:
+        LOGMAN_MSG_A_FMT("Unknown SHA operation: {}", Op->Operation);
+        break;
+    }
+  }
+
+  movapd(GetDst(Node), xmm15);
+}
+
+DEF_OP(VPCMPSTRX) {
+  auto Op = IROp->C<IR::IROp_VPCMPSTRX>();
+
+  if (!Features.has(Xbyak::util::Cpu::tSSE42)) {
+    // Same interpreter fallback that the Arm64 backend always uses
+    Op_Unhandled(IROp, Node);
+    return;
+  }
+
+  auto LHS = GetSrc(Op->LHS.ID());
+  auto RHS = GetSrc(Op->RHS.ID());
+
+  // Always generate the bit mask form, IR result only wants IntRes2 and the ZF/SF bits.
+  const uint8_t Control = Op->Control & 0b11'11'11;
+
+  if (Op->ImplicitLength) {
+    pcmpistrm(LHS, RHS, Control);
+  }
+  else {
+    // The IR sources are 64-bit signed lengths.
+    // Clamp them to [-16, 16] so the 32-bit form of the instruction gives the same result.
+    const auto Clamp = [this](Xbyak::Reg64 const &Dst, Xbyak::Reg const &Src) {
+      mov(Dst, Src.cvt64());
+      mov(rcx, 16);
+      cmp(Dst, rcx);
+      cmovg(Dst, rcx);
+      neg(rcx);
+      cmp(Dst, rcx);
+      cmovl(Dst, rcx);
+    };
+    Clamp(rax, GetSrc<RA_64>(Op->RAX.ID()));
+    Clamp(rdx, GetSrc<RA_64>(Op->RDX.ID()));
+
+    pcmpestrm(LHS, RHS, Control);
+  }
+
+  // ZF = RHS contains an invalid element, SF = LHS contains an invalid element
+  setz(cl);
+  sets(dl);
+  movd(eax, xmm0);
+  movzx(eax, ax);
+  movzx(ecx, cl);
+  shl(ecx, 16);
+  or_(eax, ecx);
+  movzx(edx, dl);
+  shl(edx, 17);
+  or_(eax, edx);
+  mov(GetDst<RA_32>(Node), eax);
+}
+
 #undef DEF_OP
 void X86JITCore::RegisterEncryptionHandlers() {
 #define REGISTER_OP(op, x) OpHandlers[FEXCore::IR::IROps::OP_##op] = &X86JITCore::Op_##x
@@ -106,6 +187,8 @@ void X86JITCore::RegisterEncryptionHandlers() {
   REGISTER_OP(VAESKEYGENASSIST,  AESKeyGenAssist);
   REGISTER_OP(CRC32,             CRC32);
   REGISTER_OP(PCLMUL,            PCLMUL);
+  REGISTER_OP(VSHA,              VSHA);
+  REGISTER_OP(VPCMPSTRX,         VPCMPSTRX);
 #undef REGISTER_OP
 }
 }
@@ -43,7 +43,7 @@ $end_info$
 // #define DEBUG_RA 1
 // #define DEBUG_CYCLES
 
-static constexpr size_t INITIAL_CODE_SIZE = 1024 * 1024 * 16;
+static constexpr size_t CODE_SEGMENT_SIZE = 1024 * 1024 * 16;
 static constexpr size_t MAX_CODE_SIZE = 1024 * 1024 * 256;
 
 namespace {
@@ -59,6 +59,8 @@ static void PrintVectorValue(uint64_t Value, uint64_t ValueUpper) {
 namespace FEXCore::CPU {
 
 void X86JITCore::PushRegs() {
+  SpillStaticRegs();
+
   sub(rsp, 16 * RAXMM_x.size());
   for (size_t i = 0; i < RAXMM_x.size(); ++i) {
     movaps(ptr[rsp + i * 16], RAXMM_x[i]);
@@ -85,6 +87,36 @@ void X86JITCore::PopRegs() {
   }
 
   add(rsp, 16 * RAXMM_x.size());
+
+  FillStaticRegs();
+}
+
+void X86JITCore::SpillStaticRegs() {
+  if (!SRAEnabled) {
+    return;
+  }
+
+  for (size_t i = 0; i < SRA64.size(); ++i) {
+    mov(qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, State.gregs[i])], SRA64[i].cvt64());
+  }
+
+  for (size_t i = 0; i < SRAXMM_x.size(); ++i) {
+    movaps(xword [STATE + offsetof(FEXCore::Core::CpuStateFrame, State.xmm[i][0])], SRAXMM_x[i]);
+  }
+}
+
+void X86JITCore::FillStaticRegs() {
+  if (!SRAEnabled) {
+    return;
+  }
+
+  for (size_t i = 0; i < SRA64.size(); ++i) {
+    mov(SRA64[i].cvt64(), qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, State.gregs[i])]);
+  }
+
+  for (size_t i = 0; i < SRAXMM_x.size(); ++i) {
+    movaps(SRAXMM_x[i], xword [STATE + offsetof(FEXCore::Core::CpuStateFrame, State.xmm[i][0])]);
+  }
 }
 
 void X86JITCore::Op_Unhandled(IR::IROp_Header *IROp, IR::NodeID Node) {
@@ -290,6 +322,56 @@ void X86JITCore::Op_Unhandled(IR::IROp_Header *IROp, IR::NodeID Node) {
       }
       break;
 
+      case FABI_I32_I64_I64_I128_I128_I16: {
+        auto Op = IROp->C<IR::IROp_VPCMPSTRX>();
+
+        PushRegs();
+
+        // The GPR sources can live in argument registers, go through the stack so the vector moves can't clobber them
+        push(GetSrc<RA_64>(Op->RAX.ID()));
+        push(GetSrc<RA_64>(Op->RDX.ID()));
+
+        movq(rdx, GetSrc(Op->LHS.ID()));
+        pextrq(rcx, GetSrc(Op->LHS.ID()), 1);
+
+        movq(r8, GetSrc(Op->RHS.ID()));
+        pextrq(r9, GetSrc(Op->RHS.ID()), 1);
+
+        pop(rsi);
+        pop(rdi);
+
+        // Control is the seventh argument and goes on the stack, padded to keep the stack aligned
+        sub(rsp, 8);
+        push(Op->Control);
+        call(qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.FallbackHandlerPointers[Info.HandlerIndex])]);
+        add(rsp, 16);
+
+        PopRegs();
+
+        mov(GetDst<RA_32>(Node), eax);
+      }
+      break;
+
+      case FABI_I32_I128_I128_I16: {
+        auto Op = IROp->C<IR::IROp_VPCMPSTRX>();
+
+        PushRegs();
+
+        movq(rdi, GetSrc(Op->LHS.ID()));
+        pextrq(rsi, GetSrc(Op->LHS.ID()), 1);
+
+        movq(rdx, GetSrc(Op->RHS.ID()));
+        pextrq(rcx, GetSrc(Op->RHS.ID()), 1);
+
+        mov(r8d, Op->Control);
+        call(qword [STATE + offsetof(FEXCore::Core::CpuStateFrame, Pointers.Common.FallbackHandlerPointers[Info.HandlerIndex])]);
+
+        PopRegs();
+
+        mov(GetDst<RA_32>(Node), eax);
+      }
+      break;
+
       case FABI_UNKNOWN:
       default:
 #if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
@@ -304,13 +386,15 @@ uint64_t X86JITCore::ExitFunctionLink(FEXCore::Core::CpuStateFrame *Frame, uint6
   auto Thread = Frame->Thread;
   auto GuestRip = record[1];
 
-  auto HostCode = Thread->LookupCache->FindBlock(GuestRip);
+  auto HostCode = Thread->LookupCache->FindBlock(GuestRip, Thread->CTX->StatsRegion ? Thread->Stats : nullptr);
 
   if (!HostCode) {
     Thread->CurrentFrame->State.rip = GuestRip;
     return Frame->Pointers.Common.DispatcherLoopTop;
   }
 
+  Thread->CPUBackend->MarkCodeReferenced(HostCode);
+
   auto LinkerAddress = Frame->Pointers.Common.ExitFunctionLinker;
   Thread->LookupCache->AddBlockLink(GuestRip, (uintptr_t)record, [record, LinkerAddress]{
     // undo the link
@@ -325,18 +409,32 @@ void X86JITCore::Op_NoOp(IR::IROp_Header *IROp, IR::NodeID Node) {
 }
 
 X86JITCore::X86JITCore(FEXCore::Context::Context *ctx, FEXCore::Core::InternalThreadState *Thread)
-  : CPUBackend(Thread, INITIAL_CODE_SIZE, MAX_CODE_SIZE)
+  : CPUBackend(Thread, CODE_SEGMENT_SIZE, MAX_CODE_SIZE)
   , CodeGenerator(0, this, nullptr) // this is not used here
   , CTX {ctx} {
 
+  SplitColdCode = ShouldSplitColdCode();
+
   RAPass = Thread->PassManager->GetPass<IR::RegisterAllocationPass>("RA");
 
+  SRAEnabled = CTX->DispatcherConfig.StaticRegisterAllocation;
+
+  // The static registers are taken off the end of the dynamic sets, along with any pair that uses one
+  const uint32_t DynamicGPRs = SRAEnabled ? NumGPRs - NumStaticGPRs : NumGPRs;
+  const uint32_t DynamicXMMs = SRAEnabled ? NumXMMs - NumStaticXMMs : NumXMMs;
+  const uint32_t DynamicGPRPairs = std::min(NumGPRPairs, DynamicGPRs / 2);
+
   RAPass->AllocateRegisterSet(RegisterCount, RegisterClasses);
-  RAPass->AddRegisters(FEXCore::IR::GPRClass, NumGPRs);
-  RAPass->AddRegisters(FEXCore::IR::FPRClass, NumXMMs);
-  RAPass->AddRegisters(FEXCore::IR::GPRPairClass, NumGPRPairs);
+  RAPass->AddRegisters(FEXCore::IR::GPRClass, DynamicGPRs);
+  RAPass->AddRegisters(FEXCore::IR::FPRClass, DynamicXMMs);
+  RAPass->AddRegisters(FEXCore::IR::GPRPairClass, DynamicGPRPairs);
 
-  for (uint32_t i = 0; i < NumGPRPairs; ++i) {
+  if (SRAEnabled) {
+    RAPass->AddRegisters(FEXCore::IR::GPRFixedClass, NumStaticGPRs);
+    RAPass->AddRegisters(FEXCore::IR::FPRFixedClass, NumStaticXMMs);
+  }
+
+  for (uint32_t i = 0; i < DynamicGPRPairs; ++i) {
     RAPass->AddRegisterConflict(FEXCore::IR::GPRClass, i * 2,     FEXCore::IR::GPRPairClass, i);
     RAPass->AddRegisterConflict(FEXCore::IR::GPRClass, i * 2 + 1, FEXCore::IR::GPRPairClass, i);
   }
@@ -400,10 +498,27 @@ void X86JITCore::EmitDetectionString() {
 
 void X86JITCore::ClearCache() {
   auto CodeBuffer = GetEmptyCodeBuffer();
-  setNewBuffer(CodeBuffer->Ptr, CodeBuffer->Size);
+  SetCodeRegion(*CodeBuffer);
+}
+
+void X86JITCore::SetCodeRegion(CPUBackend::CodeBuffer const &Region) {
+  setNewBuffer(Region.Ptr, Region.Size);
+  InColdCode = false;
   EmitDetectionString();
 }
 
+void X86JITCore::SwitchToColdCode() {
+  HotCodeCursor = getSize();
+  setSize(ColdCodeCursor);
+  InColdCode = true;
+}
+
+void X86JITCore::SwitchToHotCode() {
+  ColdCodeCursor = getSize();
+  setSize(HotCodeCursor);
+  InColdCode = false;
+}
+
 IR::PhysicalRegister X86JITCore::GetPhys(IR::NodeID Node) const {
   auto PhyReg = RAData->GetNodeRegister(Node);
 
@@ -413,11 +528,13 @@ IR::PhysicalRegister X86JITCore::GetPhys(IR::NodeID Node) const {
 }
 
 bool X86JITCore::IsFPR(IR::NodeID Node) const {
-  return RAData->GetNodeRegister(Node).Class == IR::FPRClass.Val;
+  const auto Class = RAData->GetNodeRegister(Node).Class;
+  return Class == IR::FPRClass.Val || Class == IR::FPRFixedClass.Val;
 }
 
 bool X86JITCore::IsGPR(IR::NodeID Node) const {
-  return RAData->GetNodeRegister(Node).Class == IR::GPRClass.Val;
+  const auto Class = RAData->GetNodeRegister(Node).Class;
+  return Class == IR::GPRClass.Val || Class == IR::GPRFixedClass.Val;
 }
 
 template<uint8_t RAType>
@@ -427,6 +544,21 @@ Xbyak::Reg X86JITCore::GetSrc(IR::NodeID Node) const {
   // Callee Saved
   // rbx, rbp, r12, r13, r14, r15
   auto PhyReg = GetPhys(Node);
+  if (PhyReg.Class == IR::GPRFixedClass.Val) {
+    const auto &Reg = SRA64[PhyReg.Reg];
+    if constexpr (RAType == RA_64)
+      return Reg.cvt64();
+    else if constexpr (RAType == RA_32)
+      return Reg.cvt32();
+    else if constexpr (RAType == RA_16)
+      return Reg.cvt16();
+    else if constexpr (RAType == RA_8)
+      return Reg.cvt8();
+  }
+  else if (PhyReg.Class == IR::FPRFixedClass.Val) {
+    return SRAXMM_x[PhyReg.Reg];
+  }
+
   if constexpr (RAType == RA_64)
     return RA64[PhyReg.Reg].cvt64();
   else if constexpr (RAType == RA_XMM)
@@ -453,12 +585,30 @@ Xbyak::Reg X86JITCore::GetSrc<X86JITCore::RA_8>(IR::NodeID Node) const;
 
 Xbyak::Xmm X86JITCore::GetSrc(IR::NodeID Node) const {
   auto PhyReg = GetPhys(Node);
+  if (PhyReg.Class == IR::FPRFixedClass.Val) {
+    return SRAXMM_x[PhyReg.Reg];
+  }
   return RAXMM_x[PhyReg.Reg];
 }
 
 template<uint8_t RAType>
 Xbyak::Reg X86JITCore::GetDst(IR::NodeID Node) const {
   auto PhyReg = GetPhys(Node);
+  if (PhyReg.Class == IR::GPRFixedClass.Val) {
+    const auto &Reg = SRA64[PhyReg.Reg];
+    if constexpr (RAType == RA_64)
+      return Reg.cvt64();
+    else if constexpr (RAType == RA_32)
+      return Reg.cvt32();
+    else if constexpr (RAType == RA_16)
+      return Reg.cvt16();
+    else if constexpr (RAType == RA_8)
+      return Reg.cvt8();
+  }
+  else if (PhyReg.Class == IR::FPRFixedClass.Val) {
+    return SRAXMM_x[PhyReg.Reg];
+  }
+
   if constexpr (RAType == RA_64)
     return RA64[PhyReg.Reg].cvt64();
   else if constexpr (RAType == RA_XMM)
@@ -500,6 +650,9 @@ std::pair<Xbyak::Reg, Xbyak::Reg> X86JITCore::GetSrcPair<X86JITCore::RA_32>(IR::
 
 Xbyak::Xmm X86JITCore::GetDst(IR::NodeID Node) const {
   auto PhyReg = GetPhys(Node);
+  if (PhyReg.Class == IR::FPRFixedClass.Val) {
+    return SRAXMM_x[PhyReg.Reg];
+  }
   return RAXMM_x[PhyReg.Reg];
 }
 
@@ -579,8 +732,17 @@ void *X86JITCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR::IRLi
 
   // Fairly excessive buffer range to make sure we don't overflow
   uint32_t BufferRange = SSACount * 16 + GDBEnabled * Dispatcher::MaxGDBPauseCheckSize;
-  if ((getSize() + BufferRange) > CurrentCodeBuffer->Size) {
-    CTX->ClearCodeCache(ThreadState);
+  if (!ReserveCodeRegionSpace(getSize(), BufferRange)) {
+    CTX->EvictCodeSegment(ThreadState);
+    // An empty region always has room, this only takes its first cold chunk
+    [[maybe_unused]] const bool HasSpace = ReserveCodeRegionSpace(getSize(), BufferRange);
+    LOGMAN_THROW_A_FMT(HasSpace, "Block doesn't fit in an empty code region");
+  }
+
+  const size_t ColdCodeStart = ColdCodeCursor;
+
+  if (SplitColdCode) {
+    FindColdCodeBlocks(IR, &ColdBlocks);
   }
 
 	GuestEntry = getCurr<uint8_t*>();
@@ -652,9 +814,25 @@ void *X86JITCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR::IRLi
     LOGMAN_THROW_A_FMT(BlockIROp->Header.Op == IR::OP_CODEBLOCK, "IR type failed to be a code block");
 #endif
 
+    const auto Node = IR->GetID(BlockNode);
+    const bool ColdBlock = SplitColdCode && ColdBlocks.contains(Node);
+    if (ColdBlock != InColdCode) {
+      // Can't fall through between the hot and cold parts of the region
+      if (PendingTargetLabel) {
+        jmp(*PendingTargetLabel, T_NEAR);
+        PendingTargetLabel = nullptr;
+      }
+
+      if (ColdBlock) {
+        SwitchToColdCode();
+      }
+      else {
+        SwitchToHotCode();
+      }
+    }
+
     auto BlockStartHostCode = getCurr<uint8_t *>();
     {
-      const auto Node = IR->GetID(BlockNode);
       const auto IsTarget = JumpTargets.try_emplace(Node).first;
 
       // if there is a pending branch, and it is not fall-through
@@ -724,6 +902,10 @@ void *X86JITCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR::IRLi
   }
   PendingTargetLabel = nullptr;
 
+  if (InColdCode) {
+    SwitchToHotCode();
+  }
+
   void *GuestExit = getCurr<void*>();
   this->IR = nullptr;
 
@@ -731,6 +913,8 @@ void *X86JITCore::CompileCode(uint64_t Entry, [[maybe_unused]] FEXCore::IR::IRLi
 
   if (DebugData) {
     DebugData->HostCodeSize = reinterpret_cast<uintptr_t>(GuestExit) - reinterpret_cast<uintptr_t>(GuestEntry);
+    DebugData->HostColdCodeOffset = ColdCodeStart - CursorEntry;
+    DebugData->HostColdCodeSize = ColdCodeCursor - ColdCodeStart;
     DebugData->Relocations = &Relocations;
   }
 
@@ -742,7 +926,11 @@ std::unique_ptr<CPUBackend> CreateX86JITCore(FEXCore::Context::Context *ctx, FEX
 }
 
 CPUBackendFeatures GetX86JITBackendFeatures() {
-  return CPUBackendFeatures { };
+  return CPUBackendFeatures {
+    .SupportsStaticRegisterAllocation = true,
+    .NumStaticGPRs = X86JITCore::NumStaticGPRs,
+    .NumStaticFPRs = X86JITCore::NumStaticXMMs,
+  };
 }
 
 void InitializeX86JITSignalHandlers(FEXCore::Context::Context *CTX) {
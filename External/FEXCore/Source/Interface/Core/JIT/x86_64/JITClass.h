@@ -24,6 +24,7 @@ using namespace Xbyak;
 #include "Interface/IR/Passes/RegisterAllocationPass.h"
 
 #include <tuple>
+#include <unordered_set>
 
 namespace FEXCore::CPU {
 
@@ -49,6 +50,14 @@ const std::array<std::pair<Xbyak::Reg, Xbyak::Reg>, 4> RA64Pair = {{ {rsi, r8},
 const std::array<Xbyak::Reg, 11> RAXMM = { xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7, xmm8, xmm9, xmm10, xmm11};
 const std::array<Xbyak::Xmm, 11> RAXMM_x = {  xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7, xmm8, xmm9, xmm10, xmm11};
 
+// Static register allocation
+// Guest RAX, RBX, RCX, RDX and XMM0-3 live in these while in JIT code
+// These are the tail of RA64 and RAXMM, which the RA doesn't hand out while SRA is enabled
+// GPRs are all callee saved so they survive calls in to C++ without a spill
+// The dispatcher's spill and fill sequences need to match
+const std::array<Xbyak::Reg, 4> SRA64 = { rbp, r12, r13, r15 };
+const std::array<Xbyak::Xmm, 4> SRAXMM_x = { xmm8, xmm9, xmm10, xmm11 };
+
 class X86JITCore final : public CPUBackend, public Xbyak::CodeGenerator {
 public:
   explicit X86JITCore(FEXCore::Context::Context *ctx,
@@ -152,13 +161,16 @@ private:
   constexpr static uint32_t NumGPRs = RA64.size(); // 4 is the minimum required for GPR ops
   constexpr static uint32_t NumXMMs = RAXMM.size();
   constexpr static uint32_t NumGPRPairs = RA64Pair.size();
-  constexpr static uint32_t RegisterCount = NumGPRs + NumXMMs + NumGPRPairs;
+  constexpr static uint32_t NumStaticGPRs = SRA64.size();
+  constexpr static uint32_t NumStaticXMMs = SRAXMM_x.size();
+  constexpr static uint32_t RegisterCount = NumGPRs + NumXMMs + NumGPRPairs + NumStaticGPRs + NumStaticXMMs;
   constexpr static uint32_t RegisterClasses = 6;
 
   constexpr static uint64_t GPRBase = (0ULL << 32);
   constexpr static uint64_t XMMBase = (1ULL << 32);
   constexpr static uint64_t GPRPairBase = (2ULL << 32);
 
+  bool SRAEnabled{};
   /**  @} */
 
   constexpr static uint8_t RA_8 = 0;
@@ -199,6 +211,36 @@ private:
 
   // This is purely a debugging aid for developers to see if they are in JIT code space when inspecting raw memory
   void EmitDetectionString();
+  void SetCodeRegion(CPUBackend::CodeBuffer const &Region) override;
+
+  /**
+   * @name Cold code
+   * @{ */
+    // Blocks of the current multiblock that get emitted in to the cold part of the code region
+    std::unordered_set<IR::NodeID> ColdBlocks;
+    bool InColdCode{};
+    size_t HotCodeCursor{};
+
+    void SwitchToColdCode();
+    void SwitchToHotCode();
+
+    /**
+     * @brief Emits code that only runs on an unlikely path in to the cold part of the code region
+     *
+     * Branches in to it need to be T_NEAR. Emitted in place when code isn't being split.
+     */
+    template<typename F>
+    void EmitColdCode(F &&Func) {
+      if (!SplitColdCode || InColdCode) {
+        Func();
+        return;
+      }
+
+      SwitchToColdCode();
+      Func();
+      SwitchToHotCode();
+    }
+  /**  @} */
 
   uint32_t SpillSlots{};
   /**
@@ -227,6 +269,15 @@ private:
 
   void PushRegs();
   void PopRegs();
+
+  /**
+   * @brief Moves the statically allocated guest registers between their host registers and the context
+   *
+   * Needed around anything that reads or writes guest state from outside of JIT code,
+   * and around calls in to C++ since the static XMMs are caller saved. No-ops without SRA.
+   */
+  void SpillStaticRegs();
+  void FillStaticRegs();
 #define DEF_OP(x) void Op_##x(IR::IROp_Header *IROp, IR::NodeID Node)
 
   ///< Unhandled handler
@@ -310,6 +361,7 @@ private:
   DEF_OP(Jump);
   DEF_OP(CondJump);
   DEF_OP(Syscall);
+  DEF_OP(InlineSyscall);
   DEF_OP(Thunk);
   DEF_OP(ValidateCode);
   DEF_OP(RemoveThreadCodeEntry);
@@ -333,6 +385,8 @@ private:
   ///< Memory ops
   DEF_OP(LoadContext);
   DEF_OP(StoreContext);
+  DEF_OP(LoadRegister);
+  DEF_OP(StoreRegister);
   DEF_OP(LoadContextIndexed);
   DEF_OP(StoreContextIndexed);
   DEF_OP(SpillRegister);
@@ -464,6 +518,8 @@ private:
   DEF_OP(AESKeyGenAssist);
   DEF_OP(CRC32);
   DEF_OP(PCLMUL);
+  DEF_OP(VSHA);
+  DEF_OP(VPCMPSTRX);
 #undef DEF_OP
 };
 
@@ -141,6 +141,199 @@ DEF_OP(StoreContext) {
   }
 }
 
+DEF_OP(LoadRegister) {
+  auto Op = IROp->C<IR::IROp_LoadRegister>();
+
+  if (Op->Class == IR::GPRClass) {
+    auto regId = (Op->Offset - offsetof(Core::CpuStateFrame, State.gregs[0])) / Core::CPUState::GPR_REG_SIZE;
+    auto regOffs = Op->Offset & 7;
+
+    LOGMAN_THROW_A_FMT(regId < SRA64.size(), "out of range regId");
+
+    auto reg = SRA64[regId];
+    auto Dst = GetDst<RA_64>(Node);
+
+    switch (Op->Header.Size) {
+      case 1:
+        LOGMAN_THROW_A_FMT(regOffs == 0 || regOffs == 1, "unexpected regOffs");
+        if (regOffs == 0) {
+          movzx(Dst.cvt32(), reg.cvt8());
+        }
+        else {
+          // High byte registers can't be encoded alongside REX registers
+          mov(Dst.cvt32(), reg.cvt32());
+          shr(Dst.cvt32(), 8);
+          movzx(Dst.cvt32(), Dst.cvt8());
+        }
+        break;
+
+      case 2:
+        LOGMAN_THROW_A_FMT(regOffs == 0, "unexpected regOffs");
+        movzx(Dst.cvt32(), reg.cvt16());
+        break;
+
+      case 4:
+        LOGMAN_THROW_A_FMT(regOffs == 0, "unexpected regOffs");
+        if (Dst.getIdx() != reg.getIdx())
+          mov(Dst.cvt32(), reg.cvt32());
+        break;
+
+      case 8:
+        LOGMAN_THROW_A_FMT(regOffs == 0, "unexpected regOffs");
+        if (Dst.getIdx() != reg.getIdx())
+          mov(Dst, reg.cvt64());
+        break;
+
+      default: LOGMAN_MSG_A_FMT("Unhandled LoadRegister size: {}", Op->Header.Size);
+    }
+  } else if (Op->Class == IR::FPRClass) {
+    auto regId = (Op->Offset - offsetof(Core::CpuStateFrame, State.xmm[0][0])) / Core::CPUState::XMM_REG_SIZE;
+    auto regOffs = Op->Offset & 15;
+
+    LOGMAN_THROW_A_FMT(regId < SRAXMM_x.size(), "out of range regId");
+
+    auto guest = SRAXMM_x[regId];
+    auto host = GetDst(Node);
+
+    // Matches LoadContext, everything above the loaded element is zero
+    switch (Op->Header.Size) {
+      case 1:
+        pextrb(eax, guest, regOffs);
+        vmovd(host, eax);
+        break;
+
+      case 2:
+        LOGMAN_THROW_A_FMT((regOffs & 1) == 0, "unexpected regOffs");
+        pextrw(eax, guest, regOffs / 2);
+        vmovd(host, eax);
+        break;
+
+      case 4:
+        LOGMAN_THROW_A_FMT((regOffs & 3) == 0, "unexpected regOffs");
+        pextrd(eax, guest, regOffs / 4);
+        vmovd(host, eax);
+        break;
+
+      case 8:
+        LOGMAN_THROW_A_FMT((regOffs & 7) == 0, "unexpected regOffs");
+        if (regOffs == 0) {
+          movq(host, guest);
+        } else {
+          pextrq(rax, guest, 1);
+          vmovq(host, rax);
+        }
+        break;
+
+      case 16:
+        LOGMAN_THROW_A_FMT(regOffs == 0, "unexpected regOffs");
+        if (host.getIdx() != guest.getIdx())
+          movaps(host, guest);
+        break;
+
+      default: LOGMAN_MSG_A_FMT("Unhandled LoadRegister size: {}", Op->Header.Size);
+    }
+  } else {
+    LOGMAN_THROW_A_FMT(false, "Unhandled Op->Class {}", Op->Class);
+  }
+}
+
+DEF_OP(StoreRegister) {
+  auto Op = IROp->C<IR::IROp_StoreRegister>();
+
+  if (Op->Class == IR::GPRClass) {
+    auto regId = (Op->Offset - offsetof(Core::CpuStateFrame, State.gregs[0])) / Core::CPUState::GPR_REG_SIZE;
+    auto regOffs = Op->Offset & 7;
+
+    LOGMAN_THROW_A_FMT(regId < SRA64.size(), "out of range regId");
+
+    auto reg = SRA64[regId].cvt64();
+    auto Src = GetSrc<RA_64>(Op->Value.ID());
+
+    // Partial stores leave the rest of the guest register alone, like StoreContext does
+    // The source is read in to a temp first since it may alias the guest register
+    switch (Op->Header.Size) {
+      case 1:
+        LOGMAN_THROW_A_FMT(regOffs == 0 || regOffs == 1, "unexpected regOffs");
+        if (regOffs == 0) {
+          mov(reg.cvt8(), Src.cvt8());
+        }
+        else {
+          movzx(eax, Src.cvt8());
+          shl(eax, 8);
+          and_(reg, ~0xFF00);
+          or_(reg, rax);
+        }
+        break;
+
+      case 2:
+        LOGMAN_THROW_A_FMT(regOffs == 0, "unexpected regOffs");
+        mov(reg.cvt16(), Src.cvt16());
+        break;
+
+      case 4:
+        LOGMAN_THROW_A_FMT(regOffs == 0, "unexpected regOffs");
+        mov(eax, Src.cvt32());
+        shr(reg, 32);
+        shl(reg, 32);
+        or_(reg, rax);
+        break;
+
+      case 8:
+        LOGMAN_THROW_A_FMT(regOffs == 0, "unexpected regOffs");
+        if (Src.getIdx() != reg.getIdx())
+          mov(reg, Src);
+        break;
+
+      default: LOGMAN_MSG_A_FMT("Unhandled StoreRegister size: {}", Op->Header.Size);
+    }
+  } else if (Op->Class == IR::FPRClass) {
+    auto regId = (Op->Offset - offsetof(Core::CpuStateFrame, State.xmm[0][0])) / Core::CPUState::XMM_REG_SIZE;
+    auto regOffs = Op->Offset & 15;
+
+    LOGMAN_THROW_A_FMT(regId < SRAXMM_x.size(), "regId out of range");
+
+    auto guest = SRAXMM_x[regId];
+    auto host = GetSrc(Op->Value.ID());
+
+    switch (Op->Header.Size) {
+      case 1:
+        pextrb(eax, host, 0);
+        pinsrb(guest, eax, regOffs);
+        break;
+
+      case 2:
+        LOGMAN_THROW_A_FMT((regOffs & 1) == 0, "unexpected regOffs");
+        pextrw(eax, host, 0);
+        pinsrw(guest, eax, regOffs / 2);
+        break;
+
+      case 4:
+        LOGMAN_THROW_A_FMT((regOffs & 3) == 0, "unexpected regOffs");
+        insertps(guest, host, (regOffs / 4) << 4);
+        break;
+
+      case 8:
+        LOGMAN_THROW_A_FMT((regOffs & 7) == 0, "unexpected regOffs");
+        if (regOffs == 0) {
+          movsd(guest, host);
+        } else {
+          movlhps(guest, host);
+        }
+        break;
+
+      case 16:
+        LOGMAN_THROW_A_FMT(regOffs == 0, "unexpected regOffs");
+        if (host.getIdx() != guest.getIdx())
+          movaps(guest, host);
+        break;
+
+      default: LOGMAN_MSG_A_FMT("Unhandled StoreRegister size: {}", Op->Header.Size);
+    }
+  } else {
+    LOGMAN_THROW_A_FMT(false, "Unhandled Op->Class {}", Op->Class);
+  }
+}
+
 DEF_OP(LoadContextIndexed) {
   auto Op = IROp->C<IR::IROp_LoadContextIndexed>();
   size_t size = IROp->Size;
@@ -618,8 +811,8 @@ void X86JITCore::RegisterMemoryHandlers() {
 #define REGISTER_OP(op, x) OpHandlers[FEXCore::IR::IROps::OP_##op] = &X86JITCore::Op_##x
   REGISTER_OP(LOADCONTEXT,         LoadContext);
   REGISTER_OP(STORECONTEXT,        StoreContext);
-  REGISTER_OP(LOADREGISTER,        Unhandled); // SRA specific, not supported on this backend
-  REGISTER_OP(STOREREGISTER,       Unhandled);
+  REGISTER_OP(LOADREGISTER,        LoadRegister);
+  REGISTER_OP(STOREREGISTER,       StoreRegister);
   REGISTER_OP(LOADCONTEXTINDEXED,  LoadContextIndexed);
   REGISTER_OP(STORECONTEXTINDEXED, StoreContextIndexed);
   REGISTER_OP(SPILLREGISTER,       SpillRegister);
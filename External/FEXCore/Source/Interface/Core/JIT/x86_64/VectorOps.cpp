@@ -75,7 +75,6 @@ DEF_OP(SplatVector) {
   uint8_t Elements = 0;
 
   switch (Op->Header.Op) {
-    case IR::OP_SPLATVECTOR4: Elements = 4; break;
     case IR::OP_SPLATVECTOR2: Elements = 2; break;
     default: LOGMAN_MSG_A_FMT("Unknown Splat size"); break;
   }
@@ -2217,7 +2216,6 @@ void X86JITCore::RegisterVectorHandlers() {
   REGISTER_OP(VECTORZERO,        VectorZero);
   REGISTER_OP(VECTORIMM,         VectorImm);
   REGISTER_OP(SPLATVECTOR2,      SplatVector);
-  REGISTER_OP(SPLATVECTOR4,      SplatVector);
   REGISTER_OP(VMOV,              VMov);
   REGISTER_OP(VAND,              VAnd);
   REGISTER_OP(VBIC,              VBic);
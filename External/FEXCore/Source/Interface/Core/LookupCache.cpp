@@ -11,6 +11,7 @@ $end_info$
 #include "Interface/Context/Context.h"
 #include "Interface/Core/LookupCache.h"
 
+#include <cstring>
 #include <sys/mman.h>
 
 namespace FEXCore {
@@ -29,18 +30,21 @@ LookupCache::LookupCache(FEXCore::Context::Context *CTX)
   // Allocate a region of memory that we can use to back our block pointers
   // We need one pointer per page of virtual memory
   // At 64GB of virtual memory this will allocate 128MB of virtual memory space
-  PagePointer = reinterpret_cast<uintptr_t>(FEXCore::Allocator::mmap(nullptr, ctx->Config.VirtualMemSize / 4096 * 8, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  // ConfigHugePages and HugePageType line up
+  const auto HugePages = static_cast<FEXCore::Allocator::HugePageType>(ctx->Config.HugePages());
+  PagePointer = reinterpret_cast<uintptr_t>(FEXCore::Allocator::MapHugePageAligned(ctx->Config.VirtualMemSize / 4096 * 8, PROT_READ | PROT_WRITE, HugePages));
+  LOGMAN_THROW_A_FMT(PagePointer != -1ULL, "Failed to allocate page pointers");
 
   // Allocate our memory backing our pages
   // We need 32KB per guest page (One pointer per byte)
   // XXX: We can drop down to 16KB if we store 4byte offsets from the code base
   // We currently limit to 128MB of real memory for caching for the total cache size.
   // Can end up being inefficient if we compile a small number of blocks per page
-  PageMemory = reinterpret_cast<uintptr_t>(FEXCore::Allocator::mmap(nullptr, CODE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  PageMemory = reinterpret_cast<uintptr_t>(FEXCore::Allocator::MapHugePageAligned(CODE_SIZE, PROT_READ | PROT_WRITE, HugePages));
   LOGMAN_THROW_A_FMT(PageMemory != -1ULL, "Failed to allocate page memory");
 
   // L1 Cache
-  L1Pointer = reinterpret_cast<uintptr_t>(FEXCore::Allocator::mmap(nullptr, L1_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  L1Pointer = reinterpret_cast<uintptr_t>(FEXCore::Allocator::MapHugePageAligned(L1_SIZE, PROT_READ | PROT_WRITE, HugePages));
   LOGMAN_THROW_A_FMT(L1Pointer != -1ULL, "Failed to allocate L1Pointer");
 
   VirtualMemSize = ctx->Config.VirtualMemSize;
@@ -52,11 +56,19 @@ LookupCache::~LookupCache() {
   FEXCore::Allocator::munmap(reinterpret_cast<void*>(L1Pointer), L1_SIZE);
 }
 
+// Zeroes a table by dropping its pages
+// hugetlb mappings only support MADV_DONTNEED from Linux 5.18 onwards, older kernels need it cleared by hand
+static void ZeroTable(uintptr_t Table, size_t Size) {
+  if (madvise(reinterpret_cast<void*>(Table), Size, MADV_DONTNEED) != 0) {
+    memset(reinterpret_cast<void*>(Table), 0, Size);
+  }
+}
+
 void LookupCache::ClearL2Cache() {
   std::lock_guard<std::recursive_mutex> lk(WriteLock);
   // Clear out the page memory
-  madvise(reinterpret_cast<void*>(PagePointer), ctx->Config.VirtualMemSize / 4096 * 8, MADV_DONTNEED);
-  madvise(reinterpret_cast<void*>(PageMemory), CODE_SIZE, MADV_DONTNEED);
+  ZeroTable(PagePointer, ctx->Config.VirtualMemSize / 4096 * 8);
+  ZeroTable(PageMemory, CODE_SIZE);
   AllocateOffset = 0;
 }
 
@@ -64,7 +76,7 @@ void LookupCache::ClearCache() {
   std::lock_guard<std::recursive_mutex> lk(WriteLock);
 
   // Clear L1
-  madvise(reinterpret_cast<void*>(L1Pointer), L1_SIZE, MADV_DONTNEED);
+  ZeroTable(L1Pointer, L1_SIZE);
   // Clear L2
   ClearL2Cache();
   // All code is gone, remove links
@@ -1,4 +1,5 @@
 #pragma once
+#include <FEXCore/Debug/RuntimeStats.h>
 #include <FEXCore/Utils/LogManager.h>
 
 #include <cstdint>
@@ -25,10 +26,14 @@ public:
   LookupCache(FEXCore::Context::Context *CTX);
   ~LookupCache();
 
-  uintptr_t FindBlock(uint64_t Address) {
+  // Stats is optional and must belong to the calling thread
+  uintptr_t FindBlock(uint64_t Address, FEXCore::Core::RuntimeStats *Stats = nullptr) {
     // Try L1, no lock needed
     auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[Address & L1_ENTRIES_MASK];
     if (L1Entry.GuestCode == Address) {
+      if (Stats) {
+        FEXCore::Core::IncrementStat(Stats->LookupL1Hits);
+      }
       return L1Entry.HostCode;
     }
 
@@ -49,6 +54,9 @@ public:
 
       if (BlockPointers[PageOffset].GuestCode == Address)
       {
+        if (Stats) {
+          FEXCore::Core::IncrementStat(Stats->LookupL2Hits);
+        }
         L1Entry.GuestCode = Address;
         L1Entry.HostCode = BlockPointers[PageOffset].HostCode;
         return L1Entry.HostCode;
@@ -59,11 +67,17 @@ public:
     auto HostCode = BlockList.find(Address);
 
     if (HostCode != BlockList.end()) {
+      if (Stats) {
+        FEXCore::Core::IncrementStat(Stats->LookupL3Hits);
+      }
       CacheBlockMapping(Address, HostCode->second);
       return HostCode->second;
     }
-      
+
     // Failed to find
+    if (Stats) {
+      FEXCore::Core::IncrementStat(Stats->LookupMisses);
+    }
     return 0;
   }
 
@@ -99,27 +113,18 @@ public:
     L1Entry.HostCode = (uintptr_t)HostCode;
   }
 
-  void Erase(uint64_t Address) {
+  // Returns the host code that was mapped to Address, 0 if there wasn't any
+  uintptr_t Erase(uint64_t Address) {
 
     std::lock_guard<std::recursive_mutex> lk(WriteLock);
 
-    // Sever any links to this block
-    auto lower = BlockLinks.lower_bound({Address, 0});
-    auto upper = BlockLinks.upper_bound({Address, UINTPTR_MAX});
-    for (auto it = lower; it != upper; it = BlockLinks.erase(it)) {
-      it->second();
-    }
+    Unlink(Address);
 
     // Remove from BlockList
-    BlockList.erase(Address);
-
-    // Do L1
-    auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[Address & L1_ENTRIES_MASK];
-    if (L1Entry.GuestCode == Address) {
-      L1Entry.GuestCode = 0;
-      // Leave L1Entry.HostCode as is, so that concurrent lookups won't read a null pointer
-      // This is a soft guarantee for cross thread invalidation, as atomics are not used
-      // and it hasn't been thoroughly tested
+    uintptr_t HostCode{};
+    if (auto it = BlockList.find(Address); it != BlockList.end()) {
+      HostCode = it->second;
+      BlockList.erase(it);
     }
 
     // Do full map
@@ -131,13 +136,59 @@ public:
     uint64_t LocalPagePointer = Pointers[Address];
     if (!LocalPagePointer) {
       // Page for this code didn't even exist, nothing to do
-      return;
+      return HostCode;
     }
 
     // Page exists, just set the offset to zero
     auto BlockPointers = reinterpret_cast<LookupCacheEntry*>(LocalPagePointer);
     BlockPointers[PageOffset].GuestCode = 0;
     BlockPointers[PageOffset].HostCode = 0;
+    return HostCode;
+  }
+
+  // Severs all links in to Address and drops it from L1, so that the next time it runs it goes through a lookup
+  // The block itself stays in L2 and L3
+  void Unlink(uint64_t Address) {
+    std::lock_guard<std::recursive_mutex> lk(WriteLock);
+
+    // Sever any links to this block
+    auto lower = BlockLinks.lower_bound({Address, 0});
+    auto upper = BlockLinks.upper_bound({Address, UINTPTR_MAX});
+    for (auto it = lower; it != upper; it = BlockLinks.erase(it)) {
+      it->second();
+    }
+
+    // Do L1
+    auto &L1Entry = reinterpret_cast<LookupCacheEntry*>(L1Pointer)[Address & L1_ENTRIES_MASK];
+    if (L1Entry.GuestCode == Address) {
+      L1Entry.GuestCode = 0;
+      // Leave L1Entry.HostCode as is, so that concurrent lookups won't read a null pointer
+      // This is a soft guarantee for cross thread invalidation, as atomics are not used
+      // and it hasn't been thoroughly tested
+    }
+  }
+
+  // Drops the link records that live in host code [Start, End) without undoing them
+  // Used when that code is about to be overwritten
+  void EraseLinksFrom(uintptr_t Start, uintptr_t End) {
+    std::lock_guard<std::recursive_mutex> lk(WriteLock);
+
+    for (auto it = BlockLinks.begin(); it != BlockLinks.end();) {
+      if (it->first.HostLink >= Start && it->first.HostLink < End) {
+        it = BlockLinks.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+  }
+
+  // Returns the host code mapped to Address without caching it in L1 or L2, 0 if there isn't any
+  uintptr_t GetHostCode(uint64_t Address) {
+    std::lock_guard<std::recursive_mutex> lk(WriteLock);
+
+    auto it = BlockList.find(Address);
+    return it != BlockList.end() ? it->second : 0;
   }
 
 
@@ -521,6 +521,8 @@ public:
 
   void FXSaveOp(OpcodeArgs);
   void FXRStoreOp(OpcodeArgs);
+  void XSaveOp(OpcodeArgs);
+  void XRStoreOp(OpcodeArgs);
 
   void PAlignrOp(OpcodeArgs);
   template<size_t ElementSize>
@@ -586,6 +588,7 @@ public:
   void FenceOp(OpcodeArgs);
 
   void StoreFenceOrCLFlush(OpcodeArgs);
+  void LoadFenceOrXRStore(OpcodeArgs);
   void CLZeroOp(OpcodeArgs);
   void RDTSCPOp(OpcodeArgs);
 
@@ -619,6 +622,8 @@ public:
   void VectorVariableBlend(OpcodeArgs);
   void PTestOp(OpcodeArgs);
   void PHMINPOSUWOp(OpcodeArgs);
+  template<bool IsExplicit, bool IsMask>
+  void PCMPXSTRXOp(OpcodeArgs);
   template<size_t ElementSize>
   void DPPOp(OpcodeArgs);
 
@@ -628,6 +633,19 @@ public:
 
   void CRC32(OpcodeArgs);
 
+  // AVX
+  template<FEXCore::IR::IROps IROp, size_t ElementSize>
+  void AVXVectorALUOp(OpcodeArgs);
+  void VANDNOp(OpcodeArgs);
+  void VMOVAPSOp(OpcodeArgs);
+  void VMOVUPSOp(OpcodeArgs);
+  void VMOVVectorNTOp(OpcodeArgs);
+  void VPMOVMSKBOp(OpcodeArgs);
+  template<size_t ElementSize>
+  void VBROADCASTOp(OpcodeArgs);
+  void VZEROOp(OpcodeArgs);
+  void XGetBVOp(OpcodeArgs);
+
   void UnimplementedOp(OpcodeArgs);
 
   void InvalidOp(OpcodeArgs);
@@ -664,6 +682,30 @@ private:
   void StoreResult(FEXCore::IR::RegisterClassType Class, FEXCore::X86Tables::DecodedOp Op, FEXCore::X86Tables::DecodedOperand const& Operand, OrderedNode *const Src, int8_t Align, MemoryAccessType AccessType = MemoryAccessType::ACCESS_DEFAULT);
   void StoreResult(FEXCore::IR::RegisterClassType Class, FEXCore::X86Tables::DecodedOp Op, OrderedNode *const Src, int8_t Align, MemoryAccessType AccessType = MemoryAccessType::ACCESS_DEFAULT);
 
+  // A YMM register split in to its two 128-bit halves.
+  // High is nullptr for 128-bit operations.
+  struct AVXRegister {
+    OrderedNode *Low{};
+    OrderedNode *High{};
+  };
+  AVXRegister LoadSource_AVX(FEXCore::X86Tables::DecodedOp const& Op, FEXCore::X86Tables::DecodedOperand const& Operand, uint8_t OpSize, int8_t Align, MemoryAccessType AccessType = MemoryAccessType::ACCESS_DEFAULT);
+  void StoreResult_AVX(FEXCore::X86Tables::DecodedOp Op, FEXCore::X86Tables::DecodedOperand const& Operand, AVXRegister const& Src, int8_t Align, MemoryAccessType AccessType = MemoryAccessType::ACCESS_DEFAULT);
+
+  OrderedNode *PMOVMSKBHelper(OrderedNode *Src);
+  // XSAVE state components, x87 and SSE together make up the FXSAVE area
+  void SaveX87State(OrderedNode *MemBase);
+  void SaveSSEState(OrderedNode *MemBase);
+  void SaveAVXState(OrderedNode *MemBase);
+  void RestoreX87State(OrderedNode *MemBase);
+  void RestoreSSEState(OrderedNode *MemBase);
+  void RestoreAVXState(OrderedNode *MemBase);
+  void DefaultX87State();
+  void DefaultSSEState();
+  void DefaultAVXState();
+  // Emits Body in a block that only runs if bit Component of Mask is set
+  template<typename F>
+  void XStateComponentIf(OrderedNode *Mask, uint32_t Component, F &&Body);
+
   [[nodiscard]] static uint32_t GPROffset(X86State::X86Reg reg) {
     LOGMAN_THROW_A_FMT(reg <= X86State::X86Reg::REG_R15, "Invalid reg used");
     return static_cast<uint32_t>(offsetof(Core::CPUState, gregs[static_cast<size_t>(reg)]));
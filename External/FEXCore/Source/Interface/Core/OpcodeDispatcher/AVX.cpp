@@ -0,0 +1,333 @@
+/*
+$info$
+tags: frontend|x86-to-ir, opcodes|dispatcher-implementations
+desc: Handles x86/64 AVX instructions to IR
+$end_info$
+*/
+
+#include "Interface/Context/Context.h"
+#include "Interface/Core/OpcodeDispatcher.h"
+
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Core/X86Enums.h>
+#include <FEXCore/Debug/X86Tables.h>
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/Utils/LogManager.h>
+
+#include <cstdint>
+#include <stddef.h>
+
+namespace FEXCore::IR {
+#define OpcodeArgs [[maybe_unused]] FEXCore::X86Tables::DecodedOp Op
+
+// 256-bit operations are split in to two 128-bit halves.
+// The lower half lives in the xmm registers and the upper half in ymm_upper.
+OpDispatchBuilder::AVXRegister OpDispatchBuilder::LoadSource_AVX(FEXCore::X86Tables::DecodedOp const& Op, FEXCore::X86Tables::DecodedOperand const& Operand, uint8_t OpSize, int8_t Align, MemoryAccessType AccessType) {
+  const bool Is256Bit = OpSize == 32;
+  AVXRegister Result{};
+
+  if (Operand.IsGPR()) {
+    const auto gpr = Operand.Data.GPR.GPR;
+    LOGMAN_THROW_A_FMT(gpr >= FEXCore::X86State::REG_XMM_0 && gpr <= FEXCore::X86State::REG_XMM_15, "Expected an XMM register");
+    const auto Reg = gpr - FEXCore::X86State::REG_XMM_0;
+
+    Result.Low = _LoadContext(16, FPRClass, offsetof(FEXCore::Core::CPUState, xmm[Reg]));
+    if (Is256Bit) {
+      Result.High = _LoadContext(16, FPRClass, offsetof(FEXCore::Core::CPUState, ymm_upper[Reg]));
+    }
+    return Result;
+  }
+
+  OrderedNode *Addr = LoadSource_WithOpSize(GPRClass, Op, Operand, 16, Op->Flags, Align, false);
+  Addr = AppendSegmentOffset(Addr, Op->Flags);
+
+  const uint8_t HalfAlign = Align == -1 ? 16 : Align;
+  const bool NonTSO = AccessType == MemoryAccessType::ACCESS_NONTSO || AccessType == MemoryAccessType::ACCESS_STREAM;
+  auto LoadHalf = [&](OrderedNode *HalfAddr) -> OrderedNode* {
+    if (NonTSO) {
+      return _LoadMem(FPRClass, 16, HalfAddr, HalfAlign);
+    }
+    return _LoadMemAutoTSO(FPRClass, 16, HalfAddr, HalfAlign);
+  };
+
+  Result.Low = LoadHalf(Addr);
+  if (Is256Bit) {
+    Result.High = LoadHalf(_Add(Addr, _Constant(16)));
+  }
+  return Result;
+}
+
+void OpDispatchBuilder::StoreResult_AVX(FEXCore::X86Tables::DecodedOp Op, FEXCore::X86Tables::DecodedOperand const& Operand, AVXRegister const& Src, int8_t Align, MemoryAccessType AccessType) {
+  if (Operand.IsGPR()) {
+    const auto gpr = Operand.Data.GPR.GPR;
+    LOGMAN_THROW_A_FMT(gpr >= FEXCore::X86State::REG_XMM_0 && gpr <= FEXCore::X86State::REG_XMM_15, "Expected an XMM register");
+    const auto Reg = gpr - FEXCore::X86State::REG_XMM_0;
+
+    _StoreContext(16, FPRClass, Src.Low, offsetof(FEXCore::Core::CPUState, xmm[Reg]));
+    // VEX.128 encoded instructions zero the upper half of the destination
+    OrderedNode *High = Src.High ? Src.High : _VectorZero(16);
+    _StoreContext(16, FPRClass, High, offsetof(FEXCore::Core::CPUState, ymm_upper[Reg]));
+    return;
+  }
+
+  OrderedNode *Addr = LoadSource_WithOpSize(GPRClass, Op, Operand, 16, Op->Flags, Align, false);
+  Addr = AppendSegmentOffset(Addr, Op->Flags);
+
+  const uint8_t HalfAlign = Align == -1 ? 16 : Align;
+  const bool NonTSO = AccessType == MemoryAccessType::ACCESS_NONTSO || AccessType == MemoryAccessType::ACCESS_STREAM;
+  auto StoreHalf = [&](OrderedNode *HalfAddr, OrderedNode *Value) {
+    if (NonTSO) {
+      _StoreMem(FPRClass, 16, HalfAddr, Value, HalfAlign);
+    }
+    else {
+      _StoreMemAutoTSO(FPRClass, 16, HalfAddr, Value, HalfAlign);
+    }
+  };
+
+  StoreHalf(Addr, Src.Low);
+  if (Src.High) {
+    StoreHalf(_Add(Addr, _Constant(16)), Src.High);
+  }
+}
+
+template<FEXCore::IR::IROps IROp, size_t ElementSize>
+void OpDispatchBuilder::AVXVectorALUOp(OpcodeArgs) {
+  const auto Size = GetSrcSize(Op);
+  AVXRegister Src1 = LoadSource_AVX(Op, Op->Src[0], Size, -1);
+  AVXRegister Src2 = LoadSource_AVX(Op, Op->Src[1], Size, 1);
+
+  auto HalfOp = [&](OrderedNode *Lhs, OrderedNode *Rhs) -> OrderedNode* {
+    auto ALUOp = _VAdd(16, ElementSize, Lhs, Rhs);
+    // Overwrite our IR's op type
+    ALUOp.first->Header.Op = IROp;
+    return ALUOp;
+  };
+
+  AVXRegister Result{};
+  Result.Low = HalfOp(Src1.Low, Src2.Low);
+  if (Size == 32) {
+    Result.High = HalfOp(Src1.High, Src2.High);
+  }
+
+  StoreResult_AVX(Op, Op->Dest, Result, -1);
+}
+
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VAND, 16>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VOR, 16>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VXOR, 16>(OpcodeArgs);
+
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VADD, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VADD, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VADD, 4>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VADD, 8>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSUB, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSUB, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSUB, 4>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSUB, 8>(OpcodeArgs);
+
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VUQADD, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VUQADD, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VUQSUB, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VUQSUB, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSQADD, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSQADD, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSQSUB, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSQSUB, 2>(OpcodeArgs);
+
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VUMIN, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VUMIN, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VUMIN, 4>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VUMAX, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VUMAX, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VUMAX, 4>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSMIN, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSMIN, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSMIN, 4>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSMAX, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSMAX, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSMAX, 4>(OpcodeArgs);
+
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSMUL, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VSMUL, 4>(OpcodeArgs);
+
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VCMPEQ, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VCMPEQ, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VCMPEQ, 4>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VCMPEQ, 8>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VCMPGT, 1>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VCMPGT, 2>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VCMPGT, 4>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VCMPGT, 8>(OpcodeArgs);
+
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VFADD, 4>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VFADD, 8>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VFSUB, 4>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VFSUB, 8>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VFMUL, 4>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VFMUL, 8>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VFDIV, 4>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VFDIV, 8>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VFMIN, 4>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VFMIN, 8>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VFMAX, 4>(OpcodeArgs);
+template
+void OpDispatchBuilder::AVXVectorALUOp<IR::OP_VFMAX, 8>(OpcodeArgs);
+
+void OpDispatchBuilder::VANDNOp(OpcodeArgs) {
+  const auto Size = GetSrcSize(Op);
+  AVXRegister Src1 = LoadSource_AVX(Op, Op->Src[0], Size, -1);
+  AVXRegister Src2 = LoadSource_AVX(Op, Op->Src[1], Size, 1);
+
+  // Dest = ~Src1 & Src2
+  AVXRegister Result{};
+  Result.Low = _VAnd(16, 16, _VNot(16, 16, Src1.Low), Src2.Low);
+  if (Size == 32) {
+    Result.High = _VAnd(16, 16, _VNot(16, 16, Src1.High), Src2.High);
+  }
+
+  StoreResult_AVX(Op, Op->Dest, Result, -1);
+}
+
+void OpDispatchBuilder::VMOVAPSOp(OpcodeArgs) {
+  const auto Size = GetSrcSize(Op);
+  AVXRegister Src = LoadSource_AVX(Op, Op->Src[0], Size, -1);
+  StoreResult_AVX(Op, Op->Dest, Src, -1);
+}
+
+void OpDispatchBuilder::VMOVUPSOp(OpcodeArgs) {
+  const auto Size = GetSrcSize(Op);
+  AVXRegister Src = LoadSource_AVX(Op, Op->Src[0], Size, 1);
+  StoreResult_AVX(Op, Op->Dest, Src, 1);
+}
+
+void OpDispatchBuilder::VMOVVectorNTOp(OpcodeArgs) {
+  const auto Size = GetSrcSize(Op);
+  AVXRegister Src = LoadSource_AVX(Op, Op->Src[0], Size, -1);
+  StoreResult_AVX(Op, Op->Dest, Src, -1, MemoryAccessType::ACCESS_STREAM);
+}
+
+void OpDispatchBuilder::VPMOVMSKBOp(OpcodeArgs) {
+  const auto Size = GetSrcSize(Op);
+  AVXRegister Src = LoadSource_AVX(Op, Op->Src[0], Size, -1);
+
+  OrderedNode *Result = PMOVMSKBHelper(Src.Low);
+  if (Size == 32) {
+    Result = _Or(Result, _Lshl(PMOVMSKBHelper(Src.High), _Constant(16)));
+  }
+
+  StoreResult(GPRClass, Op, Result, -1);
+}
+
+template<size_t ElementSize>
+void OpDispatchBuilder::VBROADCASTOp(OpcodeArgs) {
+  const auto DstSize = GetDstSize(Op);
+
+  // AVX2 allows the source to be an xmm register, where the lowest element is broadcast
+  const uint8_t LoadSize = Op->Src[0].IsGPR() ? 16 : ElementSize;
+  OrderedNode *Src = LoadSource_WithOpSize(FPRClass, Op, Op->Src[0], LoadSize, Op->Flags, 1);
+
+  AVXRegister Result{};
+  if constexpr (ElementSize == 16) {
+    Result.Low = Src;
+  }
+  else {
+    Result.Low = _VDupElement(16, ElementSize, Src, 0);
+  }
+
+  if (DstSize == 32) {
+    Result.High = Result.Low;
+  }
+
+  StoreResult_AVX(Op, Op->Dest, Result, -1);
+}
+
+template
+void OpDispatchBuilder::VBROADCASTOp<1>(OpcodeArgs);
+template
+void OpDispatchBuilder::VBROADCASTOp<2>(OpcodeArgs);
+template
+void OpDispatchBuilder::VBROADCASTOp<4>(OpcodeArgs);
+template
+void OpDispatchBuilder::VBROADCASTOp<8>(OpcodeArgs);
+template
+void OpDispatchBuilder::VBROADCASTOp<16>(OpcodeArgs);
+
+void OpDispatchBuilder::VZEROOp(OpcodeArgs) {
+  // VEX.L selects between VZEROUPPER and VZEROALL
+  const bool ZeroAll = GetSrcSize(Op) == 32;
+  const unsigned NumRegs = CTX->Config.Is64BitMode ? 16 : 8;
+  auto ZeroVector = _VectorZero(16);
+
+  for (unsigned i = 0; i < NumRegs; ++i) {
+    if (ZeroAll) {
+      _StoreContext(16, FPRClass, ZeroVector, offsetof(FEXCore::Core::CPUState, xmm[i]));
+    }
+    _StoreContext(16, FPRClass, ZeroVector, offsetof(FEXCore::Core::CPUState, ymm_upper[i]));
+  }
+}
+
+void OpDispatchBuilder::XGetBVOp(OpcodeArgs) {
+  const uint8_t GPRSize = CTX->GetGPRSize();
+
+  // Only XCR0 exists, ECX is ignored
+  // x87 and SSE state are always enabled, AVX state depends on if AVX is exposed
+  const uint64_t XCR0 = CTX->Config.EnableAVX ? 0b111 : 0b011;
+
+  _StoreContext(GPRSize, GPRClass, _Constant(XCR0), GPROffset(X86State::REG_RAX));
+  _StoreContext(GPRSize, GPRClass, _Constant(0), GPROffset(X86State::REG_RDX));
+}
+
+#undef OpcodeArgs
+}
@@ -24,6 +24,12 @@ void OpDispatchBuilder::SHA1NEXTEOp(OpcodeArgs) {
   OrderedNode *Dest = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
 
+  if (CTX->HostFeatures.SupportsSHA) {
+    auto Result = _VSHA(Dest, Src, Src, SHA_OP_SHA1NEXTE);
+    StoreResult(FPRClass, Op, Result, -1);
+    return;
+  }
+
   auto Tmp = _Ror(_VExtractToGPR(16, 4, Dest, 3), _Constant(32, 2));
   auto Top = _Add(_VExtractToGPR(16, 4, Src, 3), Tmp);
   auto Result = _VInsGPR(16, 4, 3, Src, Top);
@@ -35,6 +41,12 @@ void OpDispatchBuilder::SHA1MSG1Op(OpcodeArgs) {
   OrderedNode *Dest = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
 
+  if (CTX->HostFeatures.SupportsSHA) {
+    auto Result = _VSHA(Dest, Src, Src, SHA_OP_SHA1MSG1);
+    StoreResult(FPRClass, Op, Result, -1);
+    return;
+  }
+
   auto W0 = _VExtractToGPR(16, 4, Dest, 3);
   auto W1 = _VExtractToGPR(16, 4, Dest, 2);
   auto W2 = _VExtractToGPR(16, 4, Dest, 1);
@@ -54,6 +66,12 @@ void OpDispatchBuilder::SHA1MSG2Op(OpcodeArgs) {
   OrderedNode *Dest = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
 
+  if (CTX->HostFeatures.SupportsSHA) {
+    auto Result = _VSHA(Dest, Src, Src, SHA_OP_SHA1MSG2);
+    StoreResult(FPRClass, Op, Result, -1);
+    return;
+  }
+
   // ROR by 31 is equivalent to a ROL by 1
   auto ThirtyOne = _Constant(32, 31);
 
@@ -110,6 +128,12 @@ void OpDispatchBuilder::SHA1RNDS4Op(OpcodeArgs) {
   OrderedNode *Dest = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
 
+  if (CTX->HostFeatures.SupportsSHA) {
+    auto Result = _VSHA(Dest, Src, Src, SHA_OP_SHA1RNDS4 | Imm8);
+    StoreResult(FPRClass, Op, Result, -1);
+    return;
+  }
+
   auto W0E = _VExtractToGPR(16, 4, Src, 3);
   auto W1  = _VExtractToGPR(16, 4, Src, 2);
   auto W2  = _VExtractToGPR(16, 4, Src, 1);
@@ -163,6 +187,12 @@ void OpDispatchBuilder::SHA256MSG1Op(OpcodeArgs) {
   OrderedNode *Dest = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
 
+  if (CTX->HostFeatures.SupportsSHA) {
+    auto Result = _VSHA(Dest, Src, Src, SHA_OP_SHA256MSG1);
+    StoreResult(FPRClass, Op, Result, -1);
+    return;
+  }
+
   auto W4 = _VExtractToGPR(16, 4, Src, 0);
   auto W3 = _VExtractToGPR(16, 4, Dest, 3);
   auto W2 = _VExtractToGPR(16, 4, Dest, 2);
@@ -190,6 +220,12 @@ void OpDispatchBuilder::SHA256MSG2Op(OpcodeArgs) {
   OrderedNode *Dest = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
 
+  if (CTX->HostFeatures.SupportsSHA) {
+    auto Result = _VSHA(Dest, Src, Src, SHA_OP_SHA256MSG2);
+    StoreResult(FPRClass, Op, Result, -1);
+    return;
+  }
+
   auto W14 = _VExtractToGPR(16, 4, Src, 2);
   auto W15 = _VExtractToGPR(16, 4, Src, 3);
   auto W16 = _Add(_VExtractToGPR(16, 4, Dest, 0), Sigma1(W14));
@@ -223,6 +259,12 @@ void OpDispatchBuilder::SHA256RNDS2Op(OpcodeArgs) {
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
   OrderedNode *XMM0 = _LoadContext(16, FPRClass, offsetof(FEXCore::Core::CPUState, xmm[0]));
 
+  if (CTX->HostFeatures.SupportsSHA) {
+    auto Result = _VSHA(Dest, Src, XMM0, SHA_OP_SHA256RNDS2);
+    StoreResult(FPRClass, Op, Result, -1);
+    return;
+  }
+
   auto A0 = _VExtractToGPR(16, 4, Src, 3);
   auto B0 = _VExtractToGPR(16, 4, Src, 2);
   auto C0 = _VExtractToGPR(16, 4, Dest, 3);
@@ -480,7 +480,10 @@ void OpDispatchBuilder::MOVMSKOp<8>(OpcodeArgs);
 
 void OpDispatchBuilder::MOVMSKOpOne(OpcodeArgs) {
   OrderedNode *Src = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+  StoreResult(GPRClass, Op, PMOVMSKBHelper(Src), -1);
+}
 
+OrderedNode *OpDispatchBuilder::PMOVMSKBHelper(OrderedNode *Src) {
   //TODO: We could remove this VCastFromGOR + VInsGPR pair if we had a VDUPFromGPR instruction that maps directly to AArch64.
   auto M = _Constant(0x80'40'20'10'08'04'02'01ULL);
   OrderedNode *VMask = _VCastFromGPR(16, 8, M);
@@ -494,7 +497,7 @@ void OpDispatchBuilder::MOVMSKOpOne(OpcodeArgs) {
   auto VAdd2 = _VAddP(8, 1, VAdd1, VAdd1);
   auto VAdd3 = _VAddP(8, 1, VAdd2, VAdd2);
 
-  StoreResult(GPRClass, Op, _VExtractToGPR(16, 2, VAdd3, 0), -1);
+  return _VExtractToGPR(16, 2, VAdd3, 0);
 }
 
 template<size_t ElementSize>
@@ -1294,20 +1297,23 @@ void OpDispatchBuilder::FXSaveOp(OpcodeArgs) {
   OrderedNode *Mem = LoadSource(GPRClass, Op, Op->Dest, Op->Flags, -1, false);
   Mem = AppendSegmentOffset(Mem, Op->Flags);
 
+  SaveX87State(Mem);
+  SaveSSEState(Mem);
+}
+
+void OpDispatchBuilder::SaveX87State(OrderedNode *Mem) {
   // Saves 512bytes to the memory location provided
   // Header changes depending on if REX.W is set or not
-  if (Op->Flags & X86Tables::DecodeFlags::FLAG_REX_WIDENING) {
-    // BYTE | 0 1 | 2 3 | 4   | 5     | 6 7 | 8 9 | a b | c d | e f |
-    // ------------------------------------------
-    //   00 | FCW | FSW | FTW | <R>   | FOP | FIP                   |
-    //   16 | FDP                           | MXCSR     | MXCSR_MASK|
-  }
-  else {
-    // BYTE | 0 1 | 2 3 | 4   | 5     | 6 7 | 8 9 | a b | c d | e f |
-    // ------------------------------------------
-    //   00 | FCW | FSW | FTW | <R>   | FOP | FIP[31:0] | FCS | <R> |
-    //   16 | FDP[31:0] | FDS         | <R> | MXCSR     | MXCSR_MASK|
-  }
+  // REX.W set:
+  // BYTE | 0 1 | 2 3 | 4   | 5     | 6 7 | 8 9 | a b | c d | e f |
+  // ------------------------------------------
+  //   00 | FCW | FSW | FTW | <R>   | FOP | FIP                   |
+  //   16 | FDP                           | MXCSR     | MXCSR_MASK|
+  // REX.W unset:
+  // BYTE | 0 1 | 2 3 | 4   | 5     | 6 7 | 8 9 | a b | c d | e f |
+  // ------------------------------------------
+  //   00 | FCW | FSW | FTW | <R>   | FOP | FIP[31:0] | FCS | <R> |
+  //   16 | FDP[31:0] | FDS         | <R> | MXCSR     | MXCSR_MASK|
 
   {
     auto FCW = _LoadContext(2, GPRClass, offsetof(FEXCore::Core::CPUState, FCW));
@@ -1390,6 +1396,9 @@ void OpDispatchBuilder::FXSaveOp(OpcodeArgs) {
 
     _StoreMem(FPRClass, 16, MemLocation, MMReg, 16);
   }
+}
+
+void OpDispatchBuilder::SaveSSEState(OrderedNode *Mem) {
   unsigned NumRegs = CTX->Config.Is64BitMode ? 16 : 8;
 
   for (unsigned i = 0; i < NumRegs; ++i) {
@@ -1400,10 +1409,29 @@ void OpDispatchBuilder::FXSaveOp(OpcodeArgs) {
   }
 }
 
+void OpDispatchBuilder::SaveAVXState(OrderedNode *Mem) {
+  // BYTE | 0 1 2 3 4 5 6 7 | 8 9 a b c d e f |
+  // ------------------------------------------
+  //  576 | YMM_Hi128 (AVX state component at CPUID.(EAX=0Dh,ECX=2):EBX)
+  unsigned NumRegs = CTX->Config.Is64BitMode ? 16 : 8;
+
+  for (unsigned i = 0; i < NumRegs; ++i) {
+    OrderedNode *YMMHigh = _LoadContext(16, FPRClass, offsetof(FEXCore::Core::CPUState, ymm_upper[i]));
+    OrderedNode *MemLocation = _Add(Mem, _Constant(i * 16 + 576));
+
+    _StoreMem(FPRClass, 16, MemLocation, YMMHigh, 16);
+  }
+}
+
 void OpDispatchBuilder::FXRStoreOp(OpcodeArgs) {
   OrderedNode *Mem = LoadSource(GPRClass, Op, Op->Src[0], Op->Flags, -1, false);
   Mem = AppendSegmentOffset(Mem, Op->Flags);
 
+  RestoreX87State(Mem);
+  RestoreSSEState(Mem);
+}
+
+void OpDispatchBuilder::RestoreX87State(OrderedNode *Mem) {
   auto NewFCW = _LoadMem(GPRClass, 2, Mem, 2);
   _F80LoadFCW(NewFCW);
   _StoreContext(2, GPRClass, NewFCW, offsetof(FEXCore::Core::CPUState, FCW));
@@ -1439,6 +1467,9 @@ void OpDispatchBuilder::FXRStoreOp(OpcodeArgs) {
     auto MMReg = _LoadMem(FPRClass, 16, MemLocation, 16);
     _StoreContext(16, FPRClass, MMReg, offsetof(FEXCore::Core::CPUState, mm[i]));
   }
+}
+
+void OpDispatchBuilder::RestoreSSEState(OrderedNode *Mem) {
   unsigned NumRegs = CTX->Config.Is64BitMode ? 16 : 8;
 
   for (unsigned i = 0; i < NumRegs; ++i) {
@@ -1448,6 +1479,129 @@ void OpDispatchBuilder::FXRStoreOp(OpcodeArgs) {
   }
 }
 
+void OpDispatchBuilder::RestoreAVXState(OrderedNode *Mem) {
+  unsigned NumRegs = CTX->Config.Is64BitMode ? 16 : 8;
+
+  for (unsigned i = 0; i < NumRegs; ++i) {
+    OrderedNode *MemLocation = _Add(Mem, _Constant(i * 16 + 576));
+    auto YMMHigh = _LoadMem(FPRClass, 16, MemLocation, 16);
+    _StoreContext(16, FPRClass, YMMHigh, offsetof(FEXCore::Core::CPUState, ymm_upper[i]));
+  }
+}
+
+void OpDispatchBuilder::DefaultX87State() {
+  // Same state that FNINIT leaves behind, with all of the registers zeroed
+  auto NewFCW = _Constant(16, 0x037F);
+  _F80LoadFCW(NewFCW);
+  _StoreContext(2, GPRClass, NewFCW, offsetof(FEXCore::Core::CPUState, FCW));
+
+  SetX87Top(_Constant(0));
+  SetRFLAG<FEXCore::X86State::X87FLAG_C0_LOC>(_Constant(0));
+  SetRFLAG<FEXCore::X86State::X87FLAG_C1_LOC>(_Constant(0));
+  SetRFLAG<FEXCore::X86State::X87FLAG_C2_LOC>(_Constant(0));
+  SetRFLAG<FEXCore::X86State::X87FLAG_C3_LOC>(_Constant(0));
+
+  _StoreContext(2, GPRClass, _Constant(0xFFFF), offsetof(FEXCore::Core::CPUState, FTW));
+
+  auto Zero = _VectorZero(16);
+  for (unsigned i = 0; i < 8; ++i) {
+    _StoreContext(16, FPRClass, Zero, offsetof(FEXCore::Core::CPUState, mm[i]));
+  }
+}
+
+void OpDispatchBuilder::DefaultSSEState() {
+  unsigned NumRegs = CTX->Config.Is64BitMode ? 16 : 8;
+
+  auto Zero = _VectorZero(16);
+  for (unsigned i = 0; i < NumRegs; ++i) {
+    _StoreContext(16, FPRClass, Zero, offsetof(FEXCore::Core::CPUState, xmm[i]));
+  }
+}
+
+void OpDispatchBuilder::DefaultAVXState() {
+  unsigned NumRegs = CTX->Config.Is64BitMode ? 16 : 8;
+
+  auto Zero = _VectorZero(16);
+  for (unsigned i = 0; i < NumRegs; ++i) {
+    _StoreContext(16, FPRClass, Zero, offsetof(FEXCore::Core::CPUState, ymm_upper[i]));
+  }
+}
+
+template<typename F>
+void OpDispatchBuilder::XStateComponentIf(OrderedNode *Mask, uint32_t Component, F &&Body) {
+  auto CondJump = _CondJump(_Bfe(1, Component, Mask), {COND_EQ});
+
+  // Skip the component if the bit isn't set
+  auto JumpTarget = CreateNewCodeBlockAfter(GetCurrentBlock());
+  SetFalseJumpTarget(CondJump, JumpTarget);
+  SetCurrentCodeBlock(JumpTarget);
+
+  Body();
+
+  auto Jump = _Jump();
+  auto NextJumpTarget = CreateNewCodeBlockAfter(GetCurrentBlock());
+  SetJumpTarget(Jump, NextJumpTarget);
+  SetTrueJumpTarget(CondJump, NextJumpTarget);
+  SetCurrentCodeBlock(NextJumpTarget);
+}
+
+void OpDispatchBuilder::XSaveOp(OpcodeArgs) {
+  // Calculate flags early.
+  CalculateDeferredFlags();
+
+  OrderedNode *Mem = LoadSource(GPRClass, Op, Op->Dest, Op->Flags, -1, false);
+  Mem = AppendSegmentOffset(Mem, Op->Flags);
+
+  // Only components in both XCR0 and the requested-feature bitmap in EDX:EAX are saved.
+  // Every component FEX supports is in the EAX half.
+  const uint64_t XCR0 = CTX->Config.EnableAVX ? 0b111 : 0b011;
+  OrderedNode *RFBM = _And(_LoadContext(4, GPRClass, GPROffset(X86State::REG_RAX)), _Constant(XCR0));
+
+  // The legacy region matches the FXSAVE layout
+  XStateComponentIf(RFBM, 0, [&] { SaveX87State(Mem); });
+  XStateComponentIf(RFBM, 1, [&] { SaveSSEState(Mem); });
+  if (CTX->Config.EnableAVX) {
+    XStateComponentIf(RFBM, 2, [&] { SaveAVXState(Mem); });
+  }
+
+  // BYTE | 0 1 2 3 4 5 6 7 | 8 9 a b c d e f |
+  // ------------------------------------------
+  //  512 | XSTATE_BV       | XCOMP_BV        |
+  // Saved components are always reported as not being in their init state.
+  // XSTATE_BV bits outside of RFBM are left alone and the rest of the header isn't written.
+  {
+    OrderedNode *MemLocation = _Add(Mem, _Constant(512));
+    auto XStateBV = _LoadMem(GPRClass, 8, MemLocation, 8);
+    _StoreMem(GPRClass, 8, MemLocation, _Or(XStateBV, RFBM), 8);
+  }
+}
+
+void OpDispatchBuilder::XRStoreOp(OpcodeArgs) {
+  // Calculate flags early.
+  CalculateDeferredFlags();
+
+  OrderedNode *Mem = LoadSource(GPRClass, Op, Op->Dest, Op->Flags, -1, false);
+  Mem = AppendSegmentOffset(Mem, Op->Flags);
+
+  const uint64_t XCR0 = CTX->Config.EnableAVX ? 0b111 : 0b011;
+  OrderedNode *RFBM = _And(_LoadContext(4, GPRClass, GPROffset(X86State::REG_RAX)), _Constant(XCR0));
+
+  // Requested components are loaded from memory if their XSTATE_BV bit is set, otherwise they are put in their init state.
+  // Components that weren't requested are left untouched.
+  OrderedNode *XStateBV = _LoadMem(GPRClass, 8, _Add(Mem, _Constant(512)), 8);
+  OrderedNode *LoadMask = _And(RFBM, XStateBV);
+  OrderedNode *InitMask = _Andn(RFBM, XStateBV);
+
+  XStateComponentIf(LoadMask, 0, [&] { RestoreX87State(Mem); });
+  XStateComponentIf(InitMask, 0, [&] { DefaultX87State(); });
+  XStateComponentIf(LoadMask, 1, [&] { RestoreSSEState(Mem); });
+  XStateComponentIf(InitMask, 1, [&] { DefaultSSEState(); });
+  if (CTX->Config.EnableAVX) {
+    XStateComponentIf(LoadMask, 2, [&] { RestoreAVXState(Mem); });
+    XStateComponentIf(InitMask, 2, [&] { DefaultAVXState(); });
+  }
+}
+
 void OpDispatchBuilder::PAlignrOp(OpcodeArgs) {
   OrderedNode *Src1 = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
   OrderedNode *Src2 = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
@@ -2455,6 +2609,99 @@ void OpDispatchBuilder::PHMINPOSUWOp(OpcodeArgs) {
   StoreResult(FPRClass, Op, Result, -1);
 }
 
+template<bool IsExplicit, bool IsMask>
+void OpDispatchBuilder::PCMPXSTRXOp(OpcodeArgs) {
+  LOGMAN_THROW_A_FMT(Op->Src[1].IsLiteral(), "Control needs to be literal here");
+  const auto Control = static_cast<uint8_t>(Op->Src[1].Data.Literal.Value);
+  const bool IsWord = (Control & 0b0000'0001) != 0;
+  // For the index forms this selects the most significant index, for the mask forms an element mask
+  const bool Bit6 = (Control & 0b0100'0000) != 0;
+
+  // Invalidate deferred flags early
+  InvalidateDeferredFlags();
+
+  OrderedNode *LHS = LoadSource(FPRClass, Op, Op->Dest, Op->Flags, -1);
+  OrderedNode *RHS = LoadSource(FPRClass, Op, Op->Src[0], Op->Flags, -1);
+
+  OrderedNode *Result{};
+  if constexpr (IsExplicit) {
+    // Lengths are signed. REX.W selects RAX/RDX, otherwise EAX/EDX are sign extended.
+    const bool Is64Bit = (Op->Flags & FEXCore::X86Tables::DecodeFlags::FLAG_REX_WIDENING) != 0;
+    OrderedNode *RAX = _LoadContext(Is64Bit ? 8 : 4, GPRClass, GPROffset(X86State::REG_RAX));
+    OrderedNode *RDX = _LoadContext(Is64Bit ? 8 : 4, GPRClass, GPROffset(X86State::REG_RDX));
+    if (!Is64Bit) {
+      RAX = _Sbfe(32, 0, RAX);
+      RDX = _Sbfe(32, 0, RDX);
+    }
+    Result = _VPCMPSTRX(LHS, RHS, RAX, RDX, Control, false);
+  }
+  else {
+    auto Unused = _Constant(0);
+    Result = _VPCMPSTRX(LHS, RHS, Unused, Unused, Control, true);
+  }
+
+  auto ZeroConst = _Constant(0);
+  auto OneConst = _Constant(1);
+  OrderedNode *IntRes2 = _Bfe(16, 0, Result);
+
+  SetRFLAG<FEXCore::X86State::RFLAG_CF_LOC>(_Select(FEXCore::IR::COND_NEQ,
+      IntRes2, ZeroConst, OneConst, ZeroConst));
+  SetRFLAG<FEXCore::X86State::RFLAG_ZF_LOC>(_Bfe(1, 16, Result));
+  SetRFLAG<FEXCore::X86State::RFLAG_SF_LOC>(_Bfe(1, 17, Result));
+  SetRFLAG<FEXCore::X86State::RFLAG_OF_LOC>(_Bfe(1, 0, Result));
+
+  SetRFLAG<FEXCore::X86State::RFLAG_AF_LOC>(ZeroConst);
+  SetRFLAG<FEXCore::X86State::RFLAG_PF_LOC>(ZeroConst);
+
+  if constexpr (IsMask) {
+    OrderedNode *Mask = _VCastFromGPR(16, 8, IntRes2);
+
+    if (Bit6) {
+      // Expand each bit of IntRes2 to a full element.
+      // Broadcast the byte holding each element's bit, then compare against the element's bit weight.
+      OrderedNode *Indices{};
+      OrderedNode *Weights{};
+      if (IsWord) {
+        Indices = _VectorZero(16);
+        Weights = _VCastFromGPR(16, 8, _Constant(0x0008'0004'0002'0001ULL));
+        Weights = _VInsGPR(16, 8, 1, Weights, _Constant(0x0080'0040'0020'0010ULL));
+      }
+      else {
+        auto M = _Constant(0x80'40'20'10'08'04'02'01ULL);
+        Indices = _VInsGPR(16, 8, 1, _VectorZero(16), _Constant(0x01'01'01'01'01'01'01'01ULL));
+        Weights = _VCastFromGPR(16, 8, M);
+        Weights = _VInsGPR(16, 8, 1, Weights, M);
+      }
+
+      const uint8_t ElementSize = IsWord ? 2 : 1;
+      auto Bits = _VTBL1(16, Mask, Indices);
+      Mask = _VCMPEQ(16, ElementSize, _VAnd(16, ElementSize, Bits, Weights), Weights);
+    }
+
+    _StoreContext(16, FPRClass, Mask, offsetof(FEXCore::Core::CPUState, xmm[0]));
+  }
+  else {
+    const uint8_t GPRSize = CTX->GetGPRSize();
+    const uint64_t NumElements = IsWord ? 8 : 16;
+
+    OrderedNode *Index = Bit6 ? _FindMSB(IntRes2) : _FindLSB(IntRes2);
+    Index = _Select(FEXCore::IR::COND_EQ,
+        IntRes2, ZeroConst, _Constant(NumElements), Index);
+
+    // The index is written to ECX and zero extends in to RCX
+    _StoreContext(GPRSize, GPRClass, Index, GPROffset(X86State::REG_RCX));
+  }
+}
+
+template
+void OpDispatchBuilder::PCMPXSTRXOp<false, false>(OpcodeArgs);
+template
+void OpDispatchBuilder::PCMPXSTRXOp<false, true>(OpcodeArgs);
+template
+void OpDispatchBuilder::PCMPXSTRXOp<true, false>(OpcodeArgs);
+template
+void OpDispatchBuilder::PCMPXSTRXOp<true, true>(OpcodeArgs);
+
 template<size_t ElementSize>
 void OpDispatchBuilder::DPPOp(OpcodeArgs) {
   LOGMAN_THROW_A_FMT(Op->Src[1].IsLiteral(), "Src1 needs to be literal here");
@@ -0,0 +1,416 @@
+/*
+$info$
+tags: glue|profiler
+desc: Samples guest execution with a thread CPU-time timer and attributes host PCs back to guest RIPs
+$end_info$
+*/
+
+#include "Interface/Context/Context.h"
+#include "Interface/Core/ArchHelpers/MContext.h"
+#include "Interface/Core/Dispatcher/Dispatcher.h"
+#include "Interface/Core/SamplingProfiler.h"
+#include "Interface/IR/AOTIR.h"
+
+#include <FEXCore/Core/CPUBackend.h>
+#include <FEXCore/Core/SignalDelegator.h>
+#include <FEXCore/Debug/InternalThreadState.h>
+#include <FEXCore/HLE/SyscallHandler.h>
+#include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXHeaderUtils/Syscalls.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fmt/format.h>
+#include <fstream>
+#include <iterator>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace FEXCore {
+  ThreadSampler::ThreadSampler(FEXCore::Core::InternalThreadState *Thread, uint32_t Hz)
+    : Thread {Thread}
+    , Hz {std::max(Hz, 1U)} {
+    // Allocated up front so the signal handler never needs to
+    auto Ptr = FEXCore::Allocator::mmap(nullptr, sizeof(Sample) * NUM_SAMPLES, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (Ptr == MAP_FAILED) {
+      LogMan::Msg::EFmt("Couldn't allocate sample table");
+      return;
+    }
+
+    Samples = reinterpret_cast<Sample*>(Ptr);
+  }
+
+  ThreadSampler::~ThreadSampler() {
+    StopTimer();
+
+    if (Samples) {
+      FEXCore::Allocator::munmap(Samples, sizeof(Sample) * NUM_SAMPLES);
+    }
+  }
+
+  void ThreadSampler::StartTimer() {
+    if (!Samples || TimerID != -1) {
+      return;
+    }
+
+    // Using the thread CPU clock means a thread blocked in a syscall doesn't generate samples
+    // Must be called from the thread being sampled
+    sigevent Event{};
+    Event.sigev_notify = SIGEV_THREAD_ID;
+    Event.sigev_signo = SignalDelegator::SIGNAL_FOR_PROFILE;
+    Event.sigev_value.sival_ptr = this;
+    Event.sigev_notify_thread_id = FHU::Syscalls::gettid();
+
+    int NewTimer{};
+    if (::syscall(SYS_timer_create, CLOCK_THREAD_CPUTIME_ID, &Event, &NewTimer) == -1) {
+      LogMan::Msg::EFmt("Couldn't create sampling timer: {}", strerror(errno));
+      return;
+    }
+
+    const uint64_t Interval = 1'000'000'000ULL / Hz;
+    itimerspec Spec{};
+    Spec.it_interval.tv_sec = Interval / 1'000'000'000ULL;
+    Spec.it_interval.tv_nsec = Interval % 1'000'000'000ULL;
+    Spec.it_value = Spec.it_interval;
+
+    if (::syscall(SYS_timer_settime, NewTimer, 0, &Spec, nullptr) == -1) {
+      LogMan::Msg::EFmt("Couldn't arm sampling timer: {}", strerror(errno));
+      ::syscall(SYS_timer_delete, NewTimer);
+      return;
+    }
+
+    TimerID = NewTimer;
+  }
+
+  void ThreadSampler::StopTimer() {
+    if (TimerID == -1) {
+      return;
+    }
+
+    ::syscall(SYS_timer_delete, TimerID);
+    TimerID = -1;
+  }
+
+  void ThreadSampler::AddBlock(uint64_t GuestRIP, uintptr_t HostCode, FEXCore::Core::DebugData const *DebugData) {
+    // The signal handler runs on this thread, so only compiler ordering matters here
+    Updating.store(true, std::memory_order_relaxed);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    // Cold code is split away from the rest of the block, so it gets a range of its own
+    auto AddRange = [&](uintptr_t HostStart, uint64_t Size, bool Cold) {
+      if (Size == 0) {
+        return;
+      }
+
+      BlockRange Range {
+        .HostStart = HostStart,
+        .HostEnd = HostStart + Size,
+        .GuestRIP = GuestRIP,
+        .FirstOpcode = static_cast<uint32_t>(Opcodes.size()),
+        .NumOpcodes = 0,
+      };
+
+      // Host offsets are emitted in increasing order within each part so each range stays sorted
+      const uint64_t Base = HostStart - HostCode;
+      for (auto &Opcode : DebugData->GuestOpcodes) {
+        const uint64_t Offset = Opcode.HostEntryOffset;
+        if ((Offset >= DebugData->HostCodeSize) == Cold) {
+          Opcodes.push_back({static_cast<uint32_t>(Offset - Base), static_cast<uint32_t>(Opcode.GuestEntryOffset)});
+          ++Range.NumOpcodes;
+        }
+      }
+
+      // Code is bump allocated so this is almost always an append
+      if (Blocks.empty() || Blocks.back().HostStart < HostStart) {
+        Blocks.push_back(Range);
+      }
+      else {
+        auto it = std::upper_bound(Blocks.begin(), Blocks.end(), HostStart, [](uintptr_t HostCode, BlockRange const &Block) {
+          return HostCode < Block.HostStart;
+        });
+        Blocks.insert(it, Range);
+      }
+    };
+
+    AddRange(HostCode, DebugData->HostCodeSize, false);
+    AddRange(HostCode + DebugData->HostColdCodeOffset, DebugData->HostColdCodeSize, true);
+
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    Updating.store(false, std::memory_order_relaxed);
+  }
+
+  void ThreadSampler::ClearBlocks() {
+    Updating.store(true, std::memory_order_relaxed);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    Blocks.clear();
+    Opcodes.clear();
+
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    Updating.store(false, std::memory_order_relaxed);
+  }
+
+  void ThreadSampler::RemoveBlocks(uintptr_t HostStart, uintptr_t HostEnd) {
+    Updating.store(true, std::memory_order_relaxed);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    auto Begin = std::lower_bound(Blocks.begin(), Blocks.end(), HostStart, [](BlockRange const &Block, uintptr_t HostCode) {
+      return Block.HostStart < HostCode;
+    });
+    auto End = std::lower_bound(Begin, Blocks.end(), HostEnd, [](BlockRange const &Block, uintptr_t HostCode) {
+      return Block.HostStart < HostCode;
+    });
+    Blocks.erase(Begin, End);
+
+    // Compact the opcode ranges of the blocks that are left
+    std::vector<OpcodeRange> LiveOpcodes;
+    for (auto &Block : Blocks) {
+      const auto First = static_cast<uint32_t>(LiveOpcodes.size());
+      LiveOpcodes.insert(LiveOpcodes.end(), Opcodes.begin() + Block.FirstOpcode, Opcodes.begin() + Block.FirstOpcode + Block.NumOpcodes);
+      Block.FirstOpcode = First;
+    }
+    Opcodes = std::move(LiveOpcodes);
+
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    Updating.store(false, std::memory_order_relaxed);
+  }
+
+  void ThreadSampler::ClearSamples() {
+    if (Samples) {
+      memset(Samples, 0, sizeof(Sample) * NUM_SAMPLES);
+    }
+    DroppedSamples = 0;
+    Merged = false;
+  }
+
+  bool ThreadSampler::FindGuestRIP(uintptr_t PC, uint64_t *BlockRIP, uint64_t *GuestRIP) const {
+    auto Block = std::upper_bound(Blocks.begin(), Blocks.end(), PC, [](uintptr_t PC, BlockRange const &Block) {
+      return PC < Block.HostStart;
+    });
+
+    if (Block == Blocks.begin()) {
+      return false;
+    }
+
+    --Block;
+    if (PC >= Block->HostEnd) {
+      return false;
+    }
+
+    // Find the last guest instruction that starts at or before the PC
+    const uint32_t Offset = PC - Block->HostStart;
+    auto First = Opcodes.begin() + Block->FirstOpcode;
+    auto Last = First + Block->NumOpcodes;
+    auto Opcode = std::upper_bound(First, Last, Offset, [](uint32_t Offset, OpcodeRange const &Opcode) {
+      return Offset < Opcode.HostOffset;
+    });
+
+    *BlockRIP = Block->GuestRIP;
+    *GuestRIP = Block->GuestRIP;
+    if (Opcode != First) {
+      *GuestRIP += std::prev(Opcode)->GuestOffset;
+    }
+    return true;
+  }
+
+  void ThreadSampler::RecordSample(uint32_t Kind, uint64_t BlockRIP, uint64_t GuestRIP) {
+    uint64_t Hash = (GuestRIP ^ (BlockRIP << 7) ^ Kind) * 0x9E37'79B9'7F4A'7C15ULL;
+    size_t Index = Hash >> 40;
+
+    for (size_t i = 0; i < MAX_PROBE; ++i, ++Index) {
+      auto &Entry = Samples[Index & (NUM_SAMPLES - 1)];
+      if (Entry.Count == 0) {
+        Entry.BlockRIP = BlockRIP;
+        Entry.GuestRIP = GuestRIP;
+        Entry.Kind = Kind;
+        // Publish the count last, a non-zero count is what marks the entry as used
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        Entry.Count = 1;
+        return;
+      }
+
+      if (Entry.GuestRIP == GuestRIP && Entry.BlockRIP == BlockRIP && Entry.Kind == Kind) {
+        ++Entry.Count;
+        return;
+      }
+    }
+
+    ++DroppedSamples;
+  }
+
+  bool ThreadSampler::HandleSignal(void *info, void *ucontext) {
+    auto SigInfo = reinterpret_cast<siginfo_t*>(info);
+    if (SigInfo->si_code != SI_TIMER || SigInfo->si_value.sival_ptr != this) {
+      // Not our timer, let the guest have it
+      return false;
+    }
+
+    if (TimerID == -1) {
+      // Already queued when the timer was deleted
+      return true;
+    }
+
+    const uintptr_t PC = ArchHelpers::Context::GetPc(ucontext);
+    const uint64_t FrameRIP = Thread->CurrentFrame->State.rip;
+
+    if (Thread->CPUBackend && Thread->CPUBackend->IsAddressInCodeBuffer(PC)) {
+      uint64_t BlockRIP{}, GuestRIP{};
+      if (!Updating.load(std::memory_order_relaxed) && FindGuestRIP(PC, &BlockRIP, &GuestRIP)) {
+        RecordSample(SAMPLE_JIT, BlockRIP, GuestRIP);
+      }
+      else {
+        RecordSample(SAMPLE_JIT_UNKNOWN, 0, FrameRIP);
+      }
+    }
+    else if (Thread->CTX->Dispatcher->IsAddressInDispatcher(PC)) {
+      RecordSample(SAMPLE_DISPATCHER, 0, FrameRIP);
+    }
+    else {
+      RecordSample(SAMPLE_FEX, 0, FrameRIP);
+    }
+
+    return true;
+  }
+
+  SamplingProfiler::SamplingProfiler(FEXCore::Context::Context *CTX, std::string const &OutputPath, uint32_t Hz)
+    : CTX {CTX}
+    , OutputPath {OutputPath}
+    , Hz {Hz} {
+  }
+
+  SamplingProfiler::~SamplingProfiler() = default;
+
+  bool SamplingProfiler::HandleSignal(FEXCore::Core::InternalThreadState *Thread, int Signal, void *info, void *ucontext) {
+    if (!Thread || !Thread->Sampler) {
+      return false;
+    }
+
+    return Thread->Sampler->HandleSignal(info, ucontext);
+  }
+
+  void SamplingProfiler::StartThread(FEXCore::Core::InternalThreadState *Thread) {
+    if (!Thread->Sampler) {
+      Thread->Sampler = std::make_unique<ThreadSampler>(Thread, Hz);
+    }
+
+    Thread->Sampler->StartTimer();
+    ++ActiveThreads;
+  }
+
+  void SamplingProfiler::StopThread(FEXCore::Core::InternalThreadState *Thread) {
+    if (!Thread->Sampler) {
+      return;
+    }
+
+    // The sampler itself stays alive with the thread, a timer signal may already be queued
+    Thread->Sampler->StopTimer();
+    MergeThread(Thread);
+
+    // The last thread out writes the profile
+    if (--ActiveThreads == 0) {
+      WriteProfile();
+    }
+  }
+
+  void SamplingProfiler::CleanupAfterFork(FEXCore::Core::InternalThreadState *LiveThread) {
+    // Everything collected so far belongs to the parent process
+    FoldedStacks.clear();
+    TotalSamples = 0;
+    DroppedSamples = 0;
+    Written = false;
+    ActiveThreads = 0;
+
+    // POSIX timers aren't inherited across fork
+    if (LiveThread->Sampler) {
+      LiveThread->Sampler->StopTimer();
+      LiveThread->Sampler->ClearSamples();
+    }
+    StartThread(LiveThread);
+  }
+
+  std::string SamplingProfiler::Symbolize(uint64_t RIP) {
+    if (CTX->SyscallHandler) {
+      auto Lookup = CTX->SyscallHandler->LookupAOTIRCacheEntry(RIP);
+      if (Lookup.Entry) {
+        return fmt::format("{}+0x{:x}", Lookup.Entry->Filename, RIP - Lookup.VAFileStart);
+      }
+    }
+
+    return fmt::format("0x{:x}", RIP);
+  }
+
+  void SamplingProfiler::MergeThread(FEXCore::Core::InternalThreadState *Thread) {
+    std::lock_guard lk(ProfileMutex);
+
+    auto Sampler = Thread->Sampler.get();
+    if (Written || !Sampler || Sampler->Merged) {
+      return;
+    }
+
+    const auto ThreadName = fmt::format("tid-{}", Thread->ThreadManager.TID);
+
+    Sampler->ForEachSample([&](ThreadSampler::Sample const &Sample) {
+      std::string Stack;
+      switch (Sample.Kind) {
+        case ThreadSampler::SAMPLE_JIT:
+          Stack = fmt::format("{};{};{}", ThreadName, Symbolize(Sample.BlockRIP), Symbolize(Sample.GuestRIP));
+          break;
+        case ThreadSampler::SAMPLE_JIT_UNKNOWN:
+          Stack = fmt::format("{};[JIT];{}", ThreadName, Symbolize(Sample.GuestRIP));
+          break;
+        case ThreadSampler::SAMPLE_DISPATCHER:
+          Stack = fmt::format("{};{};[Dispatcher]", ThreadName, Symbolize(Sample.GuestRIP));
+          break;
+        case ThreadSampler::SAMPLE_FEX:
+        default:
+          Stack = fmt::format("{};{};[FEX]", ThreadName, Symbolize(Sample.GuestRIP));
+          break;
+      }
+
+      FoldedStacks[Stack] += Sample.Count;
+      TotalSamples += Sample.Count;
+    });
+
+    DroppedSamples += Sampler->GetDroppedSamples();
+    Sampler->Merged = true;
+  }
+
+  void SamplingProfiler::WriteProfile() {
+    {
+      // Threads that are still running get merged as they are
+      // Their tables may still be getting written to, which only costs us the samples in flight
+      std::lock_guard lk(CTX->ThreadCreationMutex);
+      for (auto &Thread : CTX->Threads) {
+        MergeThread(Thread);
+      }
+    }
+
+    std::lock_guard lk(ProfileMutex);
+    if (Written) {
+      return;
+    }
+    Written = true;
+
+    // Child processes would otherwise overwrite the parent's profile
+    const auto Filename = fmt::format("{}.{}", OutputPath, ::getpid());
+    std::ofstream Output(Filename, std::ios::out | std::ios::trunc);
+    if (!Output.is_open()) {
+      LogMan::Msg::EFmt("Couldn't open sample profile '{}'", Filename);
+      return;
+    }
+
+    for (auto &[Stack, Count] : FoldedStacks) {
+      Output << Stack << " " << Count << "\n";
+    }
+
+    LogMan::Msg::IFmt("Wrote {} samples to '{}' ({} dropped)", TotalSamples, Filename, DroppedSamples);
+  }
+}
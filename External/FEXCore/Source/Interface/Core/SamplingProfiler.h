@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace FEXCore::Context {
+  struct Context;
+}
+
+namespace FEXCore::Core {
+  struct DebugData;
+  struct InternalThreadState;
+}
+
+namespace FEXCore {
+/**
+ * @brief Per-thread sample collection for the guest sampling profiler
+ *
+ * A thread CPU-time timer delivers SIGNAL_FOR_PROFILE to the owning thread.
+ * The signal handler maps the interrupted host PC back to a guest RIP through the
+ * block table this thread builds while compiling, then bumps a counter in a fixed-size table.
+ * The table is only ever written from the owning thread so no locking is required.
+ */
+class ThreadSampler final {
+public:
+  enum SampleKind : uint32_t {
+    // Host PC was inside a JIT block that we have debug data for
+    SAMPLE_JIT,
+    // Host PC was inside JIT code but the block is unknown, frame RIP is used
+    SAMPLE_JIT_UNKNOWN,
+    SAMPLE_DISPATCHER,
+    // Anything else: compiling, syscalls, thunks and the interpreter
+    SAMPLE_FEX,
+  };
+
+  struct Sample {
+    uint64_t BlockRIP;
+    uint64_t GuestRIP;
+    uint32_t Kind;
+    uint32_t Count;
+  };
+
+  ThreadSampler(FEXCore::Core::InternalThreadState *Thread, uint32_t Hz);
+  ~ThreadSampler();
+
+  void StartTimer();
+  void StopTimer();
+
+  // Called from CompileBlock on the owning thread
+  void AddBlock(uint64_t GuestRIP, uintptr_t HostCode, FEXCore::Core::DebugData const *DebugData);
+  // Called whenever the thread's code buffer is cleared
+  void ClearBlocks();
+  // Called when a segment of the code buffer is reused
+  void RemoveBlocks(uintptr_t HostStart, uintptr_t HostEnd);
+  // Drops collected samples, used after fork
+  void ClearSamples();
+
+  bool HandleSignal(void *info, void *ucontext);
+
+  template<typename F>
+  void ForEachSample(F &&Func) const {
+    for (size_t i = 0; i < NUM_SAMPLES; ++i) {
+      if (Samples[i].Count) {
+        Func(Samples[i]);
+      }
+    }
+  }
+
+  uint64_t GetDroppedSamples() const { return DroppedSamples; }
+
+  // Set once these samples have been folded in to the process profile
+  bool Merged{};
+
+private:
+  // Power of two, fixed up front so the signal handler never allocates
+  constexpr static size_t NUM_SAMPLES = 16384;
+  constexpr static size_t MAX_PROBE = 64;
+
+  struct BlockRange {
+    uintptr_t HostStart;
+    uintptr_t HostEnd;
+    uint64_t GuestRIP;
+    uint32_t FirstOpcode;
+    uint32_t NumOpcodes;
+  };
+
+  struct OpcodeRange {
+    uint32_t HostOffset;
+    uint32_t GuestOffset;
+  };
+
+  bool FindGuestRIP(uintptr_t PC, uint64_t *BlockRIP, uint64_t *GuestRIP) const;
+  void RecordSample(uint32_t Kind, uint64_t BlockRIP, uint64_t GuestRIP);
+
+  FEXCore::Core::InternalThreadState *Thread;
+  uint32_t Hz;
+  int TimerID{-1};
+
+  // Set while the block table is being modified so a sample landing in that window skips it
+  std::atomic<bool> Updating{};
+  std::vector<BlockRange> Blocks;
+  std::vector<OpcodeRange> Opcodes;
+
+  Sample *Samples{};
+  uint64_t DroppedSamples{};
+};
+
+/**
+ * @brief Process wide state for the guest sampling profiler
+ *
+ * Threads merge their samples in here on exit, the result is written out in the
+ * folded stack format consumed by flamegraph.pl and speedscope.
+ */
+class SamplingProfiler final {
+public:
+  SamplingProfiler(FEXCore::Context::Context *CTX, std::string const &OutputPath, uint32_t Hz);
+  ~SamplingProfiler();
+
+  void StartThread(FEXCore::Core::InternalThreadState *Thread);
+  void StopThread(FEXCore::Core::InternalThreadState *Thread);
+  void CleanupAfterFork(FEXCore::Core::InternalThreadState *LiveThread);
+
+  // Merges all live threads and writes the profile, only the first call does anything
+  void WriteProfile();
+
+  static bool HandleSignal(FEXCore::Core::InternalThreadState *Thread, int Signal, void *info, void *ucontext);
+
+private:
+  void MergeThread(FEXCore::Core::InternalThreadState *Thread);
+  std::string Symbolize(uint64_t RIP);
+
+  FEXCore::Context::Context *CTX;
+  std::string OutputPath;
+  uint32_t Hz;
+  std::atomic<uint32_t> ActiveThreads{};
+
+  std::mutex ProfileMutex;
+  std::map<std::string, uint64_t> FoldedStacks;
+  uint64_t TotalSamples{};
+  uint64_t DroppedSamples{};
+  bool Written{};
+};
+}
@@ -0,0 +1,166 @@
+/*
+$info$
+tags: glue|stats
+desc: Exposes per-thread runtime counters through shared memory for FEXStats
+$end_info$
+*/
+
+#include "Interface/Core/SharedStats.h"
+
+#include <FEXCore/Debug/InternalThreadState.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXHeaderUtils/Syscalls.h>
+
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace FEXCore {
+  std::unique_ptr<SharedStats> SharedStats::Create() {
+    std::unique_ptr<SharedStats> Stats {new SharedStats()};
+    if (!Stats->Map(nullptr)) {
+      return {};
+    }
+
+    return Stats;
+  }
+
+  SharedStats::~SharedStats() {
+    if (Header) {
+      munmap(Header, sizeof(FEXCore::Stats::StatsHeader));
+      unlink(Path.c_str());
+    }
+  }
+
+  bool SharedStats::Map(void *FixedAddress) {
+    Path = FEXCore::Stats::GetSharedMemoryPath(::getpid());
+
+    int FD = open(Path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (FD == -1) {
+      LogMan::Msg::EFmt("Couldn't create stats region '{}': {}", Path, strerror(errno));
+      return false;
+    }
+
+    constexpr size_t Size = sizeof(FEXCore::Stats::StatsHeader);
+    if (ftruncate(FD, Size) == -1) {
+      LogMan::Msg::EFmt("Couldn't size stats region '{}': {}", Path, strerror(errno));
+      close(FD);
+      unlink(Path.c_str());
+      return false;
+    }
+
+    int Flags = MAP_SHARED;
+    if (FixedAddress) {
+      Flags |= MAP_FIXED;
+    }
+
+    auto Ptr = mmap(FixedAddress, Size, PROT_READ | PROT_WRITE, Flags, FD, 0);
+    close(FD);
+
+    if (Ptr == MAP_FAILED) {
+      LogMan::Msg::EFmt("Couldn't map stats region '{}': {}", Path, strerror(errno));
+      unlink(Path.c_str());
+      return false;
+    }
+
+    Header = reinterpret_cast<FEXCore::Stats::StatsHeader*>(Ptr);
+    Header->Version = FEXCore::Stats::STATS_VERSION;
+    Header->Size = Size;
+    Header->PID = ::getpid();
+    Header->MaxThreads = FEXCore::Stats::MAX_THREADS;
+
+    // Magic goes last, readers treat the region as invalid until it is set
+    std::atomic_thread_fence(std::memory_order_release);
+    Header->Magic = FEXCore::Stats::STATS_MAGIC;
+    return true;
+  }
+
+  void SharedStats::AllocateSlot(FEXCore::Core::InternalThreadState *Thread) {
+    std::lock_guard lk(SlotMutex);
+
+    for (auto &Slot : Header->Threads) {
+      if (Slot.TID.load(std::memory_order_relaxed) != 0) {
+        continue;
+      }
+
+      Slot.TID.store(Thread->ThreadManager.TID, std::memory_order_release);
+      Thread->Stats = &Slot;
+      Thread->CurrentFrame->Stats = &Slot;
+      return;
+    }
+
+    LogMan::Msg::DFmt("Stats region full, thread {} won't be visible", Thread->ThreadManager.TID);
+  }
+
+  void SharedStats::FreeSlot(FEXCore::Core::InternalThreadState *Thread) {
+    auto Slot = Thread->Stats;
+    if (Slot == &Thread->LocalStats) {
+      return;
+    }
+
+    Thread->Stats = &Thread->LocalStats;
+    Thread->CurrentFrame->Stats = &Thread->LocalStats;
+
+    std::lock_guard lk(SlotMutex);
+
+    auto Src = FEXCore::Core::GetStatCounters(Slot);
+    auto Dst = FEXCore::Core::GetStatCounters(&Header->Retired);
+    for (size_t i = 0; i < FEXCore::Core::NUM_STAT_COUNTERS; ++i) {
+      Dst[i].fetch_add(Src[i].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    Slot->TID.store(0, std::memory_order_release);
+  }
+
+  uint32_t SharedStats::GetPassIndex(std::string_view Name) {
+    const auto Truncated = Name.substr(0, FEXCore::Stats::PASS_NAME_LENGTH - 1);
+
+    // Passes are the same for every thread, so after the first block this never takes the lock
+    auto Lookup = [this, Truncated](uint32_t NumPasses) -> uint32_t {
+      for (uint32_t i = 0; i < NumPasses; ++i) {
+        if (Truncated == Header->PassNames[i]) {
+          return i;
+        }
+      }
+      return FEXCore::Core::RuntimeStats::MAX_PASSES;
+    };
+
+    auto Index = Lookup(Header->NumPasses.load(std::memory_order_acquire));
+    if (Index != FEXCore::Core::RuntimeStats::MAX_PASSES) {
+      return Index;
+    }
+
+    std::lock_guard lk(SlotMutex);
+    const auto NumPasses = Header->NumPasses.load(std::memory_order_relaxed);
+    Index = Lookup(NumPasses);
+    if (Index != FEXCore::Core::RuntimeStats::MAX_PASSES || NumPasses == FEXCore::Core::RuntimeStats::MAX_PASSES) {
+      return Index;
+    }
+
+    memcpy(Header->PassNames[NumPasses], Truncated.data(), Truncated.size());
+    Header->PassNames[NumPasses][Truncated.size()] = '\0';
+    Header->NumPasses.store(NumPasses + 1, std::memory_order_release);
+    return NumPasses;
+  }
+
+  void SharedStats::CleanupAfterFork(FEXCore::Core::InternalThreadState *LiveThread) {
+    // The mutex may have been held by a thread that no longer exists
+    new (&SlotMutex) std::mutex();
+
+    const bool HadSlot = LiveThread->Stats != &LiveThread->LocalStats;
+    auto Slot = LiveThread->Stats;
+
+    // Replacing the mapping in place keeps every Stats pointer valid
+    if (!Map(Header)) {
+      // Can't leave the parent's region mapped, we would keep writing to it
+      Header = reinterpret_cast<FEXCore::Stats::StatsHeader*>(mmap(Header, sizeof(FEXCore::Stats::StatsHeader), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0));
+      return;
+    }
+
+    if (HadSlot) {
+      Slot->TID.store(FHU::Syscalls::gettid(), std::memory_order_release);
+    }
+  }
+}
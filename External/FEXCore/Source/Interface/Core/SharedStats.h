@@ -0,0 +1,45 @@
+#pragma once
+
+#include <FEXCore/Debug/RuntimeStats.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace FEXCore::Core {
+  struct InternalThreadState;
+}
+
+namespace FEXCore {
+/**
+ * @brief Owns the shared memory region that exposes per-thread RuntimeStats to FEXStats
+ */
+class SharedStats final {
+public:
+  // Returns nullptr if the region couldn't be created
+  static std::unique_ptr<SharedStats> Create();
+  ~SharedStats();
+
+  // Moves the thread's counters in to a slot of the shared region
+  // Threads past MAX_THREADS keep using their private counters
+  void AllocateSlot(FEXCore::Core::InternalThreadState *Thread);
+  // Folds the thread's counters in to the retired totals and releases the slot
+  void FreeSlot(FEXCore::Core::InternalThreadState *Thread);
+
+  // Returns MAX_PASSES if the pass table is full
+  uint32_t GetPassIndex(std::string_view Name);
+
+  // The child gets a fresh region mapped over the parent's one so existing pointers remain valid
+  void CleanupAfterFork(FEXCore::Core::InternalThreadState *LiveThread);
+
+private:
+  SharedStats() = default;
+  bool Map(void *FixedAddress);
+
+  FEXCore::Stats::StatsHeader *Header{};
+  std::string Path;
+  std::mutex SlotMutex;
+};
+}
@@ -63,7 +63,10 @@ void GDBJITRegister(FEXCore::IR::AOTIRCacheEntry *Entry, uintptr_t VAFileStart,
       }
     }
 
-    size_t size = sizeof(info_t) + 1 * sizeof(blocks_t) +
+    // Cold code is emitted away from the rest of the block and gets a second range
+    const int nblocks = DebugData->HostColdCodeSize ? 2 : 1;
+
+    size_t size = sizeof(info_t) + nblocks * sizeof(blocks_t) +
                   Lines.size() * sizeof(gdb_line_mapping);
 
     auto mem = (uint8_t *)malloc(size);
@@ -73,7 +76,7 @@ void GDBJITRegister(FEXCore::IR::AOTIRCacheEntry *Entry, uintptr_t VAFileStart,
 
     strncpy(info->filename, map->SourceFile.c_str(), 511);
 
-    info->nblocks = 1;
+    info->nblocks = nblocks;
 
     auto blocks = (blocks_t *)mem;
     info->blocks_ofs = mem - base;
@@ -82,8 +85,13 @@ void GDBJITRegister(FEXCore::IR::AOTIRCacheEntry *Entry, uintptr_t VAFileStart,
 
     for (int i = 0; i < info->nblocks; i++) {
       strncpy(blocks[i].name, SymName.c_str(), 511);
-      blocks[i].start = HostEntry;
-      blocks[i].end = HostEntry + DebugData->HostCodeSize;
+      if (i == 0) {
+        blocks[i].start = HostEntry;
+        blocks[i].end = HostEntry + DebugData->HostCodeSize;
+      } else {
+        blocks[i].start = HostEntry + DebugData->HostColdCodeOffset;
+        blocks[i].end = blocks[i].start + DebugData->HostColdCodeSize;
+      }
     }
 
     info->nlines = Lines.size();
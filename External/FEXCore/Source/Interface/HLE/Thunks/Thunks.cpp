@@ -23,6 +23,7 @@ $end_info$
 #include <shared_mutex>
 #include <stdint.h>
 #include <string>
+#include <string.h>
 #include <utility>
 
 struct LoadlibArgs {
@@ -30,6 +31,18 @@ struct LoadlibArgs {
     uintptr_t CallbackThunks;
 };
 
+// LoadlibArgs as laid out by 32-bit guests
+struct LoadlibArgs32 {
+    uint32_t Name;
+    uint32_t CallbackThunks;
+};
+
+// Passed as arg1 of callbacks by host libraries generated for 32-bit guests
+struct GuestCallbackArgs {
+    void *Data;
+    uint32_t Size;
+};
+
 static thread_local FEXCore::Core::InternalThreadState *Thread;
 
 
@@ -56,10 +69,33 @@ namespace FEXCore {
             Set arg0/1 to arg regs, use CTX::HandleCallback to handle the callback
         */
         static void CallCallback(void *callback, void *arg0, void* arg1) {
-          Thread->CurrentFrame->State.gregs[FEXCore::X86State::REG_RDI] = (uintptr_t)arg0;
-          Thread->CurrentFrame->State.gregs[FEXCore::X86State::REG_RSI] = (uintptr_t)arg1;
+          auto &State = Thread->CurrentFrame->State;
+
+          if (Thread->CTX->Config.Is64BitMode) {
+            State.gregs[FEXCore::X86State::REG_RDI] = (uintptr_t)arg0;
+            State.gregs[FEXCore::X86State::REG_RSI] = (uintptr_t)arg1;
+
+            Thread->CTX->HandleCallback(Thread, (uintptr_t)callback);
+            return;
+          }
+
+          // Host memory isn't addressable by 32-bit guests, so the packed arguments
+          // live on the guest stack for the duration of the callback.
+          // The guest side unpacker is fastcall, which takes arguments in ecx and edx.
+          auto Args = reinterpret_cast<GuestCallbackArgs*>(arg1);
+          const uint64_t OldSP = State.gregs[FEXCore::X86State::REG_RSP];
+          const uint64_t GuestArgs = (OldSP - Args->Size) & ~15ULL;
+
+          memcpy(reinterpret_cast<void*>(GuestArgs), Args->Data, Args->Size);
+          State.gregs[FEXCore::X86State::REG_RSP] = GuestArgs;
+          State.gregs[FEXCore::X86State::REG_RCX] = (uintptr_t)arg0;
+          State.gregs[FEXCore::X86State::REG_RDX] = GuestArgs;
 
           Thread->CTX->HandleCallback(Thread, (uintptr_t)callback);
+
+          // Copy back so the host sees the return value
+          memcpy(Args->Data, reinterpret_cast<void*>(GuestArgs), Args->Size);
+          State.gregs[FEXCore::X86State::REG_RSP] = OldSP;
         }
 
         /**
@@ -76,22 +112,35 @@ namespace FEXCore {
                 uintptr_t target_addr;     // Guest function to call when branching to original_callee
             };
 
-            auto args = reinterpret_cast<args_t*>(argsv);
+            struct args32_t {
+                uint32_t original_callee;
+                uint32_t target_addr;
+            };
+
             auto CTX = Thread->CTX;
 
-            LOGMAN_THROW_A_FMT(args->original_callee, "Tried to link null pointer address to guest function");
-            LOGMAN_THROW_A_FMT(args->target_addr, "Tried to link address to null pointer guest function");
-            if (!CTX->Config.Is64BitMode) {
-                LOGMAN_THROW_A_FMT((args->original_callee >> 32) == 0, "Tried to link 64-bit address in 32-bit mode");
-                LOGMAN_THROW_A_FMT((args->target_addr >> 32) == 0, "Tried to link 64-bit address in 32-bit mode");
+            uintptr_t OriginalCallee;
+            uintptr_t TargetAddr;
+            if (CTX->Config.Is64BitMode) {
+                auto args = reinterpret_cast<args_t*>(argsv);
+                OriginalCallee = args->original_callee;
+                TargetAddr = args->target_addr;
+            }
+            else {
+                auto args = reinterpret_cast<args32_t*>(argsv);
+                OriginalCallee = args->original_callee;
+                TargetAddr = args->target_addr;
             }
 
+            LOGMAN_THROW_A_FMT(OriginalCallee, "Tried to link null pointer address to guest function");
+            LOGMAN_THROW_A_FMT(TargetAddr, "Tried to link address to null pointer guest function");
+
             LogMan::Msg::DFmt("Thunks: Adding trampoline from address {:#x} to guest function {:#x}",
-                              args->original_callee, args->target_addr);
+                              OriginalCallee, TargetAddr);
 
             auto Result = Thread->CTX->AddCustomIREntrypoint(
-                    args->original_callee,
-                    [CTX, GuestThunkEntrypoint = args->target_addr](uintptr_t Entrypoint, FEXCore::IR::IREmitter *emit) {
+                    OriginalCallee,
+                    [CTX, GuestThunkEntrypoint = TargetAddr](uintptr_t Entrypoint, FEXCore::IR::IREmitter *emit) {
                         auto IRHeader = emit->_IRHeader(emit->Invalid(), 0);
                         auto Block = emit->CreateCodeNode();
                         IRHeader.first->Blocks = emit->WrapNode(Block);
@@ -101,10 +150,10 @@ namespace FEXCore {
 
                         emit->_StoreContext(GPRSize, IR::GPRClass, emit->_Constant(Entrypoint), offsetof(Core::CPUState, gregs[X86State::REG_R11]));
                         emit->_ExitFunction(emit->_Constant(GuestThunkEntrypoint));
-                    }, CTX->ThunkHandler.get(), (void*)args->target_addr);
+                    }, CTX->ThunkHandler.get(), (void*)TargetAddr);
 
             if (!Result) {
-                if (Result.Creator != CTX->ThunkHandler.get() || Result.Data != (void*)args->target_addr) {
+                if (Result.Creator != CTX->ThunkHandler.get() || Result.Data != (void*)TargetAddr) {
                     ERROR_AND_DIE_FMT("Input address for LinkAddressToGuestFunction is already linked elsewhere");
                 }
             }
@@ -113,12 +162,28 @@ namespace FEXCore {
         static void LoadLib(void *ArgsV) {
             auto CTX = Thread->CTX;
 
-            auto Args = reinterpret_cast<LoadlibArgs*>(ArgsV);
+            const char *Name;
+            uintptr_t CallbackThunks;
+            std::string HostLibsPath = CTX->Config.ThunkHostLibsPath();
 
-            auto Name = Args->Name;
-            auto CallbackThunks = Args->CallbackThunks;
+            if (CTX->Config.Is64BitMode) {
+                auto Args = reinterpret_cast<LoadlibArgs*>(ArgsV);
+                Name = Args->Name;
+                CallbackThunks = Args->CallbackThunks;
+            }
+            else {
+                auto Args = reinterpret_cast<LoadlibArgs32*>(ArgsV);
+                Name = reinterpret_cast<const char*>(uintptr_t { Args->Name });
+                CallbackThunks = Args->CallbackThunks;
+
+                // Host libraries for 32-bit guests are generated against the guest's data layout, so they live in a sibling directory
+                while (!HostLibsPath.empty() && HostLibsPath.back() == '/') {
+                    HostLibsPath.pop_back();
+                }
+                HostLibsPath += "_32";
+            }
 
-            auto SOName = CTX->Config.ThunkHostLibsPath() + "/" + (const char*)Name + "-host.so";
+            auto SOName = HostLibsPath + "/" + Name + "-host.so";
 
             LogMan::Msg::DFmt("LoadLib: {} -> {}", Name, SOName);
 
@@ -171,6 +236,12 @@ namespace FEXCore {
             }
         }
 
+        void RegisterThunk(const IR::SHA256Sum &sha256, ThunkedFunction *Func) {
+            std::unique_lock lk(ThunksMutex);
+
+            Thunks[sha256] = Func;
+        }
+
         void RegisterTLSState(FEXCore::Core::InternalThreadState *Thread) {
             ::Thread = Thread;
         }
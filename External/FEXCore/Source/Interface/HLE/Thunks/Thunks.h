@@ -24,6 +24,7 @@ namespace FEXCore {
     class ThunkHandler {
     public:
         virtual ThunkedFunction* LookupThunk(const IR::SHA256Sum &sha256) = 0;
+        virtual void RegisterThunk(const IR::SHA256Sum &sha256, ThunkedFunction *Func) = 0;
         virtual void RegisterTLSState(FEXCore::Core::InternalThreadState *Thread) = 0;
         virtual ~ThunkHandler() { }
 
@@ -309,7 +309,7 @@ namespace FEXCore::IR {
         }
 
         // Add to AOT cache if aot generation is enabled
-        if (GeneratedIR && RAData &&
+        if (GeneratedIR && RAData && IRList &&
             (CTX->Config.AOTIRCapture() || CTX->Config.AOTIRGenerate())) {
 
           auto hash = XXH3_64bits((void*)StartAddr, Length);
@@ -322,7 +322,8 @@ namespace FEXCore::IR {
           // lambda can't be used as an std::function due to being non-copyable
           auto RADataCopy = RAData->CreateCopy();
           auto RADataCopyDeleter = RADataCopy.get_deleter();
-          auto IRListCopy = IRList->CreateCopy();
+          // Shares the IR rather than copying it, the writeout drops its reference when done
+          auto IRListCopy = IRList->Share();
           AOTIRCaptureCacheWriteoutQueue_Append([this, LocalRIP, LocalStartAddr, Length, hash, IRListCopy, RADataCopy=RADataCopy.release(), RADataCopyDeleter, FileId]() {
 
             // It is guaranteed via AOTIRCaptureCacheWriteoutLock and AOTIRCaptureCacheWriteoutFlusing that this will not run concurrently
@@ -350,7 +351,7 @@ namespace FEXCore::IR {
 
       // Insert to caches if we generated IR
       if (GeneratedIR) {
-        if (CTX->GetGdbServerStatus()) {
+        if (CTX->GetGdbServerStatus() && IRList) {
           // Add to thread local ir cache
           Core::LocalIREntry Entry = {StartAddr, Length, decltype(Entry.IR)(IRList), std::move(RAData), decltype(Entry.DebugData)(DebugData)};
           
@@ -360,7 +361,9 @@ namespace FEXCore::IR {
         else {
           // If the IR doesn't need to be retained then we can just delete it now
           delete DebugData;
-          delete IRList;
+          if (IRList) {
+            FEXCore::IR::IRListViewDeleter{}(IRList);
+          }
         }
       }
     }
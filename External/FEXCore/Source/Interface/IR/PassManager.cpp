@@ -13,38 +13,46 @@ $end_info$
 
 #include <FEXCore/Config/Config.h>
 
+#include <chrono>
+
 namespace FEXCore::IR {
 class IREmitter;
 
-void PassManager::AddDefaultPasses(FEXCore::Context::Context *ctx, bool InlineConstants, bool StaticRegisterAllocation) {
+void PassManager::AddDefaultPasses(FEXCore::Context::Context *ctx, bool InlineConstants, bool StaticRegisterAllocation, uint32_t NumStaticGPRs, uint32_t NumStaticFPRs) {
   FEX_CONFIG_OPT(DisablePasses, O0);
 
   if (!DisablePasses()) {
-    InsertPass(CreateContextLoadStoreElimination());
+    InsertPass(CreateContextLoadStoreElimination(), "RCLSE");
 
     if (Is64BitMode()) {
       // This needs to run after RCLSE
       // This only matters for 64-bit code since these instructions don't exist in 32-bit
-      InsertPass(CreateLongDivideEliminationPass());
+      InsertPass(CreateLongDivideEliminationPass(), "LongDivideElimination");
     }
 
-    InsertPass(CreateDeadStoreElimination());
-    InsertPass(CreatePassDeadCodeElimination());
-    InsertPass(CreateConstProp(InlineConstants, ctx->HostFeatures.SupportsTSOImm9));
+    InsertPass(CreateDeadStoreElimination(), "DSE");
+    InsertPass(CreatePassDeadCodeElimination(), "DCE");
+    InsertPass(CreateConstProp(InlineConstants, ctx->HostFeatures.SupportsTSOImm9), "ConstProp");
+    // Runs after ConstProp so constant address offsets are already folded in to the memory ops
+    InsertPass(CreateMemoryLoadStoreElimination(), "MemoryLSE");
+
+    if (ctx->Config.Multiblock) {
+      InsertPass(CreateMultiblockLoopOptimization(), "LoopOpt");
+    }
 
     ////// InsertPass(CreateDeadFlagCalculationEliminination());
 
-    InsertPass(CreateSyscallOptimization());
-    InsertPass(CreatePassDeadCodeElimination());
+    InsertPass(CreateSyscallOptimization(), "SyscallOptimization");
+    InsertPass(CreatePassDeadCodeElimination(), "DCE2");
 
     // only do SRA if enabled and JIT
     if (InlineConstants && StaticRegisterAllocation)
-      InsertPass(CreateStaticRegisterAllocationPass());
+      InsertPass(CreateStaticRegisterAllocationPass(NumStaticGPRs, NumStaticFPRs), "SRA");
   }
   else {
     // only do SRA if enabled and JIT
     if (InlineConstants && StaticRegisterAllocation)
-      InsertPass(CreateStaticRegisterAllocationPass());
+      InsertPass(CreateStaticRegisterAllocationPass(NumStaticGPRs, NumStaticFPRs), "SRA");
   }
 
   // If the IR is compacted post-RA then the node indexing gets messed up and the backend isn't able to find the register assigned to a node
@@ -67,8 +75,18 @@ void PassManager::InsertRegisterAllocationPass(bool OptimizeSRA) {
 
 bool PassManager::Run(IREmitter *IREmit) {
   bool Changed = false;
-  for (auto const &Pass : Passes) {
-    Changed |= Pass->Run(IREmit);
+  if (TimingHandler) {
+    for (size_t i = 0; i < Passes.size(); ++i) {
+      const auto Start = std::chrono::steady_clock::now();
+      Changed |= Passes[i]->Run(IREmit);
+      const auto Duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start);
+      TimingHandler(PassNames[i].empty() ? "Unnamed" : PassNames[i], Duration.count());
+    }
+  }
+  else {
+    for (auto const &Pass : Passes) {
+      Changed |= Pass->Run(IREmit);
+    }
   }
 
 #if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
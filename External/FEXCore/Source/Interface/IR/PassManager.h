@@ -11,6 +11,8 @@ $end_info$
 
 #include <functional>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -18,11 +20,16 @@ namespace FEXCore::HLE {
 class SyscallHandler;
 }
 
+namespace FEXCore::Core {
+struct RuntimeStats;
+}
+
 namespace FEXCore::IR {
 class PassManager;
 class IREmitter;
 
 using ShouldExitHandler = std::function<void(void)>;
+using PassTimingHandler = std::function<void(std::string_view Name, uint64_t Nanoseconds)>;
 
 class Pass {
 public:
@@ -40,11 +47,12 @@ protected:
 class PassManager final {
   friend class SyscallOptimization;
 public:
-  void AddDefaultPasses(FEXCore::Context::Context *ctx, bool InlineConstants, bool StaticRegisterAllocation);
+  void AddDefaultPasses(FEXCore::Context::Context *ctx, bool InlineConstants, bool StaticRegisterAllocation, uint32_t NumStaticGPRs, uint32_t NumStaticFPRs);
   void AddDefaultValidationPasses();
   Pass* InsertPass(std::unique_ptr<Pass> Pass, std::string Name = "") {
     Pass->RegisterPassManager(this);
     auto PassPtr = Passes.emplace_back(std::move(Pass)).get();
+    PassNames.emplace_back(Name);
 
     if (!Name.empty()) {
       NameToPassMaping[Name] = PassPtr;
@@ -60,6 +68,15 @@ public:
     ExitHandler = std::move(Handler);
   }
 
+  /**
+   * @brief Times every pass that runs and reports it to the handler
+   *
+   * Only used for benchmarking, an empty handler disables the timing.
+   */
+  void RegisterPassTimingHandler(PassTimingHandler Handler) {
+    TimingHandler = std::move(Handler);
+  }
+
   bool HasPass(std::string Name) const {
     return NameToPassMaping.contains(Name);
   }
@@ -77,12 +94,28 @@ public:
     SyscallHandler = Handler;
   }
 
+  /**
+   * @brief Counters passes report their work to, only set while SharedStats is enabled
+   *
+   * Must belong to the thread that runs the passes.
+   */
+  void RegisterStats(FEXCore::Core::RuntimeStats *_Stats) {
+    Stats = _Stats;
+  }
+
+  FEXCore::Core::RuntimeStats *GetStats() const {
+    return Stats;
+  }
+
 protected:
   ShouldExitHandler ExitHandler;
   FEXCore::HLE::SyscallHandler *SyscallHandler;
 
 private:
   std::vector<std::unique_ptr<Pass>> Passes;
+  std::vector<std::string> PassNames;
+  PassTimingHandler TimingHandler;
+  FEXCore::Core::RuntimeStats *Stats{};
   std::unordered_map<std::string, Pass*> NameToPassMaping;
 
 #if defined(ASSERTIONS_ENABLED) && ASSERTIONS_ENABLED
@@ -76,7 +76,7 @@ namespace {
     std::vector<ContextMemberInfo> ClassificationInfo;
   };
 
-  constexpr static std::array<LastAccessType, 16> DefaultAccess = {
+  constexpr static std::array<LastAccessType, 17> DefaultAccess = {
     ACCESS_NONE,
     ACCESS_NONE,
     ACCESS_INVALID, // PAD
@@ -93,6 +93,7 @@ namespace {
     ACCESS_NONE,
     ACCESS_NONE,
     ACCESS_NONE,
+    ACCESS_NONE,
   };
 
   static void ClassifyContextStruct(ContextInfo *ContextClassificationInfo) {
@@ -223,6 +224,18 @@ namespace {
       });
     }
 
+    // YMM upper halves
+    for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_YMM_UPPERS; ++i) {
+      ContextClassification->emplace_back(ContextMemberInfo{
+        ContextMemberClassification {
+          offsetof(FEXCore::Core::CPUState, ymm_upper[0][0]) + sizeof(FEXCore::Core::CPUState::ymm_upper[0]) * i,
+          FEXCore::Core::CPUState::YMM_UPPER_REG_SIZE
+        },
+        DefaultAccess[13],
+        FEXCore::IR::InvalidClass,
+      });
+    }
+
     // GDTs
     for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_GDTS; ++i) {
       ContextClassification->emplace_back(ContextMemberInfo{
@@ -230,7 +243,7 @@ namespace {
           offsetof(FEXCore::Core::CPUState, gdt[0]) + sizeof(FEXCore::Core::CPUState::gdt[0]) * i,
           sizeof(FEXCore::Core::CPUState::gdt[0]),
         },
-        DefaultAccess[13],
+        DefaultAccess[14],
         FEXCore::IR::InvalidClass,
       });
     }
@@ -241,7 +254,7 @@ namespace {
         offsetof(FEXCore::Core::CPUState, FCW),
         sizeof(FEXCore::Core::CPUState::FCW),
       },
-      DefaultAccess[14],
+      DefaultAccess[15],
       FEXCore::IR::InvalidClass,
     });
 
@@ -251,7 +264,7 @@ namespace {
         offsetof(FEXCore::Core::CPUState, FTW),
         sizeof(FEXCore::Core::CPUState::FTW),
       },
-      DefaultAccess[15],
+      DefaultAccess[16],
       FEXCore::IR::InvalidClass,
     });
 
@@ -313,12 +326,16 @@ namespace {
       SetAccess(Offset++, DefaultAccess[12]);
     }
 
-    for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_GDTS; ++i) {
+    for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_YMM_UPPERS; ++i) {
       SetAccess(Offset++, DefaultAccess[13]);
     }
 
-    SetAccess(Offset++, DefaultAccess[14]);
+    for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_GDTS; ++i) {
+      SetAccess(Offset++, DefaultAccess[14]);
+    }
+
     SetAccess(Offset++, DefaultAccess[15]);
+    SetAccess(Offset++, DefaultAccess[16]);
   }
 
   struct BlockInfo {
@@ -0,0 +1,377 @@
+/*
+$info$
+tags: ir|opts
+desc: Guest memory redundant load elimination and store to load forwarding
+$end_info$
+*/
+
+#include "Interface/IR/PassManager.h"
+
+#include <FEXCore/Debug/RuntimeStats.h>
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IREmitter.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdint.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace FEXCore::IR {
+
+/**
+ * @brief Removes guest memory loads that are known to return a value that is already in an SSA node
+ *
+ * eg.
+ *   (%%ssa40) StoreMem %ssa38 i64, %ssa12 i64, %ssa39 i64, 0x8, SXTX, 0x1
+ *   %ssa41 i64 = LoadMem %ssa12 i64, %ssa39 i64, 0x8, SXTX, 0x1
+ *   %ssa42 i64 = LoadMem %ssa12 i64, %ssa39 i64, 0x8, SXTX, 0x1
+ * Converts to
+ *   (%%ssa40) StoreMem %ssa38 i64, %ssa12 i64, %ssa39 i64, 0x8, SXTX, 0x1
+ *   Uses of %ssa41 and %ssa42 are replaced with %ssa38
+ *
+ * Alias analysis is a simple base + displacement model.
+ * Two accesses only don't alias if they share the same base and index nodes and their byte ranges are disjoint.
+ * Everything else is treated as aliasing, so an unknown store kills every tracked access.
+ *
+ * Tracking is reset at anything that can order or modify memory behind our back.
+ * TSO loads and stores, atomics, fences, syscalls, thunks and breaks all act as full barriers.
+ *
+ * Tracked state flows in to a successor block only if that block has a single predecessor that comes before it.
+ * That keeps the forwarded values dominating their uses and never carries a value around a loop backedge,
+ * which would break guest spin loops on plain loads.
+ * Every value forwarded from a predecessor stays live across the edge, so only MaxCrossBlockPerClass values
+ * of each register class are forwarded that way per function. Forwarding within a block is unlimited.
+ */
+class MemoryLoadStoreElimination final : public FEXCore::IR::Pass {
+public:
+  bool Run(IREmitter *IREmit) override;
+
+private:
+  // Cap on tracked accesses per block, keeps the linear alias scan cheap
+  constexpr static size_t MAX_TRACKED_ACCESSES = 32;
+
+  // Cap on values per register class forwarded from a predecessor block, each one extends a live range across an edge
+  constexpr static uint32_t MaxCrossBlockPerClass = 1;
+
+  struct MemoryAddress {
+    // Base node, or invalid if the address is an absolute constant
+    NodeID Base{};
+    // Index node, or invalid if the offset was folded in to the displacement
+    NodeID Index{};
+    MemOffsetType OffsetType{MEM_OFFSET_SXTX};
+    uint8_t OffsetScale{1};
+    int64_t Displacement{};
+
+    bool SameBase(MemoryAddress const &rhs) const {
+      return Base == rhs.Base &&
+             Index == rhs.Index &&
+             OffsetType == rhs.OffsetType &&
+             OffsetScale == rhs.OffsetScale;
+    }
+  };
+
+  struct MemoryAccess {
+    MemoryAddress Address;
+    uint8_t Size;
+    RegisterClassType Class;
+    // The node holding the value of memory at this address
+    OrderedNode *Value;
+    // If the value came from a store it may need truncating before a load can use it
+    bool FromStore;
+    // Tracked in a predecessor block, forwarding it makes Value live across the edge
+    bool FromPredecessor;
+  };
+
+  using AccessList = std::vector<MemoryAccess>;
+
+  MemoryAddress DecomposeAddress(IREmitter *IREmit, OrderedNodeWrapper Addr, OrderedNodeWrapper Offset, MemOffsetType OffsetType, uint8_t OffsetScale);
+  static bool MayAlias(MemoryAccess const &Access, MemoryAddress const &Address, uint8_t Size);
+  static bool IsMemoryBarrier(IROps Op);
+
+  void RecordAccess(AccessList &Accesses, MemoryAccess const &Access);
+  void KillAliasingAccesses(AccessList &Accesses, MemoryAddress const &Address, uint8_t Size);
+  OrderedNode *ForwardValue(IREmitter *IREmit, MemoryAccess const &Access, OrderedNode *LoadNode, uint8_t Size);
+  bool ClaimCrossBlockValue(NodeID::value_type ID, bool IsFPR);
+
+  std::unordered_map<NodeID::value_type, AccessList> BlockExitAccesses;
+  std::unordered_map<NodeID::value_type, uint32_t> PredecessorCount;
+  std::unordered_set<NodeID::value_type> VisitedBlocks;
+
+  std::unordered_set<NodeID::value_type> CrossBlockNodes;
+  uint32_t CrossBlockGPRs{};
+  uint32_t CrossBlockFPRs{};
+};
+
+MemoryLoadStoreElimination::MemoryAddress MemoryLoadStoreElimination::DecomposeAddress(IREmitter *IREmit,
+  OrderedNodeWrapper Addr, OrderedNodeWrapper Offset, MemOffsetType OffsetType, uint8_t OffsetScale) {
+  MemoryAddress Result{};
+
+  uint64_t Constant{};
+  auto AddrOp = IREmit->GetOpHeader(Addr);
+  if (IREmit->IsValueConstant(Addr, &Constant)) {
+    Result.Displacement = Constant;
+  }
+  else if (AddrOp->Op == OP_ADD && AddrOp->Size == 8 && IREmit->IsValueConstant(AddrOp->Args[1], &Constant)) {
+    // Only fold 64-bit adds, a 32-bit add wraps and two displacements could then name the same address
+    Result.Base = AddrOp->Args[0].ID();
+    Result.Displacement = Constant;
+  }
+  else {
+    Result.Base = Addr.ID();
+  }
+
+  if (Offset.IsInvalid()) {
+    return Result;
+  }
+
+  auto OffsetOp = IREmit->GetOpHeader(Offset);
+  if (OffsetType == MEM_OFFSET_SXTX && OffsetScale == 1) {
+    if (IREmit->IsValueConstant(Offset, &Constant)) {
+      Result.Displacement += Constant;
+      return Result;
+    }
+    else if (OffsetOp->Op == OP_INLINECONSTANT) {
+      Result.Displacement += OffsetOp->C<IROp_InlineConstant>()->Constant;
+      return Result;
+    }
+  }
+
+  Result.Index = Offset.ID();
+  Result.OffsetType = OffsetType;
+  Result.OffsetScale = OffsetScale;
+  return Result;
+}
+
+bool MemoryLoadStoreElimination::MayAlias(MemoryAccess const &Access, MemoryAddress const &Address, uint8_t Size) {
+  if (!Access.Address.SameBase(Address)) {
+    return true;
+  }
+
+  const int64_t Begin = Access.Address.Displacement;
+  const int64_t End = Begin + Access.Size;
+  return Address.Displacement < End && Begin < (Address.Displacement + Size);
+}
+
+bool MemoryLoadStoreElimination::IsMemoryBarrier(IROps Op) {
+  switch (Op) {
+    // Side effects that don't touch guest memory or ordering
+    case OP_DUMMY:
+    case OP_BEGINBLOCK:
+    case OP_ENDBLOCK:
+    case OP_INVALIDATEFLAGS:
+    case OP_GUESTOPCODE:
+    case OP_SETROUNDINGMODE:
+    case OP_PRINT:
+    case OP_JUMP:
+    case OP_CONDJUMP:
+    case OP_STOREREGISTER:
+    case OP_STORECONTEXT:
+    case OP_STORECONTEXTINDEXED:
+    case OP_SPILLREGISTER:
+    case OP_STOREFLAG:
+    case OP_INLINEENTRYPOINTOFFSET:
+    case OP_INLINECONSTANT:
+    case OP_F80LOADFCW:
+      return false;
+    // TSO loads have acquire semantics, nothing may be carried past them
+    case OP_LOADMEMTSO:
+      return true;
+    default:
+      return HasSideEffects(Op);
+  }
+}
+
+void MemoryLoadStoreElimination::RecordAccess(AccessList &Accesses, MemoryAccess const &Access) {
+  if (Accesses.size() == MAX_TRACKED_ACCESSES) {
+    Accesses.erase(Accesses.begin());
+  }
+  Accesses.emplace_back(Access);
+}
+
+void MemoryLoadStoreElimination::KillAliasingAccesses(AccessList &Accesses, MemoryAddress const &Address, uint8_t Size) {
+  std::erase_if(Accesses, [&Address, Size](MemoryAccess const &Access) {
+    return MayAlias(Access, Address, Size);
+  });
+}
+
+OrderedNode *MemoryLoadStoreElimination::ForwardValue(IREmitter *IREmit, MemoryAccess const &Access, OrderedNode *LoadNode, uint8_t Size) {
+  const uint8_t ValueSize = IREmit->GetOpSize(Access.Value);
+
+  if (!Access.FromStore) {
+    // Previous load of the same size and class, the value is already in the form the load produces
+    return Access.Value;
+  }
+
+  if (Access.Class == GPRClass) {
+    // 32-bit and 64-bit ops already leave the upper bits zeroed
+    if (Size == 8 || (Size == 4 && ValueSize == 4)) {
+      return Access.Value;
+    }
+
+    // The store implicitly truncated the value, the load zero extends it
+    IREmit->SetWriteCursor(LoadNode);
+    return IREmit->_Bfe(std::max<uint8_t>(Size, 4), Size * 8, 0, Access.Value);
+  }
+
+  if (ValueSize == Size) {
+    return Access.Value;
+  }
+
+  // Vector stores that truncate or extend aren't worth the extra moves
+  return nullptr;
+}
+
+bool MemoryLoadStoreElimination::ClaimCrossBlockValue(NodeID::value_type ID, bool IsFPR) {
+  if (CrossBlockNodes.contains(ID)) {
+    return true;
+  }
+
+  uint32_t &Count = IsFPR ? CrossBlockFPRs : CrossBlockGPRs;
+  if (Count == MaxCrossBlockPerClass) {
+    return false;
+  }
+
+  ++Count;
+  CrossBlockNodes.emplace(ID);
+  return true;
+}
+
+bool MemoryLoadStoreElimination::Run(IREmitter *IREmit) {
+  bool Changed = false;
+  uint64_t LoadsForwarded{};
+  uint64_t LoadsEliminated{};
+  auto CurrentIR = IREmit->ViewIR();
+  auto OriginalWriteCursor = IREmit->GetWriteCursor();
+
+  BlockExitAccesses.clear();
+  PredecessorCount.clear();
+  VisitedBlocks.clear();
+  CrossBlockNodes.clear();
+  CrossBlockGPRs = 0;
+  CrossBlockFPRs = 0;
+
+  // Count predecessors so we know which blocks can inherit their predecessor's state
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    auto BlockOp = BlockHeader->C<IROp_CodeBlock>();
+    auto LastOp = CurrentIR.GetOp<IROp_Header>(BlockOp->Last);
+
+    if (LastOp->Op == OP_CONDJUMP) {
+      auto Op = LastOp->C<IROp_CondJump>();
+      ++PredecessorCount[Op->TrueBlock.ID().Value];
+      ++PredecessorCount[Op->FalseBlock.ID().Value];
+    }
+    else if (LastOp->Op == OP_JUMP) {
+      ++PredecessorCount[LastOp->Args[0].ID().Value];
+    }
+  }
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    auto BlockOp = BlockHeader->C<IROp_CodeBlock>();
+    const auto BlockID = CurrentIR.GetID(BlockNode);
+    AccessList Accesses;
+
+    VisitedBlocks.emplace(BlockID.Value);
+
+    // Inherit the tracked accesses from a single predecessor that was already walked
+    if (auto Exit = BlockExitAccesses.find(BlockID.Value); Exit != BlockExitAccesses.end()) {
+      Accesses = std::move(Exit->second);
+      BlockExitAccesses.erase(Exit);
+    }
+
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(BlockNode)) {
+      if (IROp->Op == OP_LOADMEM) {
+        auto Op = IROp->C<IROp_LoadMem>();
+        auto Address = DecomposeAddress(IREmit, Op->Addr, Op->Offset, Op->OffsetType, Op->OffsetScale);
+
+        auto it = std::find_if(Accesses.rbegin(), Accesses.rend(), [&](MemoryAccess const &Access) {
+          return Access.Class == Op->Class &&
+                 Access.Size == IROp->Size &&
+                 Access.Address.SameBase(Address) &&
+                 Access.Address.Displacement == Address.Displacement;
+        });
+
+        if (it != Accesses.rend() && it->FromPredecessor &&
+            !ClaimCrossBlockValue(CurrentIR.GetID(it->Value).Value, Op->Class == FPRClass)) {
+          // Out of cross-block budget, this load becomes the value later loads in the block forward from
+          *it = MemoryAccess{Address, IROp->Size, Op->Class, CodeNode, false, false};
+          continue;
+        }
+
+        OrderedNode *Forwarded = it != Accesses.rend() ? ForwardValue(IREmit, *it, CodeNode, IROp->Size) : nullptr;
+        if (Forwarded) {
+          if (it->FromStore) {
+            ++LoadsForwarded;
+          }
+          else {
+            ++LoadsEliminated;
+          }
+
+          // Load is dominated by the forwarded value, so every use can be replaced
+          IREmit->ReplaceAllUsesWith(CodeNode, Forwarded);
+          *it = MemoryAccess{Address, IROp->Size, Op->Class, Forwarded, false, it->FromPredecessor && Forwarded == it->Value};
+          Changed = true;
+        }
+        else {
+          RecordAccess(Accesses, MemoryAccess{Address, IROp->Size, Op->Class, CodeNode, false, false});
+        }
+      }
+      else if (IROp->Op == OP_STOREMEM) {
+        auto Op = IROp->C<IROp_StoreMem>();
+        auto Address = DecomposeAddress(IREmit, Op->Addr, Op->Offset, Op->OffsetType, Op->OffsetScale);
+
+        KillAliasingAccesses(Accesses, Address, IROp->Size);
+        RecordAccess(Accesses, MemoryAccess{Address, IROp->Size, Op->Class, CurrentIR.GetNode(Op->Value), true, false});
+      }
+      else if (IsMemoryBarrier(IROp->Op)) {
+        Accesses.clear();
+      }
+    }
+
+    if (Accesses.empty()) {
+      continue;
+    }
+
+    for (auto &Access : Accesses) {
+      Access.FromPredecessor = true;
+    }
+
+    // Hand our state to any successor that only we branch to
+    auto LastOp = CurrentIR.GetOp<IROp_Header>(BlockOp->Last);
+    auto PassToSuccessor = [&](OrderedNodeWrapper Target) {
+      const auto TargetID = Target.ID();
+      // A block that was already walked is reached through a backedge
+      if (VisitedBlocks.contains(TargetID.Value) || PredecessorCount[TargetID.Value] != 1) {
+        return;
+      }
+      BlockExitAccesses[TargetID.Value] = Accesses;
+    };
+
+    if (LastOp->Op == OP_CONDJUMP) {
+      auto Op = LastOp->C<IROp_CondJump>();
+      PassToSuccessor(Op->TrueBlock);
+      PassToSuccessor(Op->FalseBlock);
+    }
+    else if (LastOp->Op == OP_JUMP) {
+      PassToSuccessor(LastOp->Args[0]);
+    }
+  }
+
+  IREmit->SetWriteCursor(OriginalWriteCursor);
+
+  if (auto Stats = Manager->GetStats()) {
+    FEXCore::Core::IncrementStat(Stats->MemoryLoadsForwarded, LoadsForwarded);
+    FEXCore::Core::IncrementStat(Stats->MemoryLoadsEliminated, LoadsEliminated);
+  }
+
+  return Changed;
+}
+
+std::unique_ptr<FEXCore::IR::Pass> CreateMemoryLoadStoreElimination() {
+  return std::make_unique<MemoryLoadStoreElimination>();
+}
+
+}
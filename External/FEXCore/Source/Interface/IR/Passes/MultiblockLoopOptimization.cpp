@@ -0,0 +1,521 @@
+/*
+$info$
+tags: ir|opts
+desc: Loop detection, loop invariant code motion and cross block context forwarding for multiblock
+$end_info$
+*/
+
+#include "Interface/IR/PassManager.h"
+
+#include <FEXCore/Core/CoreState.h>
+
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IREmitter.h>
+#include <FEXCore/IR/IntrusiveIRList.h>
+#include <FEXCore/Utils/LogManager.h>
+
+#include <algorithm>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace FEXCore::IR {
+
+/**
+ * @brief Optimizes multiblock functions using the CFG
+ *
+ * Natural loops are found from backedges to a dominating header.
+ * A loop with a single outside predecessor that unconditionally jumps to the header uses that block as its preheader.
+ *
+ * Loop invariant code motion moves pure integer ops whose arguments are all defined outside of the loop in to the preheader.
+ * LoadContext of a slot that isn't written anywhere in the loop is hoisted the same way, so read-only guest registers
+ * such as address bases and segment offsets are loaded once.
+ *
+ * Context slots that are loaded or stored at the end of a block are forwarded in to a successor with a single predecessor,
+ * which removes the LoadContext at the start of fallthrough blocks.
+ *
+ * Slots written inside of a loop would need phi nodes to live in a host register across the backedge.
+ * The register allocator doesn't support phis, so those stay in the context.
+ *
+ * Hoisted and forwarded values are live across blocks, which the register allocator can't spill.
+ * Constants are left in the loop since they are cheaper to rematerialize than to pin a register,
+ * and only MaxCrossBlockPerClass values of each register class are made live across blocks per function.
+ */
+class MultiblockLoopOptimization final : public FEXCore::IR::Pass {
+public:
+  ~MultiblockLoopOptimization();
+  bool Run(IREmitter *IREmit) override;
+
+private:
+  struct BlockInfo {
+    OrderedNode *Node;
+    OrderedNode *Terminator;
+    std::vector<size_t> Successors;
+    std::vector<size_t> Predecessors;
+  };
+
+  struct LoopInfo {
+    size_t Header;
+    // Indexes in to Blocks, sorted in list order
+    std::vector<size_t> Body;
+  };
+
+  struct ContextAccess {
+    uint32_t Offset;
+    uint8_t Size;
+    RegisterClassType Class;
+    OrderedNode *Value;
+    // Value was defined in a predecessor, using it makes it live across blocks
+    bool FromPredecessor;
+  };
+
+  using ContextAccessList = std::vector<ContextAccess>;
+
+  // x86 only has five GPRs left for allocation with SRA and a single op can need four of them
+  constexpr static uint32_t MaxCrossBlockPerClass = 1;
+
+  static uint32_t FlagOffset(uint32_t Flag) {
+    return offsetof(FEXCore::Core::CPUState, flags[0]) + Flag;
+  }
+
+  static bool IsHoistable(IROps Op);
+  static bool IsContextBarrier(IROp_Header const *IROp);
+
+  void CalculateControlFlow(IRListView const &CurrentIR);
+  void CalculateDominators();
+  void FindLoops();
+  bool HoistLoopInvariants(IRListView const &CurrentIR, LoopInfo const &Loop);
+  bool ForwardContextAcrossBlocks(IREmitter *IREmit, IRListView const &CurrentIR);
+  // Returns false once the class is out of cross block values
+  bool ClaimCrossBlockValue(NodeID::value_type ID, bool IsFPR);
+
+  std::vector<BlockInfo> Blocks;
+  std::unordered_map<NodeID::value_type, size_t> BlockIndex;
+  // Dominators[i][j] is true if block j dominates block i
+  std::vector<std::vector<bool>> Dominators;
+  std::vector<LoopInfo> Loops;
+  // Nodes that are already live across blocks don't count against the limit again
+  std::unordered_set<NodeID::value_type> CrossBlockNodes;
+  uint32_t CrossBlockGPRs{};
+  uint32_t CrossBlockFPRs{};
+
+  uint64_t LoopsFound{};
+  uint64_t NodesHoisted{};
+  uint64_t ContextLoadsForwarded{};
+};
+
+MultiblockLoopOptimization::~MultiblockLoopOptimization() {
+  if (LoopsFound || ContextLoadsForwarded) {
+    LogMan::Msg::DFmt("LoopOpt: {} loops, {} nodes hoisted, {} context loads forwarded across blocks", LoopsFound, NodesHoisted, ContextLoadsForwarded);
+  }
+}
+
+bool MultiblockLoopOptimization::IsHoistable(IROps Op) {
+  switch (Op) {
+    case OP_NEG:
+    case OP_NOT:
+    case OP_POPCOUNT:
+    case OP_FINDLSB:
+    case OP_FINDMSB:
+    case OP_FINDTRAILINGZEROS:
+    case OP_COUNTLEADINGZEROES:
+    case OP_REV:
+    case OP_ADD:
+    case OP_SUB:
+    case OP_OR:
+    case OP_XOR:
+    case OP_AND:
+    case OP_ANDN:
+    case OP_LSHL:
+    case OP_LSHR:
+    case OP_ASHR:
+    case OP_ROR:
+    case OP_MUL:
+    case OP_UMUL:
+    case OP_MULH:
+    case OP_UMULH:
+    case OP_BFI:
+    case OP_BFE:
+    case OP_SBFE:
+    case OP_SELECT:
+    case OP_EXTR:
+      return true;
+    // Divides can fault on the x86 host so they can't be executed speculatively
+    default:
+      return false;
+  }
+}
+
+bool MultiblockLoopOptimization::IsContextBarrier(IROp_Header const *IROp) {
+  switch (IROp->Op) {
+    // Side effects that don't modify the context behind a StoreContext
+    case OP_DUMMY:
+    case OP_BEGINBLOCK:
+    case OP_ENDBLOCK:
+    case OP_INVALIDATEFLAGS:
+    case OP_GUESTOPCODE:
+    case OP_SETROUNDINGMODE:
+    case OP_PRINT:
+    case OP_JUMP:
+    case OP_CONDJUMP:
+    case OP_STORECONTEXT:
+    case OP_STOREFLAG:
+    case OP_STOREMEM:
+    case OP_STOREMEMTSO:
+    case OP_VSTOREMEMELEMENT:
+    case OP_CACHELINECLEAR:
+    case OP_CACHELINEZERO:
+    case OP_FENCE:
+    case OP_INLINEENTRYPOINTOFFSET:
+    case OP_INLINECONSTANT:
+    case OP_F80LOADFCW:
+      return false;
+    case OP_SYSCALL:
+      return (IROp->C<IROp_Syscall>()->Flags & SyscallFlags::OPTIMIZETHROUGH) != SyscallFlags::OPTIMIZETHROUGH;
+    case OP_INLINESYSCALL:
+      return (IROp->C<IROp_InlineSyscall>()->Flags & SyscallFlags::OPTIMIZETHROUGH) != SyscallFlags::OPTIMIZETHROUGH;
+    default:
+      return HasSideEffects(IROp->Op);
+  }
+}
+
+bool MultiblockLoopOptimization::ClaimCrossBlockValue(NodeID::value_type ID, bool IsFPR) {
+  if (CrossBlockNodes.contains(ID)) {
+    return true;
+  }
+
+  uint32_t &Count = IsFPR ? CrossBlockFPRs : CrossBlockGPRs;
+  if (Count == MaxCrossBlockPerClass) {
+    return false;
+  }
+
+  ++Count;
+  CrossBlockNodes.emplace(ID);
+  return true;
+}
+
+void MultiblockLoopOptimization::CalculateControlFlow(IRListView const &CurrentIR) {
+  Blocks.clear();
+  BlockIndex.clear();
+
+  for (auto [BlockNode, BlockHeader] : CurrentIR.GetBlocks()) {
+    auto BlockOp = BlockHeader->C<IROp_CodeBlock>();
+    BlockIndex[CurrentIR.GetID(BlockNode).Value] = Blocks.size();
+
+    // The terminator sits right before EndBlock
+    auto EndBlock = CurrentIR.GetNode(BlockOp->Last);
+    auto Terminator = CurrentIR.GetNode(EndBlock->Header.Previous);
+    Blocks.emplace_back(BlockInfo{BlockNode, Terminator, {}, {}});
+  }
+
+  for (size_t i = 0; i < Blocks.size(); ++i) {
+    auto &Block = Blocks[i];
+    auto IROp = CurrentIR.GetOp<IROp_Header>(Block.Terminator);
+
+    auto AddEdge = [&](OrderedNodeWrapper Target) {
+      const size_t TargetIndex = BlockIndex.at(Target.ID().Value);
+      Block.Successors.emplace_back(TargetIndex);
+      Blocks[TargetIndex].Predecessors.emplace_back(i);
+    };
+
+    if (IROp->Op == OP_CONDJUMP) {
+      auto Op = IROp->C<IROp_CondJump>();
+      AddEdge(Op->TrueBlock);
+      AddEdge(Op->FalseBlock);
+    }
+    else if (IROp->Op == OP_JUMP) {
+      AddEdge(IROp->Args[0]);
+    }
+  }
+}
+
+void MultiblockLoopOptimization::CalculateDominators() {
+  const size_t NumBlocks = Blocks.size();
+
+  // Iterative dataflow, multiblock functions are small enough that this converges quickly
+  Dominators.assign(NumBlocks, std::vector<bool>(NumBlocks, true));
+  Dominators[0].assign(NumBlocks, false);
+  Dominators[0][0] = true;
+
+  bool Changed = true;
+  while (Changed) {
+    Changed = false;
+    for (size_t i = 1; i < NumBlocks; ++i) {
+      std::vector<bool> NewDom(NumBlocks, !Blocks[i].Predecessors.empty());
+      for (auto Pred : Blocks[i].Predecessors) {
+        for (size_t j = 0; j < NumBlocks; ++j) {
+          NewDom[j] = NewDom[j] && Dominators[Pred][j];
+        }
+      }
+      NewDom[i] = true;
+
+      if (NewDom != Dominators[i]) {
+        Dominators[i] = std::move(NewDom);
+        Changed = true;
+      }
+    }
+  }
+}
+
+void MultiblockLoopOptimization::FindLoops() {
+  Loops.clear();
+
+  std::unordered_map<size_t, std::vector<bool>> HeaderToBody;
+
+  for (size_t Tail = 0; Tail < Blocks.size(); ++Tail) {
+    for (auto Header : Blocks[Tail].Successors) {
+      if (!Dominators[Tail][Header]) {
+        continue;
+      }
+
+      // Backedge, walk predecessors back from the tail until we hit the header
+      auto &Body = HeaderToBody.try_emplace(Header, std::vector<bool>(Blocks.size(), false)).first->second;
+      Body[Header] = true;
+
+      std::vector<size_t> WorkList{Tail};
+      while (!WorkList.empty()) {
+        const size_t Current = WorkList.back();
+        WorkList.pop_back();
+        if (Body[Current]) {
+          continue;
+        }
+        Body[Current] = true;
+        WorkList.insert(WorkList.end(), Blocks[Current].Predecessors.begin(), Blocks[Current].Predecessors.end());
+      }
+    }
+  }
+
+  for (auto &[Header, Body] : HeaderToBody) {
+    LoopInfo Loop{Header, {}};
+    for (size_t i = 0; i < Body.size(); ++i) {
+      if (Body[i]) {
+        Loop.Body.emplace_back(i);
+      }
+    }
+    Loops.emplace_back(std::move(Loop));
+  }
+
+  // Inner loops first so their invariants can keep moving out through the outer loop
+  std::sort(Loops.begin(), Loops.end(), [](LoopInfo const &lhs, LoopInfo const &rhs) {
+    return lhs.Body.size() < rhs.Body.size();
+  });
+
+  LoopsFound += Loops.size();
+}
+
+bool MultiblockLoopOptimization::HoistLoopInvariants(IRListView const &CurrentIR, LoopInfo const &Loop) {
+  // Need a single preheader that only flows in to the header
+  size_t Preheader = ~0ULL;
+  for (auto Pred : Blocks[Loop.Header].Predecessors) {
+    if (std::binary_search(Loop.Body.begin(), Loop.Body.end(), Pred)) {
+      continue;
+    }
+
+    if (Preheader != ~0ULL) {
+      return false;
+    }
+    Preheader = Pred;
+  }
+
+  if (Preheader == ~0ULL || Blocks[Preheader].Successors.size() != 1) {
+    return false;
+  }
+
+  std::unordered_set<NodeID::value_type> DefinedInLoop;
+  std::vector<std::pair<uint32_t, uint32_t>> StoredContext;
+  bool HasContextBarrier = false;
+
+  for (auto BlockIdx : Loop.Body) {
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(Blocks[BlockIdx].Node)) {
+      DefinedInLoop.emplace(CurrentIR.GetID(CodeNode).Value);
+
+      if (IROp->Op == OP_STORECONTEXT) {
+        auto Op = IROp->C<IROp_StoreContext>();
+        StoredContext.emplace_back(Op->Offset, Op->Offset + IROp->Size);
+      }
+      else if (IROp->Op == OP_STOREFLAG) {
+        const uint32_t Offset = FlagOffset(IROp->C<IROp_StoreFlag>()->Flag);
+        StoredContext.emplace_back(Offset, Offset + 1);
+      }
+      else if (IsContextBarrier(IROp)) {
+        HasContextBarrier = true;
+      }
+    }
+  }
+
+  auto IsInvariantArg = [&](OrderedNodeWrapper Arg) {
+    return Arg.IsInvalid() || !DefinedInLoop.contains(Arg.ID().Value);
+  };
+
+  std::vector<OrderedNode*> ToHoist;
+  for (auto BlockIdx : Loop.Body) {
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(Blocks[BlockIdx].Node)) {
+      bool Hoist = false;
+      bool IsFPR = false;
+
+      if (IROp->Op == OP_LOADCONTEXT) {
+        auto Op = IROp->C<IROp_LoadContext>();
+        IsFPR = Op->Class == FPRClass;
+        const uint32_t Begin = Op->Offset;
+        const uint32_t End = Op->Offset + IROp->Size;
+        Hoist = !HasContextBarrier &&
+          std::none_of(StoredContext.begin(), StoredContext.end(), [Begin, End](auto const &Range) {
+            return Begin < Range.second && Range.first < End;
+          });
+      }
+      else if (IsHoistable(IROp->Op)) {
+        const uint8_t NumArgs = GetArgs(IROp->Op);
+        Hoist = true;
+        for (uint8_t i = 0; i < NumArgs; ++i) {
+          Hoist &= IsInvariantArg(IROp->Args[i]);
+        }
+      }
+
+      if (!Hoist) {
+        continue;
+      }
+
+      const auto ID = CurrentIR.GetID(CodeNode).Value;
+      if (!ClaimCrossBlockValue(ID, IsFPR)) {
+        continue;
+      }
+
+      DefinedInLoop.erase(ID);
+      ToHoist.emplace_back(CodeNode);
+    }
+  }
+
+  if (ToHoist.empty()) {
+    return false;
+  }
+
+  // Preserve the original order so hoisted nodes still come after the hoisted nodes they use
+  const uintptr_t ListBegin = CurrentIR.GetListData();
+  auto Terminator = Blocks[Preheader].Terminator;
+  for (auto Node : ToHoist) {
+    Node->Unlink(ListBegin);
+    Terminator->prepend(ListBegin, Node);
+  }
+
+  NodesHoisted += ToHoist.size();
+  return true;
+}
+
+bool MultiblockLoopOptimization::ForwardContextAcrossBlocks(IREmitter *IREmit, IRListView const &CurrentIR) {
+  bool Changed = false;
+  std::unordered_map<size_t, ContextAccessList> ExitState;
+  std::vector<bool> Visited(Blocks.size(), false);
+
+  for (size_t i = 0; i < Blocks.size(); ++i) {
+    auto &Block = Blocks[i];
+    Visited[i] = true;
+
+    ContextAccessList Accesses;
+    if (auto it = ExitState.find(i); it != ExitState.end()) {
+      Accesses = std::move(it->second);
+      ExitState.erase(it);
+    }
+
+    for (auto [CodeNode, IROp] : CurrentIR.GetCode(Block.Node)) {
+      if (IROp->Op == OP_LOADCONTEXT) {
+        auto Op = IROp->C<IROp_LoadContext>();
+        auto Match = std::find_if(Accesses.begin(), Accesses.end(), [&](ContextAccess const &Access) {
+          return Access.Offset == Op->Offset &&
+                 Access.Size == IROp->Size &&
+                 Access.Class == Op->Class &&
+                 IREmit->GetOpSize(Access.Value) == IROp->Size;
+        });
+
+        if (Match != Accesses.end() &&
+            (!Match->FromPredecessor || ClaimCrossBlockValue(CurrentIR.GetID(Match->Value).Value, Match->Class == FPRClass))) {
+          IREmit->ReplaceAllUsesWith(CodeNode, Match->Value);
+          ++ContextLoadsForwarded;
+          Changed = true;
+        }
+        else {
+          const uint32_t Begin = Op->Offset;
+          const uint32_t End = Op->Offset + IROp->Size;
+          std::erase_if(Accesses, [Begin, End](ContextAccess const &Access) {
+            return Begin < (Access.Offset + Access.Size) && Access.Offset < End;
+          });
+          Accesses.emplace_back(ContextAccess{Op->Offset, IROp->Size, Op->Class, CodeNode, false});
+        }
+      }
+      else if (IROp->Op == OP_STORECONTEXT) {
+        auto Op = IROp->C<IROp_StoreContext>();
+        const uint32_t Begin = Op->Offset;
+        const uint32_t End = Op->Offset + IROp->Size;
+        std::erase_if(Accesses, [Begin, End](ContextAccess const &Access) {
+          return Begin < (Access.Offset + Access.Size) && Access.Offset < End;
+        });
+        Accesses.emplace_back(ContextAccess{Op->Offset, IROp->Size, Op->Class, CurrentIR.GetNode(Op->Value), false});
+      }
+      else if (IROp->Op == OP_STOREFLAG) {
+        const uint32_t Offset = FlagOffset(IROp->C<IROp_StoreFlag>()->Flag);
+        std::erase_if(Accesses, [Offset](ContextAccess const &Access) {
+          return Offset >= Access.Offset && Offset < (Access.Offset + Access.Size);
+        });
+      }
+      else if (IsContextBarrier(IROp)) {
+        Accesses.clear();
+      }
+    }
+
+    if (Accesses.empty()) {
+      continue;
+    }
+
+    for (auto &Access : Accesses) {
+      Access.FromPredecessor = true;
+    }
+
+    // Only a successor that we are the sole predecessor of is dominated by us
+    for (auto Succ : Block.Successors) {
+      if (!Visited[Succ] && Blocks[Succ].Predecessors.size() == 1) {
+        ExitState[Succ] = Accesses;
+      }
+    }
+  }
+
+  return Changed;
+}
+
+bool MultiblockLoopOptimization::Run(IREmitter *IREmit) {
+  auto CurrentIR = IREmit->ViewIR();
+  auto HeaderOp = CurrentIR.GetHeader();
+
+  // Nothing to do for single block functions
+  if (HeaderOp->BlockCount < 2) {
+    return false;
+  }
+
+  auto OriginalWriteCursor = IREmit->GetWriteCursor();
+  bool Changed = false;
+
+  CalculateControlFlow(CurrentIR);
+  CalculateDominators();
+  FindLoops();
+
+  CrossBlockNodes.clear();
+  CrossBlockGPRs = 0;
+  CrossBlockFPRs = 0;
+  for (auto const &Loop : Loops) {
+    Changed |= HoistLoopInvariants(CurrentIR, Loop);
+  }
+
+  Changed |= ForwardContextAcrossBlocks(IREmit, CurrentIR);
+
+  IREmit->SetWriteCursor(OriginalWriteCursor);
+
+  return Changed;
+}
+
+std::unique_ptr<FEXCore::IR::Pass> CreateMultiblockLoopOptimization() {
+  return std::make_unique<MultiblockLoopOptimization>();
+}
+
+}
@@ -20,10 +20,22 @@ namespace FEXCore::IR {
 
 class StaticRegisterAllocationPass final : public FEXCore::IR::Pass {
 public:
+  StaticRegisterAllocationPass(uint32_t NumStaticGPRs, uint32_t NumStaticFPRs)
+    : NumStaticGPRs {NumStaticGPRs}
+    , NumStaticFPRs {NumStaticFPRs} {}
+
   bool Run(IREmitter *IREmit) override;
+
+private:
+  // Backends that can't pin every guest register only pin the lowest ones
+  uint32_t NumStaticGPRs;
+  uint32_t NumStaticFPRs;
+
+  bool IsStaticAllocGpr(uint32_t Offset, RegisterClassType Class) const;
+  bool IsStaticAllocFpr(uint32_t Offset, RegisterClassType Class, bool AllowGpr) const;
 };
 
-bool IsStaticAllocGpr(uint32_t Offset, RegisterClassType Class) {
+bool StaticRegisterAllocationPass::IsStaticAllocGpr(uint32_t Offset, RegisterClassType Class) const {
   const auto begin = offsetof(Core::CPUState, gregs[0]);
   const auto end = offsetof(Core::CPUState, gregs[16]);
 
@@ -31,14 +43,14 @@ bool IsStaticAllocGpr(uint32_t Offset, RegisterClassType Class) {
     const auto reg = (Offset - begin) / Core::CPUState::GPR_REG_SIZE;
     LOGMAN_THROW_A_FMT(Class == IR::GPRClass, "unexpected Class {}", Class);
 
-    // 0..15 -> 16 in total
-    return reg < Core::CPUState::NUM_GPRS;
+    // 0..NumStaticGPRs-1 are pinned, the rest stay in the context
+    return reg < NumStaticGPRs;
   }
 
   return false;
 }
 
-bool IsStaticAllocFpr(uint32_t Offset, RegisterClassType Class, bool AllowGpr) {
+bool StaticRegisterAllocationPass::IsStaticAllocFpr(uint32_t Offset, RegisterClassType Class, bool AllowGpr) const {
   const auto begin = offsetof(FEXCore::Core::CPUState, xmm[0][0]);
   const auto end = offsetof(FEXCore::Core::CPUState, xmm[16][0]);
 
@@ -46,8 +58,8 @@ bool IsStaticAllocFpr(uint32_t Offset, RegisterClassType Class, bool AllowGpr) {
     const auto reg = (Offset - begin) / Core::CPUState::XMM_REG_SIZE;
     LOGMAN_THROW_A_FMT(Class == IR::FPRClass || (AllowGpr && Class == IR::GPRClass), "unexpected Class {}, AllowGpr {}", Class, AllowGpr);
 
-    // 0..15 -> 16 in total
-    return reg < Core::CPUState::NUM_XMMS;
+    // 0..NumStaticFPRs-1 are pinned, the rest stay in the context
+    return reg < NumStaticFPRs;
   }
 
   return false;
@@ -102,8 +114,8 @@ bool StaticRegisterAllocationPass::Run(IREmitter *IREmit) {
   return true;
 }
 
-std::unique_ptr<FEXCore::IR::Pass> CreateStaticRegisterAllocationPass() {
-  return std::make_unique<StaticRegisterAllocationPass>();
+std::unique_ptr<FEXCore::IR::Pass> CreateStaticRegisterAllocationPass(uint32_t NumStaticGPRs, uint32_t NumStaticFPRs) {
+  return std::make_unique<StaticRegisterAllocationPass>(NumStaticGPRs, NumStaticFPRs);
 }
 
 }
@@ -47,9 +47,11 @@ bool SyscallOptimization::Run(IREmitter *IREmit) {
           for (uint8_t Arg = (SyscallDef.NumArgs + 1); Arg < FEXCore::HLE::SyscallArguments::MAX_ARGS; ++Arg) {
             IREmit->ReplaceNodeArgument(CodeNode, Arg, IREmit->Invalid());
           }
-#ifdef _M_ARM_64
+#if defined(_M_ARM_64) || defined(_M_X86_64)
           // Replace syscall with inline passthrough syscall if we can
-          if (SyscallDef.HostSyscallNumber != -1) {
+          // Passthrough syscalls are only registered when the guest ABI matches the host syscall
+          // Inline syscalls skip the frontend handler that counts per-syscall stats, keep them out-of-line while stats are enabled
+          if (SyscallDef.HostSyscallNumber != -1 && !Manager->GetStats()) {
             IREmit->SetWriteCursor(CodeNode);
             // Skip Args[0] since that is the syscallid
             auto InlineSyscall = IREmit->_InlineSyscall(
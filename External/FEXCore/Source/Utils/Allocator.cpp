@@ -2,10 +2,12 @@
 #include <FEXCore/Utils/Allocator.h>
 #include <FEXCore/Utils/CompilerDefs.h>
 #include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/MathUtils.h>
 #include <FEXHeaderUtils/Syscalls.h>
 #include <FEXHeaderUtils/TypeDefines.h>
 
 #include <array>
+#include <linux/mman.h>
 #include <sys/mman.h>
 #include <sys/user.h>
 #ifdef ENABLE_JEMALLOC
@@ -131,6 +133,54 @@ namespace FEXCore::Allocator {
     FEX_UNREACHABLE;
   }
 
+  void *MapHugePageAligned(size_t Size, int Prot, HugePageType Type) {
+    LOGMAN_THROW_A_FMT((Size % HUGE_PAGE_SIZE) == 0, "Huge page mapping size {} isn't a multiple of the huge page size", Size);
+
+    if (Type == HugePageType::NONE) {
+      return FEXCore::Allocator::mmap(nullptr, Size, Prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+
+    // Over-allocate so the start can be aligned, then trim off the excess on both ends
+    const size_t ReserveSize = Size + HUGE_PAGE_SIZE - FHU::FEX_PAGE_SIZE;
+    auto Reserved = FEXCore::Allocator::mmap(nullptr, ReserveSize, Prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (Reserved == MAP_FAILED) {
+      return MAP_FAILED;
+    }
+
+    const uintptr_t Base = reinterpret_cast<uintptr_t>(Reserved);
+    const uintptr_t Aligned = FEXCore::AlignUp(Base, HUGE_PAGE_SIZE);
+    const uintptr_t End = Base + ReserveSize;
+    const uintptr_t AlignedEnd = Aligned + Size;
+
+    if (Aligned != Base) {
+      FEXCore::Allocator::munmap(Reserved, Aligned - Base);
+    }
+
+    if (AlignedEnd != End) {
+      FEXCore::Allocator::munmap(reinterpret_cast<void*>(AlignedEnd), End - AlignedEnd);
+    }
+
+    auto Ptr = reinterpret_cast<void*>(Aligned);
+
+    if (Type == HugePageType::HUGETLB) {
+      // Replace the range with hugetlb pages. This fails if not enough pages are reserved in
+      // /proc/sys/vm/nr_hugepages, in which case the range is put back with regular pages
+      auto Result = FEXCore::Allocator::mmap(Ptr, Size, Prot, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB | MAP_HUGE_2MB, -1, 0);
+      if (Result == Ptr) {
+        return Ptr;
+      }
+
+      Result = FEXCore::Allocator::mmap(Ptr, Size, Prot, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+      if (Result != Ptr) {
+        return MAP_FAILED;
+      }
+    }
+
+    // Only a hint, the kernel may not have THP enabled
+    ::madvise(Ptr, Size, MADV_HUGEPAGE);
+    return Ptr;
+  }
+
   PtrCache* StealMemoryRegion(uintptr_t Begin, uintptr_t End) {
     PtrCache *Cache{};
     uint64_t CacheSize{};
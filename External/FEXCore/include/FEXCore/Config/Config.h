@@ -35,6 +35,15 @@ namespace Handler {
       return "3";
     return "0";
   }
+  static inline std::string_view HugePagesHandler(std::string_view Value) {
+    if (Value == "none")
+      return "0";
+    else if (Value == "thp")
+      return "1";
+    else if (Value == "hugetlb")
+      return "2";
+    return "0";
+  }
   static inline std::string_view CacheObjectCodeHandler(std::string_view Value) {
     if (Value == "none")
       return "0";
@@ -64,6 +73,12 @@ namespace Handler {
     CONFIG_SMC_MMAN,
   };
 
+  enum ConfigHugePages {
+    CONFIG_HUGEPAGES_NONE,
+    CONFIG_HUGEPAGES_THP,
+    CONFIG_HUGEPAGES_HUGETLB,
+  };
+
   enum ConfigObjectCodeHandler {
     CONFIG_NONE,
     CONFIG_READ,
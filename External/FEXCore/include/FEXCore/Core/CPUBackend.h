@@ -12,6 +12,7 @@ $end_info$
 #include <cstdint>
 #include <string>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 namespace FEXCore {
@@ -19,6 +20,7 @@ namespace FEXCore {
 namespace IR {
   class IRListView;
   class RegisterAllocationData;
+  struct NodeID;
 }
 
 namespace Core {
@@ -35,6 +37,9 @@ namespace CodeSerialize {
 namespace CPU {
   struct CPUBackendFeatures {
     bool SupportsStaticRegisterAllocation = false;
+    // Guest GPRs and XMMs below these indices are pinned to host registers when SRA is enabled
+    uint32_t NumStaticGPRs = 16;
+    uint32_t NumStaticFPRs = 16;
   };
   
   class CPUBackend {
@@ -45,10 +50,33 @@ namespace CPU {
     };
 
     /**
-     * @param InitialCodeSize - Initial size for the code buffers
-     * @param MaxCodeSize - Max size for the code buffers
+     * @brief A fixed size slice of the code buffer that gets reused as a unit
+     *
+     * Segments are filled in order, once all of them hold code a clock hand picks
+     * the next segment whose blocks haven't been reached through a lookup recently.
+     */
+    struct CodeSegment {
+      uint8_t *Ptr;
+      size_t Size;
+      // Guest entrypoints of the blocks emitted in to this segment, may contain blocks that were invalidated since
+      std::vector<uint64_t> Blocks;
+      // Blocks that haven't been invalidated, a segment with none left gets reclaimed first
+      size_t LiveBlocks;
+      size_t CodeBytes;
+      // Set when a block in this segment is found through a lookup slow path, cleared when the clock hand passes
+      bool Referenced;
+      // Bytes handed out by AllocateCodeStub from the end of the segment
+      size_t StubBytes;
+      // Blocks evicted the last time the clock hand reclaimed this segment
+      std::vector<uint64_t> EvictedBlocks;
+    };
+
+    /**
+     * @param SegmentSize - Size of each segment of the code buffer
+     * @param MaxCodeSize - Size of the code buffer
+     * @param StubAreaSize - Bytes at the end of every segment that are kept out of the code region for AllocateCodeStub
     */
-    CPUBackend(FEXCore::Core::InternalThreadState *ThreadState, size_t InitialCodeSize, size_t MaxCodeSize);
+    CPUBackend(FEXCore::Core::InternalThreadState *ThreadState, size_t SegmentSize, size_t MaxCodeSize, size_t StubAreaSize = 0);
 
     virtual ~CPUBackend();
     /**
@@ -121,15 +149,165 @@ namespace CPU {
 
     bool IsAddressInCodeBuffer(uintptr_t Address) const;
 
+    /**
+     * @brief Checks if code can move on to another segment instead of clearing the whole code buffer
+     *
+     * Not possible while signal handlers are running since their interrupted code could be in any segment
+     */
+    bool CanReuseCodeSegments() const;
+
+    /**
+     * @brief Advances the clock hand and returns the segment it lands on
+     */
+    CodeSegment *NextCodeSegment();
+
+    /**
+     * @brief Finds a segment with no live blocks left that isn't the one currently being emitted in to
+     */
+    CodeSegment *FindDeadCodeSegment();
+
+    /**
+     * @brief Empties the segment that the clock hand is on and starts emitting code in to it
+     */
+    void BeginCodeSegment(CodeSegment *Segment);
+
+    /**
+     * @brief Tracks a block that was just emitted
+     *
+     * @return true if the block was compiled before and got evicted to make space
+     */
+    bool AddBlockToSegment(uint64_t GuestRIP, uintptr_t HostCode, size_t HostCodeSize);
+
+    /**
+     * @brief Tracks a block being invalidated
+     */
+    void RemoveBlockFromSegment(uintptr_t HostCode);
+
+    /**
+     * @brief Marks the segment containing HostCode as recently used
+     */
+    void MarkCodeReferenced(uintptr_t HostCode) {
+      if (auto Segment = GetCodeSegment(HostCode)) {
+        Segment->Referenced = true;
+      }
+    }
+
+    /**
+     * @brief Remembers that a block was evicted from Segment, so that compiling it again gets counted as a capacity miss
+     *
+     * Blocks are only remembered until Segment gets evicted again, which keeps this bounded by what fits in the code buffer
+     */
+    void MarkBlockEvicted(CodeSegment *Segment, uint64_t GuestRIP) {
+      Segment->EvictedBlocks.emplace_back(GuestRIP);
+      EvictedBlocks.insert(GuestRIP);
+    }
+
+    /**
+     * @brief Forgets the blocks evicted the previous time the clock hand came by Segment
+     */
+    void AgeEvictedBlocks(CodeSegment *Segment) {
+      for (auto GuestRIP : Segment->EvictedBlocks) {
+        EvictedBlocks.erase(GuestRIP);
+      }
+      Segment->EvictedBlocks.clear();
+    }
+
+    /**
+     * @brief Hands out code space from the stub area of the segment holding HostCode
+     *
+     * For out of line code that is only reached from a backpatched site.
+     * Being in the same segment keeps it in direct branch range of the site and has it evicted together with the site.
+     * Safe to call from a signal handler on the owning thread.
+     *
+     * @return The 16 byte aligned stub, or nullptr if HostCode isn't in a segment or its stub area is full
+     */
+    uint8_t *AllocateCodeStub(uintptr_t HostCode, size_t Size);
+
+    /**
+     * @brief Releases the backing pages of the generated code without unmapping the code buffers
+     *
+     * Used when a thread exits and this backend is being kept around for reuse
+     */
+    void ReleaseCodeBuffers();
+
+    /**
+     * @brief Rebinds a recycled backend to a new thread and starts it with an empty code buffer
+     */
+    void ResetForThread(FEXCore::Core::InternalThreadState *NewThreadState);
+
   protected:
     FEXCore::Core::InternalThreadState *ThreadState;
 
-    size_t InitialCodeSize, MaxCodeSize;
+    /**
+     * @param SegmentSize - Size of each code segment, the code buffer is made of MaxCodeSize / SegmentSize segments
+     */
+    size_t SegmentSize, MaxCodeSize;
+    size_t StubAreaSize;
+    // Segments a CodeBufferSize sized buffer is split in to
+    constexpr static size_t NUM_RESIZED_SEGMENTS = 8;
+
+    /**
+     * @brief Clears all code and returns the region that code should be emitted in to next
+     */
     [[nodiscard]] CodeBuffer *GetEmptyCodeBuffer();
 
+    /**
+     * @brief Points the backend's assembler at a new region of the code buffer
+     */
+    virtual void SetCodeRegion(CodeBuffer const &Region) {}
+
     // This is the current code buffer that we are tracking
     CodeBuffer *CurrentCodeBuffer{};
 
+    // The part of the current code buffer that code is emitted in to, a single segment unless signals forced a new buffer
+    CodeBuffer CurrentCodeRegion{};
+
+    /**
+     * @name Cold code
+     *
+     * When splitting, paths that rarely run go to chunks taken from the end of each code region
+     * so the hot bodies of blocks stay densely packed at the start of the region.
+     * Hot code grows up and cold chunks grow down, the region is full when the two meet.
+     * Both parts live in the same segment and get evicted together.
+     * @{ */
+      // Cold code is emitted upwards inside of a chunk, new chunks are taken below the previous one
+      constexpr static size_t COLD_CODE_CHUNK_SIZE = 64 * 1024;
+
+      // Set by backends that can emit cold code before their first code region is set up
+      bool SplitColdCode{};
+
+      // Offset in the current code region where the lowest cold chunk begins, the region size when not splitting
+      size_t ColdCodeBegin{};
+      // End of the chunk that cold code is currently emitted in to
+      size_t ColdCodeEnd{};
+      // Offset that the next cold code gets emitted at
+      size_t ColdCodeCursor{};
+
+      /**
+       * @brief Checks the config for if code should be split
+       *
+       * Object cache entries are serialized as one contiguous range so splitting is off while that is in use
+       */
+      [[nodiscard]] bool ShouldSplitColdCode() const;
+
+      /**
+       * @brief Makes room for Size bytes of hot code at HotOffset, and up to as many bytes of cold code, in the current region
+       *
+       * Takes a new cold chunk if the current one is too full
+       *
+       * @return false if the region is full and a segment needs to be evicted
+       */
+      [[nodiscard]] bool ReserveCodeRegionSpace(size_t HotOffset, size_t Size);
+
+      /**
+       * @brief Collects the blocks of a multiblock that only run on unlikely paths
+       *
+       * These are the blocks that exit when SMC checks find modified code, and blocks that fault on invalid instructions.
+       * The entry block is never cold since code falls through in to it.
+       */
+      static void FindColdCodeBlocks(FEXCore::IR::IRListView const *IR, std::unordered_set<FEXCore::IR::NodeID> *ColdBlocks);
+    /**  @} */
+
   private:
     CodeBuffer AllocateNewCodeBuffer(size_t Size);
     void FreeCodeBuffer(CodeBuffer Buffer);
@@ -138,9 +316,32 @@ namespace CPU {
       CurrentCodeBuffer = &CodeBuffers.emplace_back(Buffer);
     }
 
+    void ResetCodeSegments();
+    void ResetColdCode();
+
+    CodeSegment *GetCodeSegment(uintptr_t HostCode) {
+      if (CodeSegments.empty()) {
+        return nullptr;
+      }
+
+      const auto Offset = HostCode - reinterpret_cast<uintptr_t>(CodeSegments[0].Ptr);
+      if (Offset >= MaxCodeSize) {
+        return nullptr;
+      }
+
+      return &CodeSegments[Offset / SegmentSize];
+    }
+
     // This is the array of code buffers. Unless signals force us to keep more than
     // buffer, there will be only one entry here
     std::vector<CodeBuffer> CodeBuffers{};
+
+    // Slices of CodeBuffers[0]
+    std::vector<CodeSegment> CodeSegments{};
+    size_t ClockHand{};
+
+    // Blocks that were pushed out of the code buffer and haven't aged out yet, only used for stats
+    std::unordered_set<uint64_t> EvictedBlocks{};
   };
 
 }
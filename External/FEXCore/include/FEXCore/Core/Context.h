@@ -13,6 +13,8 @@
 #include <set>
 #include <mutex>
 #include <shared_mutex>
+#include <utility>
+#include <vector>
 
 namespace FEXCore {
   class CodeLoader;
@@ -35,6 +37,7 @@ namespace FEXCore::HLE {
 
 namespace FEXCore::IR {
   struct AOTIRCacheEntry;
+  struct SHA256Sum;
   class IREmitter;
 }
 
@@ -67,6 +70,25 @@ namespace FEXCore::Context {
       std::unique_lock<std::shared_mutex> lock;
   };
 
+  /**
+   * @brief Time spent in each stage of compiling a single block
+   */
+  struct CompileBenchmarkResult {
+    uint64_t GuestInstructions;
+    uint64_t GuestInstructionBytes;
+    uint64_t HostCodeBytes;
+    uint64_t DecodeNanoseconds;
+    uint64_t IRGenNanoseconds;
+    uint64_t CodegenNanoseconds;
+    // Size of the block's IR, and what copying it out of the emitter and freeing it again would have cost
+    uint64_t IRBytes;
+    uint64_t IRCopyNanoseconds;
+    // The backend compiled straight from the emitter's buffer rather than a copy
+    bool IRLent;
+    // In pass order, includes RA
+    std::vector<std::pair<std::string, uint64_t>> PassNanoseconds;
+  };
+
   using CustomCPUFactoryType = std::function<std::unique_ptr<FEXCore::CPU::CPUBackend> (FEXCore::Context::Context*, FEXCore::Core::InternalThreadState *Thread)>;
 
   using ExitHandler = std::function<void(uint64_t ThreadId, FEXCore::Context::ExitReason)>;
@@ -146,6 +168,16 @@ namespace FEXCore::Context {
 
   FEX_DEFAULT_VISIBILITY void CompileRIP(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP);
 
+  /**
+   * @brief Compiles the code at GuestRIP and reports how long each stage took
+   *
+   * The code isn't added to the lookup cache, so this can be called repeatedly on the same RIP.
+   * The decoder is run once more on its own so its time can be split from the opcode dispatcher.
+   *
+   * @return false if the code couldn't be compiled
+   */
+  FEX_DEFAULT_VISIBILITY bool BenchmarkCompileRIP(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, CompileBenchmarkResult *Result);
+
   /**
    * @brief Gets the program exit status
    *
@@ -271,4 +303,12 @@ namespace FEXCore::Context {
 
   FEX_DEFAULT_VISIBILITY void ConfigureAOTGen(FEXCore::Core::InternalThreadState *Thread, std::set<uint64_t> *ExternalBranches, uint64_t SectionMaxAddress);
   FEX_DEFAULT_VISIBILITY CustomIRResult AddCustomIREntrypoint(FEXCore::Context::Context *CTX, uintptr_t Entrypoint, std::function<void(uintptr_t Entrypoint, FEXCore::IR::IREmitter *)> Handler, void *Creator = nullptr, void *Data = nullptr);
+  FEX_DEFAULT_VISIBILITY void RemoveCustomIREntrypoint(FEXCore::Context::Context *CTX, uintptr_t Entrypoint);
+
+  /**
+   * @brief Makes a host function callable from custom IR through the Thunk op
+   *
+   * Must be registered before any block using the hash is compiled.
+   */
+  FEX_DEFAULT_VISIBILITY void RegisterHostThunk(FEXCore::Context::Context *CTX, FEXCore::IR::SHA256Sum const &Sum, void (*Func)(void *ArgsRv));
 }
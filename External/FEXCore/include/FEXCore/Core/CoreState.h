@@ -23,6 +23,10 @@ namespace FEXCore::Core {
     uint64_t : 64; // Ensures mm is aligned
     uint64_t mm[8][2];
 
+    // Upper 128 bits of the AVX YMM registers
+    // The lower 128 bits alias the xmm registers
+    uint64_t ymm_upper[16][2];
+
     // 32bit x86 state
     struct {
       uint32_t base;
@@ -35,6 +39,7 @@ namespace FEXCore::Core {
     static constexpr size_t GPR_REG_SIZE = sizeof(gregs[0]);
     static constexpr size_t XMM_REG_SIZE = sizeof(xmm[0]);
     static constexpr size_t MM_REG_SIZE = sizeof(mm[0]);
+    static constexpr size_t YMM_UPPER_REG_SIZE = sizeof(ymm_upper[0]);
 
     // Only the first 32 bits are defined.
     static constexpr size_t NUM_EFLAG_BITS = 32;
@@ -43,10 +48,13 @@ namespace FEXCore::Core {
     static constexpr size_t NUM_GPRS = sizeof(gregs) / GPR_REG_SIZE;
     static constexpr size_t NUM_XMMS = sizeof(xmm) / XMM_REG_SIZE;
     static constexpr size_t NUM_MMS = sizeof(mm) / MM_REG_SIZE;
+    static constexpr size_t NUM_YMM_UPPERS = sizeof(ymm_upper) / YMM_UPPER_REG_SIZE;
   };
   static_assert(offsetof(CPUState, xmm) % 16 == 0, "xmm needs to be 128bit aligned!");
+  static_assert(offsetof(CPUState, ymm_upper) % 16 == 0, "ymm_upper needs to be 128bit aligned!");
 
   struct InternalThreadState;
+  struct RuntimeStats;
 
   enum FallbackHandlerIndex {
     OPINDEX_F80LOADFCW = 0,
@@ -104,6 +112,10 @@ namespace FEXCore::Core {
     OPINDEX_F64FPREM,
     OPINDEX_F64FPREM1,
     OPINDEX_F64SCALE,
+
+    // SSE4.2 string compare
+    OPINDEX_VPCMPESTRX,
+    OPINDEX_VPCMPISTRX,
     // Maximum
     OPINDEX_MAX,
   };
@@ -205,6 +217,8 @@ namespace FEXCore::Core {
     } SynchronousFaultData;
 
     InternalThreadState* Thread;
+    // Same as Thread->Stats, here so JIT code can reach it directly
+    RuntimeStats* Stats;
 
     // Pointers that the JIT needs to load to remove relocations
     JITPointers Pointers;
@@ -74,6 +74,9 @@ namespace Core {
     // Use the last signal just so we are less likely to ever conflict with something that the guest application is using
     // 64 is used internally by Valgrind
     constexpr static size_t SIGNAL_FOR_PAUSE {63};
+    // Delivered by the sampling profiler's per-thread timers
+    // SIGPROF is left alone since guests commonly use it with setitimer
+    constexpr static size_t SIGNAL_FOR_PROFILE {62};
 
   protected:
     FEXCore::Core::InternalThreadState *GetTLSThread();
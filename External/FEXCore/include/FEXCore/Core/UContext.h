@@ -43,6 +43,40 @@ namespace FEXCore {
     };
     static_assert(sizeof(FEXCore::x86_64::_libc_fpstate) == 512, "This needs to be the right size");
 
+    // Extended state that follows the FXSAVE area when the frame has UC_FP_XSTATE and the magic set
+    constexpr uint32_t FEX_FP_XSTATE_MAGIC1 = 0x46505853;
+    constexpr uint32_t FEX_FP_XSTATE_MAGIC2 = 0x46505845;
+    ///< x87, SSE and AVX
+    constexpr uint64_t FEX_XSTATE_FEATURES  = 0b111;
+
+    ///< Lives in the software reserved bytes at the end of the FXSAVE area
+    struct FEX_PACKED _fpx_sw_bytes {
+      uint32_t magic1;
+      // Size of everything from the FXSAVE area up to and including magic2
+      uint32_t extended_size;
+      uint64_t xfeatures;
+      // Size of the XSAVE area, magic2 follows it
+      uint32_t xstate_size;
+      uint32_t padding[7];
+    };
+    static_assert(sizeof(FEXCore::x86_64::_fpx_sw_bytes) == 48, "This needs to be the right size");
+
+    struct FEX_PACKED xstate_header {
+      uint64_t xfeatures;
+      uint64_t reserved1[2];
+      uint64_t reserved2[5];
+    };
+    static_assert(sizeof(FEXCore::x86_64::xstate_header) == 64, "This needs to be the right size");
+
+    struct FEX_PACKED xstate {
+      FEXCore::x86_64::_libc_fpstate fpstate;
+      FEXCore::x86_64::xstate_header xstate_hdr;
+      // Upper halves of ymm0-15
+      __uint128_t ymmh[16];
+    };
+    static_assert(sizeof(FEXCore::x86_64::xstate) == 832, "This needs to be the right size");
+    static_assert(offsetof(FEXCore::x86_64::_libc_fpstate, _res[12]) == 464, "sw bytes need to be at the end of the FXSAVE area");
+
     ///< The order of these must match the GNU ordering
     enum ContextRegs {
       FEX_REG_R8 = 0,
@@ -261,6 +295,17 @@ namespace FEXCore {
     };
     static_assert(sizeof(FEXCore::x86::_libc_fpstate) == 624, "This needs to be the right size");
 
+    // The XSAVE area starts at the FXSAVE data, after the legacy fsave state
+    constexpr size_t FXSAVE_OFFSET = offsetof(FEXCore::x86::_libc_fpstate, pad);
+
+    struct FEX_PACKED xstate {
+      FEXCore::x86::_libc_fpstate fpstate;
+      FEXCore::x86_64::xstate_header xstate_hdr;
+      // Upper halves of ymm0-15, a 32-bit guest only has the first eight
+      __uint128_t ymmh[16];
+    };
+    static_assert(sizeof(FEXCore::x86::xstate) - FXSAVE_OFFSET == sizeof(FEXCore::x86_64::xstate), "The XSAVE area matches across modes");
+
     struct FEX_PACKED ucontext_t {
       uint32_t uc_flags;
       uint32_t uc_link; // XXX: should be a compat_ptr<FEXCore::x86::ucontext_t>
@@ -2,6 +2,7 @@
 #include <FEXCore/Core/Context.h>
 #include <FEXCore/Core/CoreState.h>
 #include <FEXCore/Core/CPUBackend.h>
+#include <FEXCore/Debug/RuntimeStats.h>
 #include <FEXCore/IR/IntrusiveIRList.h>
 #include <FEXCore/IR/RegisterAllocationData.h>
 #include <FEXCore/Utils/Event.h>
@@ -15,6 +16,7 @@
 namespace FEXCore {
   class LookupCache;
   class CompileService;
+  class ThreadSampler;
 }
 
 namespace FEXCore::Context {
@@ -36,11 +38,6 @@ namespace FEXCore::IR{
 
 namespace FEXCore::Core {
 
-  struct RuntimeStats {
-    std::atomic_uint64_t InstructionsExecuted;
-    std::atomic_uint64_t BlocksCompiled;
-  };
-
   struct DebugDataSubblock {
     uint32_t HostCodeOffset;
     uint32_t HostCodeSize;
@@ -58,6 +55,8 @@ namespace FEXCore::Core {
    */
   struct DebugData {
     uint64_t HostCodeSize; ///< The size of the code generated in the host JIT
+    uint64_t HostColdCodeOffset; ///< Offset from the block entry to its cold code, split away from the rest of the block
+    uint64_t HostColdCodeSize; ///< The size of the cold code, zero if the block has none
     std::vector<DebugDataSubblock> Subblocks;
     std::vector<DebugDataGuestOpcode> GuestOpcodes;
     std::vector<FEXCore::CPU::Relocation> *Relocations;
@@ -99,6 +98,7 @@ namespace FEXCore::Core {
 
     std::unique_ptr<FEXCore::CPU::CPUBackend> CPUBackend;
     std::unique_ptr<FEXCore::LookupCache> LookupCache;
+    std::unique_ptr<FEXCore::ThreadSampler> Sampler;
 
     std::unordered_map<uint64_t, LocalIREntry> DebugStore;
 
@@ -106,7 +106,9 @@ namespace FEXCore::Core {
     std::unique_ptr<FEXCore::IR::PassManager> PassManager;
     FEXCore::HLE::ThreadManagement ThreadManager;
 
-    RuntimeStats Stats{};
+    // Points in to the shared stats region when one is enabled
+    RuntimeStats LocalStats{};
+    RuntimeStats *Stats{&LocalStats};
 
     int StatusCode{};
     FEXCore::Context::ExitReason ExitReason {FEXCore::Context::ExitReason::EXIT_WAITING};
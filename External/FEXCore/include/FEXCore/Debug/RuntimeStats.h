@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+
+namespace FEXCore::Core {
+  /**
+   * @brief Per-thread runtime counters
+   *
+   * These live in a shared memory region when SharedStats is enabled so that FEXStats can read them live.
+   * Counters are only written by their owning thread unless noted otherwise, which lets them be bumped with
+   * a plain load and store rather than a locked read-modify-write.
+   * The layout is shared with external tools, bump STATS_VERSION when changing it.
+   */
+  struct alignas(64) RuntimeStats {
+    constexpr static size_t MAX_SYSCALLS = 512;
+    constexpr static size_t MAX_PASSES = 32;
+
+    // TID of the thread that owns this slot, zero when free
+    std::atomic<uint32_t> TID;
+
+    std::atomic_uint64_t InstructionsExecuted;
+
+    // Blocks by where their code came from
+    std::atomic_uint64_t BlocksCompiled;
+    std::atomic_uint64_t BlocksFromAOTIR;
+    std::atomic_uint64_t BlocksFromObjectCache;
+
+    // Time spent compiling, per pass timings are indexed by the region's pass name table
+    std::atomic_uint64_t IRGenNanoseconds;
+    std::atomic_uint64_t CodegenNanoseconds;
+    std::atomic_uint64_t PassNanoseconds[MAX_PASSES];
+    // Guest instructions the frontend took from its decode cache instead of decoding again
+    std::atomic_uint64_t DecodeCacheHits;
+    std::atomic_uint64_t DecodeCacheMisses;
+    // Guest memory loads removed by MemoryLSE, either forwarded from a store or redundant with an earlier load
+    std::atomic_uint64_t MemoryLoadsForwarded;
+    std::atomic_uint64_t MemoryLoadsEliminated;
+
+    // Block lookups from the dispatcher and block linking, by the cache level that hit
+    std::atomic_uint64_t LookupL1Hits;
+    std::atomic_uint64_t LookupL2Hits;
+    std::atomic_uint64_t LookupL3Hits;
+    std::atomic_uint64_t LookupMisses;
+
+    std::atomic_uint64_t SMCFaults;
+    // Written by whichever thread invalidates code
+    std::atomic_uint64_t CodeInvalidations;
+    std::atomic_uint64_t CodeCacheClears;
+    // Bytes of host code in the current code buffer, reset when the cache is cleared
+    std::atomic_uint64_t CodeBufferBytes;
+    // Code buffer segments reused once the buffer was full, and the blocks that were pushed out by it
+    std::atomic_uint64_t CodeSegmentEvictions;
+    std::atomic_uint64_t BlocksEvicted;
+    // Blocks compiled again after being evicted
+    std::atomic_uint64_t CapacityRecompiles;
+
+    std::atomic_uint64_t SignalsDelivered;
+    // SIGBUS taken on misaligned atomics, a site only takes one once it has been backpatched
+    std::atomic_uint64_t MisalignedAtomicFaults;
+    // Incremented directly from JIT code
+    std::atomic_uint64_t ThunkCalls;
+    std::atomic_uint64_t Syscalls[MAX_SYSCALLS];
+  };
+
+  static_assert(sizeof(std::atomic_uint64_t) == sizeof(uint64_t), "JIT code increments counters as plain uint64_t");
+
+  // All counters are laid out back to back after TID so they can be walked as an array
+  constexpr size_t NUM_STAT_COUNTERS =
+    (offsetof(RuntimeStats, Syscalls) + sizeof(RuntimeStats::Syscalls) - offsetof(RuntimeStats, InstructionsExecuted)) / sizeof(uint64_t);
+
+  static inline std::atomic_uint64_t *GetStatCounters(RuntimeStats *Stats) {
+    return &Stats->InstructionsExecuted;
+  }
+
+  /**
+   * @brief Bumps a counter that only the calling thread writes
+   */
+  static inline void IncrementStat(std::atomic_uint64_t &Counter, uint64_t Value = 1) {
+    Counter.store(Counter.load(std::memory_order_relaxed) + Value, std::memory_order_relaxed);
+  }
+}
+
+namespace FEXCore::Stats {
+  constexpr uint32_t STATS_MAGIC = 0x53584546; // 'FEXS'
+  constexpr uint32_t STATS_VERSION = 5;
+  constexpr size_t MAX_THREADS = 256;
+  constexpr size_t PASS_NAME_LENGTH = 32;
+
+  /**
+   * @brief Layout of the shared memory stats region
+   *
+   * Created by the emulated process as /dev/shm/fex-<pid>-stats and mapped read-only by FEXStats
+   */
+  struct StatsHeader {
+    uint32_t Magic;
+    uint32_t Version;
+    uint64_t Size;
+    uint32_t PID;
+    uint32_t MaxThreads;
+
+    // Pass names are appended once and never change after that
+    std::atomic<uint32_t> NumPasses;
+    char PassNames[FEXCore::Core::RuntimeStats::MAX_PASSES][PASS_NAME_LENGTH];
+
+    // Counters of threads that have exited get folded in here
+    FEXCore::Core::RuntimeStats Retired;
+    FEXCore::Core::RuntimeStats Threads[MAX_THREADS];
+  };
+
+  static inline std::string GetSharedMemoryPath(pid_t PID) {
+    return "/dev/shm/fex-" + std::to_string(PID) + "-stats";
+  }
+}
@@ -35,6 +35,8 @@ friend class FEXCore::IR::PassManager;
 
     IRListView ViewIR() { return IRListView(&DualListData, false); }
     IRListView *CreateIRCopy() { return new IRListView(&DualListData, true); }
+    // Only valid until the working list is reset or the buffer is disowned
+    IRListView *CreateIRView() { return new IRListView(&DualListData, false); }
     void ResetWorkingList();
 
   /**
@@ -5,9 +5,11 @@
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXCore/Utils/ThreadPoolAllocator.h>
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstring>
+#include <new>
 #include <tuple>
 #include <vector>
 #include <istream>
@@ -136,7 +138,7 @@ public:
     ListSize = Data->ListSize();
 
     if (_IsCopy) {
-      IRDataInternal = malloc(DataSize + ListSize);
+      IRDataInternal = AllocateCopy(DataSize + ListSize);
       ListDataInternal = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(IRDataInternal) + DataSize);
       memcpy(IRDataInternal, reinterpret_cast<void*>(Data->DataBegin()), DataSize);
       memcpy(ListDataInternal, reinterpret_cast<void*>(Data->ListBegin()), ListSize);
@@ -152,21 +154,26 @@ public:
     SetCopy(_IsCopy);
     DataSize = Old->DataSize;
     ListSize = Old->ListSize;
+    // Old might be an inline view, go through the accessors rather than its pointers
     if (_IsCopy) {
-      IRDataInternal = malloc(DataSize + ListSize);
+      IRDataInternal = AllocateCopy(DataSize + ListSize);
       ListDataInternal = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(IRDataInternal) + DataSize);
-      memcpy(IRDataInternal, Old->IRDataInternal, DataSize);
-      memcpy(ListDataInternal, Old->ListDataInternal, ListSize);
+      memcpy(IRDataInternal, reinterpret_cast<void*>(Old->GetData()), DataSize);
+      memcpy(ListDataInternal, reinterpret_cast<void*>(Old->GetListData()), ListSize);
     } else {
-      IRDataInternal = Old->IRDataInternal;
-      ListDataInternal = Old->ListDataInternal;
+      IRDataInternal = reinterpret_cast<void*>(Old->GetData());
+      ListDataInternal = reinterpret_cast<void*>(Old->GetListData());
     }
   }
 
   ~IRListView() {
-    if (IsCopy()) {
-      free (IRDataInternal);
+    // Inline views written out from a copy still carry the copy flag
+    if (IsCopy() && !IsShared()) {
       // ListData is just offset from IRData
+      auto Header = GetCopyHeader();
+      if (Header->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        free(Header);
+      }
     }
   }
 
@@ -217,6 +224,21 @@ public:
     return new IRListView(this, true);
   }
 
+  /**
+   * @brief Creates another view of this IR without copying it
+   *
+   * Copies are refcounted, the data lives until the last view of it is deleted.
+   * Views of inline or emitter owned IR are only valid as long as that storage is.
+   */
+  [[nodiscard]] IRListView *Share() {
+    auto View = new IRListView(this, false);
+    if (IsCopy() && !IsShared()) {
+      GetCopyHeader()->RefCount.fetch_add(1, std::memory_order_relaxed);
+      View->SetCopy(true);
+    }
+    return View;
+  }
+
   [[nodiscard]] size_t GetDataSize() const { return DataSize; }
   [[nodiscard]] size_t GetListSize() const { return ListSize; }
   [[nodiscard]] size_t GetSSACount() const { return ListSize / sizeof(OrderedNode); }
@@ -391,6 +413,21 @@ public:
   }
 
 private:
+  // Copies are a single allocation with the refcount in front of the IR and list data
+  struct alignas(16) CopyHeader {
+    std::atomic<uint32_t> RefCount;
+  };
+
+  static void *AllocateCopy(size_t Size) {
+    auto Header = new (malloc(sizeof(CopyHeader) + Size)) CopyHeader{};
+    Header->RefCount.store(1, std::memory_order_relaxed);
+    return Header + 1;
+  }
+
+  CopyHeader *GetCopyHeader() const {
+    return reinterpret_cast<CopyHeader*>(IRDataInternal) - 1;
+  }
+
   void *IRDataInternal;
   void *ListDataInternal;
   size_t DataSize;
@@ -24,6 +24,28 @@ namespace FEXCore::Allocator {
   FEX_DEFAULT_VISIBILITY void ClearHooks();
 
   FEX_DEFAULT_VISIBILITY size_t DetermineVASize();
+
+  enum class HugePageType {
+    // Regular 4K pages
+    NONE,
+    // Transparent huge pages through MADV_HUGEPAGE
+    THP,
+    // Explicit hugetlb pages, falls back to THP when none are reserved
+    HUGETLB,
+  };
+
+  constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+  /**
+   * @brief Maps private anonymous memory aligned to HUGE_PAGE_SIZE and backed by huge pages where possible
+   *
+   * Size must be a multiple of HUGE_PAGE_SIZE. Goes through FEXCore::Allocator::mmap so the mapping
+   * stays out of the guest's address space, free it with FEXCore::Allocator::munmap.
+   *
+   * @return The mapping or MAP_FAILED
+   */
+  FEX_DEFAULT_VISIBILITY void *MapHugePageAligned(size_t Size, int Prot, HugePageType Type);
+
   // 48-bit VA handling
   struct PtrCache {
     uint64_t Ptr;
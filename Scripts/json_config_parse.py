@@ -51,7 +51,23 @@ class Regs(Flag):
     REG_MM7   = (1 << 43)
     REG_MM8   = (1 << 44)
     REG_ALL   = (1 << 45) - 1
-    REG_INVALID = (1 << 45)
+    REG_YMMH0  = (1 << 45)
+    REG_YMMH1  = (1 << 46)
+    REG_YMMH2  = (1 << 47)
+    REG_YMMH3  = (1 << 48)
+    REG_YMMH4  = (1 << 49)
+    REG_YMMH5  = (1 << 50)
+    REG_YMMH6  = (1 << 51)
+    REG_YMMH7  = (1 << 52)
+    REG_YMMH8  = (1 << 53)
+    REG_YMMH9  = (1 << 54)
+    REG_YMMH10 = (1 << 55)
+    REG_YMMH11 = (1 << 56)
+    REG_YMMH12 = (1 << 57)
+    REG_YMMH13 = (1 << 58)
+    REG_YMMH14 = (1 << 59)
+    REG_YMMH15 = (1 << 60)
+    REG_INVALID = (1 << 61)
 
 class ABI(Flag) :
     ABI_SYSTEMV = 0
@@ -110,6 +126,22 @@ RegStringLookup = {
     "MM6":   Regs.REG_MM6,
     "MM7":   Regs.REG_MM7,
     "MM8":   Regs.REG_MM8,
+    "YMMH0": Regs.REG_YMMH0,
+    "YMMH1": Regs.REG_YMMH1,
+    "YMMH2": Regs.REG_YMMH2,
+    "YMMH3": Regs.REG_YMMH3,
+    "YMMH4": Regs.REG_YMMH4,
+    "YMMH5": Regs.REG_YMMH5,
+    "YMMH6": Regs.REG_YMMH6,
+    "YMMH7": Regs.REG_YMMH7,
+    "YMMH8": Regs.REG_YMMH8,
+    "YMMH9": Regs.REG_YMMH9,
+    "YMMH10": Regs.REG_YMMH10,
+    "YMMH11": Regs.REG_YMMH11,
+    "YMMH12": Regs.REG_YMMH12,
+    "YMMH13": Regs.REG_YMMH13,
+    "YMMH14": Regs.REG_YMMH14,
+    "YMMH15": Regs.REG_YMMH15,
 }
 
 ABIStringLookup = {
@@ -321,6 +321,30 @@ ELFSymbol const *ELFContainer::GetSymbolInRange(RangeType Address) {
   return Sym->second;
 }
 
+std::optional<uint64_t> ELFContainer::GetFileOffset(uint64_t Address) const {
+  for (auto const &Phdr : ProgramHeaders) {
+    uint64_t Type, VAddr, FileSize, Offset;
+    if (Mode == MODE_32BIT) {
+      Type = Phdr._32->p_type;
+      VAddr = Phdr._32->p_vaddr;
+      FileSize = Phdr._32->p_filesz;
+      Offset = Phdr._32->p_offset;
+    }
+    else {
+      Type = Phdr._64->p_type;
+      VAddr = Phdr._64->p_vaddr;
+      FileSize = Phdr._64->p_filesz;
+      Offset = Phdr._64->p_offset;
+    }
+
+    if (Type == PT_LOAD && Address >= VAddr && Address < (VAddr + FileSize)) {
+      return Offset + (Address - VAddr);
+    }
+  }
+
+  return std::nullopt;
+}
+
 void ELFContainer::CalculateMemoryLayouts() {
   uint64_t MinPhysAddr = ~0ULL;
   uint64_t MaxPhysAddr = 0;
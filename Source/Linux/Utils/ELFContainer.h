@@ -4,6 +4,7 @@
 #include <elf.h>
 #include <functional>
 #include <map>
+#include <optional>
 #include <stddef.h>
 #include <string>
 #include <tuple>
@@ -71,6 +72,9 @@ public:
   using RangeType = std::pair<uint64_t, uint64_t>;
   ELFSymbol const *GetSymbolInRange(RangeType Address);
 
+  // Translates a virtual address to its offset in the file through the PT_LOAD headers
+  std::optional<uint64_t> GetFileOffset(uint64_t Address) const;
+
   bool WasDynamic() const { return DynamicProgram; }
   bool HasDynamicLinker() const { return !DynamicLinker.empty(); }
   bool WasLoaded() const { return Loaded; }
@@ -1,3 +1,4 @@
+#include "AOTGenerator.h"
 #include "ELFCodeLoader2.h"
 #include "Linux/Utils/ELFContainer.h"
 
@@ -5,18 +6,93 @@
 #include <FEXCore/Utils/LogManager.h>
 #include <FEXHeaderUtils/Syscalls.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <sys/resource.h>
 #include <sys/sysinfo.h>
 #include <thread>
-#include <queue>
+#include <vector>
 
 namespace FEX::AOT {
-void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader2::LoadedSection &Section) {
+namespace {
+  /**
+   * @brief Lock-free set of entrypoints that were already queued
+   *
+   * One bit per byte of the section, anything outside of the section is never inserted.
+   */
+  class VisitedSet final {
+  public:
+    VisitedSet(uint64_t Base, uint64_t Size)
+      : Base {Base}
+      , Size {Size}
+      , Bits {std::make_unique<std::atomic<uint64_t>[]>((Size + 63) / 64)} {
+    }
+
+    // Returns true if Address is in the section and wasn't in the set before
+    bool Insert(uint64_t Address) {
+      if (Address < Base || Address >= (Base + Size)) {
+        return false;
+      }
+
+      const uint64_t Offset = Address - Base;
+      const uint64_t Mask = 1ULL << (Offset % 64);
+      return !(Bits[Offset / 64].fetch_or(Mask, std::memory_order_relaxed) & Mask);
+    }
+
+  private:
+    uint64_t Base;
+    uint64_t Size;
+    std::unique_ptr<std::atomic<uint64_t>[]> Bits;
+  };
+
+  /**
+   * @brief Per-thread entrypoint deque
+   *
+   * The owning thread works depth first from the back so related blocks get compiled together,
+   * other threads steal from the front. The lock is only contended while stealing.
+   */
+  struct WorkQueue {
+    std::mutex Mutex;
+    std::deque<uint64_t> Entries;
+
+    void PushBack(uint64_t Entry) {
+      std::scoped_lock lk(Mutex);
+      Entries.push_back(Entry);
+    }
+
+    std::optional<uint64_t> PopBack() {
+      std::scoped_lock lk(Mutex);
+      if (Entries.empty()) {
+        return std::nullopt;
+      }
+      auto Entry = Entries.back();
+      Entries.pop_back();
+      return Entry;
+    }
+
+    std::optional<uint64_t> PopFront() {
+      std::scoped_lock lk(Mutex);
+      if (Entries.empty()) {
+        return std::nullopt;
+      }
+      auto Entry = Entries.front();
+      Entries.pop_front();
+      return Entry;
+    }
+  };
+}
+
+AOTGenStats AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader2::LoadedSection &Section, size_t NumThreads) {
   // Make sure this section is executable and big enough
   if (!Section.Executable || Section.Size < 16)
-    return;
+    return {};
 
   std::set<uintptr_t> InitialBranchTargets;
 
@@ -77,26 +153,35 @@ void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader2::LoadedSection
 
   uint64_t SectionMaxAddress = Section.Base + Section.Size;
 
-  std::set<uint64_t> Compiled;
-  std::atomic<int> counter = 0;
-
-  std::queue<uint64_t> BranchTargets;
-
-  // Setup BranchTargets, Compiled sets from InitiaBranchTargets
-
-  Compiled.insert(InitialBranchTargets.begin(), InitialBranchTargets.end());
-  for (auto BranchTarget: InitialBranchTargets) {
-    BranchTargets.push(BranchTarget);
+  if (NumThreads == 0) {
+    NumThreads = std::max(1, get_nprocs_conf());
   }
+  VisitedSet Visited{Section.Base, Section.Size};
+  std::vector<WorkQueue> Queues(NumThreads);
+
+  // Pushed but not yet compiled, threads only exit once this hits zero
+  std::atomic<uint64_t> Pending{};
+  std::atomic<uint64_t> Compiled{};
+  std::atomic<uint64_t> Discovered{};
+  std::atomic<uint64_t> Steals{};
+
+  // Spread the seed over the queues, neighbouring entrypoints tend to cost about the same
+  size_t Seeded{};
+  for (auto BranchTarget : InitialBranchTargets) {
+    if (Visited.Insert(BranchTarget)) {
+      Queues[Seeded % NumThreads].Entries.push_back(BranchTarget);
+      ++Seeded;
+    }
+  }
+  Pending = Seeded;
 
   InitialBranchTargets.clear();
 
-
-  std::mutex QueueMutex;
+  const auto Start = std::chrono::steady_clock::now();
   std::vector<std::thread> ThreadPool;
 
-  for (int i = 0; i < get_nprocs_conf(); i++) {
-    std::thread thd([&BranchTargets, CTX, &counter, &Compiled, &Section, &QueueMutex, SectionMaxAddress]() {
+  for (size_t i = 0; i < NumThreads; i++) {
+    std::thread thd([&, i]() {
       // Set the priority of the thread so it doesn't overwhelm the system when running in the background
       setpriority(PRIO_PROCESS, FHU::Syscalls::gettid(), 19);
 
@@ -106,40 +191,42 @@ void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader2::LoadedSection
       std::set<uint64_t> ExternalBranchesLocal;
       FEXCore::Context::ConfigureAOTGen(Thread, &ExternalBranchesLocal, SectionMaxAddress);
 
+      auto &Local = Queues[i];
 
-      for (;;) {
-        uint64_t BranchTarget;
+      while (Pending.load(std::memory_order_acquire)) {
+        auto BranchTarget = Local.PopBack();
 
-        // Get a entrypoint to process from the queue
-        QueueMutex.lock();
-        if (BranchTargets.empty()) {
-          QueueMutex.unlock();
-          break; // no entrypoint to process - exit
+        // Out of local work, steal the oldest entrypoints of another thread
+        for (size_t Victim = 1; !BranchTarget && Victim < NumThreads; ++Victim) {
+          BranchTarget = Queues[(i + Victim) % NumThreads].PopFront();
+          if (BranchTarget) {
+            ++Steals;
+          }
+        }
+
+        if (!BranchTarget) {
+          // Whatever is left is being compiled and may still produce more work
+          std::this_thread::yield();
+          continue;
         }
 
-        BranchTarget = BranchTargets.front();
-        BranchTargets.pop();
-        QueueMutex.unlock();
-
-        // Compile entrypoint
-        counter++;
-        FEXCore::Context::CompileRIP(Thread, BranchTarget);
-
-        // Are there more branches?
-        if (ExternalBranchesLocal.size() > 0) {
-          // Add them to the "to process" list
-          QueueMutex.lock();
-          for(auto Destination: ExternalBranchesLocal) {
-              if (! (Destination >= Section.Base && Destination <= (Section.Base + Section.Size)) )
-                continue;
-              if (Compiled.contains(Destination))
-                continue;
-              Compiled.insert(Destination);
-            BranchTargets.push(Destination);
+        FEXCore::Context::CompileRIP(Thread, *BranchTarget);
+        ++Compiled;
+
+        // Branch targets leaving the compiled blocks are new entrypoints, queue them locally
+        for (auto Destination : ExternalBranchesLocal) {
+          if (!Visited.Insert(Destination)) {
+            continue;
           }
-          QueueMutex.unlock();
-          ExternalBranchesLocal.clear();
+
+          Pending.fetch_add(1, std::memory_order_relaxed);
+          Local.PushBack(Destination);
+          ++Discovered;
         }
+        ExternalBranchesLocal.clear();
+
+        // Only retire this entrypoint once its discoveries are visible
+        Pending.fetch_sub(1, std::memory_order_release);
       }
 
       // All entryproints processed, cleanup this thread
@@ -157,6 +244,13 @@ void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader2::LoadedSection
 
   ThreadPool.clear();
 
-  LogMan::Msg::IFmt("\nAll Done: {}", counter.load());
+  const auto Duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - Start);
+  LogMan::Msg::IFmt("\nAll Done: {} entrypoints ({} seed, {} discovered) in {}ms on {} threads, {} steals",
+    Compiled.load(), Seeded, Discovered.load(), Duration.count(), NumThreads, Steals.load());
+
+  return {
+    .Entrypoints = Compiled.load(),
+    .Steals = Steals.load(),
+  };
 }
 }
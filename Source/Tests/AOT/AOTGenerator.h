@@ -2,6 +2,19 @@
 
 #include "ELFCodeLoader2.h"
 
+#include <cstddef>
+#include <cstdint>
+
 namespace FEX::AOT {
-  void AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader2::LoadedSection &Section);
+  struct AOTGenStats {
+    uint64_t Entrypoints{};
+    uint64_t Steals{};
+  };
+
+  /**
+   * @brief Compiles every entrypoint reachable in an executable section
+   *
+   * @param NumThreads - Compile threads to use, 0 uses one per CPU
+   */
+  AOTGenStats AOTGenSection(FEXCore::Context::Context *CTX, ELFCodeLoader2::LoadedSection &Section, size_t NumThreads = 0);
 }
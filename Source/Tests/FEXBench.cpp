@@ -0,0 +1,821 @@
+/*
+$info$
+tags: Bin|FEXBench
+desc: Microbenchmarks for the compile pipeline and runtime hot paths, writes JSON
+$end_info$
+*/
+
+#include "AOT/AOTGenerator.h"
+#include "Common/ArgumentLoader.h"
+#include "ELFCodeLoader2.h"
+#include "HarnessHelpers.h"
+#include "Tests/LinuxSyscalls/LibcReplacements.h"
+#include "Tests/LinuxSyscalls/Syscalls.h"
+#include "Tests/LinuxSyscalls/x64/Syscalls.h"
+#include "Tests/LinuxSyscalls/SignalDelegator.h"
+
+#include <FEXCore/Config/Config.h>
+#include <FEXCore/Core/CodeLoader.h>
+#include <FEXCore/Core/Context.h>
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Core/X86Enums.h>
+#include <FEXCore/Debug/InternalThreadState.h>
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IREmitter.h>
+#include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXCore/Utils/ThreadPoolAllocator.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <linux/perf_event.h>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/sysinfo.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include <fmt/format.h>
+#include <git_version.h>
+#include <json-maker.h>
+
+namespace {
+// Every runtime kernel is run this many times, the fastest run is reported
+constexpr size_t KERNEL_RUNS = 3;
+// Every block in the compile corpus is compiled this many times, the fastest compile of each stage is kept
+constexpr size_t COMPILE_RUNS = 5;
+
+// Kernels can jump over a table of libc style routines, they are then run a second time with those replaced by host code
+constexpr char NATIVE_ROUTINES_MAGIC[8] = {'F', 'E', 'X', 'N', 'A', 'T', 'I', 'V'};
+constexpr size_t NATIVE_ROUTINES_OFFSET = 8;
+
+// Kernels that get a second .NoSRA run with static register allocation disabled, the difference is what SRA is worth
+constexpr std::array<std::string_view, 3> SRA_COMPARISON_KERNELS = {"IntegerALU", "LargeBody", "RegisterPressure"};
+
+// Terminated by a zero offset
+struct NativeRoutineEntry {
+  uint64_t Offset;
+  char Name[8];
+};
+
+struct BenchResult {
+  std::string Name;
+  std::string Unit;
+  double Value;
+};
+
+void MsgHandler(LogMan::DebugLevels Level, char const *Message) {
+  // Only surface errors, stdout may be carrying the JSON
+  if (Level == LogMan::ERROR) {
+    fmt::print(stderr, "[ERROR] {}\n", Message);
+  }
+}
+
+void AssertHandler(char const *Message) {
+  fmt::print(stderr, "[ASSERT] {}\n", Message);
+  fflush(nullptr);
+}
+
+/**
+ * @brief Runs the benchmark in a forked child so every benchmark starts from a fresh FEXCore context
+ *
+ * Results are sent back over a pipe as tab separated lines.
+ */
+std::vector<BenchResult> RunInChild(std::function<std::vector<BenchResult>()> Bench) {
+  int Pipes[2];
+  if (pipe(Pipes) == -1) {
+    return {};
+  }
+
+  pid_t Child = fork();
+  if (Child == 0) {
+    close(Pipes[0]);
+    std::string Output;
+    for (auto &Result : Bench()) {
+      Output += fmt::format("{}\t{}\t{}\n", Result.Name, Result.Unit, Result.Value);
+    }
+    write(Pipes[1], Output.data(), Output.size());
+    close(Pipes[1]);
+    _exit(0);
+  }
+
+  close(Pipes[1]);
+  std::string Input;
+  char Buffer[4096];
+  ssize_t Read;
+  while ((Read = read(Pipes[0], Buffer, sizeof(Buffer))) > 0) {
+    Input.append(Buffer, Read);
+  }
+  close(Pipes[0]);
+
+  int Status{};
+  waitpid(Child, &Status, 0);
+  if (!WIFEXITED(Status) || WEXITSTATUS(Status) != 0) {
+    LogMan::Msg::EFmt("Benchmark child didn't exit cleanly");
+  }
+
+  std::vector<BenchResult> Results;
+  size_t Offset{};
+  while (Offset < Input.size()) {
+    size_t End = Input.find('\n', Offset);
+    std::string_view Line {Input.data() + Offset, End - Offset};
+    Offset = End + 1;
+
+    size_t Tab1 = Line.find('\t');
+    size_t Tab2 = Line.find('\t', Tab1 + 1);
+    Results.emplace_back(BenchResult {
+      .Name = std::string(Line.substr(0, Tab1)),
+      .Unit = std::string(Line.substr(Tab1 + 1, Tab2 - Tab1 - 1)),
+      .Value = std::stod(std::string(Line.substr(Tab2 + 1))),
+    });
+  }
+  return Results;
+}
+
+// Context setup shared by every benchmark, same as the TestHarnessRunner
+struct BenchContext {
+  BenchContext() {
+    FEXCore::Config::Set(FEXCore::Config::CONFIG_IS64BIT_MODE, "1");
+    SignalDelegation = std::make_unique<FEX::HLE::SignalDelegator>();
+
+    FEXCore::Context::InitializeStaticTables(FEXCore::Context::MODE_64BIT);
+    CTX = FEXCore::Context::CreateNewContext();
+    FEXCore::Context::InitializeContext(CTX);
+
+    SyscallHandler = FEX::HLE::x64::CreateHandler(CTX, SignalDelegation.get());
+    FEXCore::Context::SetSignalDelegator(CTX, SignalDelegation.get());
+    FEXCore::Context::SetSyscallHandler(CTX, SyscallHandler.get());
+  }
+
+  ~BenchContext() {
+    SyscallHandler.reset();
+    FEXCore::Context::DestroyContext(CTX);
+    FEXCore::Context::ShutdownStaticTables();
+  }
+
+  bool MapMemory(FEXCore::CodeLoader &Loader) {
+    auto Mapper = std::bind_front(&FEX::HLE::SyscallHandler::GuestMmap, SyscallHandler.get());
+    auto Unmapper = std::bind_front(&FEX::HLE::SyscallHandler::GuestMunmap, SyscallHandler.get());
+    return Loader.MapMemory(Mapper, Unmapper);
+  }
+
+  std::unique_ptr<FEX::HLE::SignalDelegator> SignalDelegation;
+  FEXCore::Context::Context *CTX;
+  std::unique_ptr<FEX::HLE::SyscallHandler> SyscallHandler;
+};
+
+/**
+ * @brief Counts TLB and instruction cache misses of the calling thread and any threads it spawns
+ *
+ * Uses perf_event_open, so counters read as empty when the host PMU isn't available
+ * or perf_event_paranoid doesn't allow self-monitoring.
+ */
+class MissCounters {
+public:
+  enum Counter {
+    DTLB,
+    ITLB,
+    L1I,
+    NUM_COUNTERS,
+  };
+
+  MissCounters()
+    : FDs {Open(PERF_COUNT_HW_CACHE_DTLB), Open(PERF_COUNT_HW_CACHE_ITLB), Open(PERF_COUNT_HW_CACHE_L1I)} {
+  }
+
+  ~MissCounters() {
+    for (int FD : FDs) {
+      if (FD != -1) {
+        close(FD);
+      }
+    }
+  }
+
+  void Start() {
+    for (int FD : FDs) {
+      if (FD != -1) {
+        ioctl(FD, PERF_EVENT_IOC_RESET, 0);
+        ioctl(FD, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+  }
+
+  void Stop() {
+    for (int FD : FDs) {
+      if (FD != -1) {
+        ioctl(FD, PERF_EVENT_IOC_DISABLE, 0);
+      }
+    }
+  }
+
+  std::optional<uint64_t> Misses(Counter Which) const {
+    uint64_t Value{};
+    if (FDs[Which] == -1 || read(FDs[Which], &Value, sizeof(Value)) != sizeof(Value)) {
+      return std::nullopt;
+    }
+    return Value;
+  }
+
+private:
+  static int Open(uint64_t Cache) {
+    perf_event_attr Attr{};
+    Attr.size = sizeof(Attr);
+    Attr.type = PERF_TYPE_HW_CACHE;
+    Attr.config = Cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    Attr.disabled = 1;
+    Attr.inherit = 1;
+    // Page walks and cache misses from the kernel aren't what we are measuring
+    Attr.exclude_kernel = 1;
+    Attr.exclude_hv = 1;
+    return ::syscall(SYS_perf_event_open, &Attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+  }
+
+  std::array<int, NUM_COUNTERS> FDs;
+};
+
+/**
+ * @brief Runs a kernel from the bench directory to completion
+ *
+ * Kernels leave the number of iterations they ran in RAX before halting.
+ *
+ * @return Per kernel iteration costs, including compiling the kernel
+ */
+std::vector<BenchResult> RunKernel(std::string const &Name, std::string const &Binary, std::string const &Config, bool NativeRoutines) {
+  FEX::HarnessHelper::HarnessCodeLoader Loader{Binary, Config.c_str()};
+  BenchContext Bench;
+
+  if (!Bench.MapMemory(Loader)) {
+    return {};
+  }
+
+  std::unique_ptr<FEX::HLE::LibcReplacements> Replacements;
+  if (NativeRoutines) {
+    Replacements = std::make_unique<FEX::HLE::LibcReplacements>(Bench.CTX, Bench.SignalDelegation.get());
+
+    const auto Base = Loader.DefaultRIP();
+    auto Entry = reinterpret_cast<NativeRoutineEntry const*>(Base + NATIVE_ROUTINES_OFFSET + sizeof(NATIVE_ROUTINES_MAGIC));
+    for (; Entry->Offset; ++Entry) {
+      const std::string_view RoutineName {Entry->Name, strnlen(Entry->Name, sizeof(Entry->Name))};
+      if (!Replacements->HookRoutine(RoutineName, Base + Entry->Offset)) {
+        LogMan::Msg::EFmt("Kernel {} lists unknown native routine '{}'", Name, RoutineName);
+        return {};
+      }
+    }
+  }
+
+  auto Thread = FEXCore::Context::InitCore(Bench.CTX, Loader.DefaultRIP(), Loader.GetStackPointer());
+  if (!Thread) {
+    return {};
+  }
+
+  MissCounters Counters;
+  Counters.Start();
+  const auto Start = std::chrono::steady_clock::now();
+  FEXCore::Context::RunUntilExit(Bench.CTX);
+  const auto Duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start);
+  Counters.Stop();
+
+  FEXCore::Core::CPUState State;
+  FEXCore::Context::GetCPUState(Bench.CTX, &State);
+  const uint64_t Iterations = State.gregs[FEXCore::X86State::REG_RAX];
+  if (Iterations == 0) {
+    return {};
+  }
+
+  std::vector<BenchResult> Results;
+  Results.emplace_back(BenchResult{fmt::format("Kernel.{}", Name), "ns/iter", static_cast<double>(Duration.count()) / Iterations});
+  auto AddMisses = [&](MissCounters::Counter Which, char const *Suffix) {
+    if (auto Misses = Counters.Misses(Which)) {
+      Results.emplace_back(BenchResult{fmt::format("Kernel.{}.{}", Name, Suffix), "misses/iter", static_cast<double>(*Misses) / Iterations});
+    }
+  };
+  AddMisses(MissCounters::DTLB, "dTLBMisses");
+  AddMisses(MissCounters::ITLB, "iTLBMisses");
+  AddMisses(MissCounters::L1I, "L1IMisses");
+
+  // Only ever non-zero on hosts where misaligned atomics trap
+  if (const auto Faults = Thread->Stats->MisalignedAtomicFaults.load(std::memory_order_relaxed)) {
+    Results.emplace_back(BenchResult{fmt::format("Kernel.{}.MisalignedAtomicFaults", Name), "faults/iter", static_cast<double>(Faults) / Iterations});
+  }
+  return Results;
+}
+
+bool HasNativeRoutines(std::string const &Binary) {
+  std::ifstream File(Binary, std::ios::binary);
+  char Magic[sizeof(NATIVE_ROUTINES_MAGIC)]{};
+  File.seekg(NATIVE_ROUTINES_OFFSET);
+  return File.read(Magic, sizeof(Magic)) && memcmp(Magic, NATIVE_ROUTINES_MAGIC, sizeof(Magic)) == 0;
+}
+
+std::vector<BenchResult> KernelBenchmarks(std::string const &KernelDir) {
+  FEX_CONFIG_OPT(StaticRegisterAllocation, SRA);
+
+  std::vector<BenchResult> Results;
+  std::vector<std::filesystem::path> Kernels;
+
+  std::error_code ec;
+  for (auto &Entry : std::filesystem::directory_iterator(KernelDir, ec)) {
+    auto Path = Entry.path().string();
+    if (Path.ends_with(".asm.bin")) {
+      Kernels.emplace_back(Entry.path());
+    }
+  }
+  std::sort(Kernels.begin(), Kernels.end());
+
+  for (auto &Kernel : Kernels) {
+    const auto Binary = Kernel.string();
+    const auto Config = Binary.substr(0, Binary.size() - strlen(".bin")) + ".config.bin";
+    // Foo.asm.bin -> Foo
+    const auto Name = Kernel.stem().stem().string();
+
+    auto RunBest = [&](std::string const &RunName, bool NativeRoutines, bool DisableSRA) {
+      // Best of each metric across the runs, in the order the first successful run reported them
+      std::vector<BenchResult> Best;
+      for (size_t i = 0; i < KERNEL_RUNS; ++i) {
+        auto Run = RunInChild([&]() {
+          if (DisableSRA) {
+            FEXCore::Config::Set(FEXCore::Config::CONFIG_SRA, "0");
+          }
+          return RunKernel(RunName, Binary, Config, NativeRoutines);
+        });
+
+        for (auto &Result : Run) {
+          auto it = std::find_if(Best.begin(), Best.end(), [&Result](BenchResult const &Existing) {
+            return Existing.Name == Result.Name;
+          });
+
+          if (it == Best.end()) {
+            Best.emplace_back(std::move(Result));
+          }
+          else {
+            it->Value = std::min(it->Value, Result.Value);
+          }
+        }
+      }
+
+      if (!Best.empty()) {
+        Results.insert(Results.end(), std::make_move_iterator(Best.begin()), std::make_move_iterator(Best.end()));
+      }
+      else {
+        LogMan::Msg::EFmt("Kernel {} failed to run", RunName);
+      }
+    };
+
+    RunBest(Name, false, false);
+    if (HasNativeRoutines(Binary)) {
+      RunBest(Name + ".Native", true, false);
+    }
+
+    if (StaticRegisterAllocation() &&
+        std::find(SRA_COMPARISON_KERNELS.begin(), SRA_COMPARISON_KERNELS.end(), Name) != SRA_COMPARISON_KERNELS.end()) {
+      RunBest(Name + ".NoSRA", false, true);
+    }
+  }
+
+  return Results;
+}
+
+struct CompileTotals {
+  uint64_t Blocks{};
+  uint64_t GuestInstructions{};
+  uint64_t GuestInstructionBytes{};
+  uint64_t HostCodeBytes{};
+  uint64_t DecodeNanoseconds{};
+  uint64_t IRGenNanoseconds{};
+  uint64_t CodegenNanoseconds{};
+  uint64_t IRBytes{};
+  uint64_t IRCopyNanoseconds{};
+  uint64_t LentBlocks{};
+  std::map<std::string, uint64_t> PassNanoseconds;
+};
+
+/**
+ * @brief Compiles GuestRIP COMPILE_RUNS times and adds the fastest time of each stage to the totals
+ */
+void BenchmarkCompile(FEXCore::Core::InternalThreadState *Thread, uint64_t GuestRIP, CompileTotals *Totals) {
+  std::optional<FEXCore::Context::CompileBenchmarkResult> Best;
+
+  for (size_t i = 0; i < COMPILE_RUNS; ++i) {
+    FEXCore::Context::CompileBenchmarkResult Result;
+    if (!FEXCore::Context::BenchmarkCompileRIP(Thread, GuestRIP, &Result)) {
+      return;
+    }
+
+    if (!Best) {
+      Best = std::move(Result);
+      continue;
+    }
+
+    Best->DecodeNanoseconds = std::min(Best->DecodeNanoseconds, Result.DecodeNanoseconds);
+    Best->IRGenNanoseconds = std::min(Best->IRGenNanoseconds, Result.IRGenNanoseconds);
+    Best->CodegenNanoseconds = std::min(Best->CodegenNanoseconds, Result.CodegenNanoseconds);
+    Best->IRCopyNanoseconds = std::min(Best->IRCopyNanoseconds, Result.IRCopyNanoseconds);
+    for (size_t Pass = 0; Pass < std::min(Best->PassNanoseconds.size(), Result.PassNanoseconds.size()); ++Pass) {
+      Best->PassNanoseconds[Pass].second = std::min(Best->PassNanoseconds[Pass].second, Result.PassNanoseconds[Pass].second);
+    }
+  }
+
+  ++Totals->Blocks;
+  Totals->GuestInstructions += Best->GuestInstructions;
+  Totals->GuestInstructionBytes += Best->GuestInstructionBytes;
+  Totals->HostCodeBytes += Best->HostCodeBytes;
+  Totals->DecodeNanoseconds += Best->DecodeNanoseconds;
+  Totals->IRGenNanoseconds += Best->IRGenNanoseconds;
+  Totals->CodegenNanoseconds += Best->CodegenNanoseconds;
+  Totals->IRBytes += Best->IRBytes;
+  Totals->IRCopyNanoseconds += Best->IRCopyNanoseconds;
+  Totals->LentBlocks += Best->IRLent;
+  for (auto &[Name, Nanoseconds] : Best->PassNanoseconds) {
+    Totals->PassNanoseconds[Name] += Nanoseconds;
+  }
+}
+
+/**
+ * @brief Compiles the entrypoint of every ASM test, which covers the decoder, IR generation, passes, RA and codegen
+ */
+std::vector<BenchResult> ASMCompileBenchmarks(std::string const &ASMDir) {
+  std::vector<std::filesystem::path> Tests;
+  std::error_code ec;
+  for (auto &Entry : std::filesystem::recursive_directory_iterator(ASMDir, ec)) {
+    auto Path = Entry.path().string();
+    if (Path.ends_with(".asm.bin")) {
+      Tests.emplace_back(Entry.path());
+    }
+  }
+  std::sort(Tests.begin(), Tests.end());
+
+  if (Tests.empty()) {
+    return {};
+  }
+
+  BenchContext Bench;
+  FEXCore::Core::InternalThreadState *Thread{};
+  CompileTotals Totals;
+
+  for (auto &Test : Tests) {
+    const auto Binary = Test.string();
+    const auto Config = Binary.substr(0, Binary.size() - strlen(".bin")) + ".config.bin";
+    if (!std::filesystem::exists(Config)) {
+      continue;
+    }
+
+    FEX::HarnessHelper::HarnessCodeLoader Loader{Binary, Config.c_str()};
+    if (!Bench.MapMemory(Loader)) {
+      continue;
+    }
+
+    if (!Thread) {
+      Thread = FEXCore::Context::InitCore(Bench.CTX, Loader.DefaultRIP(), Loader.GetStackPointer());
+    }
+
+    BenchmarkCompile(Thread, Loader.DefaultRIP(), &Totals);
+  }
+
+  std::vector<BenchResult> Results;
+  if (!Totals.GuestInstructions) {
+    return Results;
+  }
+
+  const double Instructions = Totals.GuestInstructions;
+  Results.emplace_back(BenchResult{"Compile.Blocks", "count", static_cast<double>(Totals.Blocks)});
+  Results.emplace_back(BenchResult{"Compile.GuestInstructions", "count", Instructions});
+  Results.emplace_back(BenchResult{"Decoder.Throughput", "MB/s", Totals.GuestInstructionBytes * 1000.0 / std::max<uint64_t>(Totals.DecodeNanoseconds, 1)});
+  Results.emplace_back(BenchResult{"Decoder.PerInstruction", "ns/inst", Totals.DecodeNanoseconds / Instructions});
+  Results.emplace_back(BenchResult{"OpDispatcher.PerInstruction", "ns/inst", Totals.IRGenNanoseconds / Instructions});
+  for (auto &[Name, Nanoseconds] : Totals.PassNanoseconds) {
+    Results.emplace_back(BenchResult{fmt::format("Pass.{}.PerInstruction", Name), "ns/inst", Nanoseconds / Instructions});
+  }
+  // Copy is what each block paid before the emitter's IR was lent to the backend, Lent is how many blocks skipped it
+  Results.emplace_back(BenchResult{"Compile.IRBytesPerInstruction", "bytes/inst", Totals.IRBytes / Instructions});
+  Results.emplace_back(BenchResult{"Compile.IRCopy.PerInstruction", "ns/inst", Totals.IRCopyNanoseconds / Instructions});
+  Results.emplace_back(BenchResult{"Compile.IRCopy.PerBlock", "ns/block", static_cast<double>(Totals.IRCopyNanoseconds) / Totals.Blocks});
+  Results.emplace_back(BenchResult{"Compile.IRLentBlocks", "count", static_cast<double>(Totals.LentBlocks)});
+  Results.emplace_back(BenchResult{"Codegen.PerInstruction", "ns/inst", Totals.CodegenNanoseconds / Instructions});
+  Results.emplace_back(BenchResult{"Codegen.BytesPerInstruction", "bytes/inst", Totals.HostCodeBytes / Instructions});
+  Results.emplace_back(BenchResult{"Codegen.BytesPerGuestByte", "ratio", static_cast<double>(Totals.HostCodeBytes) / Totals.GuestInstructionBytes});
+  return Results;
+}
+
+/**
+ * @brief Runs the passes, RA and codegen over the IR test corpus, no frontend involved
+ */
+std::vector<BenchResult> IRCompileBenchmarks(std::string const &IRDir) {
+  std::vector<std::filesystem::path> Tests;
+  std::error_code ec;
+  for (auto &Entry : std::filesystem::recursive_directory_iterator(IRDir, ec)) {
+    if (Entry.path().extension() == ".ir") {
+      Tests.emplace_back(Entry.path());
+    }
+  }
+  std::sort(Tests.begin(), Tests.end());
+
+  if (Tests.empty()) {
+    return {};
+  }
+
+  BenchContext Bench;
+  FEXCore::Utils::PooledAllocatorMalloc Allocator;
+  std::vector<std::unique_ptr<FEXCore::IR::IREmitter>> ParsedCode;
+
+  // Each IR file gets its own fake entrypoint
+  constexpr uint64_t IR_ENTRY_BASE = 0x4000'0000;
+  for (auto &Test : Tests) {
+    std::fstream fp(Test, std::fstream::binary | std::fstream::in);
+    if (!fp.is_open()) {
+      continue;
+    }
+
+    auto Parsed = FEXCore::IR::Parse(Allocator, &fp);
+    if (!Parsed) {
+      continue;
+    }
+
+    const uint64_t Entry = IR_ENTRY_BASE + ParsedCode.size() * 0x1000;
+    auto Result = FEXCore::Context::AddCustomIREntrypoint(Bench.CTX, Entry, [ParsedCodePtr = Parsed.get()](uintptr_t Entrypoint, FEXCore::IR::IREmitter *emit) {
+      emit->CopyData(*ParsedCodePtr);
+    });
+
+    if (Result) {
+      ParsedCode.emplace_back(std::move(Parsed));
+    }
+  }
+
+  auto Thread = FEXCore::Context::InitCore(Bench.CTX, IR_ENTRY_BASE, 0);
+
+  CompileTotals Totals;
+  for (size_t i = 0; i < ParsedCode.size(); ++i) {
+    BenchmarkCompile(Thread, IR_ENTRY_BASE + i * 0x1000, &Totals);
+  }
+
+  std::vector<BenchResult> Results;
+  if (!Totals.Blocks) {
+    return Results;
+  }
+
+  const double Blocks = Totals.Blocks;
+  Results.emplace_back(BenchResult{"IR.Files", "count", Blocks});
+  for (auto &[Name, Nanoseconds] : Totals.PassNanoseconds) {
+    Results.emplace_back(BenchResult{fmt::format("IR.Pass.{}.PerFile", Name), "ns/file", Nanoseconds / Blocks});
+  }
+  Results.emplace_back(BenchResult{"IR.Codegen.PerFile", "ns/file", Totals.CodegenNanoseconds / Blocks});
+  Results.emplace_back(BenchResult{"IR.Codegen.BytesPerFile", "bytes/file", Totals.HostCodeBytes / Blocks});
+  return Results;
+}
+
+#ifdef INTERPRETER_ENABLED
+/**
+ * @brief Runs every 64-bit ASM test to completion under the interpreter
+ *
+ * Each test gets its own child, only the time spent running guest code is counted.
+ * Tests are only run once since the corpus is large, the total smooths out the noise.
+ */
+std::vector<BenchResult> InterpreterBenchmarks(std::string const &ASMDir) {
+  std::vector<std::filesystem::path> Tests;
+  std::error_code ec;
+  for (auto &Entry : std::filesystem::recursive_directory_iterator(ASMDir, ec)) {
+    auto Path = Entry.path().string();
+    if (Path.ends_with(".asm.bin")) {
+      Tests.emplace_back(Entry.path());
+    }
+  }
+  std::sort(Tests.begin(), Tests.end());
+
+  double TotalNanoseconds{};
+  size_t NumTests{};
+
+  for (auto &Test : Tests) {
+    const auto Binary = Test.string();
+    const auto Config = Binary.substr(0, Binary.size() - strlen(".bin")) + ".config.bin";
+    if (!std::filesystem::exists(Config)) {
+      continue;
+    }
+
+    auto Run = RunInChild([&]() -> std::vector<BenchResult> {
+      FEX::HarnessHelper::HarnessCodeLoader Loader{Binary, Config.c_str()};
+      if (!Loader.Is64BitMode()) {
+        return {};
+      }
+
+      FEXCore::Config::Set(FEXCore::Config::CONFIG_CORE, std::to_string(FEXCore::Config::CONFIG_INTERPRETER));
+      BenchContext Bench;
+
+      if (!Bench.MapMemory(Loader)) {
+        return {};
+      }
+
+      if (!FEXCore::Context::InitCore(Bench.CTX, Loader.DefaultRIP(), Loader.GetStackPointer())) {
+        return {};
+      }
+
+      const auto Start = std::chrono::steady_clock::now();
+      FEXCore::Context::RunUntilExit(Bench.CTX);
+      const auto Duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start);
+      return {BenchResult{"Run", "ns", static_cast<double>(Duration.count())}};
+    });
+
+    if (!Run.empty()) {
+      TotalNanoseconds += Run[0].Value;
+      ++NumTests;
+    }
+  }
+
+  std::vector<BenchResult> Results;
+  if (!NumTests) {
+    return Results;
+  }
+
+  Results.emplace_back(BenchResult{"Interpreter.ASMTests", "count", static_cast<double>(NumTests)});
+  Results.emplace_back(BenchResult{"Interpreter.ASMTests.Total", "ms", TotalNanoseconds / 1'000'000.0});
+  Results.emplace_back(BenchResult{"Interpreter.ASMTests.PerTest", "us/test", TotalNanoseconds / 1'000.0 / NumTests});
+  return Results;
+}
+#endif
+
+/**
+ * @brief Times AOT IR generation over every executable section of an x86-64 ELF and its interpreter
+ *
+ * Generation runs once on a single thread and once with a thread per core, each in its own child.
+ * The speedup between the two is what the work-stealing scheduler gets out of the extra cores.
+ */
+std::vector<BenchResult> AOTBenchmarks(std::string const &Program) {
+  FEX_CONFIG_OPT(LDPath, ROOTFS);
+  const size_t NumCores = std::max(1, get_nprocs_conf());
+  std::vector<size_t> ThreadCounts{1};
+  if (NumCores > 1) {
+    ThreadCounts.push_back(NumCores);
+  }
+
+  std::vector<BenchResult> Results;
+  double SingleThreadMilliseconds{};
+
+  for (size_t NumThreads : ThreadCounts) {
+    auto Run = RunInChild([&]() -> std::vector<BenchResult> {
+      ELFCodeLoader2 Loader{Program, LDPath(), {Program}, {Program}};
+      if (!Loader.ELFWasLoaded() || !Loader.Is64BitMode()) {
+        LogMan::Msg::EFmt("'{}' isn't a loadable x86-64 ELF", Program);
+        return {};
+      }
+
+      FEXCore::Config::Set(FEXCore::Config::CONFIG_AOTIRGENERATE, "1");
+      BenchContext Bench;
+
+      if (!Bench.MapMemory(Loader)) {
+        return {};
+      }
+
+      Bench.SyscallHandler->SetCodeLoader(&Loader);
+      if (!FEXCore::Context::InitCore(Bench.CTX, Loader.DefaultRIP(), Loader.GetStackPointer())) {
+        return {};
+      }
+
+      // Generated IR is still serialized, but the disk isn't what is being measured
+      FEXCore::Context::SetAOTIRWriter(Bench.CTX, [](const std::string &) -> std::unique_ptr<std::ofstream> {
+        return std::make_unique<std::ofstream>("/dev/null", std::ios::out | std::ios::binary);
+      });
+
+      FEX::AOT::AOTGenStats Totals{};
+      const auto Start = std::chrono::steady_clock::now();
+      for (auto &Section : Loader.Sections) {
+        auto Stats = FEX::AOT::AOTGenSection(Bench.CTX, Section, NumThreads);
+        Totals.Entrypoints += Stats.Entrypoints;
+        Totals.Steals += Stats.Steals;
+      }
+      const auto Duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start);
+
+      FEXCore::Context::FinalizeAOTIRCache(Bench.CTX);
+      Loader.FreeSections();
+
+      return {
+        BenchResult{"Milliseconds", "ms", Duration.count() / 1'000'000.0},
+        BenchResult{"Entrypoints", "count", static_cast<double>(Totals.Entrypoints)},
+        BenchResult{"Steals", "count", static_cast<double>(Totals.Steals)},
+      };
+    });
+
+    if (Run.size() != 3) {
+      return {};
+    }
+
+    const double Milliseconds = Run[0].Value;
+    const double Entrypoints = Run[1].Value;
+    if (NumThreads == 1) {
+      SingleThreadMilliseconds = Milliseconds;
+      Results.emplace_back(BenchResult{"AOT.Entrypoints", "count", Entrypoints});
+      Results.emplace_back(BenchResult{"AOT.Generate.1Thread", "ms", Milliseconds});
+      Results.emplace_back(BenchResult{"AOT.Generate.1Thread.EntrypointsPerSecond", "entrypoints/s", Entrypoints * 1000.0 / std::max(Milliseconds, 1.0)});
+    } else {
+      Results.emplace_back(BenchResult{"AOT.Generate", "ms", Milliseconds});
+      Results.emplace_back(BenchResult{"AOT.Generate.EntrypointsPerSecond", "entrypoints/s", Entrypoints * 1000.0 / std::max(Milliseconds, 1.0)});
+      Results.emplace_back(BenchResult{"AOT.Generate.Threads", "count", static_cast<double>(NumThreads)});
+      Results.emplace_back(BenchResult{"AOT.Generate.Steals", "count", Run[2].Value});
+      Results.emplace_back(BenchResult{"AOT.Generate.Speedup", "ratio", SingleThreadMilliseconds / std::max(Milliseconds, 1.0)});
+    }
+  }
+
+  return Results;
+}
+
+bool WriteJSON(std::string const &Filename, std::vector<BenchResult> const &Results) {
+  FEX_CONFIG_OPT(Core, CORE);
+  FEX_CONFIG_OPT(Multiblock, MULTIBLOCK);
+  FEX_CONFIG_OPT(HugePages, HUGEPAGES);
+  FEX_CONFIG_OPT(SplitColdCode, SPLITCOLDCODE);
+  FEX_CONFIG_OPT(StaticRegisterAllocation, SRA);
+
+  std::vector<char> Buffer(256 + Results.size() * 256);
+  char *Dest{};
+  Dest = json_objOpen(Buffer.data(), nullptr);
+  Dest = json_str(Dest, "Version", GIT_DESCRIBE_STRING);
+  Dest = json_uint(Dest, "Core", Core());
+  Dest = json_bool(Dest, "Multiblock", Multiblock());
+  Dest = json_uint(Dest, "HugePages", HugePages());
+  Dest = json_bool(Dest, "SplitColdCode", SplitColdCode());
+  Dest = json_bool(Dest, "StaticRegisterAllocation", StaticRegisterAllocation());
+  Dest = json_arrOpen(Dest, "Results");
+  for (auto &Result : Results) {
+    Dest = json_objOpen(Dest, nullptr);
+    Dest = json_str(Dest, "Name", Result.Name.c_str());
+    Dest = json_str(Dest, "Unit", Result.Unit.c_str());
+    Dest = json_double(Dest, "Value", Result.Value);
+    Dest = json_objClose(Dest);
+  }
+  Dest = json_arrClose(Dest);
+  Dest = json_objClose(Dest);
+  json_end(Dest);
+
+  if (Filename == "-") {
+    fmt::print("{}\n", Buffer.data());
+    return true;
+  }
+
+  std::ofstream Output (Filename, std::ios::out | std::ios::binary);
+  if (!Output.is_open()) {
+    return false;
+  }
+  Output.write(Buffer.data(), strlen(Buffer.data()));
+  return true;
+}
+}
+
+int main(int argc, char **argv, char **const envp) {
+  LogMan::Throw::InstallHandler(AssertHandler);
+  LogMan::Msg::InstallHandler(MsgHandler);
+  FEXCore::Config::Initialize();
+  FEXCore::Config::AddLayer(std::make_unique<FEX::ArgLoader::ArgLoader>(argc, argv));
+  FEXCore::Config::AddLayer(FEXCore::Config::CreateEnvironmentLayer(envp));
+  FEXCore::Config::Load();
+
+  auto Args = FEX::ArgLoader::Get();
+
+  if (Args.size() < 2) {
+    LogMan::Msg::EFmt("Usage: FEXBench [FEX options] <Output.json|-> <Kernel directory> [<ASM test directory>] [<IR test directory>] [<x86-64 ELF to AOT generate>]");
+    return -1;
+  }
+
+  std::vector<BenchResult> Results;
+  auto Append = [&Results](std::vector<BenchResult> &&New) {
+    Results.insert(Results.end(), std::make_move_iterator(New.begin()), std::make_move_iterator(New.end()));
+  };
+
+  Append(KernelBenchmarks(Args[1]));
+
+  if (Args.size() > 2) {
+    Append(RunInChild([&]() { return ASMCompileBenchmarks(Args[2]); }));
+#ifdef INTERPRETER_ENABLED
+    Append(InterpreterBenchmarks(Args[2]));
+#endif
+  }
+
+  if (Args.size() > 3) {
+    Append(RunInChild([&]() { return IRCompileBenchmarks(Args[3]); }));
+  }
+
+  if (Args.size() > 4 && !Args[4].empty()) {
+    Append(AOTBenchmarks(Args[4]));
+  }
+
+  if (!WriteJSON(Args[0], Results)) {
+    LogMan::Msg::EFmt("Couldn't write results to '{}'", Args[0]);
+    return -1;
+  }
+
+  FEXCore::Config::Shutdown();
+
+  LogMan::Throw::UnInstallHandlers();
+  LogMan::Msg::UnInstallHandlers();
+
+  return 0;
+}
@@ -189,7 +189,7 @@ namespace FEX::HarnessHelper {
       }
 
       if (BaseConfig.OptionRegDataCount > 0) {
-        static constexpr std::array<uint64_t, 45> OffsetArray = {{
+        static constexpr std::array<uint64_t, 61> OffsetArray = {{
           offsetof(FEXCore::Core::CPUState, rip),
           offsetof(FEXCore::Core::CPUState, gregs[0]),
           offsetof(FEXCore::Core::CPUState, gregs[1]),
@@ -235,6 +235,22 @@ namespace FEX::HarnessHelper {
           offsetof(FEXCore::Core::CPUState, mm[6][0]),
           offsetof(FEXCore::Core::CPUState, mm[7][0]),
           offsetof(FEXCore::Core::CPUState, mm[8][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[0][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[1][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[2][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[3][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[4][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[5][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[6][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[7][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[8][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[9][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[10][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[11][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[12][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[13][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[14][0]),
+          offsetof(FEXCore::Core::CPUState, ymm_upper[15][0]),
         }};
 
         uintptr_t DataOffset = BaseConfig.OptionRegDataOffset;
@@ -277,6 +293,8 @@ namespace FEX::HarnessHelper {
               Name = "rflags";
             else if (NameIndex >= 36 && NameIndex < 45)
               Name = fmt::format("MM[{}][{}]", NameIndex - 36, j);
+            else if (NameIndex >= 45 && NameIndex < 61)
+              Name = fmt::format("YMMH[{}][{}]", NameIndex - 45, j);
 
             if (State1) {
               CheckGPRs(fmt::format("Core1: {}: ", Name), State1Data[j], RegData->RegValues[j]);
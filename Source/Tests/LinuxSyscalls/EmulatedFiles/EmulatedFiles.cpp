@@ -18,11 +18,16 @@ $end_info$
 #include <git_version.h>
 
 #include <cstring>
+#include <errno.h>
 #include <fcntl.h>
 #include <filesystem>
+#include <linux/memfd.h>
 #include <ostream>
 #include <sstream>
 #include <stdio.h>
+#include <string_view>
+#include <sys/stat.h>
+#include <sys/syscall.h>
 #include <system_error>
 #include <unistd.h>
 #include <utility>
@@ -50,6 +55,50 @@ namespace FEX::EmulatedFile {
     return fd;
   }
 
+  static bool WriteAll(int FD, std::string_view Data) {
+    size_t Written{};
+    while (Written < Data.size()) {
+      ssize_t Result = write(FD, Data.data() + Written, Data.size() - Written);
+      if (Result == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      Written += Result;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Generates a sealed memfd containing the data
+   *
+   * Once sealed the contents can't change, which lets us hand out reopened copies of the FD
+   * instead of regenerating the file every time the guest opens it.
+   *
+   * @return The sealed FD or -1 if memfd sealing isn't supported
+   */
+  static int GenSealedFD(const char *Name, std::string_view Data) {
+    int FD = ::syscall(SYS_memfd_create, Name, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (FD == -1) {
+      return -1;
+    }
+
+    if (!WriteAll(FD, Data) ||
+        fcntl(FD, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) == -1) {
+      close(FD);
+      return -1;
+    }
+
+    return FD;
+  }
+
+  static int ReopenFD(int FD, int32_t flags) {
+    // Opening through /proc gives a new open file description, so the guest gets its own file offset
+    const auto Path = "/proc/self/fd/" + std::to_string(FD);
+    return open(Path.c_str(), O_RDONLY | (flags & O_CLOEXEC));
+  }
+
   std::string GenerateCPUInfo(FEXCore::Context::Context *ctx, uint32_t CPUCores) {
     std::ostringstream cpu_stream{};
     auto res_0 = FEXCore::Context::RunCPUIDFunction(ctx, 0, 0);
@@ -622,48 +671,44 @@ namespace FEX::EmulatedFile {
   EmulatedFDManager::EmulatedFDManager(FEXCore::Context::Context *ctx)
     : CTX {ctx} {
     FDReadCreators["/proc/cpuinfo"] = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
-      int FD = GenTmpFD();
-      write(FD, (void*)&cpu_info.at(0), cpu_info.size());
-      lseek(FD, 0, SEEK_SET);
-      return FD;
+      return OpenSealedFile("cpuinfo", ThreadsConfig(), flags, [&]() {
+        return cpu_info;
+      });
     };
 
     FDReadCreators["/proc/sys/kernel/osrelease"] = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
-      int FD = GenTmpFD();
       uint32_t GuestVersion = FEX::HLE::_SyscallHandler->GetGuestKernelVersion();
-      char Tmp[64]{};
-      snprintf(Tmp, sizeof(Tmp), "%d.%d.%d\n",
-        FEX::HLE::SyscallHandler::KernelMajor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelMinor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelPatch(GuestVersion));
-      // + 1 to ensure null at the end
-      write(FD, Tmp, strlen(Tmp) + 1);
-      lseek(FD, 0, SEEK_SET);
-      return FD;
+      return OpenSealedFile("osrelease", GuestVersion, flags, [GuestVersion]() {
+        char Tmp[64]{};
+        snprintf(Tmp, sizeof(Tmp), "%d.%d.%d\n",
+          FEX::HLE::SyscallHandler::KernelMajor(GuestVersion),
+          FEX::HLE::SyscallHandler::KernelMinor(GuestVersion),
+          FEX::HLE::SyscallHandler::KernelPatch(GuestVersion));
+        // + 1 to ensure null at the end
+        return std::string(Tmp, strlen(Tmp) + 1);
+      });
     };
 
     FDReadCreators["/proc/version"] = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
-      int FD = GenTmpFD();
-      // UTS version NEEDS to be in a format that can pass to `date -d`
-      // Format of this is Linux version <Release> (<Compile By>@<Compile Host>) (<Linux Compiler>) #<version> {SMP, PREEMPT, PREEMPT_RT} <UTS version>\n"
-      const char kernel_version[] = "Linux version %d.%d.%d (FEX@FEX) (clang) #" GIT_DESCRIBE_STRING " SMP " __DATE__ " " __TIME__ "\n";
       uint32_t GuestVersion = FEX::HLE::_SyscallHandler->GetGuestKernelVersion();
-      char Tmp[sizeof(kernel_version) + 64]{};
-      snprintf(Tmp, sizeof(Tmp), kernel_version,
-        FEX::HLE::SyscallHandler::KernelMajor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelMinor(GuestVersion),
-        FEX::HLE::SyscallHandler::KernelPatch(GuestVersion));
-      // + 1 to ensure null at the end
-      write(FD, Tmp, strlen(Tmp) + 1);
-      lseek(FD, 0, SEEK_SET);
-      return FD;
+      return OpenSealedFile("version", GuestVersion, flags, [GuestVersion]() {
+        // UTS version NEEDS to be in a format that can pass to `date -d`
+        // Format of this is Linux version <Release> (<Compile By>@<Compile Host>) (<Linux Compiler>) #<version> {SMP, PREEMPT, PREEMPT_RT} <UTS version>\n"
+        const char kernel_version[] = "Linux version %d.%d.%d (FEX@FEX) (clang) #" GIT_DESCRIBE_STRING " SMP " __DATE__ " " __TIME__ "\n";
+        char Tmp[sizeof(kernel_version) + 64]{};
+        snprintf(Tmp, sizeof(Tmp), kernel_version,
+          FEX::HLE::SyscallHandler::KernelMajor(GuestVersion),
+          FEX::HLE::SyscallHandler::KernelMinor(GuestVersion),
+          FEX::HLE::SyscallHandler::KernelPatch(GuestVersion));
+        // + 1 to ensure null at the end
+        return std::string(Tmp, strlen(Tmp) + 1);
+      });
     };
 
     auto NumCPUCores = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
-      int FD = GenTmpFD();
-      write(FD, (void*)&cpus_online.at(0), cpus_online.size());
-      lseek(FD, 0, SEEK_SET);
-      return FD;
+      return OpenSealedFile("cpus_online", ThreadsConfig(), flags, [&]() {
+        return cpus_online;
+      });
     };
 
     FDReadCreators["/sys/devices/system/cpu/online"] = NumCPUCores;
@@ -675,21 +720,19 @@ namespace FEX::EmulatedFile {
     FDReadCreators["/proc/self/auxv"] = &EmulatedFDManager::ProcAuxv;
 
     auto cmdline_handler = [&](FEXCore::Context::Context *ctx, int32_t fd, const char *pathname, int32_t flags, mode_t mode) -> int32_t {
-      int FD = GenTmpFD();
       auto CodeLoader = FEX::HLE::_SyscallHandler->GetCodeLoader();
       auto Args = CodeLoader->GetApplicationArguments();
-      char NullChar{};
-      // cmdline is an array of null terminated arguments
-      for (size_t i = 0; i < Args->size(); ++i) {
-        auto &Arg = Args->at(i);
-        write(FD, Arg.c_str(), Arg.size());
-        // Finish off with a null terminator
-        write(FD, &NullChar, sizeof(uint8_t));
-      }
-
-      // One additional null terminator to finish the list
-      lseek(FD, 0, SEEK_SET);
-      return FD;
+      return OpenSealedFile("cmdline", reinterpret_cast<uintptr_t>(Args), flags, [Args]() {
+        std::string cmdline{};
+        // cmdline is an array of null terminated arguments
+        for (size_t i = 0; i < Args->size(); ++i) {
+          auto &Arg = Args->at(i);
+          cmdline += Arg;
+          // Finish off with a null terminator
+          cmdline += '\0';
+        }
+        return cmdline;
+      });
     };
 
     FDReadCreators["/proc/self/cmdline"] = cmdline_handler;
@@ -705,6 +748,62 @@ namespace FEX::EmulatedFile {
   }
 
   EmulatedFDManager::~EmulatedFDManager() {
+    for (auto &[Name, File] : SealedFiles) {
+      if (File.FD != -1) {
+        close(File.FD);
+      }
+    }
+  }
+
+  int32_t EmulatedFDManager::OpenSealedFile(const std::string &Name, uint64_t Inputs, int32_t flags, FDGenerateStringFunc Generator) {
+    std::lock_guard lk(SealedFilesMutex);
+    auto &File = SealedFiles[Name];
+
+    if (File.FD != -1) {
+      int FD = ReopenFD(File.FD, flags);
+      if (FD != -1) {
+        struct stat Stat{};
+        if (fstat(FD, &Stat) == 0 &&
+            Stat.st_dev == File.Dev &&
+            Stat.st_ino == File.Inode) {
+          if (File.Inputs == Inputs) {
+            return FD;
+          }
+
+          // Inputs changed, the FD is still ours so it is safe to close
+          close(File.FD);
+        }
+        close(FD);
+      }
+
+      // Either the inputs changed or the guest closed our FD out from under us
+      File.FD = -1;
+    }
+
+    const auto Data = Generator();
+    int SealedFD = GenSealedFD(Name.c_str(), Data);
+    if (SealedFD != -1) {
+      struct stat Stat{};
+      int FD = ReopenFD(SealedFD, flags);
+      if (FD != -1 && fstat(SealedFD, &Stat) == 0) {
+        File.FD = SealedFD;
+        File.Inputs = Inputs;
+        File.Dev = Stat.st_dev;
+        File.Inode = Stat.st_ino;
+        return FD;
+      }
+
+      if (FD != -1) {
+        close(FD);
+      }
+      close(SealedFD);
+    }
+
+    // No memfd sealing available, generate a new file every time
+    int FD = GenTmpFD();
+    WriteAll(FD, Data);
+    lseek(FD, 0, SEEK_SET);
+    return FD;
   }
 
   int32_t EmulatedFDManager::OpenAt(int dirfs, const char *pathname, int flags, uint32_t mode) {
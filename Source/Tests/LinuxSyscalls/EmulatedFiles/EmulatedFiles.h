@@ -9,6 +9,7 @@ $end_info$
 
 #include <cstdint>
 #include <functional>
+#include <mutex>
 #include <unordered_map>
 #include <string>
 #include <sys/types.h>
@@ -32,6 +33,32 @@ namespace FEX::EmulatedFile {
       std::unordered_map<std::string, FDReadStringFunc> FDReadCreators;
 
       static int32_t ProcAuxv(FEXCore::Context::Context* ctx, int32_t fd, const char* pathname, int32_t flags, mode_t mode);
+
+      /**
+       * @brief A generated file kept around in a sealed memfd
+       *
+       * Inputs is whatever the contents were generated from, if that changes then the file is regenerated.
+       * Dev and Inode are used to make sure the guest didn't close our FD and reuse the number.
+       */
+      struct SealedFile {
+        int FD {-1};
+        uint64_t Inputs{};
+        dev_t Dev{};
+        ino_t Inode{};
+      };
+
+      using FDGenerateStringFunc = std::function<std::string()>;
+
+      /**
+       * @brief Returns a new open file description of the memoized file, generating it on first use
+       *
+       * Each open gets its own file offset, while the contents are only generated once.
+       * Falls back to a temporary file if memfd sealing isn't available.
+       */
+      int32_t OpenSealedFile(const std::string &Name, uint64_t Inputs, int32_t flags, FDGenerateStringFunc Generator);
+
+      std::mutex SealedFilesMutex;
+      std::unordered_map<std::string, SealedFile> SealedFiles;
       FEX_CONFIG_OPT(ThreadsConfig, THREADS);
   };
 }
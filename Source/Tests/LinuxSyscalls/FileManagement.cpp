@@ -13,15 +13,17 @@ $end_info$
 #include "Tests/LinuxSyscalls/x64/Syscalls.h"
 
 #include <FEXCore/Utils/LogManager.h>
-#include <FEXHeaderUtils/ScopedSignalMask.h>
 #include <FEXHeaderUtils/Syscalls.h>
 
 #include <algorithm>
+#include <chrono>
 #include <errno.h>
 #include <cstring>
 #include <fcntl.h>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
+#include <shared_mutex>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -57,6 +59,10 @@ namespace FEXCore::Context {
   struct Context;
 }
 
+#ifndef RESOLVE_IN_ROOT
+#define RESOLVE_IN_ROOT 0x10
+#endif
+
 namespace FEX::HLE {
   struct open_how;
 
@@ -195,6 +201,14 @@ FileManager::FileManager(FEXCore::Context::Context *ctx)
   if (ThunkConfigFile.size()) {
 
     auto ThunkGuestPath = std::filesystem::path(ThunkGuestLibs());
+    if (!Is64BitMode()) {
+      // Guest thunks for 32-bit guests are installed to a sibling directory
+      std::string GuestPath32 = ThunkGuestLibs();
+      while (!GuestPath32.empty() && GuestPath32.back() == '/') {
+        GuestPath32.pop_back();
+      }
+      ThunkGuestPath = GuestPath32 + "_32";
+    }
 
     std::vector<char> FileData;
     if (LoadFile(FileData, ThunkConfigFile)) {
@@ -307,14 +321,129 @@ FileManager::FileManager(FEXCore::Context::Context *ctx)
     }
   }
 
+  HasRootFS = !LDPath().empty();
+  if (HasRootFS) {
+    RootFSPrefix = std::filesystem::path(LDPath()).lexically_normal().string();
+    if (!RootFSPrefix.ends_with('/')) {
+      RootFSPrefix += '/';
+    }
+
+    int FD = ::open(LDPath().c_str(), O_DIRECTORY | O_PATH | O_CLOEXEC);
+    if (FD != -1) {
+      // openat2 with RESOLVE_IN_ROOT needs kernel 5.6, older kernels stay on userspace path resolution
+      FEX::HLE::open_how how {
+        .flags = O_PATH | O_DIRECTORY | O_CLOEXEC,
+        .mode = 0,
+        .resolve = RESOLVE_IN_ROOT,
+      };
+      int TestFD = ::syscall(SYSCALL_DEF(openat2), FD, "/", &how, sizeof(how));
+      if (TestFD != -1) {
+        close(TestFD);
+        RootFSFD = FD;
+      }
+      else {
+        close(FD);
+      }
+    }
+  }
+
   UpdatePID(::getpid());
 }
 
 FileManager::~FileManager() {
+  int FD = RootFSFD.exchange(-1);
+  if (FD != -1) {
+    close(FD);
+  }
+
+  const uint64_t Hits = RootFSPathCacheStats.Hits;
+  const uint64_t NegativeHits = RootFSPathCacheStats.NegativeHits;
+  const uint64_t Misses = RootFSPathCacheStats.Misses;
+  if (Misses) {
+    // Every hit skips resolving the path in the rootfs, negative hits also skip the failing syscall on the rootfs path
+    const uint64_t AverageMissNanoseconds = RootFSPathCacheStats.MissNanoseconds / Misses;
+    LogMan::Msg::DFmt("RootFS path cache: {} hits, {} negative hits, {} misses ({:.1f}% hit rate), ~{} us saved",
+      Hits, NegativeHits, Misses,
+      100.0 * (Hits + NegativeHits) / (Hits + NegativeHits + Misses),
+      (Hits + NegativeHits) * AverageMissNanoseconds / 1000);
+  }
 }
 
-std::string FileManager::GetEmulatedPath(const char *pathname, bool FollowSymlink) {
+std::string FileManager::ResolveEmulatedPath(const char *pathname, bool FollowSymlink) {
   auto RootFSPath = LDPath();
+  std::string Path = RootFSPath + pathname;
+  if (FollowSymlink) {
+    std::error_code ec;
+    while(std::filesystem::is_symlink(Path, ec)) {
+      auto SymlinkTarget = std::filesystem::read_symlink(Path);
+      if (SymlinkTarget.is_absolute()) {
+        Path = RootFSPath + SymlinkTarget.string();
+      }
+      else {
+        break;
+      }
+    }
+  }
+  return Path;
+}
+
+auto FileManager::LookupRootFSPath(const char *pathname, bool FollowSymlink) -> std::optional<RootFSPathCacheEntry> {
+  auto &Cache = RootFSPathCache[FollowSymlink];
+  const std::string_view Key {pathname};
+  const uint64_t Generation = RootFSPathCacheGeneration.load(std::memory_order_acquire);
+
+  {
+    std::shared_lock lk(RootFSPathCacheMutex, std::try_to_lock);
+    if (!lk.owns_lock()) {
+      return std::nullopt;
+    }
+
+    auto it = Cache.find(Key);
+    if (it != Cache.end() && it->second.Generation == Generation) {
+      if (it->second.Exists) {
+        RootFSPathCacheStats.Hits.fetch_add(1, std::memory_order_relaxed);
+      }
+      else {
+        RootFSPathCacheStats.NegativeHits.fetch_add(1, std::memory_order_relaxed);
+      }
+      return it->second;
+    }
+  }
+
+  const auto Start = std::chrono::steady_clock::now();
+
+  RootFSPathCacheEntry Entry {
+    .Path = ResolveEmulatedPath(pathname, FollowSymlink),
+    .Exists = false,
+    .Generation = Generation,
+  };
+
+  // Doesn't follow symlinks so dangling relative symlinks still count as existing, same as the uncached path
+  struct stat Buffer{};
+  Entry.Exists = ::lstat(Entry.Path.c_str(), &Buffer) == 0;
+  if (!Entry.Exists) {
+    // Negative hits never hand out the path, so don't keep a copy of it around
+    Entry.Path.clear();
+  }
+
+  {
+    std::unique_lock lk(RootFSPathCacheMutex, std::try_to_lock);
+    if (lk.owns_lock()) {
+      if (Cache.size() >= MAX_ROOTFS_PATH_CACHE_ENTRIES) {
+        Cache.clear();
+      }
+      Cache.insert_or_assign(std::string(Key), Entry);
+    }
+  }
+
+  const auto Duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start);
+  RootFSPathCacheStats.Misses.fetch_add(1, std::memory_order_relaxed);
+  RootFSPathCacheStats.MissNanoseconds.fetch_add(Duration.count(), std::memory_order_relaxed);
+
+  return Entry;
+}
+
+std::string FileManager::GetEmulatedPath(const char *pathname, bool FollowSymlink) {
   if (!pathname || // If no pathname
       pathname[0] != '/' || // If relative
       strcmp(pathname, "/") == 0) { // If we are getting root
@@ -326,26 +455,86 @@ std::string FileManager::GetEmulatedPath(const char *pathname, bool FollowSymlin
     return thunkOverlay->second;
   }
 
-  if (RootFSPath.empty()) { // If RootFS doesn't exist
+  if (!HasRootFS) { // If RootFS doesn't exist
     return {};
   }
 
-  std::string Path = RootFSPath + pathname;
-  if (FollowSymlink) {
-    std::error_code ec;
-    while(std::filesystem::is_symlink(Path, ec)) {
-      auto SymlinkTarget = std::filesystem::read_symlink(Path);
-      if (SymlinkTarget.is_absolute()) {
-        Path = RootFSPath + SymlinkTarget.string();
+  if (auto Entry = LookupRootFSPath(pathname, FollowSymlink); Entry && Entry->Exists) {
+    return std::move(Entry->Path);
+  }
+
+  return ResolveEmulatedPath(pathname, FollowSymlink);
+}
+
+std::string FileManager::GetEmulatedPathIfExists(const char *pathname, bool FollowSymlink) {
+  if (!pathname || // If no pathname
+      pathname[0] != '/' || // If relative
+      strcmp(pathname, "/") == 0) { // If we are getting root
+    return {};
+  }
+
+  auto thunkOverlay = ThunkOverlays.find(pathname);
+  if (thunkOverlay != ThunkOverlays.end()) {
+    return thunkOverlay->second;
+  }
+
+  if (!HasRootFS) { // If RootFS doesn't exist
+    return {};
+  }
+
+  if (auto Entry = LookupRootFSPath(pathname, FollowSymlink)) {
+    if (!Entry->Exists) {
+      // Skip straight to the host path
+      return {};
+    }
+    return std::move(Entry->Path);
+  }
+
+  return ResolveEmulatedPath(pathname, FollowSymlink);
+}
+
+void FileManager::InvalidateRootFSPathCache(int dirfd, const char *pathname) {
+  if (!HasRootFS || !pathname) {
+    return;
+  }
+
+  auto IsInRootFS = [this](std::string_view Path) {
+    return Path.starts_with(RootFSPrefix) ||
+           Path == std::string_view(RootFSPrefix).substr(0, RootFSPrefix.size() - 1);
+  };
+
+  std::string Path{};
+  if (pathname[0] == '/') {
+    // Common case, an absolute path without `.` or `..` components is checked without any syscalls or allocations
+    if (!strstr(pathname, "/.")) {
+      if (IsInRootFS(pathname)) {
+        InvalidateRootFSPathCache();
       }
-      else {
-        break;
+      return;
+    }
+    Path = pathname;
+  }
+  else {
+    if (dirfd == AT_FDCWD) {
+      char CWD[PATH_MAX];
+      if (!getcwd(CWD, sizeof(CWD))) {
+        // Can't tell where this happened, be conservative
+        InvalidateRootFSPathCache();
+        return;
       }
+      Path = CWD;
+    }
+    else {
+      Path = FEX::get_fdpath(dirfd);
     }
+    Path += "/";
+    Path += pathname;
   }
-  return Path;
-}
 
+  if (IsInRootFS(std::filesystem::path(Path).lexically_normal().string())) {
+    InvalidateRootFSPathCache();
+  }
+}
 
 std::optional<std::string> FileManager::GetSelf(const char *Pathname) {
   if (!Pathname) {
@@ -364,6 +553,43 @@ std::optional<std::string> FileManager::GetSelf(const char *Pathname) {
   return Pathname;
 }
 
+int FileManager::OpenInRootFS(const char *pathname, uint64_t flags, uint64_t mode, uint64_t resolve) {
+  const int FD = RootFSFD.load(std::memory_order_relaxed);
+  if (FD == -1 ||
+      !pathname || // If no pathname
+      pathname[0] != '/' || // If relative
+      strcmp(pathname, "/") == 0 || // If we are getting root
+      (!ThunkOverlays.empty() && ThunkOverlays.find(pathname) != ThunkOverlays.end())) {
+    errno = ENOSYS;
+    return -1;
+  }
+
+  FEX::HLE::open_how how {
+    .flags = flags,
+    // openat2 rejects a mode if the open can't create a file
+    .mode = ((flags & O_CREAT) || (flags & O_TMPFILE) == O_TMPFILE) ? mode : 0,
+    .resolve = resolve | RESOLVE_IN_ROOT,
+  };
+
+  return ::syscall(SYSCALL_DEF(openat2), FD, pathname, &how, sizeof(how));
+}
+
+static bool NeedsRootFSPathFallback(int fd) {
+  // ENOSYS: The rootfs dirfd couldn't be used for this path
+  // EAGAIN: RESOLVE_IN_ROOT raced with a rename and asks us to retry
+  // EINVAL: open(2) ignores unknown flags while openat2 rejects them
+  return fd == -1 && (errno == ENOSYS || errno == EAGAIN || errno == EINVAL);
+}
+
+void FileManager::CheckRootFSFDClose(unsigned int first, unsigned int last) {
+  const int FD = RootFSFD.load(std::memory_order_relaxed);
+  if (FD != -1 && static_cast<unsigned int>(FD) >= first && static_cast<unsigned int>(FD) <= last) {
+    // Guest is closing or replacing the rootfs dirfd, fall back to userspace resolution from now on
+    RootFSFD = -1;
+    LogMan::Msg::DFmt("Guest closed the rootfs dirfd, disabling in-kernel rootfs resolution");
+  }
+}
+
 uint64_t FileManager::Open(const char *pathname, [[maybe_unused]] int flags, [[maybe_unused]] uint32_t mode) {
   auto NewPath = GetSelf(pathname);
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
@@ -371,9 +597,16 @@ uint64_t FileManager::Open(const char *pathname, [[maybe_unused]] int flags, [[m
 
   fd = EmuFD.OpenAt(AT_FDCWD, SelfPath, flags, mode);
   if (fd == -1) {
-    auto Path = GetEmulatedPath(SelfPath, true);
-    if (!Path.empty()) {
-      fd = ::open(Path.c_str(), flags, mode);
+    fd = OpenInRootFS(SelfPath, flags, mode, 0);
+    if (NeedsRootFSPathFallback(fd)) {
+      auto Path = (flags & O_CREAT) ? GetEmulatedPath(SelfPath, true) : GetEmulatedPathIfExists(SelfPath, true);
+      if (!Path.empty()) {
+        fd = ::open(Path.c_str(), flags, mode);
+      }
+    }
+
+    if (fd != -1 && (flags & O_CREAT)) {
+      InvalidateRootFSPathCache();
     }
 
     if (fd == -1) {
@@ -381,22 +614,28 @@ uint64_t FileManager::Open(const char *pathname, [[maybe_unused]] int flags, [[m
     }
   }
 
-  if (fd != -1) {
-    FHU::ScopedSignalMaskWithMutex lk(FDLock);
-    FDToNameMap.insert_or_assign(fd, SelfPath);
-  }
-
   return fd;
 }
 
 uint64_t FileManager::Close(int fd) {
-  {
-    FHU::ScopedSignalMaskWithMutex lk(FDLock);
-    FDToNameMap.erase(fd);
-  }
+  CheckRootFSFDClose(fd, fd);
   return ::close(fd);
 }
 
+uint64_t FileManager::Dup2(int oldfd, int newfd) {
+  if (oldfd != newfd) {
+    CheckRootFSFDClose(newfd, newfd);
+  }
+  return ::dup2(oldfd, newfd);
+}
+
+uint64_t FileManager::Dup3(int oldfd, int newfd, int flags) {
+  if (oldfd != newfd) {
+    CheckRootFSFDClose(newfd, newfd);
+  }
+  return ::dup3(oldfd, newfd, flags);
+}
+
 uint64_t FileManager::CloseRange(unsigned int first, unsigned int last, unsigned int flags) {
 #ifndef CLOSE_RANGE_CLOEXEC
 #define CLOSE_RANGE_CLOEXEC (1U << 2)
@@ -405,11 +644,7 @@ uint64_t FileManager::CloseRange(unsigned int first, unsigned int last, unsigned
   if (!(flags & CLOSE_RANGE_CLOEXEC)) {
     // If the flag was set then it doesn't actually close the FDs
     // Just sets the flag on a range
-    FHU::ScopedSignalMaskWithMutex lk(FDLock);
-    for (unsigned int i = first; i <= last; ++i) {
-      // We remove from first to last inclusive
-      FDToNameMap.erase(i);
-    }
+    CheckRootFSFDClose(first, last);
   }
   return ::syscall(SYSCALL_DEF(close_range), first, last, flags);
 }
@@ -419,7 +654,7 @@ uint64_t FileManager::Stat(const char *pathname, void *buf) {
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
   // Stat follows symlinks
-  auto Path = GetEmulatedPath(SelfPath, true);
+  auto Path = GetEmulatedPathIfExists(SelfPath, true);
   if (!Path.empty()) {
     uint64_t Result = ::stat(Path.c_str(), reinterpret_cast<struct stat*>(buf));
     if (Result != -1)
@@ -433,7 +668,7 @@ uint64_t FileManager::Lstat(const char *pathname, void *buf) {
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
   // lstat does not follow symlinks
-  auto Path = GetEmulatedPath(SelfPath, false);
+  auto Path = GetEmulatedPathIfExists(SelfPath, false);
   if (!Path.empty()) {
     uint64_t Result = ::lstat(Path.c_str(), reinterpret_cast<struct stat*>(buf));
     if (Result != -1)
@@ -448,7 +683,7 @@ uint64_t FileManager::Access(const char *pathname, [[maybe_unused]] int mode) {
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
   // Access follows symlinks
-  auto Path = GetEmulatedPath(SelfPath, true);
+  auto Path = GetEmulatedPathIfExists(SelfPath, true);
   if (!Path.empty()) {
     uint64_t Result = ::access(Path.c_str(), mode);
     if (Result != -1)
@@ -462,7 +697,7 @@ uint64_t FileManager::FAccessat(int dirfd, const char *pathname, int mode) {
   auto NewPath = GetSelf(pathname);
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
-  auto Path = GetEmulatedPath(SelfPath);
+  auto Path = GetEmulatedPathIfExists(SelfPath);
   if (!Path.empty()) {
     uint64_t Result = ::syscall(SYS_faccessat, dirfd, Path.c_str(), mode);
     if (Result != -1)
@@ -476,7 +711,7 @@ uint64_t FileManager::FAccessat2(int dirfd, const char *pathname, int mode, int
   auto NewPath = GetSelf(pathname);
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
-  auto Path = GetEmulatedPath(SelfPath, (flags & AT_SYMLINK_NOFOLLOW) == 0);
+  auto Path = GetEmulatedPathIfExists(SelfPath, (flags & AT_SYMLINK_NOFOLLOW) == 0);
   if (!Path.empty()) {
     uint64_t Result = ::syscall(SYSCALL_DEF(faccessat2), dirfd, Path.c_str(), mode, flags);
     if (Result != -1)
@@ -500,7 +735,7 @@ uint64_t FileManager::Readlink(const char *pathname, char *buf, size_t bufsiz) {
     return std::min(bufsiz, App.size());
   }
 
-  auto Path = GetEmulatedPath(pathname);
+  auto Path = GetEmulatedPathIfExists(pathname);
   if (!Path.empty()) {
     uint64_t Result = ::readlink(Path.c_str(), buf, bufsiz);
     if (Result != -1)
@@ -573,7 +808,7 @@ uint64_t FileManager::Readlinkat(int dirfd, const char *pathname, char *buf, siz
     return std::min(bufsiz, App.size());
   }
 
-  Path = GetEmulatedPath(pathname);
+  Path = GetEmulatedPathIfExists(pathname);
   if (!Path.empty()) {
     uint64_t Result = ::readlinkat(dirfd, Path.c_str(), buf, bufsiz);
     if (Result != -1)
@@ -598,20 +833,22 @@ uint64_t FileManager::Openat([[maybe_unused]] int dirfs, const char *pathname, i
 
   fd = EmuFD.OpenAt(dirfs, SelfPath, flags, mode);
   if (fd == -1) {
-    auto Path = GetEmulatedPath(SelfPath, true);
-    if (!Path.empty()) {
-      fd = ::openat(dirfs, Path.c_str(), flags, mode);
+    fd = OpenInRootFS(SelfPath, flags, mode, 0);
+    if (NeedsRootFSPathFallback(fd)) {
+      auto Path = (flags & O_CREAT) ? GetEmulatedPath(SelfPath, true) : GetEmulatedPathIfExists(SelfPath, true);
+      if (!Path.empty()) {
+        fd = ::openat(dirfs, Path.c_str(), flags, mode);
+      }
+    }
+
+    if (fd != -1 && (flags & O_CREAT)) {
+      InvalidateRootFSPathCache();
     }
 
     if (fd == -1)
       fd = ::openat(dirfs, SelfPath, flags, mode);
   }
 
-  if (fd != -1) {
-    FHU::ScopedSignalMaskWithMutex lk(FDLock);
-    FDToNameMap.insert_or_assign(fd, SelfPath);
-  }
-
   return fd;
 }
 
@@ -623,20 +860,22 @@ uint64_t FileManager::Openat2(int dirfs, const char *pathname, FEX::HLE::open_ho
 
   fd = EmuFD.OpenAt(dirfs, SelfPath, how->flags, how->mode);
   if (fd == -1) {
-    auto Path = GetEmulatedPath(SelfPath, true);
-    if (!Path.empty()) {
-      fd = ::syscall(SYSCALL_DEF(openat2), dirfs, Path.c_str(), how, usize);
+    fd = OpenInRootFS(SelfPath, how->flags, how->mode, how->resolve);
+    if (NeedsRootFSPathFallback(fd)) {
+      auto Path = (how->flags & O_CREAT) ? GetEmulatedPath(SelfPath, true) : GetEmulatedPathIfExists(SelfPath, true);
+      if (!Path.empty()) {
+        fd = ::syscall(SYSCALL_DEF(openat2), dirfs, Path.c_str(), how, usize);
+      }
+    }
+
+    if (fd != -1 && (how->flags & O_CREAT)) {
+      InvalidateRootFSPathCache();
     }
 
     if (fd == -1)
       fd = ::syscall(SYSCALL_DEF(openat2), dirfs, SelfPath, how, usize);
   }
 
-  if (fd != -1) {
-    FHU::ScopedSignalMaskWithMutex lk(FDLock);
-    FDToNameMap.insert_or_assign(fd, SelfPath);
-  }
-
   return fd;
 
 }
@@ -645,7 +884,7 @@ uint64_t FileManager::Statx(int dirfd, const char *pathname, int flags, uint32_t
   auto NewPath = GetSelf(pathname);
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
-  auto Path = GetEmulatedPath(SelfPath, (flags & AT_SYMLINK_NOFOLLOW) == 0);
+  auto Path = GetEmulatedPathIfExists(SelfPath, (flags & AT_SYMLINK_NOFOLLOW) == 0);
   if (!Path.empty()) {
     uint64_t Result = FHU::Syscalls::statx(dirfd, Path.c_str(), flags, mask, statxbuf);
     if (Result != -1)
@@ -661,14 +900,16 @@ uint64_t FileManager::Mknod(const char *pathname, mode_t mode, dev_t dev) {
   auto Path = GetEmulatedPath(SelfPath);
   if (!Path.empty()) {
     uint64_t Result = ::mknod(Path.c_str(), mode, dev);
-    if (Result != -1)
+    if (Result != -1) {
+      InvalidateRootFSPathCache();
       return Result;
+    }
   }
   return ::mknod(SelfPath, mode, dev);
 }
 
 uint64_t FileManager::Statfs(const char *path, void *buf) {
-  auto Path = GetEmulatedPath(path);
+  auto Path = GetEmulatedPathIfExists(path);
   if (!Path.empty()) {
     uint64_t Result = ::statfs(Path.c_str(), reinterpret_cast<struct statfs*>(buf));
     if (Result != -1)
@@ -681,7 +922,7 @@ uint64_t FileManager::NewFSStatAt(int dirfd, const char *pathname, struct stat *
   auto NewPath = GetSelf(pathname);
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
-  auto Path = GetEmulatedPath(SelfPath, (flag & AT_SYMLINK_NOFOLLOW) == 0);
+  auto Path = GetEmulatedPathIfExists(SelfPath, (flag & AT_SYMLINK_NOFOLLOW) == 0);
   if (!Path.empty()) {
     uint64_t Result = ::fstatat(dirfd, Path.c_str(), buf, flag);
     if (Result != -1) {
@@ -695,7 +936,7 @@ uint64_t FileManager::NewFSStatAt64(int dirfd, const char *pathname, struct stat
   auto NewPath = GetSelf(pathname);
   const char *SelfPath = NewPath ? NewPath->c_str() : nullptr;
 
-  auto Path = GetEmulatedPath(SelfPath, (flag & AT_SYMLINK_NOFOLLOW) == 0);
+  auto Path = GetEmulatedPathIfExists(SelfPath, (flag & AT_SYMLINK_NOFOLLOW) == 0);
   if (!Path.empty()) {
     uint64_t Result = ::fstatat64(dirfd, Path.c_str(), buf, flag);
     if (Result != -1) {
@@ -705,13 +946,73 @@ uint64_t FileManager::NewFSStatAt64(int dirfd, const char *pathname, struct stat
   return ::fstatat64(dirfd, SelfPath, buf, flag);
 }
 
-std::string *FileManager::FindFDName(int fd) {
-  FHU::ScopedSignalMaskWithMutex lk(FDLock);
-  auto it = FDToNameMap.find(fd);
-  if (it == FDToNameMap.end()) {
-    return nullptr;
+uint64_t FileManager::Creat(const char *pathname, mode_t mode) {
+  uint64_t Result = ::creat(pathname, mode);
+  if (Result != -1) {
+    InvalidateRootFSPathCache(AT_FDCWD, pathname);
+  }
+  return Result;
+}
+
+uint64_t FileManager::Mkdirat(int dirfd, const char *pathname, mode_t mode) {
+  uint64_t Result = ::mkdirat(dirfd, pathname, mode);
+  if (Result != -1) {
+    InvalidateRootFSPathCache(dirfd, pathname);
+  }
+  return Result;
+}
+
+uint64_t FileManager::Mknodat(int dirfd, const char *pathname, mode_t mode, dev_t dev) {
+  uint64_t Result = ::mknodat(dirfd, pathname, mode, dev);
+  if (Result != -1) {
+    InvalidateRootFSPathCache(dirfd, pathname);
+  }
+  return Result;
+}
+
+uint64_t FileManager::Unlinkat(int dirfd, const char *pathname, int flags) {
+  uint64_t Result = ::unlinkat(dirfd, pathname, flags);
+  if (Result != -1) {
+    InvalidateRootFSPathCache(dirfd, pathname);
+  }
+  return Result;
+}
+
+uint64_t FileManager::Renameat2(int olddirfd, const char *oldpath, int newdirfd, const char *newpath, unsigned int flags) {
+  uint64_t Result = FHU::Syscalls::renameat2(olddirfd, oldpath, newdirfd, newpath, flags);
+  if (Result != -1) {
+    InvalidateRootFSPathCache(olddirfd, oldpath);
+    InvalidateRootFSPathCache(newdirfd, newpath);
+  }
+  return Result;
+}
+
+uint64_t FileManager::Linkat(int olddirfd, const char *oldpath, int newdirfd, const char *newpath, int flags) {
+  uint64_t Result = ::linkat(olddirfd, oldpath, newdirfd, newpath, flags);
+  if (Result != -1) {
+    InvalidateRootFSPathCache(newdirfd, newpath);
+  }
+  return Result;
+}
+
+uint64_t FileManager::Symlinkat(const char *target, int newdirfd, const char *linkpath) {
+  uint64_t Result = ::symlinkat(target, newdirfd, linkpath);
+  if (Result != -1) {
+    InvalidateRootFSPathCache(newdirfd, linkpath);
+  }
+  return Result;
+}
+
+std::optional<std::string> FileManager::FindFDName(int fd) {
+  char Path[32];
+  snprintf(Path, sizeof(Path), "/proc/self/fd/%d", fd);
+
+  char Name[PATH_MAX];
+  ssize_t Result = ::readlink(Path, Name, sizeof(Name));
+  if (Result == -1) {
+    return std::nullopt;
   }
-  return &it->second;
+  return std::string(Name, Result);
 }
 
 }
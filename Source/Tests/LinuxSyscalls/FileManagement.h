@@ -7,13 +7,16 @@ $end_info$
 #pragma once
 #include <FEXCore/Config/Config.h>
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <map>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <stddef.h>
 #include <string>
+#include <string_view>
 #include <sys/stat.h>
 #include <vector>
 
@@ -40,6 +43,9 @@ public:
   uint64_t Open(const char *pathname, int flags, uint32_t mode);
   uint64_t Close(int fd);
   uint64_t CloseRange(unsigned int first, unsigned int last, unsigned int flags);
+  // dup2/dup3 close newfd implicitly
+  uint64_t Dup2(int oldfd, int newfd);
+  uint64_t Dup3(int oldfd, int newfd, int flags);
   uint64_t Stat(const char *pathname, void *buf);
   uint64_t Lstat(const char *path, void *buf);
   uint64_t Access(const char *pathname, int mode);
@@ -55,10 +61,26 @@ public:
   uint64_t NewFSStatAt(int dirfd, const char *pathname, struct stat *buf, int flag);
   uint64_t NewFSStatAt64(int dirfd, const char *pathname, struct stat64 *buf, int flag);
 
+  // Namespace mutations, these only invalidate the rootfs path cache when they touch the rootfs
+  // Without a rootfs there is nothing to invalidate and these can be passed through directly
+  bool HasRootFSPathCache() const { return HasRootFS; }
+  uint64_t Creat(const char *pathname, mode_t mode);
+  uint64_t Mkdirat(int dirfd, const char *pathname, mode_t mode);
+  uint64_t Mknodat(int dirfd, const char *pathname, mode_t mode, dev_t dev);
+  uint64_t Unlinkat(int dirfd, const char *pathname, int flags);
+  uint64_t Renameat2(int olddirfd, const char *oldpath, int newdirfd, const char *newpath, unsigned int flags);
+  uint64_t Linkat(int olddirfd, const char *oldpath, int newdirfd, const char *newpath, int flags);
+  uint64_t Symlinkat(const char *target, int newdirfd, const char *linkpath);
+
   // vfs
   uint64_t Statfs(const char *path, void *buf);
 
-  std::string *FindFDName(int fd);
+  /**
+   * @brief Returns the host path that the FD currently points to
+   *
+   * Resolved on demand through /proc/self/fd instead of tracking a copy of the path for every open FD.
+   */
+  std::optional<std::string> FindFDName(int fd);
 
   std::optional<std::string> GetSelf(const char *Pathname);
 
@@ -66,13 +88,20 @@ public:
 
   std::string GetEmulatedPath(const char *pathname, bool FollowSymlink = false);
 
+  /**
+   * @brief Same as GetEmulatedPath but returns an empty string if the path doesn't exist in the rootfs
+   *
+   * Use for lookups that would otherwise try the rootfs path, fail, and then fall back to the host path.
+   * Operations that can create the path must use GetEmulatedPath instead.
+   */
+  std::string GetEmulatedPathIfExists(const char *pathname, bool FollowSymlink = false);
+
   std::mutex *GetFDLock() { return &FDLock; }
 
 private:
   FEX::EmulatedFile::EmulatedFDManager EmuFD;
 
   std::mutex FDLock;
-  std::unordered_map<int32_t, std::string> FDToNameMap;
   std::map<std::string, std::string, std::less<>> ThunkOverlays;
 
   FEX_CONFIG_OPT(Filename, APP_FILENAME);
@@ -80,6 +109,7 @@ private:
   FEX_CONFIG_OPT(ThunkHostLibs, THUNKHOSTLIBS);
   FEX_CONFIG_OPT(ThunkGuestLibs, THUNKGUESTLIBS);
   FEX_CONFIG_OPT(ThunkConfig, THUNKCONFIG);
+  FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
   uint32_t CurrentPID{};
 
   void LoadThunkDatabase(bool Global);
@@ -90,5 +120,73 @@ private:
     bool Enabled{};
   };
   std::unordered_map<std::string, ThunkDBObject> ThunkDB{};
+
+  std::string ResolveEmulatedPath(const char *pathname, bool FollowSymlink);
+
+  /**
+   * @brief Opens an absolute guest path inside of the rootfs with openat2 and RESOLVE_IN_ROOT
+   *
+   * The kernel walks the path and any symlinks with the rootfs as `/`, so no path needs to be built.
+   *
+   * @return The host FD, or -1 with errno set. errno is ENOSYS if the rootfs dirfd can't be used.
+   */
+  int OpenInRootFS(const char *pathname, uint64_t flags, uint64_t mode, uint64_t resolve);
+
+  /**
+   * @brief Stops using the rootfs dirfd if the guest is closing it from under us
+   */
+  void CheckRootFSFDClose(unsigned int first, unsigned int last);
+
+  // O_PATH dirfd of the rootfs, only valid if the host supports openat2 with RESOLVE_IN_ROOT.
+  std::atomic<int> RootFSFD{-1};
+  bool HasRootFS{};
+  // Normalized rootfs path with a trailing slash, for checking if a mutation happened inside of the rootfs
+  std::string RootFSPrefix{};
+
+  struct RootFSPathCacheEntry {
+    std::string Path;
+    bool Exists;
+    uint64_t Generation;
+  };
+
+  /**
+   * @brief Looks up or fills the rootfs resolution cache for an absolute guest path
+   *
+   * @return The cached entry, or std::nullopt if the cache couldn't be used
+   */
+  std::optional<RootFSPathCacheEntry> LookupRootFSPath(const char *pathname, bool FollowSymlink);
+
+  /**
+   * @brief Drops the rootfs path cache if the path (relative to dirfd) is inside of the rootfs
+   */
+  void InvalidateRootFSPathCache(int dirfd, const char *pathname);
+
+  void InvalidateRootFSPathCache() {
+    RootFSPathCacheGeneration.fetch_add(1, std::memory_order_release);
+  }
+
+  struct StringViewHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view Str) const { return std::hash<std::string_view>{}(Str); }
+  };
+
+  // Keyed by guest path, one map for each FollowSymlink setting
+  using RootFSPathCacheMap = std::unordered_map<std::string, RootFSPathCacheEntry, StringViewHash, std::equal_to<>>;
+  RootFSPathCacheMap RootFSPathCache[2];
+
+  // The cache is only ever try-locked, so a signal handler reentering the FileManager
+  // while the lock is held just bypasses the cache instead of deadlocking.
+  // Invalidation bumps the generation instead of taking the lock, so it can never be skipped.
+  std::shared_mutex RootFSPathCacheMutex;
+  std::atomic<uint64_t> RootFSPathCacheGeneration{};
+
+  constexpr static size_t MAX_ROOTFS_PATH_CACHE_ENTRIES = 65536;
+
+  struct {
+    std::atomic<uint64_t> Hits{};
+    std::atomic<uint64_t> NegativeHits{};
+    std::atomic<uint64_t> Misses{};
+    std::atomic<uint64_t> MissNanoseconds{};
+  } RootFSPathCacheStats;
 };
 }
@@ -0,0 +1,428 @@
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Native replacements for hot guest libc routines
+$end_info$
+*/
+
+#include "Common/FDUtils.h"
+#include "Linux/Utils/ELFContainer.h"
+#include "Tests/LinuxSyscalls/LibcReplacements.h"
+#include "Tests/LinuxSyscalls/SignalDelegator.h"
+
+#include <FEXCore/Core/Context.h>
+#include <FEXCore/Core/CoreState.h>
+#include <FEXCore/Core/X86Enums.h>
+#include <FEXCore/IR/IR.h>
+#include <FEXCore/IR/IREmitter.h>
+#include <FEXCore/Utils/Allocator.h>
+#include <FEXCore/Utils/LogManager.h>
+#include <FEXHeaderUtils/TypeDefines.h>
+
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <setjmp.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+
+namespace FEX::HLE {
+namespace {
+  constexpr const char *RoutineNames[LibcReplacements::NUM_ROUTINES] = {
+    "memcpy",
+    "memset",
+    "strlen",
+    "memcmp",
+    "strchr",
+  };
+
+  // sha256(fex:native_<routine>)
+  const FEXCore::IR::SHA256Sum RoutineSums[LibcReplacements::NUM_ROUTINES] = {
+    { 0x78, 0x25, 0x40, 0x13, 0xd8, 0x04, 0x6c, 0x70, 0xb5, 0xe6, 0x91, 0xd6, 0x6a, 0xa6, 0x02, 0xe5, 0x4c, 0x23, 0x9a, 0x99, 0x2c, 0x22, 0x88, 0xd1, 0xfd, 0xfb, 0x2e, 0xf9, 0x9d, 0x64, 0x6c, 0x41 },
+    { 0x21, 0x97, 0x36, 0x03, 0x84, 0x9f, 0xdf, 0x66, 0xa7, 0x25, 0xed, 0x92, 0x2e, 0x01, 0x2e, 0x18, 0x4c, 0x0a, 0x10, 0x27, 0x9a, 0x88, 0xe3, 0x8b, 0xee, 0x93, 0x3f, 0x23, 0xa6, 0x6f, 0x94, 0x67 },
+    { 0xbe, 0x25, 0x1b, 0xd1, 0x62, 0x45, 0xc2, 0x16, 0x37, 0x4a, 0x00, 0xdc, 0x54, 0xc4, 0xe8, 0x9c, 0xf8, 0x09, 0xbd, 0x9c, 0xeb, 0x7a, 0xae, 0xa3, 0xac, 0x30, 0x55, 0xb5, 0x82, 0xcc, 0x91, 0x9b },
+    { 0x07, 0xb9, 0xb3, 0x49, 0xdb, 0x1e, 0xc3, 0x3b, 0x9c, 0xb2, 0xe5, 0x29, 0xb2, 0x12, 0xde, 0x1e, 0x69, 0x28, 0xad, 0x99, 0x6e, 0xec, 0x2a, 0xeb, 0xd1, 0x5d, 0x91, 0xe2, 0xa8, 0xe6, 0x30, 0x3f },
+    { 0x12, 0x35, 0x03, 0xc2, 0x30, 0xdd, 0x75, 0xf4, 0x1b, 0xd4, 0x1c, 0x9a, 0xc8, 0xe5, 0x0e, 0x60, 0xc8, 0xa5, 0x4b, 0x7e, 0xda, 0x61, 0x37, 0xe8, 0xc5, 0xcc, 0x18, 0xd9, 0xbd, 0x69, 0xba, 0xe3 },
+  };
+
+  // Guest fallbacks, simple byte loops that fault on exactly the first bad byte
+  const uint8_t MemcpyFallback[] = {
+    0x48, 0x89, 0xf8,             // mov rax, rdi
+    0x48, 0x89, 0xd1,             // mov rcx, rdx
+    0xf3, 0xa4,                   // rep movsb
+    0xc3,                         // ret
+  };
+
+  const uint8_t MemsetFallback[] = {
+    0x49, 0x89, 0xf8,             // mov r8, rdi
+    0x89, 0xf0,                   // mov eax, esi
+    0x48, 0x89, 0xd1,             // mov rcx, rdx
+    0xf3, 0xaa,                   // rep stosb
+    0x4c, 0x89, 0xc0,             // mov rax, r8
+    0xc3,                         // ret
+  };
+
+  const uint8_t StrlenFallback[] = {
+    0x48, 0x89, 0xf8,             // mov rax, rdi
+    0x80, 0x38, 0x00,             // 1: cmp byte [rax], 0
+    0x74, 0x05,                   // je 2f
+    0x48, 0xff, 0xc0,             // inc rax
+    0xeb, 0xf6,                   // jmp 1b
+    0x48, 0x29, 0xf8,             // 2: sub rax, rdi
+    0xc3,                         // ret
+  };
+
+  const uint8_t MemcmpFallback[] = {
+    0x31, 0xc0,                   // xor eax, eax
+    0x48, 0x85, 0xd2,             // test rdx, rdx
+    0x74, 0x15,                   // je 2f
+    0x0f, 0xb6, 0x07,             // 1: movzx eax, byte [rdi]
+    0x0f, 0xb6, 0x0e,             // movzx ecx, byte [rsi]
+    0x29, 0xc8,                   // sub eax, ecx
+    0x75, 0x0b,                   // jne 2f
+    0x48, 0xff, 0xc7,             // inc rdi
+    0x48, 0xff, 0xc6,             // inc rsi
+    0x48, 0xff, 0xca,             // dec rdx
+    0x75, 0xeb,                   // jne 1b
+    0xc3,                         // 2: ret
+  };
+
+  const uint8_t StrchrFallback[] = {
+    0x0f, 0xb6, 0x07,             // 1: movzx eax, byte [rdi]
+    0x40, 0x38, 0xf0,             // cmp al, sil
+    0x74, 0x09,                   // je 2f
+    0x84, 0xc0,                   // test al, al
+    0x74, 0x09,                   // je 3f
+    0x48, 0xff, 0xc7,             // inc rdi
+    0xeb, 0xef,                   // jmp 1b
+    0x48, 0x89, 0xf8,             // 2: mov rax, rdi
+    0xc3,                         // ret
+    0x31, 0xc0,                   // 3: xor eax, eax
+    0xc3,                         // ret
+  };
+
+  struct FallbackCode {
+    uint8_t const *Code;
+    size_t Size;
+  };
+
+  const FallbackCode Fallbacks[LibcReplacements::NUM_ROUTINES] = {
+    { MemcpyFallback, sizeof(MemcpyFallback) },
+    { MemsetFallback, sizeof(MemsetFallback) },
+    { StrlenFallback, sizeof(StrlenFallback) },
+    { MemcmpFallback, sizeof(MemcmpFallback) },
+    { StrchrFallback, sizeof(StrchrFallback) },
+  };
+
+  // Each routine gets a slot in the stub page.
+  // The entrypoint at the start of the slot is what IFUNC resolvers hand out, it only ever runs as custom IR.
+  // Its guest bytes jump over to the fallback so the slot is still sane if the custom IR is gone.
+  constexpr size_t STUB_SLOT_SIZE = 64;
+  constexpr size_t STUB_FALLBACK_OFFSET = 16;
+  static_assert(STUB_SLOT_SIZE * LibcReplacements::NUM_ROUTINES <= FHU::FEX_PAGE_SIZE, "Stubs must fit in one page");
+
+  // The guest may have live data in the red zone, arguments get passed below it
+  constexpr uint64_t RED_ZONE_SIZE = 128;
+
+  struct NativeArgs {
+    uint64_t Args[3];
+    uint64_t Result;
+    uint64_t Faulted;
+  };
+
+  // Only ever touched by the owning thread, the fault handler included
+  struct FaultGuard {
+    jmp_buf Buffer;
+    bool Active;
+  };
+
+  thread_local FaultGuard Guard{};
+
+  [[noreturn]] void FaultLanding() {
+    longjmp(Guard.Buffer, 1);
+  }
+
+  bool HandleFault(FEXCore::Core::InternalThreadState *Thread, int Signal, void *info, void *ucontext) {
+    // Only synchronous faults come from the host routine, a kill or tgkill while it runs belongs to the guest
+    if (!Guard.Active || reinterpret_cast<siginfo_t*>(info)->si_code <= 0) {
+      return false;
+    }
+
+    // Abandon the host routine's frame and enter the landing pad as if it had been called
+    auto &mcontext = reinterpret_cast<ucontext_t*>(ucontext)->uc_mcontext;
+#ifdef _M_ARM_64
+    mcontext.pc = reinterpret_cast<uint64_t>(&FaultLanding);
+#else
+    mcontext.gregs[REG_RSP] = (mcontext.gregs[REG_RSP] & ~15ULL) - 8;
+    mcontext.gregs[REG_RIP] = reinterpret_cast<uint64_t>(&FaultLanding);
+#endif
+    return true;
+  }
+
+  template<typename F>
+  void RunGuarded(NativeArgs *Args, F &&Func) {
+    if (setjmp(Guard.Buffer)) {
+      Guard.Active = false;
+      Args->Faulted = 1;
+      return;
+    }
+
+    Guard.Active = true;
+    Args->Result = Func();
+    Guard.Active = false;
+    Args->Faulted = 0;
+  }
+
+  void NativeMemcpy(void *ArgsV) {
+    auto Args = reinterpret_cast<NativeArgs*>(ArgsV);
+    RunGuarded(Args, [Args]() {
+      // Plenty of guest code relies on overlapping memcpy behaving
+      return reinterpret_cast<uint64_t>(memmove(reinterpret_cast<void*>(Args->Args[0]), reinterpret_cast<void const*>(Args->Args[1]), Args->Args[2]));
+    });
+  }
+
+  void NativeMemset(void *ArgsV) {
+    auto Args = reinterpret_cast<NativeArgs*>(ArgsV);
+    RunGuarded(Args, [Args]() {
+      return reinterpret_cast<uint64_t>(memset(reinterpret_cast<void*>(Args->Args[0]), static_cast<int>(Args->Args[1]), Args->Args[2]));
+    });
+  }
+
+  void NativeStrlen(void *ArgsV) {
+    auto Args = reinterpret_cast<NativeArgs*>(ArgsV);
+    RunGuarded(Args, [Args]() {
+      return static_cast<uint64_t>(strlen(reinterpret_cast<char const*>(Args->Args[0])));
+    });
+  }
+
+  void NativeMemcmp(void *ArgsV) {
+    auto Args = reinterpret_cast<NativeArgs*>(ArgsV);
+    RunGuarded(Args, [Args]() {
+      return static_cast<uint64_t>(static_cast<int64_t>(memcmp(reinterpret_cast<void const*>(Args->Args[0]), reinterpret_cast<void const*>(Args->Args[1]), Args->Args[2])));
+    });
+  }
+
+  void NativeStrchr(void *ArgsV) {
+    auto Args = reinterpret_cast<NativeArgs*>(ArgsV);
+    RunGuarded(Args, [Args]() {
+      return reinterpret_cast<uint64_t>(strchr(reinterpret_cast<char const*>(Args->Args[0]), static_cast<int>(Args->Args[1])));
+    });
+  }
+
+  void (*const NativeRoutines[LibcReplacements::NUM_ROUTINES])(void *) = {
+    NativeMemcpy,
+    NativeMemset,
+    NativeStrlen,
+    NativeMemcmp,
+    NativeStrchr,
+  };
+
+  bool IsLibc(std::string const &Filename) {
+    auto Name = std::filesystem::path(Filename).filename().string();
+    // glibc (libc.so.6, libc-2.31.so) and musl (ld-musl-x86_64.so.1)
+    return Name.starts_with("libc.so") ||
+           Name.starts_with("libc-") ||
+           Name.starts_with("ld-musl-");
+  }
+
+  void SetupEmitter(FEXCore::IR::IREmitter *emit) {
+    auto IRHeader = emit->_IRHeader(emit->Invalid(), 0);
+    auto Block = emit->CreateCodeNode();
+    IRHeader.first->Blocks = emit->WrapNode(Block);
+    emit->SetCurrentCodeBlock(Block);
+  }
+
+  constexpr uint32_t GPROffset(size_t Reg) {
+    return offsetof(FEXCore::Core::CPUState, gregs[0]) + Reg * sizeof(uint64_t);
+  }
+
+  // Calls the host routine and returns to the caller, or restarts the call in the fallback if it faulted
+  void EmitNativeCall(FEXCore::IR::IREmitter *emit, size_t Routine, uint64_t Fallback) {
+    using namespace FEXCore;
+    SetupEmitter(emit);
+
+    auto OldSP = emit->_LoadContext(8, IR::GPRClass, GPROffset(X86State::REG_RSP));
+    auto Args = emit->_And(emit->_Sub(OldSP, emit->_Constant(RED_ZONE_SIZE + sizeof(NativeArgs))), emit->_Constant(~15ULL));
+
+    constexpr unsigned ArgRegs[] = { X86State::REG_RDI, X86State::REG_RSI, X86State::REG_RDX };
+    for (size_t i = 0; i < std::size(ArgRegs); ++i) {
+      auto Value = emit->_LoadContext(8, IR::GPRClass, GPROffset(ArgRegs[i]));
+      emit->_StoreMem(IR::GPRClass, 8, emit->_Add(Args, emit->_Constant(offsetof(NativeArgs, Args[i]))), Value, 8);
+    }
+
+    emit->_Thunk(Args, RoutineSums[Routine]);
+
+    auto Result = emit->_LoadMem(IR::GPRClass, 8, emit->_Add(Args, emit->_Constant(offsetof(NativeArgs, Result))), 8);
+    auto Faulted = emit->_LoadMem(IR::GPRClass, 8, emit->_Add(Args, emit->_Constant(offsetof(NativeArgs, Faulted))), 8);
+    auto ReturnRIP = emit->_LoadMem(IR::GPRClass, 8, OldSP, 8);
+    auto OldRAX = emit->_LoadContext(8, IR::GPRClass, GPROffset(X86State::REG_RAX));
+    auto Zero = emit->_Constant(0);
+
+    // On a fault every register is left as it was on entry, the fallback redoes the whole call
+    auto NewRAX = emit->_Select(IR::COND_EQ, Faulted, Zero, Result, OldRAX);
+    auto NewSP = emit->_Select(IR::COND_EQ, Faulted, Zero, emit->_Add(OldSP, emit->_Constant(8)), OldSP);
+    auto NewRIP = emit->_Select(IR::COND_EQ, Faulted, Zero, ReturnRIP, emit->_Constant(Fallback));
+
+    emit->_StoreContext(8, IR::GPRClass, NewRAX, GPROffset(X86State::REG_RAX));
+    emit->_StoreContext(8, IR::GPRClass, NewSP, GPROffset(X86State::REG_RSP));
+    emit->_ExitFunction(NewRIP);
+  }
+
+  // Replaces an IFUNC resolver, returns the FEX entrypoint no matter what the guest CPU looks like
+  void EmitResolver(FEXCore::IR::IREmitter *emit, uint64_t Entrypoint) {
+    using namespace FEXCore;
+    SetupEmitter(emit);
+
+    auto OldSP = emit->_LoadContext(8, IR::GPRClass, GPROffset(X86State::REG_RSP));
+    auto ReturnRIP = emit->_LoadMem(IR::GPRClass, 8, OldSP, 8);
+
+    emit->_StoreContext(8, IR::GPRClass, emit->_Constant(Entrypoint), GPROffset(X86State::REG_RAX));
+    emit->_StoreContext(8, IR::GPRClass, emit->_Add(OldSP, emit->_Constant(8)), GPROffset(X86State::REG_RSP));
+    emit->_ExitFunction(ReturnRIP);
+  }
+}
+
+LibcReplacements::LibcReplacements(FEXCore::Context::Context *CTX, FEX::HLE::SignalDelegator *SignalDelegation)
+  : CTX {CTX} {
+  auto Page = FEXCore::Allocator::mmap(nullptr, FHU::FEX_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  LOGMAN_THROW_A_FMT(Page != MAP_FAILED, "Couldn't allocate libc replacement stubs");
+  Stubs = reinterpret_cast<uint8_t*>(Page);
+
+  memset(Stubs, 0xcc, FHU::FEX_PAGE_SIZE);
+  for (size_t i = 0; i < NUM_ROUTINES; ++i) {
+    auto Slot = &Stubs[i * STUB_SLOT_SIZE];
+    // jmp rel8 to the fallback
+    Slot[0] = 0xeb;
+    Slot[1] = STUB_FALLBACK_OFFSET - 2;
+
+    LOGMAN_THROW_A_FMT(Fallbacks[i].Size <= (STUB_SLOT_SIZE - STUB_FALLBACK_OFFSET), "Fallback doesn't fit in its slot");
+    memcpy(&Slot[STUB_FALLBACK_OFFSET], Fallbacks[i].Code, Fallbacks[i].Size);
+
+    FEXCore::Context::RegisterHostThunk(CTX, RoutineSums[i], NativeRoutines[i]);
+    FEXCore::Context::AddCustomIREntrypoint(CTX, reinterpret_cast<uintptr_t>(Slot),
+      [Fallback = reinterpret_cast<uint64_t>(&Slot[STUB_FALLBACK_OFFSET]), i](uintptr_t, FEXCore::IR::IREmitter *emit) {
+        EmitNativeCall(emit, i, Fallback);
+      }, this, reinterpret_cast<void*>(i));
+  }
+
+  mprotect(Stubs, FHU::FEX_PAGE_SIZE, PROT_READ | PROT_EXEC);
+
+  SignalDelegation->RegisterHostSignalHandler(SIGSEGV, HandleFault, true);
+  SignalDelegation->RegisterHostSignalHandler(SIGBUS, HandleFault, true);
+}
+
+LibcReplacements::~LibcReplacements() {
+  FEXCore::Allocator::munmap(Stubs, FHU::FEX_PAGE_SIZE);
+}
+
+LibcReplacements::LibrarySymbols const *LibcReplacements::GetLibrarySymbols(std::string const &Filename) {
+  auto [Iter, Inserted] = Libraries.emplace(Filename, LibrarySymbols{});
+  auto Symbols = &Iter->second;
+  if (!Inserted) {
+    return Symbols;
+  }
+
+  ELFLoader::ELFContainer File(Filename, {}, true);
+  if (!File.WasLoaded() || File.GetMode() != ELFLoader::ELFContainer::MODE_64BIT) {
+    return Symbols;
+  }
+
+  for (size_t i = 0; i < NUM_ROUTINES; ++i) {
+    auto Symbol = File.GetSymbol(RoutineNames[i]);
+    if (!Symbol || (Symbol->Type != STT_FUNC && Symbol->Type != STT_GNU_IFUNC)) {
+      continue;
+    }
+
+    if (auto Offset = File.GetFileOffset(Symbol->Address)) {
+      Symbols->Offsets[i] = *Offset;
+      Symbols->IsIFunc[i] = Symbol->Type == STT_GNU_IFUNC;
+      LogMan::Msg::DFmt("LibcReplacements: {} {} at offset {:#x}{}", Filename, RoutineNames[i], *Offset, Symbols->IsIFunc[i] ? " (ifunc)" : "");
+    }
+  }
+
+  return Symbols;
+}
+
+void LibcReplacements::Hook(uintptr_t GuestAddr, size_t Routine, bool IsIFunc) {
+  auto Entrypoint = reinterpret_cast<uint64_t>(&Stubs[Routine * STUB_SLOT_SIZE]);
+  auto Fallback = Entrypoint + STUB_FALLBACK_OFFSET;
+
+  std::function<void(uintptr_t, FEXCore::IR::IREmitter *)> Handler;
+  if (IsIFunc) {
+    Handler = [Entrypoint](uintptr_t, FEXCore::IR::IREmitter *emit) {
+      EmitResolver(emit, Entrypoint);
+    };
+  }
+  else {
+    Handler = [Routine, Fallback](uintptr_t, FEXCore::IR::IREmitter *emit) {
+      EmitNativeCall(emit, Routine, Fallback);
+    };
+  }
+
+  // Already hooked when the same library gets mapped again at the same address
+  if (FEXCore::Context::AddCustomIREntrypoint(CTX, GuestAddr, Handler, this, reinterpret_cast<void*>(Routine))) {
+    Hooked[GuestAddr] = Routine;
+  }
+}
+
+bool LibcReplacements::HookRoutine(std::string_view Name, uintptr_t GuestAddr) {
+  std::scoped_lock lk(Mutex);
+
+  for (size_t i = 0; i < NUM_ROUTINES; ++i) {
+    if (Name == RoutineNames[i]) {
+      Hook(GuestAddr, i, false);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void LibcReplacements::TrackMmap(uintptr_t Base, uintptr_t Size, int Prot, int Flags, int fd, off_t Offset) {
+  std::scoped_lock lk(Mutex);
+
+  // Whatever was hooked in this range got replaced by the new mapping
+  RemoveHooks(Base, Size);
+
+  if ((Flags & MAP_ANONYMOUS) || !(Prot & PROT_EXEC)) {
+    return;
+  }
+
+  auto Filename = FEX::get_fdpath(fd);
+  if (!IsLibc(Filename)) {
+    return;
+  }
+
+  auto Symbols = GetLibrarySymbols(Filename);
+  for (size_t i = 0; i < NUM_ROUTINES; ++i) {
+    const uint64_t SymbolOffset = Symbols->Offsets[i];
+    if (SymbolOffset && SymbolOffset >= static_cast<uint64_t>(Offset) && SymbolOffset < (Offset + Size)) {
+      Hook(Base + (SymbolOffset - Offset), i, Symbols->IsIFunc[i]);
+    }
+  }
+}
+
+void LibcReplacements::TrackMunmap(uintptr_t Base, uintptr_t Size) {
+  std::scoped_lock lk(Mutex);
+  RemoveHooks(Base, Size);
+}
+
+void LibcReplacements::TrackMprotect(uintptr_t Base, uintptr_t Size, int Prot) {
+  if (Prot & PROT_EXEC) {
+    return;
+  }
+
+  std::scoped_lock lk(Mutex);
+  RemoveHooks(Base, Size);
+}
+
+void LibcReplacements::RemoveHooks(uintptr_t Base, uintptr_t Size) {
+  auto Begin = Hooked.lower_bound(Base);
+  auto End = Hooked.lower_bound(Base + Size);
+  for (auto it = Begin; it != End; ++it) {
+    FEXCore::Context::RemoveCustomIREntrypoint(CTX, it->first);
+  }
+  Hooked.erase(Begin, End);
+}
+}
@@ -0,0 +1,71 @@
+/*
+$info$
+tags: LinuxSyscalls|common
+desc: Native replacements for hot guest libc routines
+$end_info$
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <sys/types.h>
+#include <unordered_map>
+
+namespace FEXCore::Context {
+  struct Context;
+}
+
+namespace FEX::HLE {
+class SignalDelegator;
+
+/**
+ * @brief Redirects memcpy, memset, strlen, memcmp and strchr of a 64-bit guest libc to the host's implementations
+ *
+ * Entrypoints are found through the library's ELF symbols when its executable segment gets mapped.
+ * glibc exports these as IFUNCs, in that case the resolver is replaced so it hands out a FEX owned entrypoint instead.
+ *
+ * Host code runs under a fault guard. If it faults the call is restarted in a plain x86 byte loop,
+ * which then takes the fault at a precise guest RIP like the guest's own implementation would.
+ */
+class LibcReplacements final {
+public:
+  LibcReplacements(FEXCore::Context::Context *CTX, FEX::HLE::SignalDelegator *SignalDelegation);
+  ~LibcReplacements();
+
+  // Called for every mapping, hooks in a replaced range are dropped
+  void TrackMmap(uintptr_t Base, uintptr_t Size, int Prot, int Flags, int fd, off_t Offset);
+  void TrackMunmap(uintptr_t Base, uintptr_t Size);
+  void TrackMprotect(uintptr_t Base, uintptr_t Size, int Prot);
+
+  // Replaces a plain (non-IFUNC) routine at a known guest address, returns false for unknown routine names
+  bool HookRoutine(std::string_view Name, uintptr_t GuestAddr);
+
+  constexpr static size_t NUM_ROUTINES = 5;
+
+private:
+  struct LibrarySymbols {
+    // File offset of each routine's symbol, zero if the library doesn't export it
+    uint64_t Offsets[NUM_ROUTINES];
+    bool IsIFunc[NUM_ROUTINES];
+  };
+
+  LibrarySymbols const *GetLibrarySymbols(std::string const &Filename);
+  void Hook(uintptr_t GuestAddr, size_t Routine, bool IsIFunc);
+  // Expects Mutex to be held
+  void RemoveHooks(uintptr_t Base, uintptr_t Size);
+
+  FEXCore::Context::Context *CTX;
+
+  // Guest visible page holding an entrypoint and a fallback for each routine
+  uint8_t *Stubs{};
+
+  std::mutex Mutex;
+  std::unordered_map<std::string, LibrarySymbols> Libraries;
+  // Hooked guest address -> routine
+  std::map<uintptr_t, size_t> Hooked;
+};
+}
@@ -116,13 +116,8 @@ namespace FEX::HLE {
           NewMask |= (1ULL << (Signal - 1));
         }
 
-        // Walk our required signals and stop masking them if requested
-        for (size_t i = 0; i < MAX_SIGNALS; ++i) {
-          if (HostHandlers[i + 1].Required.load(std::memory_order_relaxed)) {
-            // Never mask our required signals
-            NewMask &= ~(1ULL << i);
-          }
-        }
+        // Never mask our required signals
+        NewMask &= ~RequiredSignals.load(std::memory_order_relaxed);
 
         // Update our host signal mask so we don't hit race conditions with signals
         // This allows us to maintain the expected signal mask through the guest signal handling and then all the way back again
@@ -199,6 +194,11 @@ namespace FEX::HLE {
       SignalHandler.GuestAction.sa_flags,
       SA_NOCLDSTOP | SA_NOCLDWAIT | SA_NODEFER | SA_RESTART);
 
+    // The sampling profiler's timer must never surface as an interrupted syscall in the guest
+    if (Signal == SIGNAL_FOR_PROFILE && SignalHandler.Required.load(std::memory_order_relaxed)) {
+      SignalHandler.HostAction.sa_flags |= SA_RESTART;
+    }
+
 #ifdef _M_X86_64
 #define SA_RESTORER 0x04000000
     SignalHandler.HostAction.sa_flags |= SA_RESTORER;
@@ -340,7 +340,7 @@ namespace FEX::HLE {
     // Linux signal handlers are per-process rather than per thread
     // Multiple threads could be calling in to this
     std::lock_guard lk(HostDelegatorMutex);
-    HostHandlers[Signal].Required = Required;
+    SetRequired(Signal, Required);
     InstallHostThunk(Signal);
   }
 
@@ -348,10 +348,22 @@ namespace FEX::HLE {
     // Linux signal handlers are per-process rather than per thread
     // Multiple threads could be calling in to this
     std::lock_guard lk(HostDelegatorMutex);
-    HostHandlers[Signal].Required = Required;
+    SetRequired(Signal, Required);
     InstallHostThunk(Signal);
   }
 
+  void SignalDelegator::SetRequired(int Signal, bool Required) {
+    HostHandlers[Signal].Required = Required;
+
+    const uint64_t SignalBit = 1ULL << (Signal - 1);
+    if (Required) {
+      RequiredSignals.fetch_or(SignalBit, std::memory_order_relaxed);
+    }
+    else {
+      RequiredSignals.fetch_and(~SignalBit, std::memory_order_relaxed);
+    }
+  }
+
   void SignalDelegator::RegisterHostSignalHandlerForGuest(int Signal, FEXCore::HostSignalDelegatorFunctionForGuest Func) {
     std::lock_guard lk(HostDelegatorMutex);
     HostHandlers[Signal].GuestHandler = std::move(Func);
@@ -104,6 +104,9 @@ namespace FEX::HLE {
     };
 
     std::array<SignalHandler, MAX_SIGNALS + 1> HostHandlers{};
+    // Mirrors each handler's Required flag so guest signal delivery doesn't have to walk every handler
+    std::atomic<uint64_t> RequiredSignals{};
+    void SetRequired(int Signal, bool Required);
     bool InstallHostThunk(int Signal);
     bool UpdateHostThunk(int Signal);
 
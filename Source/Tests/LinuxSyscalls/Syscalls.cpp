@@ -601,6 +601,11 @@ SyscallHandler::SyscallHandler(FEXCore::Context::Context *_CTX, FEX::HLE::Signal
   if (SMCChecks == FEXCore::Config::CONFIG_SMC_MTRACK) {
     SignalDelegation->RegisterHostSignalHandler(SIGSEGV, HandleSegfault, true);
   }
+
+  // Registered after the SMC handler so writes to tracked code pages still get handled in place
+  if (NativeLibc() && Is64BitMode()) {
+    LibcReplacer = std::make_unique<FEX::HLE::LibcReplacements>(CTX, SignalDelegation);
+  }
 }
 
 SyscallHandler::~SyscallHandler() {
@@ -636,6 +641,10 @@ uint64_t SyscallHandler::HandleSyscall(FEXCore::Core::CpuStateFrame *Frame, FEXC
     return -ENOSYS;
   }
 
+  if (Args->Argument[0] < FEXCore::Core::RuntimeStats::MAX_SYSCALLS) {
+    FEXCore::Core::IncrementStat(Frame->Thread->Stats->Syscalls[Args->Argument[0]]);
+  }
+
   auto &Def = Definitions[Args->Argument[0]];
   uint64_t Result{};
   switch (Def.NumArgs) {
@@ -8,6 +8,7 @@ $end_info$
 #pragma once
 
 #include "Tests/LinuxSyscalls/FileManagement.h"
+#include "Tests/LinuxSyscalls/LibcReplacements.h"
 #include "Tests/LinuxSyscalls/LinuxAllocator.h"
 
 #include <FEXCore/Config/Config.h>
@@ -148,6 +149,7 @@ public:
   FEX_CONFIG_OPT(ThreadsConfig, THREADS);
   FEX_CONFIG_OPT(Is64BitMode, IS64BIT_MODE);
   FEX_CONFIG_OPT(SMCChecks, SMCCHECKS);
+  FEX_CONFIG_OPT(NativeLibc, NATIVELIBC);
 
   uint32_t GetHostKernelVersion() const { return HostKernelVersion; }
   uint32_t GetGuestKernelVersion() const { return GuestKernelVersion; }
@@ -227,6 +229,7 @@ private:
   #endif
 
   std::unique_ptr<FEX::HLE::MemAllocator> Alloc32Handler{};
+  std::unique_ptr<FEX::HLE::LibcReplacements> LibcReplacer{};
 
   std::unique_ptr<FEXCore::HLE::SourcecodeMap> GenerateMap(const std::string_view& GuestBinaryFile, const std::string_view& GuestBinaryFileId) override;
   
@@ -562,3 +565,12 @@ static bool HasSyscallError(const void* Result) {
       FEX::HLE::x64::RegisterSyscall(FEX::HLE::x64::SYSCALL_x64_##name, SYSCALL_DEF(name), flags, #name, lambda); \
       FEX::HLE::x32::RegisterSyscall(FEX::HLE::x32::SYSCALL_x86_##name, SYSCALL_DEF(name), flags, #name, lambda); \
     } } impl_##name
+
+// Registers syscall for both 32bit and 64bit, only as a passthrough syscall if pass is true at registration time
+#define REGISTER_SYSCALL_IMPL_PASS_IF_FLAGS(name, pass, flags, lambda) \
+  struct impl_##name { \
+    impl_##name(bool Pass) \
+    { \
+      FEX::HLE::x64::RegisterSyscall(FEX::HLE::x64::SYSCALL_x64_##name, Pass ? SYSCALL_DEF(name) : ~0, flags, #name, lambda); \
+      FEX::HLE::x32::RegisterSyscall(FEX::HLE::x32::SYSCALL_x86_##name, Pass ? SYSCALL_DEF(name) : ~0, flags, #name, lambda); \
+    } } impl_##name {pass}
@@ -24,6 +24,9 @@ namespace FEX::HLE {
   void RegisterFS(FEX::HLE::SyscallHandler *const Handler) {
     using namespace FEXCore::IR;
 
+    // Namespace mutations need to reach the FileManager to keep the rootfs path cache coherent
+    const bool PassMutations = !Handler->FM.HasRootFSPathCache();
+
     REGISTER_SYSCALL_IMPL_PASS_FLAGS(getcwd, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
       [](FEXCore::Core::CpuStateFrame *Frame, char *buf, size_t size) -> uint64_t {
       uint64_t Result = syscall(SYSCALL_DEF(getcwd), buf, size);
@@ -42,39 +45,39 @@ namespace FEX::HLE {
       SYSCALL_ERRNO();
     });
 
-    REGISTER_SYSCALL_IMPL_PASS_FLAGS(rename, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
+    REGISTER_SYSCALL_IMPL_PASS_IF_FLAGS(rename, PassMutations, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
       [](FEXCore::Core::CpuStateFrame *Frame, const char *oldpath, const char *newpath) -> uint64_t {
-      uint64_t Result = ::rename(oldpath, newpath);
+      uint64_t Result = FEX::HLE::_SyscallHandler->FM.Renameat2(AT_FDCWD, oldpath, AT_FDCWD, newpath, 0);
       SYSCALL_ERRNO();
     });
 
-    REGISTER_SYSCALL_IMPL_PASS_FLAGS(mkdir, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
+    REGISTER_SYSCALL_IMPL_PASS_IF_FLAGS(mkdir, PassMutations, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
       [](FEXCore::Core::CpuStateFrame *Frame, const char *pathname, mode_t mode) -> uint64_t {
-      uint64_t Result = ::mkdir(pathname, mode);
+      uint64_t Result = FEX::HLE::_SyscallHandler->FM.Mkdirat(AT_FDCWD, pathname, mode);
       SYSCALL_ERRNO();
     });
 
-    REGISTER_SYSCALL_IMPL_PASS_FLAGS(rmdir, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
+    REGISTER_SYSCALL_IMPL_PASS_IF_FLAGS(rmdir, PassMutations, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
       [](FEXCore::Core::CpuStateFrame *Frame, const char *pathname) -> uint64_t {
-      uint64_t Result = ::rmdir(pathname);
+      uint64_t Result = FEX::HLE::_SyscallHandler->FM.Unlinkat(AT_FDCWD, pathname, AT_REMOVEDIR);
       SYSCALL_ERRNO();
     });
 
-    REGISTER_SYSCALL_IMPL_PASS_FLAGS(link, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
+    REGISTER_SYSCALL_IMPL_PASS_IF_FLAGS(link, PassMutations, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
       [](FEXCore::Core::CpuStateFrame *Frame, const char *oldpath, const char *newpath) -> uint64_t {
-      uint64_t Result = ::link(oldpath, newpath);
+      uint64_t Result = FEX::HLE::_SyscallHandler->FM.Linkat(AT_FDCWD, oldpath, AT_FDCWD, newpath, 0);
       SYSCALL_ERRNO();
     });
 
-    REGISTER_SYSCALL_IMPL_PASS_FLAGS(unlink, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
+    REGISTER_SYSCALL_IMPL_PASS_IF_FLAGS(unlink, PassMutations, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
       [](FEXCore::Core::CpuStateFrame *Frame, const char *pathname) -> uint64_t {
-      uint64_t Result = ::unlink(pathname);
+      uint64_t Result = FEX::HLE::_SyscallHandler->FM.Unlinkat(AT_FDCWD, pathname, 0);
       SYSCALL_ERRNO();
     });
 
-    REGISTER_SYSCALL_IMPL_PASS_FLAGS(symlink, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
+    REGISTER_SYSCALL_IMPL_PASS_IF_FLAGS(symlink, PassMutations, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
       [](FEXCore::Core::CpuStateFrame *Frame, const char *target, const char *linkpath) -> uint64_t {
-      uint64_t Result = ::symlink(target, linkpath);
+      uint64_t Result = FEX::HLE::_SyscallHandler->FM.Symlinkat(target, AT_FDCWD, linkpath);
       SYSCALL_ERRNO();
     });
 
@@ -127,9 +130,9 @@ namespace FEX::HLE {
       SYSCALL_ERRNO();
     });
 
-    REGISTER_SYSCALL_IMPL_PASS_FLAGS(creat, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
+    REGISTER_SYSCALL_IMPL_PASS_IF_FLAGS(creat, PassMutations, SyscallFlags::OPTIMIZETHROUGH | SyscallFlags::NOSYNCSTATEONENTRY,
       [](FEXCore::Core::CpuStateFrame *Frame, const char *pathname, mode_t mode) -> uint64_t {
-      uint64_t Result = ::creat(pathname, mode);
+      uint64_t Result = FEX::HLE::_SyscallHandler->FM.Creat(pathname, mode);
       SYSCALL_ERRNO();
     });
 
@@ -65,6 +65,8 @@ bool SyscallHandler::HandleSegfault(FEXCore::Core::InternalThreadState *Thread,
 
     auto FaultBase = FEXCore::AlignDown(FaultAddress, FHU::FEX_PAGE_SIZE);
 
+    FEXCore::Core::IncrementStat(Thread->Stats->SMCFaults);
+
     if (Entry->second.Flags.Shared) {
       LOGMAN_THROW_A_FMT(Entry->second.Resource, "VMA tracking error");
 
@@ -226,6 +228,10 @@ void SyscallHandler::TrackMmap(uintptr_t Base, uintptr_t Size, int Prot, int Fla
   if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
     FEXCore::Context::InvalidateGuestCodeRange(CTX, (uintptr_t)Base, Size);
   }
+
+  if (LibcReplacer) {
+    LibcReplacer->TrackMmap(Base, Size, Prot, Flags, fd, Offset);
+  }
 }
 
 void SyscallHandler::TrackMunmap(uintptr_t Base, uintptr_t Size) {
@@ -240,6 +246,10 @@ void SyscallHandler::TrackMunmap(uintptr_t Base, uintptr_t Size) {
   if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
     FEXCore::Context::InvalidateGuestCodeRange(CTX, (uintptr_t)Base, Size);
   }
+
+  if (LibcReplacer) {
+    LibcReplacer->TrackMunmap(Base, Size);
+  }
 }
 
 void SyscallHandler::TrackMprotect(uintptr_t Base, uintptr_t Size, int Prot) {
@@ -254,6 +264,10 @@ void SyscallHandler::TrackMprotect(uintptr_t Base, uintptr_t Size, int Prot) {
   if (SMCChecks != FEXCore::Config::CONFIG_SMC_NONE) {
     FEXCore::Context::InvalidateGuestCodeRange(CTX, Base, Size);
   }
+
+  if (LibcReplacer) {
+    LibcReplacer->TrackMprotect(Base, Size, Prot);
+  }
 }
 
 void SyscallHandler::TrackMremap(uintptr_t OldAddress, size_t OldSize, size_t NewSize, int flags, uintptr_t NewAddress) {
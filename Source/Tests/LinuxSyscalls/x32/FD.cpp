@@ -498,7 +498,7 @@ namespace FEX::HLE::x32 {
     });
 
     REGISTER_SYSCALL_IMPL_X32(dup2, [](FEXCore::Core::CpuStateFrame *Frame, int oldfd, int newfd) -> uint64_t {
-      uint64_t Result = ::dup2(oldfd, newfd);
+      uint64_t Result = FEX::HLE::_SyscallHandler->FM.Dup2(oldfd, newfd);
       if (Result != -1) {
         CheckAndAddFDDuplication(oldfd, newfd);
       }
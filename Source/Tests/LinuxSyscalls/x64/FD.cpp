@@ -226,8 +226,8 @@ namespace FEX::HLE::x64 {
       SYSCALL_ERRNO();
     });
 
-    REGISTER_SYSCALL_IMPL_X64_PASS(dup2, [](FEXCore::Core::CpuStateFrame *Frame, int oldfd, int newfd) -> uint64_t {
-      uint64_t Result = ::dup2(oldfd, newfd);
+    REGISTER_SYSCALL_IMPL_X64(dup2, [](FEXCore::Core::CpuStateFrame *Frame, int oldfd, int newfd) -> uint64_t {
+      uint64_t Result = FEX::HLE::_SyscallHandler->FM.Dup2(oldfd, newfd);
       SYSCALL_ERRNO();
     });
 
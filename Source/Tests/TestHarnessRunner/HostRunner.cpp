@@ -153,6 +153,20 @@ public:
       memcpy(&OutState->xmm[i], &_mcontext->fpregs->_xmm[i], sizeof(_mcontext->fpregs->_xmm[0]));
     }
 
+    // The kernel appends the XSAVE header and extended state after the legacy FXSAVE region
+    // UC_FP_XSTATE is set when this extended state exists
+    constexpr unsigned long UC_FP_XSTATE = 0x1;
+    if (_context->uc_flags & UC_FP_XSTATE) {
+      const uint8_t *XSaveArea = reinterpret_cast<const uint8_t*>(_mcontext->fpregs);
+      uint64_t XStateBV{};
+      memcpy(&XStateBV, XSaveArea + 512, sizeof(XStateBV));
+
+      // Bit 2 of XSTATE_BV is the YMM state component, otherwise the upper halves are in their init state
+      if (XStateBV & (1U << 2)) {
+        memcpy(OutState->ymm_upper, XSaveArea + 576, sizeof(OutState->ymm_upper));
+      }
+    }
+
     uint16_t CurrentOffset = (_mcontext->fpregs->swd >> 11) & 7;
 
     for (size_t i = 0; i < FEXCore::Core::CPUState::NUM_MMS; ++i) {
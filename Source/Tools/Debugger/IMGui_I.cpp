@@ -392,6 +392,20 @@ namespace Disasm {
     return nullptr;
   }
 
+  std::string DisasmHost(uint8_t *HostCodePtr, FEXCore::Core::DebugData const &DebugData) {
+    uint32_t InstCount{};
+    std::string Disasm = HostDisassembler->Disassemble(HostCodePtr, DebugData.HostCodeSize, -1U, reinterpret_cast<uint64_t>(HostCodePtr), &InstCount);
+
+    // Cold code is emitted away from the rest of the block
+    if (DebugData.HostColdCodeSize) {
+      uint8_t *ColdCodePtr = HostCodePtr + DebugData.HostColdCodeOffset;
+      Disasm += "\nCold code:\n";
+      Disasm += HostDisassembler->Disassemble(ColdCodePtr, DebugData.HostColdCodeSize, -1U, reinterpret_cast<uint64_t>(ColdCodePtr), &InstCount);
+    }
+
+    return Disasm;
+  }
+
   void DisasmGuest(uint64_t PC, int Size) {
     CurrentDisasmRIP = PC;
     uint8_t *GuestCode = GetPointerFromRegions(PC);
@@ -410,7 +424,7 @@ namespace Disasm {
       HostDisasmString = "<No Backing>";
     }
     else {
-      HostDisasmString = HostDisassembler->Disassemble(static_cast<uint8_t*>(HostCodePtr), DebugData.HostCodeSize, -1U, reinterpret_cast<uint64_t>(HostCodePtr), &InstCount);
+      HostDisasmString = DisasmHost(HostCodePtr, DebugData);
     }
   }
 
@@ -433,7 +447,7 @@ namespace Disasm {
       HostDisasmString = "<No Backing>";
     }
     else {
-      HostDisasmString = HostDisassembler->Disassemble(static_cast<uint8_t*>(HostCodePtr), DebugData.HostCodeSize, -1U, reinterpret_cast<uint64_t>(HostCodePtr), &InstCount);
+      HostDisasmString = DisasmHost(HostCodePtr, DebugData);
     }
   }
 
@@ -0,0 +1,240 @@
+#include "OptionParser.h"
+#include "git_version.h"
+
+#include <FEXCore/Debug/RuntimeStats.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace {
+  using Counters = std::array<uint64_t, FEXCore::Core::NUM_STAT_COUNTERS>;
+
+  struct Snapshot {
+    Counters Totals{};
+    uint32_t ActiveThreads{};
+    std::chrono::steady_clock::time_point Time{};
+  };
+
+  // Index of a counter in the flattened counter array
+#define STAT_INDEX(Name) ((offsetof(FEXCore::Core::RuntimeStats, Name) - offsetof(FEXCore::Core::RuntimeStats, InstructionsExecuted)) / sizeof(uint64_t))
+
+  FEXCore::Stats::StatsHeader const *MapRegion(pid_t PID) {
+    const auto Path = FEXCore::Stats::GetSharedMemoryPath(PID);
+    int FD = open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (FD == -1) {
+      fprintf(stderr, "Couldn't open '%s': %s\n", Path.c_str(), strerror(errno));
+      fprintf(stderr, "Is FEX running with FEX_SHAREDSTATS=1?\n");
+      return nullptr;
+    }
+
+    struct stat Stat{};
+    if (fstat(FD, &Stat) == -1 || static_cast<size_t>(Stat.st_size) < sizeof(FEXCore::Stats::StatsHeader)) {
+      fprintf(stderr, "'%s' is too small to be a stats region\n", Path.c_str());
+      close(FD);
+      return nullptr;
+    }
+
+    auto Ptr = mmap(nullptr, sizeof(FEXCore::Stats::StatsHeader), PROT_READ, MAP_SHARED, FD, 0);
+    close(FD);
+
+    if (Ptr == MAP_FAILED) {
+      fprintf(stderr, "Couldn't map '%s': %s\n", Path.c_str(), strerror(errno));
+      return nullptr;
+    }
+
+    auto Header = reinterpret_cast<FEXCore::Stats::StatsHeader const*>(Ptr);
+    if (Header->Magic != FEXCore::Stats::STATS_MAGIC) {
+      fprintf(stderr, "'%s' isn't a FEX stats region\n", Path.c_str());
+      munmap(Ptr, sizeof(FEXCore::Stats::StatsHeader));
+      return nullptr;
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (Header->Version != FEXCore::Stats::STATS_VERSION ||
+        Header->Size != sizeof(FEXCore::Stats::StatsHeader)) {
+      fprintf(stderr, "Stats region version %u doesn't match FEXStats version %u\n", Header->Version, FEXCore::Stats::STATS_VERSION);
+      munmap(Ptr, sizeof(FEXCore::Stats::StatsHeader));
+      return nullptr;
+    }
+
+    return Header;
+  }
+
+  void Accumulate(Counters &Totals, FEXCore::Core::RuntimeStats const *Stats) {
+    auto Src = FEXCore::Core::GetStatCounters(const_cast<FEXCore::Core::RuntimeStats*>(Stats));
+    for (size_t i = 0; i < Totals.size(); ++i) {
+      Totals[i] += Src[i].load(std::memory_order_relaxed);
+    }
+  }
+
+  Snapshot Sample(FEXCore::Stats::StatsHeader const *Header) {
+    Snapshot Result{};
+    Result.Time = std::chrono::steady_clock::now();
+
+    Accumulate(Result.Totals, &Header->Retired);
+    for (size_t i = 0; i < Header->MaxThreads; ++i) {
+      auto Thread = &Header->Threads[i];
+      if (Thread->TID.load(std::memory_order_relaxed) == 0) {
+        continue;
+      }
+      ++Result.ActiveThreads;
+      Accumulate(Result.Totals, Thread);
+    }
+
+    return Result;
+  }
+
+  void PrintStats(FEXCore::Stats::StatsHeader const *Header, Snapshot const &Previous, Snapshot const &Current, size_t TopSyscalls) {
+    const double Seconds = std::chrono::duration<double>(Current.Time - Previous.Time).count();
+    auto Total = [&](size_t Index) {
+      return Current.Totals[Index];
+    };
+    auto Rate = [&](size_t Index) {
+      // Counters folded from exiting threads can make a total step backwards for a moment
+      const auto Delta = Current.Totals[Index] >= Previous.Totals[Index] ? Current.Totals[Index] - Previous.Totals[Index] : 0;
+      return static_cast<double>(Delta) / Seconds;
+    };
+    auto Millis = [&](size_t Index) {
+      return Rate(Index) / 1'000'000.0;
+    };
+
+    // Clear the screen and home the cursor
+    printf("\033[H\033[2J");
+    printf("FEXStats: pid %u, %u active threads\n\n", Header->PID, Current.ActiveThreads);
+
+    printf("%-24s %14s %14s\n", "", "Total", "Per second");
+    auto Row = [&](char const *Name, size_t Index) {
+      printf("%-24s %14lu %14.1f\n", Name, Total(Index), Rate(Index));
+    };
+
+    Row("Blocks compiled", STAT_INDEX(BlocksCompiled));
+    Row("Blocks from AOT IR", STAT_INDEX(BlocksFromAOTIR));
+    Row("Blocks from object cache", STAT_INDEX(BlocksFromObjectCache));
+    Row("Decode cache hits", STAT_INDEX(DecodeCacheHits));
+    Row("Decode cache misses", STAT_INDEX(DecodeCacheMisses));
+    Row("Memory loads forwarded", STAT_INDEX(MemoryLoadsForwarded));
+    Row("Memory loads eliminated", STAT_INDEX(MemoryLoadsEliminated));
+    Row("L1 lookup hits", STAT_INDEX(LookupL1Hits));
+    Row("L2 lookup hits", STAT_INDEX(LookupL2Hits));
+    Row("L3 lookup hits", STAT_INDEX(LookupL3Hits));
+    Row("Lookup misses", STAT_INDEX(LookupMisses));
+    Row("SMC faults", STAT_INDEX(SMCFaults));
+    Row("Code invalidations", STAT_INDEX(CodeInvalidations));
+    Row("Code cache clears", STAT_INDEX(CodeCacheClears));
+    Row("Segment evictions", STAT_INDEX(CodeSegmentEvictions));
+    Row("Blocks evicted", STAT_INDEX(BlocksEvicted));
+    Row("Capacity recompiles", STAT_INDEX(CapacityRecompiles));
+    Row("Signals delivered", STAT_INDEX(SignalsDelivered));
+    Row("Misaligned atomic faults", STAT_INDEX(MisalignedAtomicFaults));
+    Row("Thunk calls", STAT_INDEX(ThunkCalls));
+    Row("Instructions executed", STAT_INDEX(InstructionsExecuted));
+    printf("%-24s %14lu\n", "Code buffer bytes", Total(STAT_INDEX(CodeBufferBytes)));
+
+    printf("\n%-24s %14s\n", "Compile time", "ms per second");
+    printf("%-24s %14.3f\n", "IR generation", Millis(STAT_INDEX(IRGenNanoseconds)));
+    printf("%-24s %14.3f\n", "Codegen", Millis(STAT_INDEX(CodegenNanoseconds)));
+
+    const auto NumPasses = std::min<size_t>(Header->NumPasses.load(std::memory_order_acquire), FEXCore::Core::RuntimeStats::MAX_PASSES);
+    for (size_t i = 0; i < NumPasses; ++i) {
+      char Name[FEXCore::Stats::PASS_NAME_LENGTH + 1]{};
+      memcpy(Name, Header->PassNames[i], FEXCore::Stats::PASS_NAME_LENGTH);
+      printf("  %-22s %14.3f\n", Name, Millis(STAT_INDEX(PassNanoseconds) + i));
+    }
+
+    if (TopSyscalls) {
+      std::vector<std::pair<double, size_t>> Syscalls;
+      for (size_t i = 0; i < FEXCore::Core::RuntimeStats::MAX_SYSCALLS; ++i) {
+        const auto SyscallRate = Rate(STAT_INDEX(Syscalls) + i);
+        if (SyscallRate > 0.0) {
+          Syscalls.emplace_back(SyscallRate, i);
+        }
+      }
+
+      std::sort(Syscalls.begin(), Syscalls.end(), std::greater<>());
+      Syscalls.resize(std::min(Syscalls.size(), TopSyscalls));
+
+      printf("\n%-24s %14s %14s\n", "Guest syscall", "Total", "Per second");
+      for (auto &[SyscallRate, Number] : Syscalls) {
+        printf("%-24zu %14lu %14.1f\n", Number, Total(STAT_INDEX(Syscalls) + Number), SyscallRate);
+      }
+    }
+
+    fflush(stdout);
+  }
+}
+
+int main(int argc, char **argv) {
+  optparse::OptionParser Parser = optparse::OptionParser()
+    .usage("%prog [options] <pid>")
+    .description("Shows live runtime statistics of a FEX process started with FEX_SHAREDSTATS=1")
+    .version("FEX-Emu (" GIT_DESCRIBE_STRING ") ");
+
+  Parser.add_option("-i", "--interval")
+    .action("store")
+    .type("int")
+    .set_default(1000)
+    .metavar("ms")
+    .help("Refresh interval in milliseconds");
+
+  Parser.add_option("-s", "--syscalls")
+    .action("store")
+    .type("int")
+    .set_default(10)
+    .metavar("n")
+    .help("Number of most frequent guest syscalls to show");
+
+  Parser.add_option("-v")
+    .action("version")
+    .help("Version string");
+
+  optparse::Values Options = Parser.parse_args(argc, argv);
+  auto Args = Parser.args();
+
+  if (Args.size() != 1) {
+    Parser.print_help();
+    return 1;
+  }
+
+  const pid_t PID = std::stoi(Args[0]);
+  const int Interval = std::max(50, static_cast<int>(Options.get("interval")));
+  const int TopSyscalls = std::max(0, static_cast<int>(Options.get("syscalls")));
+
+  auto Header = MapRegion(PID);
+  if (!Header) {
+    return 1;
+  }
+
+  auto Previous = Sample(Header);
+  while (true) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(Interval));
+
+    // The region outlives the process if it was killed, stop once the process is gone
+    if (kill(PID, 0) == -1 && errno == ESRCH) {
+      printf("Process %d has exited\n", PID);
+      break;
+    }
+
+    auto Current = Sample(Header);
+    PrintStats(Header, Previous, Current, TopSyscalls);
+    Previous = Current;
+  }
+
+  munmap(const_cast<FEXCore::Stats::StatsHeader*>(Header), sizeof(FEXCore::Stats::StatsHeader));
+  return 0;
+}
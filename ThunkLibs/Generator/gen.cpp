@@ -6,13 +6,38 @@
 #include <iomanip>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <openssl/sha.h>
 
 #include "interface.h"
 
+/**
+ * Representation of a parameter or return value in the packed argument struct of a 32-bit guest.
+ *
+ * Host code reads these structs in the guest's layout and converts to the host's types around the call.
+ */
+struct GuestTypeInfo {
+    enum class Kind {
+        // Identical representation on guest and host
+        Same,
+        // long/unsigned long, extended from 32 bits when unpacking
+        Integer,
+        // Guest pointer to data that has the same layout on the host, zero-extended when unpacking
+        Pointer,
+        // Guest pointer to a single long/unsigned long, repacked through a host temporary
+        IntegerPointer,
+    };
+
+    Kind kind = Kind::Same;
+    bool is_signed = false;
+};
+
 struct FunctionParams {
     std::vector<clang::QualType> param_types;
+
+    // Only filled in for 32-bit guests
+    std::vector<GuestTypeInfo> guest_param_info;
 };
 
 struct ThunkedCallback : FunctionParams {
@@ -24,6 +49,9 @@ struct ThunkedCallback : FunctionParams {
     bool is_stub = false;  // Callback will be replaced by a stub that calls std::abort
     bool is_guest = false; // Callback will never be called on the host
     bool is_variadic = false;
+
+    // Only filled in for 32-bit guests
+    GuestTypeInfo guest_return_info;
 };
 
 /**
@@ -52,6 +80,11 @@ struct ThunkedFunction : FunctionParams {
     // function directly.
     bool is_hostcall = false;
 
+    // If true, a returned pointer is known to point to guest memory
+    bool returns_guest_pointer = false;
+
+    GuestTypeInfo guest_return_info;
+
     std::string GetOriginalFunctionName() const {
         const std::string suffix = "_internal";
         assert(function_name.length() > suffix.size());
@@ -94,6 +127,10 @@ struct ThunkedAPIFunction : FunctionParams {
 static std::vector<ThunkedFunction> thunks;
 static std::vector<ThunkedAPIFunction> thunked_api;
 static std::optional<unsigned> lib_version;
+static GuestABI guest_abi;
+
+// Canonical types annotated with fexgen::assume_compatible_data_layout
+static std::unordered_set<const clang::Type*> compatible_layout_types;
 
 struct NamespaceInfo {
     std::string name;
@@ -263,6 +300,10 @@ public:
      * Matches "template<> struct fex_gen_config<LibraryFunc> { ... }"
      */
     bool VisitClassTemplateSpecializationDecl(clang::ClassTemplateSpecializationDecl* decl) try {
+        if (decl->getName() == "fex_gen_type") {
+            return VisitTypeAnnotations(decl);
+        }
+
         if (decl->getName() != "fex_gen_config") {
             return true;
         }
@@ -302,6 +343,7 @@ public:
         data.decl = emitted_function;
 
         data.custom_host_impl = annotations.custom_host_impl;
+        data.returns_guest_pointer = annotations.returns_guest_pointer;
 
         for (std::size_t param_idx = 0; param_idx < emitted_function->param_size(); ++param_idx) {
             auto* param = emitted_function->getParamDecl(param_idx);
@@ -379,16 +421,169 @@ public:
         context.getDiagnostics().Report(exception.first, exception.second);
         return false;
     }
+
+    /**
+     * Matches "template<> struct fex_gen_type<Type> { ... }"
+     */
+    bool VisitTypeAnnotations(clang::ClassTemplateSpecializationDecl* decl) {
+        const auto& template_args = decl->getTemplateArgs();
+        assert(template_args.size() == 1);
+
+        const auto type = template_args[0].getAsType().getCanonicalType().getUnqualifiedType();
+
+        for (const auto& base : decl->bases()) {
+            auto annotation = base.getType().getAsString();
+            if (annotation == "fexgen::assume_compatible_data_layout") {
+                compatible_layout_types.insert(type.getTypePtr());
+            } else {
+                throw Error(base.getSourceRange().getBegin(), "Unknown type annotation");
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Determines how each thunk's parameters are laid out by a 32-bit guest.
+     *
+     * This runs after the whole interface was visited so fex_gen_type annotations may appear anywhere.
+     */
+    bool AnalyzeGuestLayouts() try {
+        if (context.getTypeSize(context.VoidPtrTy) != 32) {
+            throw Error(clang::SourceLocation {}, "32-bit guest thunks must be generated with a 32-bit target triple");
+        }
+
+        for (auto& thunk : thunks) {
+            const auto loc = thunk.decl->getBeginLoc();
+
+            if (thunk.is_hostcall) {
+                throw Error(loc, "indirect_guest_calls is not supported for 32-bit guests");
+            }
+
+            for (auto& type : thunk.param_types) {
+                thunk.guest_param_info.push_back(GetGuestTypeInfo(type, loc));
+            }
+
+            if (thunk.is_variadic && thunk.guest_param_info.back().kind == GuestTypeInfo::Kind::IntegerPointer) {
+                throw Error(loc, "uniform_va_type must have the same size on 32-bit guests");
+            }
+
+            thunk.guest_return_info = GetGuestReturnInfo(thunk.return_type, thunk.returns_guest_pointer, loc);
+
+            // Stubs never reach the guest and guest callbacks are opaque to the host
+            for (auto& [cb_idx, cb] : thunk.callbacks) {
+                if (cb.is_stub || cb.is_guest) {
+                    continue;
+                }
+
+                for (auto& type : cb.param_types) {
+                    cb.guest_param_info.push_back(GetGuestTypeInfo(type, loc));
+                    // The guest can't see the host temporary a repacked integer would live in
+                    if (cb.guest_param_info.back().kind == GuestTypeInfo::Kind::IntegerPointer) {
+                        throw Error(loc, "Callback parameters must not point to data with a different layout on 32-bit guests");
+                    }
+                }
+
+                // Pointers returned by the guest point to guest memory, which the host can access
+                cb.guest_return_info = GetGuestReturnInfo(cb.return_type, true, loc);
+            }
+        }
+
+        return true;
+    } catch (ClangDiagnosticAsException& exception) {
+        context.getDiagnostics().Report(exception.first, exception.second);
+        return false;
+    }
+
+private:
+    // Integers that are wider on the host: long, unsigned long and pointer-sized typedefs.
+    // The latter are int/unsigned int on i386, so they can only be told apart by name.
+    static bool IsWidenedInteger(clang::QualType type) {
+        static const std::unordered_set<std::string_view> pointer_sized_typedefs = {
+            "size_t", "ssize_t", "__ssize_t", "ptrdiff_t", "intptr_t", "uintptr_t", "__intptr_t",
+        };
+
+        for (auto typedef_type = type->getAs<clang::TypedefType>(); typedef_type;
+             typedef_type = typedef_type->getDecl()->getUnderlyingType()->getAs<clang::TypedefType>()) {
+            if (pointer_sized_typedefs.count(typedef_type->getDecl()->getName().str())) {
+                return true;
+            }
+        }
+
+        auto builtin = type->getAs<clang::BuiltinType>();
+        return builtin && (builtin->getKind() == clang::BuiltinType::Long || builtin->getKind() == clang::BuiltinType::ULong);
+    }
+
+    static bool HasCompatibleLayout(clang::QualType type) {
+        type = type.getCanonicalType().getUnqualifiedType();
+        if (type->isVoidType() || type->isEnumeralType()) {
+            return true;
+        }
+
+        if (auto builtin = type->getAs<clang::BuiltinType>()) {
+            return !IsWidenedInteger(type) && builtin->getKind() != clang::BuiltinType::LongDouble;
+        }
+
+        return compatible_layout_types.count(type.getTypePtr());
+    }
+
+    GuestTypeInfo GetGuestTypeInfo(clang::QualType type, clang::SourceLocation loc) {
+        if (type->isFunctionPointerType()) {
+            return { GuestTypeInfo::Kind::Pointer };
+        }
+
+        if (type->isPointerType()) {
+            auto pointee = type->getPointeeType();
+            if (IsWidenedInteger(pointee)) {
+                return { GuestTypeInfo::Kind::IntegerPointer, pointee->isSignedIntegerType() };
+            }
+            if (HasCompatibleLayout(pointee)) {
+                return { GuestTypeInfo::Kind::Pointer };
+            }
+            throw Error(loc, "Pointee has a different layout on 32-bit guests, annotate it with fexgen::assume_compatible_data_layout if that's not the case");
+        }
+
+        if (IsWidenedInteger(type)) {
+            return { GuestTypeInfo::Kind::Integer, type->isSignedIntegerType() };
+        }
+
+        if (!HasCompatibleLayout(type)) {
+            throw Error(loc, "Type has a different layout on 32-bit guests, annotate it with fexgen::assume_compatible_data_layout if that's not the case");
+        }
+
+        return {};
+    }
+
+    GuestTypeInfo GetGuestReturnInfo(clang::QualType type, bool returns_guest_pointer, clang::SourceLocation loc) {
+        if (type->isVoidType()) {
+            return {};
+        }
+
+        auto info = GetGuestTypeInfo(type, loc);
+        if (info.kind == GuestTypeInfo::Kind::IntegerPointer) {
+            throw Error(loc, "Returned pointers must point to data with the same layout on 32-bit guests");
+        }
+
+        // Host allocations aren't addressable by 32-bit guests
+        if (info.kind == GuestTypeInfo::Kind::Pointer && !returns_guest_pointer) {
+            throw Error(loc, "Pointer return types require fexgen::returns_guest_pointer for 32-bit guests");
+        }
+
+        return info;
+    }
 };
 
 class ASTConsumer : public clang::ASTConsumer {
 public:
     void HandleTranslationUnit(clang::ASTContext& context) override {
-        ASTVisitor{context}.TraverseDecl(context.getTranslationUnitDecl());
+        ASTVisitor visitor { context };
+        if (visitor.TraverseDecl(context.getTranslationUnitDecl()) && guest_abi == GuestABI::X86_32) {
+            visitor.AnalyzeGuestLayouts();
+        }
     }
 };
 
-GenerateThunkLibsAction::GenerateThunkLibsAction(const std::string& libname_, const OutputFilenames& output_filenames_)
+GenerateThunkLibsAction::GenerateThunkLibsAction(const std::string& libname_, const OutputFilenames& output_filenames_, GuestABI guest_abi_)
     : libfilename(libname_), libname(libname_), output_filenames(output_filenames_) {
     for (auto& c : libname) {
         if (c == '-') {
@@ -400,6 +595,8 @@ GenerateThunkLibsAction::GenerateThunkLibsAction(const std::string& libname_, co
     thunked_api.clear();
     namespaces.clear();
     lib_version = std::nullopt;
+    guest_abi = guest_abi_;
+    compatible_layout_types.clear();
 }
 
 template<typename Fn>
@@ -444,6 +641,32 @@ void GenerateThunkLibsAction::EndSourceFileAction() {
         return ret;
     };
 
+    // Member declaration as laid out by a 32-bit guest, see GuestTypeInfo
+    static auto format_guest_decl = [](clang::QualType type, const GuestTypeInfo& info, const std::string& name) {
+        switch (info.kind) {
+        case GuestTypeInfo::Kind::Integer:
+            return (info.is_signed ? "int32_t " : "uint32_t ") + name;
+        case GuestTypeInfo::Kind::Pointer:
+        case GuestTypeInfo::Kind::IntegerPointer:
+            return "uint32_t " + name;
+        case GuestTypeInfo::Kind::Same:
+            break;
+        }
+        // Builtin typedefs may have a different size on the host, so spell out the type the guest sees
+        if (type->isBuiltinType()) {
+            return format_decl(type.getCanonicalType().getUnqualifiedType(), name);
+        }
+        return format_decl(type.getUnqualifiedType(), name);
+    };
+
+    auto format_guest_struct_members = [](const FunctionParams& params, const char* indent) {
+        std::string ret;
+        for (std::size_t idx = 0; idx < params.param_types.size(); ++idx) {
+            ret += indent + format_guest_decl(params.param_types[idx], params.guest_param_info[idx], "a_" + std::to_string(idx)) + ";\n";
+        }
+        return ret;
+    };
+
     auto format_function_params = [](const FunctionParams& params) {
         std::string ret;
         for (std::size_t idx = 0; idx < params.param_types.size(); ++idx) {
@@ -567,15 +790,21 @@ void GenerateThunkLibsAction::EndSourceFileAction() {
     if (!output_filenames.function_unpacks.empty()) {
         std::ofstream file(output_filenames.function_unpacks);
 
+        const bool guest32 = (guest_abi == GuestABI::X86_32);
+
         file << "extern \"C\" {\n";
+        if (guest32) {
+            // i386 only aligns 8-byte members to 4 bytes
+            file << "#pragma pack(push, 4)\n";
+        }
         for (auto& thunk : thunks) {
             const auto& function_name = thunk.function_name;
             bool is_void = thunk.return_type->isVoidType();
 
             file << "struct fexfn_packed_args_" << libname << "_" << function_name << " {\n";
-            file << format_struct_members(thunk, "  ");
+            file << (guest32 ? format_guest_struct_members(thunk, "  ") : format_struct_members(thunk, "  "));
             if (!is_void) {
-                file << "  " << format_decl(thunk.return_type, "rv") << ";\n";
+                file << "  " << (guest32 ? format_guest_decl(thunk.return_type, thunk.guest_return_info, "rv") : format_decl(thunk.return_type, "rv")) << ";\n";
             } else if (thunk.param_types.size() == 0) {
                 // Avoid "empty struct has size 0 in C, size 1 in C++" warning
                 file << "    char force_nonempty;\n";
@@ -608,26 +837,72 @@ void GenerateThunkLibsAction::EndSourceFileAction() {
             }
 
             file << "static void fexfn_unpack_" << libname << "_" << function_name << "(fexfn_packed_args_" << libname << "_" << function_name << "* args) {\n";
-            file << (is_void ? "  " : "  args->rv = ") << function_to_call << "(";
+            if (guest32) {
+                // Guest longs are 32-bit, so pointers to them are repacked through a host temporary
+                for (std::size_t idx = 0; idx < thunk.param_types.size(); ++idx) {
+                    if (thunk.guest_param_info[idx].kind != GuestTypeInfo::Kind::IntegerPointer) {
+                        continue;
+                    }
+                    auto pointee = thunk.param_types[idx]->getPointeeType();
+                    auto arg = "a_" + std::to_string(idx);
+                    file << "  auto " << arg << "_guest = reinterpret_cast<" << (thunk.guest_param_info[idx].is_signed ? "int32_t" : "uint32_t")
+                         << "*>(uintptr_t { args->" << arg << " });\n";
+                    file << "  " << pointee.getUnqualifiedType().getAsString() << " " << arg << "_host = " << arg << "_guest ? *" << arg << "_guest : 0;\n";
+                }
+            }
+
+            std::string return_value_prefix = "  args->rv = ";
+            std::string return_value_suffix;
+            if (guest32 && thunk.guest_return_info.kind == GuestTypeInfo::Kind::Pointer) {
+                return_value_prefix += "static_cast<uint32_t>(reinterpret_cast<uintptr_t>(";
+                return_value_suffix = "))";
+            } else if (guest32 && thunk.guest_return_info.kind == GuestTypeInfo::Kind::Integer) {
+                return_value_prefix += thunk.guest_return_info.is_signed ? "static_cast<int32_t>(" : "static_cast<uint32_t>(";
+                return_value_suffix = ")";
+            }
+
+            file << (is_void ? "  " : return_value_prefix) << function_to_call << "(";
             {
                 auto format_param = [&](std::size_t idx) {
                     auto cb = thunk.callbacks.find(idx);
+                    auto arg = "args->a_" + std::to_string(idx);
+                    if (guest32 && thunk.guest_param_info[idx].kind == GuestTypeInfo::Kind::Pointer) {
+                        arg = "reinterpret_cast<" + thunk.param_types[idx].getAsString() + ">(uintptr_t { " + arg + " })";
+                    } else if (guest32 && thunk.guest_param_info[idx].kind == GuestTypeInfo::Kind::IntegerPointer) {
+                        arg = "a_" + std::to_string(idx) + "_guest ? &a_" + std::to_string(idx) + "_host : nullptr";
+                    }
+
                     if (cb != thunk.callbacks.end() && cb->second.is_stub) {
                         bool is_first_cb = (cb->first == thunk.callbacks.begin()->first);
                         return "fexfn_unpack_" + get_callback_name(function_name, cb->first, is_first_cb) + "_stub";
                     } else if (cb != thunk.callbacks.end() && cb->second.is_guest) {
-                        return "fex_guest_function_ptr { args->a_" + std::to_string(idx) + " }";
+                        return "fex_guest_function_ptr { " + arg + " }";
                     } else {
-                        return "args->a_" + std::to_string(idx);
+                        return arg;
                     }
                 };
 
                 file << format_function_args(args, format_param);
             }
-            file << ");\n";
+            file << ")" << (is_void ? "" : return_value_suffix) << ";\n";
+
+            if (guest32) {
+                for (std::size_t idx = 0; idx < thunk.param_types.size(); ++idx) {
+                    if (thunk.guest_param_info[idx].kind != GuestTypeInfo::Kind::IntegerPointer ||
+                        thunk.param_types[idx]->getPointeeType().isConstQualified()) {
+                        continue;
+                    }
+                    auto arg = "a_" + std::to_string(idx);
+                    file << "  if (" << arg << "_guest) { *" << arg << "_guest = static_cast<" << (thunk.guest_param_info[idx].is_signed ? "int32_t" : "uint32_t")
+                         << ">(" << arg << "_host); }\n";
+                }
+            }
             file << "}\n";
         }
 
+        if (guest32) {
+            file << "#pragma pack(pop)\n";
+        }
         file << "}\n";
     }
 
@@ -697,6 +972,85 @@ void GenerateThunkLibsAction::EndSourceFileAction() {
         }
     }
 
+    if (!output_filenames.callback_packs.empty()) {
+        std::ofstream file(output_filenames.callback_packs);
+
+        const bool guest32 = (guest_abi == GuestABI::X86_32);
+
+        if (guest32) {
+            file << "#pragma pack(push, 4)\n";
+        }
+        for (auto& thunk : thunks) {
+            for (const auto& [cb_idx, cb] : thunk.callbacks) {
+                if (cb.is_stub || cb.is_guest) {
+                    continue;
+                }
+
+                bool is_void = cb.return_type->isVoidType();
+                bool is_first_cb = (cb_idx == thunk.callbacks.begin()->first);
+                auto cb_function_name = thunk.GetOriginalFunctionName() + "CB" + (is_first_cb ? "" : std::to_string(cb_idx));
+
+                // Arguments in the layout the guest side unpacker reads them in
+                file << "struct fexfn_packed_args_" << libname << "_" << cb_function_name << " {\n";
+                file << (guest32 ? format_guest_struct_members(cb, "  ") : format_struct_members(cb, "  "));
+                if (!is_void) {
+                    file << "  " << (guest32 ? format_guest_decl(cb.return_type, cb.guest_return_info, "rv") : format_decl(cb.return_type, "rv")) << ";\n";
+                } else if (cb.param_types.size() == 0) {
+                    file << "  char force_nonempty;\n";
+                }
+                file << "};\n";
+            }
+        }
+        if (guest32) {
+            file << "#pragma pack(pop)\n";
+        }
+
+        for (auto& thunk : thunks) {
+            for (const auto& [cb_idx, cb] : thunk.callbacks) {
+                if (cb.is_stub || cb.is_guest) {
+                    continue;
+                }
+
+                bool is_void = cb.return_type->isVoidType();
+                bool is_first_cb = (cb_idx == thunk.callbacks.begin()->first);
+                auto cb_function_name = thunk.GetOriginalFunctionName() + "CB" + (is_first_cb ? "" : std::to_string(cb_idx));
+
+                file << "static auto fexfn_pack_" << libname << "_" << cb_function_name << "(uintptr_t guest_cb";
+                for (std::size_t idx = 0; idx < cb.param_types.size(); ++idx) {
+                    file << ", " << format_decl(cb.param_types[idx], "a_" + std::to_string(idx));
+                }
+                file << ") -> " << cb.return_type.getAsString() << " {\n";
+                file << "  fexfn_packed_args_" << libname << "_" << cb_function_name << " args;\n";
+                for (std::size_t idx = 0; idx < cb.param_types.size(); ++idx) {
+                    auto arg = "a_" + std::to_string(idx);
+                    if (guest32 && cb.guest_param_info[idx].kind == GuestTypeInfo::Kind::Pointer) {
+                        // Only guest memory is addressable by the guest, the host library must pass back guest pointers
+                        arg = "static_cast<uint32_t>(reinterpret_cast<uintptr_t>(" + arg + "))";
+                    } else if (guest32 && cb.guest_param_info[idx].kind == GuestTypeInfo::Kind::Integer) {
+                        arg = (cb.guest_param_info[idx].is_signed ? "static_cast<int32_t>(" : "static_cast<uint32_t>(") + arg + ")";
+                    }
+                    file << "  args.a_" << idx << " = " << arg << ";\n";
+                }
+
+                auto unpacker = "callback_unpacks->" + libname + "_" + cb_function_name;
+                if (guest32) {
+                    // FEX copies the arguments to the guest stack for the duration of the call
+                    file << "  GuestCallbackArgs guest_args { &args, sizeof(args) };\n";
+                    file << "  call_guest(" << unpacker << ", reinterpret_cast<void*>(guest_cb), &guest_args);\n";
+                } else {
+                    file << "  call_guest(" << unpacker << ", reinterpret_cast<void*>(guest_cb), &args);\n";
+                }
+
+                if (guest32 && cb.guest_return_info.kind == GuestTypeInfo::Kind::Pointer) {
+                    file << "  return reinterpret_cast<" << cb.return_type.getAsString() << ">(uintptr_t { args.rv });\n";
+                } else if (!is_void) {
+                    file << "  return args.rv;\n";
+                }
+                file << "}\n";
+            }
+        }
+    }
+
     if (!output_filenames.callback_typedefs.empty()) {
         std::ofstream file(output_filenames.callback_typedefs);
 
@@ -727,7 +1081,10 @@ void GenerateThunkLibsAction::EndSourceFileAction() {
                 bool is_void = cb.return_type->isVoidType();
                 bool is_first_cb = (cb_idx == thunk.callbacks.begin()->first);
                 auto cb_function_name = thunk.function_name + "CB" + (is_first_cb ? "" : std::to_string(cb_idx));
-                file << "static void fexfn_unpack_" << libname << "_" << cb_function_name << "(uintptr_t cb, void* argsv) {\n";
+                // FEX enters the unpacker with the callback and packed arguments in the first two argument registers.
+                // i386 passes arguments on the stack by default, fastcall takes them in ecx and edx instead.
+                file << "static void " << (guest_abi == GuestABI::X86_32 ? "__attribute__((fastcall)) " : "")
+                     << "fexfn_unpack_" << libname << "_" << cb_function_name << "(uintptr_t cb, void* argsv) {\n";
                 file << "  typedef " << cb.return_type.getAsString() << " fn_t (" << format_function_params(cb) << ");\n";
                 file << "  auto callback = reinterpret_cast<fn_t*>(cb);\n";
                 file << "  struct arg_t {\n";
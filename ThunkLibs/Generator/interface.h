@@ -10,6 +10,7 @@ struct OutputFilenames {
     std::string tab_function_unpacks;
     std::string ldr;
     std::string ldr_ptrs;
+    std::string callback_packs;
 
     // Guest
     std::string thunks;
@@ -26,9 +27,16 @@ struct OutputFilenames {
     std::string symbol_list;
 };
 
+// ABI of the guest the thunks are generated for, the host is always a 64-bit ABI
+enum class GuestABI {
+    X86_64,
+    // i386: host code is generated against the guest's data layout and repacks arguments
+    X86_32,
+};
+
 class GenerateThunkLibsAction : public clang::ASTFrontendAction {
 public:
-    GenerateThunkLibsAction(const std::string& libname, const OutputFilenames&);
+    GenerateThunkLibsAction(const std::string& libname, const OutputFilenames&, GuestABI);
 
     void EndSourceFileAction() override;
 
@@ -42,15 +50,16 @@ private:
 
 class GenerateThunkLibsActionFactory : public clang::tooling::FrontendActionFactory {
 public:
-    GenerateThunkLibsActionFactory(std::string_view libname_, OutputFilenames output_filenames_)
-        : libname(std::move(libname_)), output_filenames(std::move(output_filenames_)) {
+    GenerateThunkLibsActionFactory(std::string_view libname_, OutputFilenames output_filenames_, GuestABI guest_abi_ = GuestABI::X86_64)
+        : libname(std::move(libname_)), output_filenames(std::move(output_filenames_)), guest_abi(guest_abi_) {
     }
 
     std::unique_ptr<clang::FrontendAction> create() override {
-        return std::make_unique<GenerateThunkLibsAction>(libname, output_filenames);
+        return std::make_unique<GenerateThunkLibsAction>(libname, output_filenames, guest_abi);
     }
 
 private:
     std::string libname;
     OutputFilenames output_filenames;
+    GuestABI guest_abi;
 };
@@ -3,13 +3,14 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 
 #include "interface.h"
 
 using namespace clang::tooling;
 
 void print_usage(const char* program_name) {
-    std::cerr << "Usage: " << program_name << " <filename> <libname> <gen_target> <output_filename> -- <clang_flags>\n";
+    std::cerr << "Usage: " << program_name << " <filename> <libname> [-guest_abi x86_64|x86_32] <gen_target> <output_filename> -- <clang_flags>\n";
 }
 
 int main(int argc, char* argv[]) {
@@ -34,10 +35,22 @@ int main(int argc, char* argv[]) {
 
     // Iterate over generator targets (remaining arguments up to "--" separator)
     OutputFilenames output_filenames;
+    GuestABI guest_abi = GuestABI::X86_64;
     while (arg < last_internal_arg) {
         auto target = std::string { *arg++ };
         auto out_filename = *arg++;
-        if (target == "-function_unpacks") {
+        if (target == "-guest_abi") {
+            // Not an output, the clang flags must select a matching target triple
+            const std::string_view abi = out_filename;
+            if (abi == "x86_64") {
+                guest_abi = GuestABI::X86_64;
+            } else if (abi == "x86_32") {
+                guest_abi = GuestABI::X86_32;
+            } else {
+                std::cerr << "Unrecognized guest ABI \"" << abi << "\"\n";
+                return EXIT_FAILURE;
+            }
+        } else if (target == "-function_unpacks") {
             output_filenames.function_unpacks = out_filename;
         } else if (target == "-tab_function_unpacks") {
             output_filenames.tab_function_unpacks = out_filename;
@@ -45,6 +58,8 @@ int main(int argc, char* argv[]) {
             output_filenames.ldr = out_filename;
         } else if (target == "-ldr_ptrs") {
             output_filenames.ldr_ptrs = out_filename;
+        } else if (target == "-callback_packs") {
+            output_filenames.callback_packs = out_filename;
         } else if (target == "-thunks") {
             output_filenames.thunks = out_filename;
         } else if (target == "-function_packs") {
@@ -70,5 +85,5 @@ int main(int argc, char* argv[]) {
     }
 
     ClangTool Tool(*compile_db, { filename });
-    return Tool.run(std::make_unique<GenerateThunkLibsActionFactory>(std::move(libname), std::move(output_filenames)).get());
+    return Tool.run(std::make_unique<GenerateThunkLibsActionFactory>(std::move(libname), std::move(output_filenames), guest_abi).get());
 }
@@ -6,6 +6,9 @@ struct custom_guest_entrypoint {};
 struct generate_guest_symtable {};
 struct indirect_guest_calls {};
 
+// Used with fex_gen_type: the type is laid out identically by 32-bit guests and the host
+struct assume_compatible_data_layout {};
+
 struct callback_annotation_base {
     // Prevent annotating multiple callback strategies
     bool prevent_multiple;
@@ -144,7 +144,10 @@ struct PackedArguments<void, A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A
 // fexfn_pack_* functions generated for global API functions.
 template<auto Thunk, typename Result, typename... Args>
 inline Result CallHostThunkFromRuntimePointer(Args... args) {
-#ifndef _M_ARM_64
+#if defined(__i386__)
+    static_assert(sizeof(Result*) == 0, "Host function pointers are not supported for 32-bit guests");
+    uintptr_t host_addr = 0;
+#elif !defined(_M_ARM_64)
     uintptr_t host_addr;
     asm("mov %%r11, %0" : "=r" (host_addr));
 #else
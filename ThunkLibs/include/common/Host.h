@@ -28,6 +28,17 @@ typedef void fex_call_callback_t(uintptr_t callback, void *arg0, void* arg1);
 
 static fex_call_callback_t* call_guest;
 
+/**
+ * Packed callback arguments as handed to call_guest for 32-bit guests.
+ *
+ * Host memory generally isn't addressable by the guest, so FEX copies Size
+ * bytes from Data to the guest stack for the callback and back afterwards.
+ */
+struct GuestCallbackArgs {
+    void* Data;
+    uint32_t Size;
+};
+
 /**
  * Opaque wrapper around a guest function pointer.
  *
@@ -0,0 +1,15 @@
+/*
+$info$
+tags: thunklibs|z
+$end_info$
+*/
+
+#include <zlib.h>
+
+#include "common/Guest.h"
+
+#include "thunks.inl"
+#include "function_packs.inl"
+#include "function_packs_public.inl"
+
+LOAD_LIB(libz)
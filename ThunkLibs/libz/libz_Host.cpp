@@ -0,0 +1,24 @@
+/*
+$info$
+tags: thunklibs|z
+$end_info$
+*/
+
+#include <stdio.h>
+
+#include <zlib.h>
+
+#include "common/Host.h"
+#include <dlfcn.h>
+
+#include "ldr_ptrs.inl"
+#include "function_unpacks.inl"
+
+static ExportEntry exports[] = {
+    #include "tab_function_unpacks.inl"
+    { nullptr, nullptr }
+};
+
+#include "ldr.inl"
+
+EXPORTS(libz)
@@ -0,0 +1,17 @@
+#include <common/GeneratorInterface.h>
+
+#include <zlib.h>
+
+template<auto>
+struct fex_gen_config {
+    unsigned version = 1;
+};
+
+// Only the one-shot API for now, z_stream holds pointers and needs a 32-bit guest layout first
+template<> struct fex_gen_config<compress> {};
+template<> struct fex_gen_config<compress2> {};
+template<> struct fex_gen_config<compressBound> {};
+template<> struct fex_gen_config<uncompress> {};
+template<> struct fex_gen_config<crc32> {};
+template<> struct fex_gen_config<adler32> {};
+template<> struct fex_gen_config<zlibCompileFlags> {};
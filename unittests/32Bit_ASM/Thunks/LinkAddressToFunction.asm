@@ -0,0 +1,33 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x41424344"
+  },
+  "Mode": "32BIT"
+}
+%endif
+
+; Calls the fex:link_address_to_function thunk with the 32-bit guest ABI,
+; the only argument is a pointer to the packed {original_callee, target_addr} pair on the stack
+push target
+push original
+push esp
+call thunk_link
+add esp, 12
+
+; Branches to original now end up in target
+call original
+hlt
+
+thunk_link:
+db 0x0f, 0x3f
+db 0xe6, 0xa8, 0xec, 0x1c, 0x7b, 0x74, 0x35, 0x27, 0xe9, 0x4f, 0x5b, 0x6e, 0x2d, 0xc9, 0xa0, 0x27
+db 0xd6, 0x1f, 0x2b, 0x87, 0x8f, 0x2d, 0x35, 0x50, 0xea, 0x16, 0xb8, 0xc4, 0x5e, 0x42, 0xfd, 0x77
+
+original:
+mov eax, 1
+ret
+
+target:
+mov eax, 0x41424344
+ret
@@ -0,0 +1,55 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "R8": "0xa410ffa2a3ef07a2",
+    "R9": "0xd12a7d7439d9932b"
+  }
+}
+%endif
+
+; Differential test, expected values were generated by running the same sequence on a host with SSE4.2.
+; Runs every imm8 control value (bits [6:0]) against each input pair.
+; R8 accumulates the ECX results, R9 accumulates the status flags.
+
+%macro accumulate 0
+  rol r8, 5
+  xor r8, rcx
+  pushfq
+  pop rsi
+  and rsi, 0x8d5
+  rol r9, 3
+  xor r9, rsi
+%endmacro
+
+; LHS index, RHS index, RAX, RDX, control
+%macro compare 5
+  mov rax, %3
+  mov rdx, %4
+  movaps xmm1, [rbx + 16 * %1]
+  pcmpestri xmm1, [rbx + 16 * %2], %5
+  accumulate
+%endmacro
+
+lea rbx, [rel .data]
+
+mov r8, 0
+mov r9, 0
+
+%assign ctrl 0
+%rep 128
+  compare 0, 1, 6, 13, ctrl
+  compare 2, 3, -3, 20, ctrl
+  compare 4, 5, 16, 16, ctrl
+%assign ctrl ctrl+1
+%endrep
+
+hlt
+
+align 16
+.data:
+db 0x61, 0x7a, 0x30, 0x39, 0x41, 0x5a, 0x5f, 0x5f, 0x68, 0x65, 0x6c, 0x6c, 0x6f, 0x00, 0x77, 0x6f
+db 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x77, 0x6f, 0x72, 0x6c, 0x64, 0x21, 0x20, 0x61, 0x7a
+db 0x77, 0x6f, 0x72, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+db 0x68, 0x65, 0x6c, 0x6c, 0x6f, 0x77, 0x6f, 0x72, 0x6c, 0x64, 0x5f, 0x77, 0x6f, 0x72, 0x6c, 0x64
+db 0x7f, 0x80, 0xff, 0x01, 0x00, 0x10, 0x80, 0x7f, 0xfe, 0x02, 0x81, 0x7e, 0x33, 0xcc, 0x80, 0xff
+db 0x80, 0xff, 0x7f, 0x01, 0x10, 0x80, 0x00, 0x7f, 0x02, 0xfe, 0x7e, 0x81, 0xcc, 0x33, 0xff, 0x80
@@ -0,0 +1,71 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "R8":  "0x02aa0e4050772842",
+    "R9":  "0x0000020920020924",
+    "R10": "0xe0e7f001f4d0e3ef"
+  }
+}
+%endif
+
+; Differential test, expected values were generated by running the same sequence on a host with SSE4.2.
+; Checks that PCMPESTRI/PCMPESTRM only use RAX/RDX as lengths with REX.W, otherwise EAX/EDX are used.
+; Without REX.W the lengths are 5 and 3, with REX.W both saturate to 16.
+; R8 accumulates ECX, R9 accumulates the status flags, R10 accumulates XMM0.
+
+; REX prefix, control
+%macro compare 2
+  mov rax, 0x100000005
+  mov rdx, 0xFFFFFFFF00000003
+  movaps xmm1, [rbx + 16 * 0]
+  movaps xmm2, [rbx + 16 * 1]
+
+  ; pcmpestri xmm1, xmm2, %2
+  db 0x66, %1, 0x0F, 0x3A, 0x61, 0xCA, %2
+  rol r8, 5
+  xor r8, rcx
+  pushfq
+  pop rsi
+  and rsi, 0x8d5
+  rol r9, 3
+  xor r9, rsi
+
+  ; pcmpestrm xmm1, xmm2, %2
+  db 0x66, %1, 0x0F, 0x3A, 0x60, 0xCA, %2
+  movq rax, xmm0
+  pextrq rdi, xmm0, 1
+  rol r10, 5
+  xor r10, rax
+  rol r10, 5
+  xor r10, rdi
+%endmacro
+
+lea rbx, [rel .data]
+
+mov r8, 0
+mov r9, 0
+mov r10, 0
+
+compare 0x40, 0x00
+compare 0x48, 0x00
+compare 0x40, 0x04
+compare 0x48, 0x04
+compare 0x40, 0x08
+compare 0x48, 0x08
+compare 0x40, 0x0C
+compare 0x48, 0x0C
+compare 0x40, 0x01
+compare 0x48, 0x01
+compare 0x40, 0x0D
+compare 0x48, 0x0D
+compare 0x40, 0x48
+compare 0x48, 0x48
+compare 0x40, 0x3A
+compare 0x48, 0x3A
+
+hlt
+
+align 16
+.data:
+db 0x61, 0x7a, 0x30, 0x39, 0x41, 0x5a, 0x5f, 0x5f, 0x68, 0x65, 0x6c, 0x6c, 0x6f, 0x00, 0x77, 0x6f
+db 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x77, 0x6f, 0x72, 0x6c, 0x64, 0x21, 0x20, 0x61, 0x7a
@@ -0,0 +1,58 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "R8": "0x87878661e1e1e007",
+    "R9": "0x3e12c46311f29da3",
+    "XMM0": ["0xffffffffffffffff", "0xffffffffffffffff"]
+  }
+}
+%endif
+
+; Differential test, expected values were generated by running the same sequence on a host with SSE4.2.
+; Runs every imm8 control value (bits [6:0]) against each input pair.
+; R8 accumulates the XMM0 results, R9 accumulates the status flags.
+
+%macro accumulate 0
+  movq rax, xmm0
+  pextrq rdi, xmm0, 1
+  rol r8, 5
+  xor r8, rax
+  rol r8, 5
+  xor r8, rdi
+  pushfq
+  pop rsi
+  and rsi, 0x8d5
+  rol r9, 3
+  xor r9, rsi
+%endmacro
+
+; LHS index, RHS index, control
+%macro compare 3
+  movaps xmm1, [rbx + 16 * %1]
+  pcmpistrm xmm1, [rbx + 16 * %2], %3
+  accumulate
+%endmacro
+
+lea rbx, [rel .data]
+
+mov r8, 0
+mov r9, 0
+
+%assign ctrl 0
+%rep 128
+  compare 0, 1, ctrl
+  compare 2, 3, ctrl
+  compare 4, 5, ctrl
+%assign ctrl ctrl+1
+%endrep
+
+hlt
+
+align 16
+.data:
+db 0x61, 0x7a, 0x30, 0x39, 0x41, 0x5a, 0x5f, 0x5f, 0x68, 0x65, 0x6c, 0x6c, 0x6f, 0x00, 0x77, 0x6f
+db 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x77, 0x6f, 0x72, 0x6c, 0x64, 0x21, 0x20, 0x61, 0x7a
+db 0x77, 0x6f, 0x72, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+db 0x68, 0x65, 0x6c, 0x6c, 0x6f, 0x77, 0x6f, 0x72, 0x6c, 0x64, 0x5f, 0x77, 0x6f, 0x72, 0x6c, 0x64
+db 0x7f, 0x80, 0xff, 0x01, 0x00, 0x10, 0x80, 0x7f, 0xfe, 0x02, 0x81, 0x7e, 0x33, 0xcc, 0x80, 0xff
+db 0x80, 0xff, 0x7f, 0x01, 0x10, 0x80, 0x00, 0x7f, 0x02, 0xfe, 0x7e, 0x81, 0xcc, 0x33, 0xff, 0x80
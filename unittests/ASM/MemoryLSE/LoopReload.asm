@@ -0,0 +1,25 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x10",
+    "RBX": "0x10"
+  }
+}
+%endif
+
+mov rdx, 0xe0000000
+mov qword [rdx], 0
+xor ebx, ebx
+
+; The load at the top of the loop must observe the store from the previous iteration
+loop_top:
+mov rax, [rdx]
+inc rax
+mov [rdx], rax
+inc rbx
+cmp rbx, 0x10
+jne loop_top
+
+mov rax, [rdx]
+
+hlt
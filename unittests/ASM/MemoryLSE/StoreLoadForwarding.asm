@@ -0,0 +1,53 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RBX": "0x4142434445464748",
+    "RCX": "0x45464748",
+    "RDI": "0x88",
+    "R9":  "0x2",
+    "R10": "0xff00",
+    "R12": "0x33",
+    "R13": "0x55667788"
+  }
+}
+%endif
+
+mov rdx, 0xe0000000
+
+; Full width forward
+mov rax, 0x4142434445464748
+mov [rdx], rax
+mov rbx, [rdx]
+
+; Smaller load of the same address can't forward
+mov ecx, dword [rdx]
+
+; Byte store implicitly truncates, forwarded value must be zero extended
+mov rsi, 0x1122334455667788
+mov [rdx + 8], sil
+movzx edi, byte [rdx + 8]
+
+; 32-bit store and load
+mov [rdx + 40], esi
+mov r13d, [rdx + 40]
+
+; Store through a different base register aliases
+lea r8, [rdx + 16]
+mov qword [rdx + 16], 1
+mov qword [r8], 2
+mov r9, [rdx + 16]
+
+; Partial overlap with an earlier store
+mov qword [rdx + 24], 0
+mov byte [rdx + 25], 0xff
+mov r10, [rdx + 24]
+
+; Forward in to a successor block
+mov qword [rdx + 32], 0x33
+xor r12, r12
+cmp r10, 0
+jz skip
+mov r12, [rdx + 32]
+skip:
+
+hlt
@@ -0,0 +1,60 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x12C",
+    "RBX": "0x64",
+    "RCX": "0x64",
+    "RDX": "0x32",
+    "RSI": "0x32",
+    "R12": "0x64",
+    "R13": "0x1356"
+  }
+}
+%endif
+
+; Misaligned atomics that run many times, so the sites run both the SIGBUS path
+; and whatever they get backpatched to afterwards, on misaligned and aligned addresses
+mov r15, 0xe0000000
+
+mov rax, 0
+mov [r15 + 0x01], rax
+mov [r15 + 0x11], eax
+mov [r15 + 0x21], ax
+mov [r15 + 0x40], rax
+mov [r15 + 0x51], rax
+
+mov r14, 0
+mov r13, 0
+mov r12, 0
+
+loop:
+lock add qword [r15 + 0x01], 3
+
+mov edx, 1
+lock xadd dword [r15 + 0x11], edx
+add r13, rdx
+
+; Swaps in i + 1 if the word still holds i
+mov rax, r14
+lea rbx, [r14 + 1]
+lock cmpxchg word [r15 + 0x21], bx
+setz cl
+movzx ecx, cl
+add r12, rcx
+
+; Alternates between an aligned and a misaligned address from the same site
+mov rdi, r14
+and rdi, 1
+imul rdi, rdi, 0x11
+lock inc qword [r15 + rdi + 0x40]
+
+inc r14
+cmp r14, 100
+jne loop
+
+mov rax, [r15 + 0x01]
+mov ebx, [r15 + 0x11]
+movzx ecx, word [r15 + 0x21]
+mov rdx, [r15 + 0x40]
+mov rsi, [r15 + 0x51]
+hlt
@@ -0,0 +1,45 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x91a2b3c480",
+    "RCX": "0x8",
+    "R9":  "0x1234567890",
+    "R10": "0x1000",
+    "R11": "0x4",
+    "R12": "0x4"
+  }
+}
+%endif
+
+mov rdx, 0xe0000000
+mov rsi, 0x100
+xor eax, eax
+xor ecx, ecx
+
+; Address base and constant are invariant, rcx and rax are written every iteration
+loop_top:
+lea rbx, [rdx + rsi]
+mov r8, 0x1234567890
+mov [rbx + rcx * 8], r8
+add rax, [rbx + rcx * 8]
+inc rcx
+cmp rcx, 8
+jne loop_top
+
+mov r9, [rdx + 0x100 + 56]
+
+; Nested loops, rsi stays invariant through both
+xor r10, r10
+xor r11, r11
+outer:
+xor r12, r12
+inner:
+add r10, rsi
+inc r12
+cmp r12, 4
+jne inner
+inc r11
+cmp r11, 4
+jne outer
+
+hlt
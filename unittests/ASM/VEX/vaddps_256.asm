@@ -0,0 +1,38 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "XMM2":  ["0x4040000040000000", "0x40a0000040800000"],
+    "YMMH2": ["0x40e0000040c00000", "0x4110000041000000"],
+    "XMM3":  ["0x3f8000003f800000", "0x3f8000003f800000"],
+    "YMMH3": ["0x3f8000003f800000", "0x3f8000003f800000"]
+  },
+  "Env": { "FEX_ENABLEAVX" : "1" }
+}
+%endif
+
+mov rdx, 0xe0000000
+
+; 1.0 through 8.0
+mov rax, 0x400000003f800000
+mov [rdx + 8 * 0], rax
+mov rax, 0x4080000040400000
+mov [rdx + 8 * 1], rax
+mov rax, 0x40c0000040a00000
+mov [rdx + 8 * 2], rax
+mov rax, 0x4100000040e00000
+mov [rdx + 8 * 3], rax
+
+; 1.0 everywhere
+mov rax, 0x3f8000003f800000
+mov [rdx + 8 * 4], rax
+mov [rdx + 8 * 5], rax
+mov [rdx + 8 * 6], rax
+mov [rdx + 8 * 7], rax
+
+vmovaps ymm0, [rdx + 8 * 0]
+vmovups ymm1, [rdx + 8 * 4]
+
+vaddps ymm2, ymm0, ymm1
+vdivps ymm3, ymm0, ymm0
+
+hlt
@@ -0,0 +1,41 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "XMM0":  ["0x3f8000003f800000", "0x3f8000003f800000"],
+    "YMMH0": ["0x3f8000003f800000", "0x3f8000003f800000"],
+    "XMM1":  ["0x8080808080808080", "0x8080808080808080"],
+    "YMMH1": ["0x8080808080808080", "0x8080808080808080"],
+    "XMM2":  ["0x4142434445464748", "0x5152535455565758"],
+    "YMMH2": ["0x4142434445464748", "0x5152535455565758"],
+    "XMM3":  ["0x3f8000003f800000", "0x3f8000003f800000"],
+    "YMMH3": ["0x0", "0x0"],
+    "RAX":   "0xFFFFFFFF",
+    "RBX":   "0xFFFF"
+  },
+  "Env": { "FEX_ENABLEAVX" : "1" }
+}
+%endif
+
+mov rdx, 0xe0000000
+
+mov eax, 0x3f800000
+mov [rdx + 8 * 0], eax
+mov eax, 0x80
+mov [rdx + 8 * 1], eax
+
+mov rax, 0x4142434445464748
+mov [rdx + 8 * 2], rax
+mov rax, 0x5152535455565758
+mov [rdx + 8 * 3], rax
+
+vbroadcastss ymm0, [rdx + 8 * 0]
+vpbroadcastb ymm1, [rdx + 8 * 1]
+vbroadcastf128 ymm2, [rdx + 8 * 2]
+
+; VEX.128 only fills the lower half
+vbroadcastss xmm3, [rdx + 8 * 0]
+
+vpmovmskb eax, ymm1
+vpmovmskb ebx, xmm1
+
+hlt
@@ -0,0 +1,40 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "XMM1":  ["0x2222222222222222", "0x4444444444444444"],
+    "YMMH1": ["0x0", "0x0"],
+    "XMM2":  ["0x1111111111111111", "0x2222222222222222"],
+    "YMMH2": ["0x3333333333333333", "0x4444444444444444"],
+    "XMM3":  ["0x1111111111111111", "0x2222222222222222"],
+    "YMMH3": ["0x0", "0x0"]
+  },
+  "Env": { "FEX_ENABLEAVX" : "1" }
+}
+%endif
+
+mov rdx, 0xe0000000
+
+mov rax, 0x1111111111111111
+mov [rdx + 8 * 0], rax
+mov rax, 0x2222222222222222
+mov [rdx + 8 * 1], rax
+mov rax, 0x3333333333333333
+mov [rdx + 8 * 2], rax
+mov rax, 0x4444444444444444
+mov [rdx + 8 * 3], rax
+
+vmovdqu ymm0, [rdx]
+vmovdqu ymm1, [rdx]
+vmovdqu ymm2, [rdx]
+vmovdqu ymm3, [rdx]
+
+; VEX.128 encoded instructions zero the upper half
+vpaddq xmm1, xmm1, xmm1
+
+; Legacy SSE encoded instructions leave the upper half alone
+pxor xmm2, xmm2
+movdqa xmm2, xmm0
+
+vmovdqa xmm3, xmm0
+
+hlt
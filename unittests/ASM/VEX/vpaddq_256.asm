@@ -0,0 +1,48 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "XMM2":  ["0x1212121212121212", "0x2424242424242424"],
+    "YMMH2": ["0x3636363636363636", "0x4848484848484848"],
+    "XMM3":  ["0x1010101010101010", "0x2020202020202020"],
+    "YMMH3": ["0x3030303030303030", "0x4040404040404040"],
+    "XMM4":  ["0x0", "0x0"],
+    "YMMH4": ["0x0", "0x0"],
+    "XMM5":  ["0x1212121212121212", "0x2424242424242424"],
+    "YMMH5": ["0x3636363636363636", "0x4848484848484848"]
+  },
+  "Env": { "FEX_ENABLEAVX" : "1" }
+}
+%endif
+
+mov rdx, 0xe0000000
+
+mov rax, 0x1111111111111111
+mov [rdx + 8 * 0], rax
+mov rax, 0x2222222222222222
+mov [rdx + 8 * 1], rax
+mov rax, 0x3333333333333333
+mov [rdx + 8 * 2], rax
+mov rax, 0x4444444444444444
+mov [rdx + 8 * 3], rax
+
+mov rax, 0x0101010101010101
+mov [rdx + 8 * 4], rax
+mov rax, 0x0202020202020202
+mov [rdx + 8 * 5], rax
+mov rax, 0x0303030303030303
+mov [rdx + 8 * 6], rax
+mov rax, 0x0404040404040404
+mov [rdx + 8 * 7], rax
+
+vmovdqu ymm0, [rdx + 8 * 0]
+vmovdqu ymm1, [rdx + 8 * 4]
+
+vpaddq ymm2, ymm0, ymm1
+vpsubq ymm3, ymm0, [rdx + 8 * 4]
+vpxor ymm4, ymm0, ymm0
+
+; Round trip through memory
+vmovdqu [rdx + 8 * 8], ymm2
+vmovdqa ymm5, [rdx + 8 * 8]
+
+hlt
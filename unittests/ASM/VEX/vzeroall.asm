@@ -0,0 +1,29 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "XMM0":  ["0x0", "0x0"],
+    "YMMH0": ["0x0", "0x0"],
+    "XMM15": ["0x0", "0x0"],
+    "YMMH15": ["0x0", "0x0"]
+  },
+  "Env": { "FEX_ENABLEAVX" : "1" }
+}
+%endif
+
+mov rdx, 0xe0000000
+
+mov rax, 0x1111111111111111
+mov [rdx + 8 * 0], rax
+mov rax, 0x2222222222222222
+mov [rdx + 8 * 1], rax
+mov rax, 0x3333333333333333
+mov [rdx + 8 * 2], rax
+mov rax, 0x4444444444444444
+mov [rdx + 8 * 3], rax
+
+vmovdqu ymm0, [rdx]
+vmovdqu ymm15, [rdx]
+
+vzeroall
+
+hlt
@@ -0,0 +1,16 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "RAX": "0x7",
+    "RDX": "0x0"
+  },
+  "Env": { "FEX_ENABLEAVX" : "1" }
+}
+%endif
+
+mov rax, -1
+mov rdx, -1
+xor ecx, ecx
+xgetbv
+
+hlt
@@ -0,0 +1,42 @@
+%ifdef CONFIG
+{
+  "RegData": {
+    "R8":  "0x4142434445464748",
+    "R9":  "0x1112131415161718",
+    "R10": "0x6",
+    "MM0": "0xffffffffffffffff",
+    "XMM0":  ["0x0", "0x0"]
+  },
+  "Env": { "FEX_ENABLEAVX" : "1" }
+}
+%endif
+
+mov rsp, 0xe0000000
+
+; Markers in the x87 area and XSTATE_BV
+mov rax, 0x4142434445464748
+mov qword [rsp + 32], rax
+mov qword [rsp + 512], 0x4
+
+mov rax, 0x1112131415161718
+movq xmm0, rax
+
+; Only request the SSE component
+mov eax, 2
+xor edx, edx
+xsave [rsp]
+
+; x87 area isn't written, XSTATE_BV gets the SSE bit and keeps the AVX bit
+mov r8, qword [rsp + 32]
+mov r9, qword [rsp + 160]
+mov r10, qword [rsp + 512]
+
+; SSE gets its init state since its XSTATE_BV bit is clear, x87 isn't requested so MM0 stays
+mov qword [rsp + 512], 0
+mov rax, -1
+movq mm0, rax
+mov eax, 2
+xor edx, edx
+xrstor [rsp]
+
+hlt
@@ -0,0 +1,43 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; AES-128 encryption of four independent blocks, ten rounds per block per iteration
+mov r15, 2000000
+mov r14, r15
+mov rsi, 0xe0000000
+
+movdqu xmm0, [rsi]
+movdqu xmm1, [rsi + 16]
+movdqu xmm2, [rsi + 32]
+movdqu xmm3, [rsi + 48]
+movdqu xmm4, [rsi + 64]
+movdqu xmm5, [rsi + 80]
+
+aes_loop:
+pxor xmm0, xmm4
+pxor xmm1, xmm4
+pxor xmm2, xmm4
+pxor xmm3, xmm4
+mov ecx, 9
+
+aes_round:
+aesenc xmm0, xmm5
+aesenc xmm1, xmm5
+aesenc xmm2, xmm5
+aesenc xmm3, xmm5
+dec ecx
+jnz aes_round
+
+aesenclast xmm0, xmm4
+aesenclast xmm1, xmm4
+aesenclast xmm2, xmm4
+aesenclast xmm3, xmm4
+
+dec r14
+jnz aes_loop
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
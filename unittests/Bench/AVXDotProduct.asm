@@ -0,0 +1,31 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; 256-bit version of SSEDotProduct
+mov r15, 200000
+mov r14, r15
+mov rsi, 0xe0000000
+mov rdi, 0xe0000400
+
+dot_outer:
+vxorps ymm0, ymm0, ymm0
+xor ecx, ecx
+
+dot_loop:
+vmovaps ymm1, [rsi + rcx]
+vmulps ymm1, ymm1, [rdi + rcx]
+vaddps ymm0, ymm0, ymm1
+add ecx, 32
+cmp ecx, 1024
+jne dot_loop
+
+dec r14
+jnz dot_outer
+
+vzeroupper
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
@@ -0,0 +1,42 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; 256-bit version of SSEMatMul, one row of B fits in a single ymm register
+mov r15, 50000
+mov r14, r15
+mov rsi, 0xe0000000
+mov rdi, 0xe0000100
+mov rdx, 0xe0000200
+
+matmul_outer:
+xor r8d, r8d
+
+row_loop:
+vxorps ymm0, ymm0, ymm0
+xor ecx, ecx
+xor r9d, r9d
+
+k_loop:
+vbroadcastss ymm2, [rsi + r8 + rcx]
+vmulps ymm3, ymm2, [rdi + r9]
+vaddps ymm0, ymm0, ymm3
+add ecx, 4
+add r9d, 32
+cmp ecx, 32
+jne k_loop
+
+vmovaps [rdx + r8], ymm0
+add r8d, 32
+cmp r8d, 256
+jne row_loop
+
+dec r14
+jnz matmul_outer
+
+vzeroupper
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
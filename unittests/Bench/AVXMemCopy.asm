@@ -0,0 +1,31 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; 256-bit vector copy of 16KB inside of the scratch memory, compare against MemCopy
+mov r15, 100000
+mov r14, r15
+mov rsi, 0xe0000000
+mov rdi, 0xe0004000
+
+copy_outer:
+xor ecx, ecx
+
+copy_loop:
+vmovdqu ymm0, [rsi + rcx]
+vmovdqu ymm1, [rsi + rcx + 32]
+vmovdqu [rdi + rcx], ymm0
+vmovdqu [rdi + rcx + 32], ymm1
+add ecx, 64
+cmp ecx, 16384
+jne copy_loop
+
+dec r14
+jnz copy_outer
+
+vzeroupper
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
@@ -0,0 +1,32 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; 256-bit version of SSEVector, streams over the same 1KB of the scratch memory
+mov r15, 200000
+mov r14, r15
+mov rdi, 0xe0000000
+vpxor ymm0, ymm0, ymm0
+
+vector_outer:
+xor ecx, ecx
+
+vector_loop:
+vmovaps ymm1, [rdi + rcx]
+vpaddd ymm0, ymm0, ymm1
+vmulps ymm1, ymm1, ymm1
+vaddps ymm1, ymm1, ymm0
+vmovaps [rdi + rcx], ymm1
+add ecx, 32
+cmp ecx, 1024
+jne vector_loop
+
+dec r14
+jnz vector_outer
+
+vzeroupper
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
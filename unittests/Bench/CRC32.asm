@@ -0,0 +1,26 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; CRC32C over a 4KB buffer in the scratch memory, 8 bytes at a time
+mov r15, 20000
+mov r14, r15
+mov rsi, 0xe0000000
+
+crc_outer:
+mov eax, 0xFFFFFFFF
+xor ecx, ecx
+
+crc_loop:
+crc32 rax, qword [rsi + rcx]
+add ecx, 8
+cmp ecx, 4096
+jne crc_loop
+
+dec r14
+jnz crc_outer
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
@@ -0,0 +1,21 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; Indirect call and return to a single target, stays in the L1 lookup cache
+mov r15, 10000000
+mov r14, r15
+lea rbx, [rel target]
+
+call_loop:
+call rbx
+dec r14
+jnz call_loop
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
+
+target:
+ret
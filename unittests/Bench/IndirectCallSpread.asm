@@ -0,0 +1,32 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; Indirect calls spread over 4096 targets so lookups miss the L1 lookup cache and fall back to L2
+mov r15, 4000000
+mov r14, r15
+xor ecx, ecx
+lea rbx, [rel targets]
+
+call_loop:
+mov eax, ecx
+and eax, 4095
+shl eax, 4
+lea rdx, [rbx + rax]
+call rdx
+inc ecx
+dec r14
+jnz call_loop
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
+
+; 16 bytes per target
+align 16
+targets:
+%rep 4096
+  ret
+  align 16
+%endrep
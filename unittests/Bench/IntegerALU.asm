@@ -0,0 +1,23 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; Dependent integer ALU chain, mostly flags and register allocation pressure
+mov r15, 50000000
+mov r14, r15
+xor eax, eax
+mov ebx, 1
+
+alu_loop:
+add rax, rbx
+imul rbx, rbx, 3
+xor rax, rbx
+ror rax, 7
+adc rbx, rax
+dec r14
+jnz alu_loop
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
@@ -0,0 +1,32 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; Loop body with far more code than fits in the L1 icache, split in to small blocks by
+; conditional branches. Every block ends in two exits, which stresses how densely hot code is packed.
+%macro BODY_BLOCK 0
+  add rax, rbx
+  rol rbx, 5
+  test al, 1
+  jz %%skip
+  xor rcx, rax
+%%skip:
+%endmacro
+
+mov r15, 20000
+mov r14, r15
+xor eax, eax
+mov ebx, 0x12345
+xor ecx, ecx
+
+body_loop:
+%rep 2048
+  BODY_BLOCK
+%endrep
+dec r14
+jnz body_loop
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
@@ -0,0 +1,174 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; strlen, memcpy, memcmp and memset of 256 bytes through SSE2 routines shaped like a guest libc's
+; FEXBench runs this a second time as LibcString.Native with the routines in the table replaced by host code
+jmp start
+
+align 8
+db 'FEXNATIV'
+dq memcpy_impl
+db 'memcpy', 0, 0
+dq memset_impl
+db 'memset', 0, 0
+dq strlen_impl
+db 'strlen', 0, 0
+dq memcmp_impl
+db 'memcmp', 0, 0
+dq 0, 0
+
+start:
+; 255 character string in the scratch memory
+mov rdi, 0xe0000000
+mov esi, 'a'
+mov edx, 255
+call memset_impl
+mov rax, 0xe00000ff
+mov byte [rax], 0
+
+mov r15, 100000
+mov r14, r15
+
+string_loop:
+mov rdi, 0xe0000000
+call strlen_impl
+
+lea rdx, [rax + 1]
+mov rsi, 0xe0000000
+mov rdi, 0xe0001000
+call memcpy_impl
+
+mov rdi, 0xe0000000
+mov rsi, 0xe0001000
+mov edx, 256
+call memcmp_impl
+
+mov rdi, 0xe0002000
+xor esi, esi
+mov edx, 256
+call memset_impl
+
+dec r14
+jnz string_loop
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
+
+memcpy_impl:
+mov rax, rdi
+mov rcx, rdx
+shr rcx, 4
+jz .tail
+.vec:
+movdqu xmm0, [rsi]
+movdqu [rdi], xmm0
+add rsi, 16
+add rdi, 16
+dec rcx
+jnz .vec
+.tail:
+and edx, 15
+jz .done
+.byte:
+mov cl, [rsi]
+mov [rdi], cl
+inc rsi
+inc rdi
+dec edx
+jnz .byte
+.done:
+ret
+
+memset_impl:
+mov rax, rdi
+movzx ecx, sil
+imul ecx, ecx, 0x01010101
+movd xmm0, ecx
+pshufd xmm0, xmm0, 0
+mov rcx, rdx
+shr rcx, 4
+jz .tail
+.vec:
+movdqu [rdi], xmm0
+add rdi, 16
+dec rcx
+jnz .vec
+.tail:
+and edx, 15
+jz .done
+.byte:
+mov [rdi], sil
+inc rdi
+dec edx
+jnz .byte
+.done:
+ret
+
+; Aligned loads only, so it never reads across in to the next page
+strlen_impl:
+mov rax, rdi
+and rax, -16
+pxor xmm1, xmm1
+movdqa xmm0, [rax]
+pcmpeqb xmm0, xmm1
+pmovmskb edx, xmm0
+mov ecx, edi
+and ecx, 15
+shr edx, cl
+test edx, edx
+jnz .first
+.loop:
+add rax, 16
+movdqa xmm0, [rax]
+pcmpeqb xmm0, xmm1
+pmovmskb edx, xmm0
+test edx, edx
+jz .loop
+bsf edx, edx
+add rax, rdx
+sub rax, rdi
+ret
+.first:
+bsf eax, edx
+ret
+
+memcmp_impl:
+xor eax, eax
+mov rcx, rdx
+shr rcx, 4
+jz .tail
+.vec:
+movdqu xmm0, [rdi]
+movdqu xmm1, [rsi]
+pcmpeqb xmm0, xmm1
+pmovmskb r8d, xmm0
+cmp r8d, 0xffff
+jne .diff
+add rdi, 16
+add rsi, 16
+dec rcx
+jnz .vec
+.tail:
+and edx, 15
+jz .done
+.byte:
+movzx eax, byte [rdi]
+movzx r8d, byte [rsi]
+sub eax, r8d
+jnz .done
+inc rdi
+inc rsi
+dec edx
+jnz .byte
+.done:
+ret
+.diff:
+not r8d
+bsf r8d, r8d
+movzx eax, byte [rdi + r8]
+movzx ecx, byte [rsi + r8]
+sub eax, ecx
+ret
@@ -0,0 +1,21 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; rep movsb of 16KB inside of the scratch memory
+mov r15, 100000
+mov r14, r15
+
+copy_loop:
+mov rsi, 0xe0000000
+mov rdi, 0xe0004000
+mov ecx, 16384
+cld
+rep movsb
+dec r14
+jnz copy_loop
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
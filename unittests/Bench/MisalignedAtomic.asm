@@ -0,0 +1,28 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; Locked read-modify-writes on misaligned addresses
+; Hosts without LSE2 trap on these, only the first execution of each site should reach the SIGBUS handler
+mov r15, 1000000
+mov r14, r15
+mov rdi, 0xe0000001
+mov esi, 1
+xor ecx, ecx
+
+atomic_loop:
+lock add dword [rdi], esi
+mov rdx, 1
+lock xadd qword [rdi + 8], rdx
+mov rax, rcx
+lock cmpxchg qword [rdi + 16], rdx
+mov ebx, 2
+xchg word [rdi + 32], bx
+lock inc word [rdi + 40]
+dec r14
+jnz atomic_loop
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
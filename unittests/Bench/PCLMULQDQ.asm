@@ -0,0 +1,37 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; GHASH style carryless multiply folding over a 4KB buffer in the scratch memory
+mov r15, 20000
+mov r14, r15
+mov rsi, 0xe0000000
+
+movdqu xmm7, [rsi]
+
+pclmul_outer:
+pxor xmm0, xmm0
+xor ecx, ecx
+
+pclmul_loop:
+movdqu xmm1, [rsi + rcx]
+pxor xmm1, xmm0
+movdqa xmm2, xmm1
+movdqa xmm3, xmm1
+pclmulqdq xmm1, xmm7, 0x00
+pclmulqdq xmm2, xmm7, 0x11
+pclmulqdq xmm3, xmm7, 0x01
+pxor xmm1, xmm2
+pxor xmm0, xmm1
+pxor xmm0, xmm3
+add ecx, 16
+cmp ecx, 4096
+jne pclmul_loop
+
+dec r14
+jnz pclmul_outer
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
@@ -0,0 +1,42 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; Guest registers that every host statically allocates (RAX-RDX, XMM0-XMM3) carried through a chain
+; of small blocks. Without static register allocation each block loads them from the context and stores them back.
+%macro SMALL_BLOCK 0
+  add rax, rbx
+  xor rcx, rax
+  rol rdx, 3
+  sub rbx, rcx
+  paddd xmm0, xmm1
+  pxor xmm2, xmm0
+  paddq xmm3, xmm2
+  test dl, 1
+  jz %%skip
+  inc rdx
+%%skip:
+%endmacro
+
+mov r15, 500000
+mov r14, r15
+xor eax, eax
+mov ebx, 0x12345
+mov ecx, 0x6789
+mov edx, 0xabcd
+movq xmm0, rbx
+movq xmm1, rcx
+movq xmm2, rdx
+pxor xmm3, xmm3
+
+pressure_loop:
+%rep 64
+  SMALL_BLOCK
+%endrep
+dec r14
+jnz pressure_loop
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
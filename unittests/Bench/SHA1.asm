@@ -0,0 +1,48 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; SHA1 message schedule and compression with the SHA extensions, 16 rounds per iteration
+mov r15, 2000000
+mov r14, r15
+mov rsi, 0xe0000000
+
+movdqu xmm0, [rsi]
+movdqu xmm1, [rsi + 16]
+movdqu xmm3, [rsi + 32]
+movdqu xmm4, [rsi + 48]
+movdqu xmm5, [rsi + 64]
+movdqu xmm6, [rsi + 80]
+
+sha1_loop:
+movdqa xmm2, xmm0
+sha1nexte xmm1, xmm3
+sha1rnds4 xmm0, xmm1, 0
+sha1msg1 xmm3, xmm4
+sha1msg2 xmm3, xmm6
+
+movdqa xmm1, xmm0
+sha1nexte xmm2, xmm4
+sha1rnds4 xmm0, xmm2, 1
+sha1msg1 xmm4, xmm5
+sha1msg2 xmm4, xmm3
+
+movdqa xmm2, xmm0
+sha1nexte xmm1, xmm5
+sha1rnds4 xmm0, xmm1, 2
+sha1msg1 xmm5, xmm6
+sha1msg2 xmm5, xmm4
+
+movdqa xmm1, xmm0
+sha1nexte xmm2, xmm6
+sha1rnds4 xmm0, xmm2, 3
+sha1msg1 xmm6, xmm3
+sha1msg2 xmm6, xmm5
+
+dec r14
+jnz sha1_loop
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
@@ -0,0 +1,69 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; SHA256 message schedule and compression with the SHA extensions, 16 rounds per iteration
+mov r15, 2000000
+mov r14, r15
+mov rsi, 0xe0000000
+
+movdqu xmm1, [rsi]
+movdqu xmm2, [rsi + 16]
+movdqu xmm3, [rsi + 32]
+movdqu xmm4, [rsi + 48]
+movdqu xmm5, [rsi + 64]
+movdqu xmm6, [rsi + 80]
+movdqu xmm7, [rsi + 96]
+
+sha256_loop:
+movdqa xmm0, xmm3
+paddd xmm0, xmm7
+sha256rnds2 xmm2, xmm1
+pshufd xmm0, xmm0, 0x0E
+sha256rnds2 xmm1, xmm2
+sha256msg1 xmm3, xmm4
+movdqa xmm8, xmm6
+palignr xmm8, xmm5, 4
+paddd xmm3, xmm8
+sha256msg2 xmm3, xmm6
+
+movdqa xmm0, xmm4
+paddd xmm0, xmm7
+sha256rnds2 xmm2, xmm1
+pshufd xmm0, xmm0, 0x0E
+sha256rnds2 xmm1, xmm2
+sha256msg1 xmm4, xmm5
+movdqa xmm8, xmm3
+palignr xmm8, xmm6, 4
+paddd xmm4, xmm8
+sha256msg2 xmm4, xmm3
+
+movdqa xmm0, xmm5
+paddd xmm0, xmm7
+sha256rnds2 xmm2, xmm1
+pshufd xmm0, xmm0, 0x0E
+sha256rnds2 xmm1, xmm2
+sha256msg1 xmm5, xmm6
+movdqa xmm8, xmm4
+palignr xmm8, xmm3, 4
+paddd xmm5, xmm8
+sha256msg2 xmm5, xmm4
+
+movdqa xmm0, xmm6
+paddd xmm0, xmm7
+sha256rnds2 xmm2, xmm1
+pshufd xmm0, xmm0, 0x0E
+sha256rnds2 xmm1, xmm2
+sha256msg1 xmm6, xmm3
+movdqa xmm8, xmm5
+palignr xmm8, xmm4, 4
+paddd xmm6, xmm8
+sha256msg2 xmm6, xmm5
+
+dec r14
+jnz sha256_loop
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
@@ -0,0 +1,29 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; Single precision dot product of two 1KB vectors in the scratch memory
+mov r15, 200000
+mov r14, r15
+mov rsi, 0xe0000000
+mov rdi, 0xe0000400
+
+dot_outer:
+xorps xmm0, xmm0
+xor ecx, ecx
+
+dot_loop:
+movaps xmm1, [rsi + rcx]
+mulps xmm1, [rdi + rcx]
+addps xmm0, xmm1
+add ecx, 16
+cmp ecx, 1024
+jne dot_loop
+
+dec r14
+jnz dot_outer
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
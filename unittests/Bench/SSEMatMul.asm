@@ -0,0 +1,48 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; 8x8 single precision matrix multiply, C = A * B
+; Each row of C accumulates rows of B scaled by a broadcast element of A
+mov r15, 50000
+mov r14, r15
+mov rsi, 0xe0000000
+mov rdi, 0xe0000100
+mov rdx, 0xe0000200
+
+matmul_outer:
+xor r8d, r8d
+
+row_loop:
+xorps xmm0, xmm0
+xorps xmm1, xmm1
+xor ecx, ecx
+xor r9d, r9d
+
+k_loop:
+movss xmm2, [rsi + r8 + rcx]
+shufps xmm2, xmm2, 0
+movaps xmm3, [rdi + r9]
+movaps xmm4, [rdi + r9 + 16]
+mulps xmm3, xmm2
+mulps xmm4, xmm2
+addps xmm0, xmm3
+addps xmm1, xmm4
+add ecx, 4
+add r9d, 32
+cmp ecx, 32
+jne k_loop
+
+movaps [rdx + r8], xmm0
+movaps [rdx + r8 + 16], xmm1
+add r8d, 32
+cmp r8d, 256
+jne row_loop
+
+dec r14
+jnz matmul_outer
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
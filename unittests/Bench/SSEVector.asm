@@ -0,0 +1,30 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; Streams SSE loads, math and stores over 1KB of the scratch memory
+mov r15, 200000
+mov r14, r15
+mov rdi, 0xe0000000
+pxor xmm0, xmm0
+
+vector_outer:
+xor ecx, ecx
+
+vector_loop:
+movaps xmm1, [rdi + rcx]
+paddd xmm0, xmm1
+mulps xmm1, xmm1
+addps xmm1, xmm0
+movaps [rdi + rcx], xmm1
+add ecx, 16
+cmp ecx, 1024
+jne vector_loop
+
+dec r14
+jnz vector_outer
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
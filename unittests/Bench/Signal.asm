@@ -0,0 +1,54 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; Signal delivery latency, kill self with SIGUSR1 and return through rt_sigreturn
+mov r15, 100000
+mov r14, r15
+
+; The harness stack is a single page, move to the scratch memory so the signal frames fit
+mov r12, rsp
+mov rsp, 0xe0100000
+
+; struct sigaction {handler, flags, restorer, mask} on the stack
+sub rsp, 32
+lea rax, [rel handler]
+mov [rsp], rax
+mov rax, 0x04000000 ; SA_RESTORER
+mov [rsp + 8], rax
+lea rax, [rel restorer]
+mov [rsp + 16], rax
+mov qword [rsp + 24], 0
+
+mov eax, 13 ; rt_sigaction
+mov edi, 10 ; SIGUSR1
+mov rsi, rsp
+xor edx, edx
+mov r10d, 8
+syscall
+
+mov eax, 39 ; getpid
+syscall
+mov r13, rax
+
+signal_loop:
+mov eax, 62 ; kill
+mov rdi, r13
+mov esi, 10 ; SIGUSR1
+syscall
+dec r14
+jnz signal_loop
+
+mov rsp, r12
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
+
+handler:
+ret
+
+restorer:
+mov eax, 15 ; rt_sigreturn
+syscall
@@ -0,0 +1,50 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; Synchronous fault round trip, load from a null pointer and have the SIGSEGV handler step over it
+mov r15, 100000
+mov r14, r15
+
+; The harness stack is a single page, move to the scratch memory so the signal frames fit
+mov r12, rsp
+mov rsp, 0xe0100000
+
+; struct sigaction {handler, flags, restorer, mask} on the stack
+sub rsp, 32
+lea rax, [rel handler]
+mov [rsp], rax
+mov rax, 0x04000004 ; SA_RESTORER | SA_SIGINFO
+mov [rsp + 8], rax
+lea rax, [rel restorer]
+mov [rsp + 16], rax
+mov qword [rsp + 24], 0
+
+mov eax, 13 ; rt_sigaction
+mov edi, 11 ; SIGSEGV
+mov rsi, rsp
+xor edx, edx
+mov r10d, 8
+syscall
+
+fault_loop:
+; 7 byte encoding, the handler skips exactly this much
+mov eax, [abs 0]
+dec r14
+jnz fault_loop
+
+mov rsp, r12
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
+
+handler:
+; ucontext_t->uc_mcontext.gregs[REG_RIP]
+add qword [rdx + 168], 7
+ret
+
+restorer:
+mov eax, 15 ; rt_sigreturn
+syscall
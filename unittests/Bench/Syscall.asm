@@ -0,0 +1,18 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; Syscall round trip of a passthrough syscall, inlined as a host syscall when the JIT supports it
+mov r15, 1000000
+mov r14, r15
+
+syscall_loop:
+mov eax, 39 ; getpid
+syscall
+dec r14
+jnz syscall_loop
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
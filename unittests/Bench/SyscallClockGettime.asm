@@ -0,0 +1,20 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; Passthrough syscall with a pointer argument, inlined as a host syscall when the JIT supports it
+mov r15, 1000000
+mov r14, r15
+
+clock_loop:
+mov eax, 228 ; clock_gettime
+mov edi, 1 ; CLOCK_MONOTONIC
+mov rsi, 0xe0000000
+syscall
+dec r14
+jnz clock_loop
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
@@ -0,0 +1,21 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; futex wake with no waiters, the uncontended unlock path of most guest mutexes
+mov r15, 1000000
+mov r14, r15
+
+futex_loop:
+mov eax, 202 ; futex
+mov rdi, 0xe0000000
+mov esi, 129 ; FUTEX_WAKE_PRIVATE
+mov edx, 1
+syscall
+dec r14
+jnz futex_loop
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
@@ -0,0 +1,20 @@
+%ifdef CONFIG
+{
+}
+%endif
+
+; uname is emulated so this always goes through the syscall handler
+; Baseline to compare the inlined passthrough syscall kernels against
+mov r15, 1000000
+mov r14, r15
+
+uname_loop:
+mov eax, 63 ; uname
+mov rdi, 0xe0000000
+syscall
+dec r14
+jnz uname_loop
+
+; Iteration count for FEXBench
+mov rax, r15
+hlt
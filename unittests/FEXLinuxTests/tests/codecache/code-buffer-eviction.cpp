@@ -0,0 +1,130 @@
+/*
+  generates far more guest code than fits in a 2MB code buffer and runs it several times over
+  every pass has to evict code segments a few times, results have to stay correct throughout
+*/
+
+// fex env: FEX_CODEBUFFERSIZE=2
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <vector>
+
+// Each function is a long unfoldable chain on its argument, a few KB of host code once compiled
+constexpr size_t NUM_FUNCTIONS = 2048;
+constexpr size_t STEPS_PER_FUNCTION = 96;
+constexpr size_t NUM_PASSES = 4;
+
+struct Step {
+  uint32_t Xor;
+  uint32_t Add;
+};
+
+static uint32_t Seed = 0x12345678;
+static uint32_t next_random() {
+  Seed = Seed * 1103515245 + 12345;
+  return Seed ^ (Seed >> 16);
+}
+
+static uint32_t rol5(uint32_t value) {
+  return (value << 5) | (value >> 27);
+}
+
+static uint8_t *emit32(uint8_t *code, uint32_t value) {
+  memcpy(code, &value, sizeof(value));
+  return code + sizeof(value);
+}
+
+static uint8_t *emit_function(uint8_t *code, std::vector<Step> const &steps) {
+#ifdef __x86_64__
+  // mov eax, edi
+  *code++ = 0x89;
+  *code++ = 0xf8;
+#else
+  // mov eax, [esp + 4]
+  *code++ = 0x8b;
+  *code++ = 0x44;
+  *code++ = 0x24;
+  *code++ = 0x04;
+#endif
+
+  for (auto const &step : steps) {
+    // xor eax, imm32
+    *code++ = 0x35;
+    code = emit32(code, step.Xor);
+    // rol eax, 5
+    *code++ = 0xc1;
+    *code++ = 0xc0;
+    *code++ = 0x05;
+    // add eax, imm32
+    *code++ = 0x05;
+    code = emit32(code, step.Add);
+  }
+
+  // ret
+  *code++ = 0xc3;
+  return code;
+}
+
+static uint32_t model(std::vector<Step> const &steps, uint32_t value) {
+  for (auto const &step : steps) {
+    value = rol5(value ^ step.Xor) + step.Add;
+  }
+  return value;
+}
+
+using GeneratedFn = uint32_t (*)(uint32_t);
+
+int main() {
+  constexpr size_t MAX_FUNCTION_SIZE = 4 + STEPS_PER_FUNCTION * 13 + 1;
+  const size_t code_size = NUM_FUNCTIONS * MAX_FUNCTION_SIZE;
+  auto code = static_cast<uint8_t *>(mmap(nullptr, code_size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  if (code == MAP_FAILED) {
+    printf("mmap failed\n");
+    return 1;
+  }
+
+  std::vector<std::vector<Step>> steps(NUM_FUNCTIONS);
+  std::vector<GeneratedFn> functions(NUM_FUNCTIONS);
+  uint8_t *cursor = code;
+  for (size_t i = 0; i < NUM_FUNCTIONS; ++i) {
+    steps[i].resize(STEPS_PER_FUNCTION);
+    for (auto &step : steps[i]) {
+      step.Xor = next_random();
+      step.Add = next_random();
+    }
+    functions[i] = reinterpret_cast<GeneratedFn>(cursor);
+    cursor = emit_function(cursor, steps[i]);
+  }
+
+  uint32_t failures = 0;
+  for (size_t pass = 0; pass < NUM_PASSES; ++pass) {
+    // A different odd stride each pass, so segments fill with a different mix of blocks
+    const size_t stride = pass * 2 + 1;
+    for (size_t n = 0; n < NUM_FUNCTIONS; ++n) {
+      const size_t i = (n * stride) % NUM_FUNCTIONS;
+      const uint32_t arg = static_cast<uint32_t>(pass << 16 | i);
+
+      // The first function stays hot the whole time, it should survive the clock hand passing it
+      const uint32_t hot_arg = arg ^ 0x5a5a5a5a;
+      if (functions[0](hot_arg) != model(steps[0], hot_arg)) {
+        ++failures;
+      }
+
+      if (functions[i](arg) != model(steps[i], arg)) {
+        if (failures < 16) {
+          printf("pass %zu function %zu: wrong result\n", pass, i);
+        }
+        ++failures;
+      }
+    }
+  }
+
+  munmap(code, code_size);
+
+  if (failures) {
+    printf("%u failures\n", failures);
+  }
+  return failures != 0;
+}
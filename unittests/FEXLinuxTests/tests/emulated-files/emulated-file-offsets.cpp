@@ -0,0 +1,68 @@
+/*
+  tests that emulated /proc and /sys files opened multiple times
+  get independent file offsets and identical contents
+
+  FEX memoizes these files and hands out reopened copies,
+  so reading from one FD must not move the offset of another.
+*/
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+
+static std::string ReadAll(int fd) {
+  std::string Data;
+  char Buffer[4096];
+  ssize_t Read;
+  while ((Read = read(fd, Buffer, sizeof(Buffer))) > 0) {
+    Data.append(Buffer, Read);
+  }
+  return Data;
+}
+
+static int TestFile(const char *Path) {
+  int fd1 = open(Path, O_RDONLY);
+  int fd2 = open(Path, O_RDONLY | O_CLOEXEC);
+  if (fd1 == -1 || fd2 == -1) {
+    printf("%s: Couldn't open\n", Path);
+    return 1;
+  }
+
+  // Consume the first FD completely before touching the second one
+  auto Data1 = ReadAll(fd1);
+  auto Data2 = ReadAll(fd2);
+
+  // Rewinding the first FD shouldn't affect the second
+  lseek(fd1, 0, SEEK_SET);
+  auto Data3 = ReadAll(fd1);
+  char c;
+  auto Remaining = read(fd2, &c, 1);
+
+  close(fd1);
+  close(fd2);
+
+  int Result = Data1.empty() || Data1 != Data2 || Data1 != Data3 || Remaining != 0;
+  printf("%s: %zu bytes, %s\n", Path, Data1.size(), Result ? "FAIL" : "PASS");
+  return Result;
+}
+
+int main() {
+  int Result{};
+  const char *Files[] = {
+    "/proc/cpuinfo",
+    "/proc/version",
+    "/proc/sys/kernel/osrelease",
+    "/sys/devices/system/cpu/online",
+    "/proc/self/cmdline",
+  };
+
+  // Open everything more than once so the memoized copies are exercised
+  for (int i = 0; i < 2; ++i) {
+    for (auto File : Files) {
+      Result |= TestFile(File);
+    }
+  }
+
+  return Result;
+}
@@ -0,0 +1,144 @@
+/*
+  tests the host replacements of guest libc routines, run with FEX_NATIVELIBC=1
+  results have to match plain libc, and a fault in the middle of a call has to reach the guest
+*/
+
+// fex env: FEX_NATIVELIBC=1
+
+auto args = "results, memcpy_fault, strlen_fault";
+
+#include <initializer_list>
+#include <setjmp.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Called through pointers so the compiler can't expand them inline
+static void *(*volatile memcpy_fn)(void *, const void *, size_t) = memcpy;
+static void *(*volatile memset_fn)(void *, int, size_t) = memset;
+static size_t (*volatile strlen_fn)(const char *) = strlen;
+static int (*volatile memcmp_fn)(const void *, const void *, size_t) = memcmp;
+static const char *(*volatile strchr_fn)(const char *, int) = strchr;
+
+static sigjmp_buf jmpbuf;
+static void *volatile fault_addr;
+
+static void handler(int sig, siginfo_t *si, void *unused) {
+  fault_addr = si->si_addr;
+  siglongjmp(jmpbuf, 1);
+}
+
+#define CHECK(cond)                                                                                                                        \
+  do {                                                                                                                                     \
+    if (!(cond)) {                                                                                                                         \
+      printf("%s:%d check failed: %s\n", __FILE__, __LINE__, #cond);                                                                        \
+      return 1;                                                                                                                            \
+    }                                                                                                                                      \
+  } while (0)
+
+static int test_results() {
+  char src[256];
+  char dst[256];
+  for (size_t i = 0; i < sizeof(src); ++i) {
+    src[i] = static_cast<char>(i * 7 + 1);
+  }
+
+  // Odd sizes and offsets so both vector bodies and tails get used
+  for (size_t size : {0, 1, 15, 16, 17, 63, 200}) {
+    memset(dst, 0x5a, sizeof(dst));
+    CHECK(memcpy_fn(dst + 3, src + 1, size) == dst + 3);
+    CHECK(memcmp(dst + 3, src + 1, size) == 0);
+    CHECK(dst[2] == 0x5a && dst[3 + size] == 0x5a);
+
+    CHECK(memset_fn(dst + 1, 0x11, size) == dst + 1);
+    for (size_t i = 0; i < size; ++i) {
+      CHECK(dst[1 + i] == 0x11);
+    }
+    CHECK(dst[0] == 0x5a);
+  }
+
+  // Overlapping copies must behave like memmove
+  char overlap[32] = "0123456789abcdefghijklmnopqrstu";
+  memcpy_fn(overlap + 4, overlap, 16);
+  CHECK(memcmp(overlap, "01230123456789abcdefklmnopqrstu", 32) == 0);
+
+  const char str[] = "the quick brown fox";
+  CHECK(strlen_fn(str) == sizeof(str) - 1);
+  CHECK(strlen_fn(str + 19) == 0);
+  CHECK(strlen_fn("") == 0);
+
+  CHECK(memcmp_fn("abcd", "abcd", 4) == 0);
+  CHECK(memcmp_fn("abcd", "abce", 4) < 0);
+  CHECK(memcmp_fn("abce", "abcd", 4) > 0);
+  CHECK(memcmp_fn("\x80", "\x01", 1) > 0);
+  CHECK(memcmp_fn("abcd", "xbcd", 0) == 0);
+
+  CHECK(strchr_fn(str, 'q') == str + 4);
+  CHECK(strchr_fn(str, 'z') == nullptr);
+  CHECK(strchr_fn(str, '\0') == str + sizeof(str) - 1);
+
+  // Strings ending right before an unmapped page mustn't fault
+  const long page = sysconf(_SC_PAGESIZE);
+  auto pages = static_cast<char *>(mmap(nullptr, page * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  CHECK(pages != MAP_FAILED);
+  CHECK(mprotect(pages + page, page, PROT_NONE) == 0);
+  memset(pages, 'a', page);
+  pages[page - 1] = '\0';
+  CHECK(strlen_fn(pages + page - 33) == 32);
+  CHECK(strlen_fn(pages) == static_cast<size_t>(page - 1));
+  munmap(pages, page * 2);
+
+  return 0;
+}
+
+// The first byte of the second page is inaccessible, calls reading over the boundary must fault there
+template<typename F>
+static int test_fault(F &&Call) {
+  const long page = sysconf(_SC_PAGESIZE);
+  auto pages = static_cast<char *>(mmap(nullptr, page * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  CHECK(pages != MAP_FAILED);
+  CHECK(mprotect(pages + page, page, PROT_NONE) == 0);
+  memset(pages, 'a', page);
+
+  struct sigaction sa {};
+  sa.sa_flags = SA_SIGINFO;
+  sigemptyset(&sa.sa_mask);
+  sa.sa_sigaction = handler;
+  sigaction(SIGSEGV, &sa, nullptr);
+
+  if (sigsetjmp(jmpbuf, 1) == 0) {
+    Call(pages + page - 64);
+    printf("call didn't fault\n");
+    return 1;
+  }
+
+  auto addr = static_cast<char *>(fault_addr);
+  CHECK(addr >= pages + page && addr < pages + page * 2);
+
+  // Later calls still work after a faulting one
+  pages[page - 1] = '\0';
+  CHECK(strlen_fn(pages + page - 16) == 15);
+
+  munmap(pages, page * 2);
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc == 2) {
+    if (strcmp(argv[1], "results") == 0) {
+      return test_results();
+    } else if (strcmp(argv[1], "memcpy_fault") == 0) {
+      static char dst[256];
+      return test_fault([](char *src) { memcpy_fn(dst, src, 128); });
+    } else if (strcmp(argv[1], "strlen_fault") == 0) {
+      return test_fault([](char *src) { strlen_fn(src); });
+    }
+  }
+
+  printf("Invalid arguments\n");
+  printf("please specify one of %s\n", args);
+  return 1;
+}
@@ -0,0 +1,157 @@
+/*
+  runs a known hot loop in a child process with the sampling profiler enabled
+  the profile the child writes on exit has to attribute most samples to the loop's guest RIP range
+*/
+
+// fex env: FEX_SAMPLEPROFILE=@CMAKE_BINARY_DIR@/sampling-profiler FEX_SAMPLEPROFILEHZ=997
+// libs: dl
+
+#include <dlfcn.h>
+#include <fstream>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __x86_64__
+#define LOAD_ITERATIONS "mov %edi, %ecx\n"
+#else
+#define LOAD_ITERATIONS "mov 4(%esp), %ecx\n"
+#endif
+
+// Written in asm so the guest RIP range is exactly known
+extern "C" void hot_loop(uint32_t iterations);
+extern "C" char hot_loop_end[];
+asm(".text\n"
+    ".global hot_loop\n"
+    ".hidden hot_loop\n"
+    "hot_loop:\n"
+    LOAD_ITERATIONS
+    "xor %eax, %eax\n"
+    "1:\n"
+    "add $3, %eax\n"
+    "imul %eax, %eax\n"
+    "dec %ecx\n"
+    "jnz 1b\n"
+    "ret\n"
+    ".global hot_loop_end\n"
+    ".hidden hot_loop_end\n"
+    "hot_loop_end:\n");
+
+static uint64_t thread_cpu_ns() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static std::string basename_of(std::string const &path) {
+  auto slash = path.rfind('/');
+  return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+// Frames are either a raw RIP or file+offset when the address is inside a mapped file
+static bool parse_frame(std::string const &frame, std::string const &exe_name, uintptr_t exe_base, uintptr_t *rip) {
+  auto plus = frame.rfind("+0x");
+  if (plus != std::string::npos) {
+    if (basename_of(frame.substr(0, plus)) != exe_name) {
+      return false;
+    }
+    *rip = exe_base + strtoull(frame.c_str() + plus + 3, nullptr, 16);
+    return true;
+  }
+
+  if (frame.compare(0, 2, "0x") == 0) {
+    *rip = strtoull(frame.c_str() + 2, nullptr, 16);
+    return true;
+  }
+
+  // [FEX], [Dispatcher] and friends
+  return false;
+}
+
+int main() {
+  const char *profile = getenv("FEX_SAMPLEPROFILE");
+  if (!profile) {
+    printf("FEX_SAMPLEPROFILE isn't set\n");
+    return 1;
+  }
+
+  pid_t child = fork();
+  if (child == 0) {
+    // Burn half a second of CPU time in the loop, the clock reads are a tiny fraction of it
+    const uint64_t start = thread_cpu_ns();
+    while (thread_cpu_ns() - start < 500000000ULL) {
+      hot_loop(1000000);
+    }
+    exit(0);
+  }
+
+  int status;
+  if (waitpid(child, &status, 0) != child || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    printf("child failed\n");
+    return 1;
+  }
+
+  char exe_path[PATH_MAX] {};
+  if (readlink("/proc/self/exe", exe_path, sizeof(exe_path) - 1) < 0) {
+    printf("couldn't read /proc/self/exe\n");
+    return 1;
+  }
+
+  Dl_info info;
+  if (!dladdr(reinterpret_cast<void *>(&hot_loop), &info)) {
+    printf("dladdr failed\n");
+    return 1;
+  }
+
+  const auto exe_name = basename_of(exe_path);
+  const auto exe_base = reinterpret_cast<uintptr_t>(info.dli_fbase);
+  const auto loop_start = reinterpret_cast<uintptr_t>(&hot_loop);
+  const auto loop_end = reinterpret_cast<uintptr_t>(hot_loop_end);
+
+  // The child's profile is suffixed with its pid
+  const auto path = std::string { profile } + "." + std::to_string(child);
+  std::ifstream input(path);
+  if (!input.is_open()) {
+    printf("no profile at %s\n", path.c_str());
+    return 1;
+  }
+
+  // Lines are "thread;block;leaf count"
+  uint64_t total = 0;
+  uint64_t in_loop = 0;
+  std::string line;
+  while (std::getline(input, line)) {
+    auto space = line.rfind(' ');
+    auto leaf_start = line.rfind(';');
+    if (space == std::string::npos || leaf_start == std::string::npos || leaf_start > space) {
+      printf("malformed line: %s\n", line.c_str());
+      return 1;
+    }
+
+    const uint64_t count = strtoull(line.c_str() + space + 1, nullptr, 10);
+    total += count;
+
+    uintptr_t rip;
+    if (parse_frame(line.substr(leaf_start + 1, space - leaf_start - 1), exe_name, exe_base, &rip) &&
+        rip >= loop_start && rip < loop_end) {
+      in_loop += count;
+    }
+  }
+  unlink(path.c_str());
+
+  printf("%llu of %llu samples in the hot loop\n", static_cast<unsigned long long>(in_loop), static_cast<unsigned long long>(total));
+
+  // ~500 samples are expected at this rate, leave plenty of slack for busy machines
+  if (total < 100) {
+    return 1;
+  }
+
+  // Startup, compilation and exit land outside the loop, but they are far shorter than it
+  return in_loop * 2 >= total ? 0 : 1;
+}
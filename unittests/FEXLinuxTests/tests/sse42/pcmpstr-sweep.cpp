@@ -0,0 +1,279 @@
+/*
+  sweeps every imm8 mode of PCMPESTRI/PCMPESTRM/PCMPISTRI/PCMPISTRM over a range of lengths and inputs
+  results are compared against a plain C++ model, so the host run checks the model and the emulated run checks FEX
+*/
+
+// append cxxflags: -msse4.2
+
+auto args = "explicit, implicit";
+
+#include <array>
+#include <immintrin.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <utility>
+
+struct Operands {
+  __m128i A;
+  __m128i B;
+  int32_t LenA;
+  int32_t LenB;
+};
+
+struct Result {
+  uint32_t Index;
+  __m128i Mask;
+  bool CF, ZF, SF, OF;
+};
+
+// Model of the SDM pseudocode, kept independent of FEX's implementation
+struct Model {
+  uint8_t Imm;
+  int32_t A[16];
+  int32_t B[16];
+  uint32_t NumElements;
+
+  Model(uint8_t Imm_, __m128i LHS, __m128i RHS) : Imm(Imm_), NumElements((Imm & 1) ? 8 : 16) {
+    uint8_t RawA[16], RawB[16];
+    memcpy(RawA, &LHS, 16);
+    memcpy(RawB, &RHS, 16);
+    for (uint32_t i = 0; i < NumElements; ++i) {
+      A[i] = Element(RawA, i);
+      B[i] = Element(RawB, i);
+    }
+  }
+
+  int32_t Element(const uint8_t *Raw, uint32_t i) const {
+    const bool Signed = Imm & 2;
+    if (Imm & 1) {
+      uint16_t Value;
+      memcpy(&Value, Raw + i * 2, 2);
+      return Signed ? static_cast<int16_t>(Value) : Value;
+    }
+    return Signed ? static_cast<int8_t>(Raw[i]) : Raw[i];
+  }
+
+  uint32_t ExplicitLength(int32_t Length) const {
+    const int64_t Abs = Length < 0 ? -static_cast<int64_t>(Length) : Length;
+    return Abs > NumElements ? NumElements : static_cast<uint32_t>(Abs);
+  }
+
+  uint32_t ImplicitLength(const int32_t *Src) const {
+    for (uint32_t i = 0; i < NumElements; ++i) {
+      if (Src[i] == 0) {
+        return i;
+      }
+    }
+    return NumElements;
+  }
+
+  Result Run(uint32_t LenA, uint32_t LenB) const {
+    uint32_t IntRes1 = 0;
+    for (uint32_t i = 0; i < NumElements; ++i) {
+      bool Match = false;
+      switch ((Imm >> 2) & 3) {
+        case 0: // Equal any
+          for (uint32_t j = 0; j < LenA && i < LenB; ++j) {
+            Match |= A[j] == B[i];
+          }
+          break;
+        case 1: // Ranges
+          for (uint32_t j = 0; j + 1 < LenA && i < LenB; j += 2) {
+            Match |= A[j] <= B[i] && B[i] <= A[j + 1];
+          }
+          break;
+        case 2: // Equal each
+          Match = (i < LenA && i < LenB) ? A[i] == B[i] : (i >= LenA && i >= LenB);
+          break;
+        case 3: // Equal ordered
+          Match = true;
+          for (uint32_t j = 0; j < LenA && i + j < NumElements; ++j) {
+            if (i + j >= LenB || A[j] != B[i + j]) {
+              Match = false;
+              break;
+            }
+          }
+          break;
+      }
+      IntRes1 |= static_cast<uint32_t>(Match) << i;
+    }
+
+    const uint32_t AllMask = (1U << NumElements) - 1;
+    uint32_t IntRes2 = IntRes1;
+    if (((Imm >> 4) & 3) == 1) {
+      IntRes2 = IntRes1 ^ AllMask;
+    } else if (((Imm >> 4) & 3) == 3) {
+      IntRes2 = IntRes1 ^ ((1U << LenB) - 1);
+    }
+
+    Result R {};
+    if (IntRes2 == 0) {
+      R.Index = NumElements;
+    } else {
+      R.Index = (Imm & 0x40) ? 31 - __builtin_clz(IntRes2) : __builtin_ctz(IntRes2);
+    }
+
+    uint8_t Mask[16] {};
+    if (Imm & 0x40) {
+      const uint32_t Size = 16 / NumElements;
+      for (uint32_t i = 0; i < NumElements; ++i) {
+        memset(Mask + i * Size, (IntRes2 >> i) & 1 ? 0xff : 0, Size);
+      }
+    } else {
+      const uint16_t Bits = IntRes2;
+      memcpy(Mask, &Bits, 2);
+    }
+    memcpy(&R.Mask, Mask, 16);
+
+    R.CF = IntRes2 != 0;
+    R.ZF = LenB < NumElements;
+    R.SF = LenA < NumElements;
+    R.OF = IntRes2 & 1;
+    return R;
+  }
+};
+
+template<uint8_t Imm>
+static Result ExplicitIndex(const Operands &Ops) {
+  Result R {};
+  asm("pcmpestri %[imm], %[b], %[a]"
+      : "=c"(R.Index), "=@ccc"(R.CF), "=@ccz"(R.ZF), "=@ccs"(R.SF), "=@cco"(R.OF)
+      : [a] "x"(Ops.A), [b] "x"(Ops.B), "a"(Ops.LenA), "d"(Ops.LenB), [imm] "i"(Imm));
+  return R;
+}
+
+template<uint8_t Imm>
+static Result ExplicitMask(const Operands &Ops) {
+  Result R {};
+  asm("pcmpestrm %[imm], %[b], %[a]"
+      : "=Yz"(R.Mask), "=@ccc"(R.CF), "=@ccz"(R.ZF), "=@ccs"(R.SF), "=@cco"(R.OF)
+      : [a] "x"(Ops.A), [b] "x"(Ops.B), "a"(Ops.LenA), "d"(Ops.LenB), [imm] "i"(Imm));
+  return R;
+}
+
+template<uint8_t Imm>
+static Result ImplicitIndex(const Operands &Ops) {
+  Result R {};
+  asm("pcmpistri %[imm], %[b], %[a]"
+      : "=c"(R.Index), "=@ccc"(R.CF), "=@ccz"(R.ZF), "=@ccs"(R.SF), "=@cco"(R.OF)
+      : [a] "x"(Ops.A), [b] "x"(Ops.B), [imm] "i"(Imm));
+  return R;
+}
+
+template<uint8_t Imm>
+static Result ImplicitMask(const Operands &Ops) {
+  Result R {};
+  asm("pcmpistrm %[imm], %[b], %[a]"
+      : "=Yz"(R.Mask), "=@ccc"(R.CF), "=@ccz"(R.ZF), "=@ccs"(R.SF), "=@cco"(R.OF)
+      : [a] "x"(Ops.A), [b] "x"(Ops.B), [imm] "i"(Imm));
+  return R;
+}
+
+using TestFn = Result (*)(const Operands &);
+
+// Bit 7 of imm8 is ignored, so bits [6:0] cover every mode
+#define DEFINE_TABLE(Name)                                                                                                                 \
+  template<size_t... Imm>                                                                                                                  \
+  static constexpr auto Name##Table(std::index_sequence<Imm...>) {                                                                        \
+    return std::array<TestFn, sizeof...(Imm)> { &Name<Imm>... };                                                                         \
+  }                                                                                                                                        \
+  static constexpr auto Name##Fns = Name##Table(std::make_index_sequence<128>());
+
+DEFINE_TABLE(ExplicitIndex)
+DEFINE_TABLE(ExplicitMask)
+DEFINE_TABLE(ImplicitIndex)
+DEFINE_TABLE(ImplicitMask)
+
+// Small alphabet so that matches, ranges and nulls all show up
+static __m128i MakeInput(uint32_t &Seed) {
+  static const uint8_t Alphabet[] = { 0, 1, 'a', 'b', 'c', 0x7f, 0x80, 0xff };
+  uint8_t Raw[16];
+  for (auto &Byte : Raw) {
+    Seed = Seed * 1103515245 + 12345;
+    Byte = Alphabet[(Seed >> 16) % sizeof(Alphabet)];
+    // Keep most elements non-null so implicit lengths vary
+    if (Byte == 0 && ((Seed >> 24) & 3) != 0) {
+      Byte = 'a';
+    }
+  }
+  __m128i Result;
+  memcpy(&Result, Raw, 16);
+  return Result;
+}
+
+static bool Compare(const char *Name, uint8_t Imm, const Result &Expected, const Result &Actual, bool IsIndex, int32_t LenA, int32_t LenB) {
+  bool Match = Expected.CF == Actual.CF && Expected.ZF == Actual.ZF && Expected.SF == Actual.SF && Expected.OF == Actual.OF;
+  if (IsIndex) {
+    Match &= Expected.Index == Actual.Index;
+  } else {
+    Match &= memcmp(&Expected.Mask, &Actual.Mask, 16) == 0;
+  }
+
+  // A broken mode tends to fail for every input, only show the first few
+  static uint32_t Printed;
+  if (!Match && Printed++ < 32) {
+    printf("%s imm8 %#04x lengths %d %d: index %u/%u CF %d/%d ZF %d/%d SF %d/%d OF %d/%d (expected/actual)\n", Name, Imm, LenA, LenB,
+           Expected.Index, Actual.Index, Expected.CF, Actual.CF, Expected.ZF, Actual.ZF, Expected.SF, Actual.SF, Expected.OF, Actual.OF);
+  }
+  return Match;
+}
+
+static int test_explicit() {
+  static const int32_t Lengths[] = { -100, -17, -8, -1, 0, 1, 2, 7, 8, 9, 15, 16, 100 };
+  uint32_t Seed = 1;
+  uint32_t Failures = 0;
+
+  for (int Input = 0; Input < 16; ++Input) {
+    const __m128i A = MakeInput(Seed);
+    const __m128i B = MakeInput(Seed);
+
+    for (uint32_t Imm = 0; Imm < 128; ++Imm) {
+      const Model M(Imm, A, B);
+      for (int32_t LenA : Lengths) {
+        for (int32_t LenB : Lengths) {
+          const Operands Ops { A, B, LenA, LenB };
+          const auto Expected = M.Run(M.ExplicitLength(LenA), M.ExplicitLength(LenB));
+          Failures += !Compare("pcmpestri", Imm, Expected, ExplicitIndexFns[Imm](Ops), true, LenA, LenB);
+          Failures += !Compare("pcmpestrm", Imm, Expected, ExplicitMaskFns[Imm](Ops), false, LenA, LenB);
+        }
+      }
+    }
+  }
+
+  return Failures != 0;
+}
+
+static int test_implicit() {
+  uint32_t Seed = 2;
+  uint32_t Failures = 0;
+
+  for (int Input = 0; Input < 256; ++Input) {
+    const __m128i A = MakeInput(Seed);
+    const __m128i B = MakeInput(Seed);
+
+    for (uint32_t Imm = 0; Imm < 128; ++Imm) {
+      const Model M(Imm, A, B);
+      const Operands Ops { A, B, 0, 0 };
+      const auto Expected = M.Run(M.ImplicitLength(M.A), M.ImplicitLength(M.B));
+      Failures += !Compare("pcmpistri", Imm, Expected, ImplicitIndexFns[Imm](Ops), true, -1, -1);
+      Failures += !Compare("pcmpistrm", Imm, Expected, ImplicitMaskFns[Imm](Ops), false, -1, -1);
+    }
+  }
+
+  return Failures != 0;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc == 2) {
+    if (strcmp(argv[1], "explicit") == 0) {
+      return test_explicit();
+    } else if (strcmp(argv[1], "implicit") == 0) {
+      return test_implicit();
+    }
+  }
+
+  printf("Invalid arguments\n");
+  printf("please specify one of %s\n", args);
+  return 1;
+}
@@ -0,0 +1,77 @@
+// libs: pthread
+
+/*
+  measures guest thread create + join latency
+
+  spawns and joins a trivial thread many times, both one at a time and in small batches
+  so a thread-per-request style workload is exercised.
+  Each thread runs a bit of guest code to make sure its compiler state is usable.
+*/
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <pthread.h>
+
+#include <atomic>
+
+constexpr int Iterations = 1000;
+constexpr int BatchSize = 8;
+
+std::atomic<int> result;
+
+void *thread(void *arg) {
+  auto Value = reinterpret_cast<uintptr_t>(arg);
+
+  uintptr_t Sum{};
+  for (uintptr_t i = 0; i <= Value; ++i) {
+    Sum += i;
+  }
+
+  if (Sum != Value * (Value + 1) / 2) {
+    result = 1;
+  }
+
+  return nullptr;
+}
+
+template<typename F>
+double Measure(const char *Name, int Count, F &&Func) {
+  auto Begin = std::chrono::steady_clock::now();
+  Func();
+  auto End = std::chrono::steady_clock::now();
+
+  double PerThread = std::chrono::duration<double, std::micro>(End - Begin).count() / Count;
+  printf("%s: %d threads, %.2f us per create+join\n", Name, Count, PerThread);
+  return PerThread;
+}
+
+int main() {
+  Measure("serial", Iterations, [] {
+    for (int i = 0; i < Iterations; i++) {
+      pthread_t tid;
+      if (pthread_create(&tid, nullptr, &thread, reinterpret_cast<void*>(i)) != 0) {
+        result = 1;
+        return;
+      }
+      pthread_join(tid, nullptr);
+    }
+  });
+
+  Measure("batched", Iterations, [] {
+    for (int i = 0; i < Iterations; i += BatchSize) {
+      pthread_t tid[BatchSize];
+      for (int j = 0; j < BatchSize; j++) {
+        if (pthread_create(&tid[j], nullptr, &thread, reinterpret_cast<void*>(i + j)) != 0) {
+          result = 1;
+          return;
+        }
+      }
+
+      for (int j = 0; j < BatchSize; j++) {
+        pthread_join(tid[j], nullptr);
+      }
+    }
+  });
+
+  return result;
+}
@@ -0,0 +1,147 @@
+/*
+  calls the generated libz guest thunks directly, 32-bit guests go through the host library built against their data layout
+  compress/uncompress have to round trip and agree with the checksums
+*/
+
+// fex requires: BUILD_THUNKS BUILD_THUNKS_32
+// fex env: FEX_THUNKHOSTLIBS=@CMAKE_BINARY_DIR@/ThunkLibs/HostLibs FEX_THUNKGUESTLIBS=@CMAKE_BINARY_DIR@/Guest
+// libs: dl
+
+auto args = "roundtrip, buffer_error";
+
+#include <dlfcn.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// From zlib.h, the guest doesn't need zlib headers
+#define Z_OK 0
+#define Z_BUF_ERROR (-5)
+
+typedef unsigned long uLong;
+typedef int compress_t(uint8_t *dest, uLong *destLen, const uint8_t *source, uLong sourceLen);
+typedef int compress2_t(uint8_t *dest, uLong *destLen, const uint8_t *source, uLong sourceLen, int level);
+typedef uLong compressBound_t(uLong sourceLen);
+typedef uLong checksum_t(uLong crc, const uint8_t *buf, unsigned len);
+
+static compress_t *compress_fn;
+static compress2_t *compress2_fn;
+static compress_t *uncompress_fn;
+static compressBound_t *compressBound_fn;
+static checksum_t *crc32_fn;
+
+#define CHECK(cond)                                                                                                                        \
+  do {                                                                                                                                     \
+    if (!(cond)) {                                                                                                                         \
+      printf("%s:%d check failed: %s\n", __FILE__, __LINE__, #cond);                                                                        \
+      return 1;                                                                                                                            \
+    }                                                                                                                                      \
+  } while (0)
+
+static bool load_thunks() {
+  const char *dir = getenv("FEX_THUNKGUESTLIBS");
+  if (!dir) {
+    printf("FEX_THUNKGUESTLIBS isn't set\n");
+    return false;
+  }
+
+  // Thunks for 32-bit guests are built to a sibling directory
+  std::string path = std::string { dir } + (sizeof(void *) == 4 ? "_32" : "") + "/libz-guest.so";
+  auto lib = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (!lib) {
+    printf("%s\n", dlerror());
+    return false;
+  }
+
+  compress_fn = reinterpret_cast<compress_t *>(dlsym(lib, "compress"));
+  compress2_fn = reinterpret_cast<compress2_t *>(dlsym(lib, "compress2"));
+  uncompress_fn = reinterpret_cast<compress_t *>(dlsym(lib, "uncompress"));
+  compressBound_fn = reinterpret_cast<compressBound_t *>(dlsym(lib, "compressBound"));
+  crc32_fn = reinterpret_cast<checksum_t *>(dlsym(lib, "crc32"));
+  return compress_fn && compress2_fn && uncompress_fn && compressBound_fn && crc32_fn;
+}
+
+static std::vector<uint8_t> make_input(size_t size) {
+  std::vector<uint8_t> input(size);
+  for (size_t i = 0; i < size; ++i) {
+    // Repetitive enough to compress, varied enough to not be trivial
+    input[i] = static_cast<uint8_t>((i * 31) ^ (i >> 7));
+  }
+  return input;
+}
+
+static int test_roundtrip() {
+  for (size_t size : { 1, 100, 4096, 100000 }) {
+    const auto input = make_input(size);
+
+    // uLong is 32-bit on the guest, the host thunk repacks it through a 64-bit temporary
+    uLong bound = compressBound_fn(size);
+    CHECK(bound >= size);
+
+    std::vector<uint8_t> compressed(bound);
+    uLong compressed_size = bound;
+    CHECK(compress_fn(compressed.data(), &compressed_size, input.data(), size) == Z_OK);
+    CHECK(compressed_size > 0 && compressed_size <= bound);
+
+    std::vector<uint8_t> output(size + 16, 0xcc);
+    uLong output_size = output.size();
+    CHECK(uncompress_fn(output.data(), &output_size, compressed.data(), compressed_size) == Z_OK);
+    CHECK(output_size == size);
+    CHECK(memcmp(output.data(), input.data(), size) == 0);
+    CHECK(output[size] == 0xcc);
+
+    // A different level produces a different stream that still decompresses to the same data
+    compressed_size = bound;
+    CHECK(compress2_fn(compressed.data(), &compressed_size, input.data(), size, 1) == Z_OK);
+    output_size = output.size();
+    CHECK(uncompress_fn(output.data(), &output_size, compressed.data(), compressed_size) == Z_OK);
+    CHECK(output_size == size);
+    CHECK(crc32_fn(0, output.data(), output_size) == crc32_fn(0, input.data(), size));
+  }
+
+  // Known value, checks the uLong return value is truncated and extended correctly
+  const char check[] = "123456789";
+  CHECK(crc32_fn(0, reinterpret_cast<const uint8_t *>(check), 9) == 0xcbf43926UL);
+
+  return 0;
+}
+
+static int test_buffer_error() {
+  const auto input = make_input(4096);
+  std::vector<uint8_t> compressed(compressBound_fn(input.size()));
+  uLong compressed_size = compressed.size();
+  CHECK(compress_fn(compressed.data(), &compressed_size, input.data(), input.size()) == Z_OK);
+
+  // The output length written back on failure must land in the guest's 32-bit uLong
+  struct {
+    uLong size;
+    uint32_t canary;
+  } out_len { 16, 0x5a5a5a5a };
+  std::vector<uint8_t> output(16);
+  CHECK(uncompress_fn(output.data(), &out_len.size, compressed.data(), compressed_size) == Z_BUF_ERROR);
+  CHECK(out_len.size <= 16);
+  CHECK(out_len.canary == 0x5a5a5a5a);
+
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  if (!load_thunks()) {
+    return 1;
+  }
+
+  if (argc == 2) {
+    if (strcmp(argv[1], "roundtrip") == 0) {
+      return test_roundtrip();
+    } else if (strcmp(argv[1], "buffer_error") == 0) {
+      return test_buffer_error();
+    }
+  }
+
+  printf("Invalid arguments\n");
+  printf("please specify one of %s\n", args);
+  return 1;
+}
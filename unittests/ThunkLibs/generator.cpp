@@ -2,6 +2,7 @@
 
 #include <clang/ASTMatchers/ASTMatchers.h>
 #include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/AST/RecordLayout.h>
 #include <clang/Frontend/CompilerInstance.h>
 #include <clang/Frontend/TextDiagnosticPrinter.h>
 #include <clang/Tooling/Tooling.h>
@@ -54,6 +55,7 @@ struct Fixture {
             tmpdir + "/tab_function_unpacks",
             tmpdir + "/ldr",
             tmpdir + "/ldr_ptrs",
+            tmpdir + "/callback_packs",
             tmpdir + "/thunks",
             tmpdir + "/function_packs",
             tmpdir + "/function_packs_public",
@@ -87,6 +89,7 @@ struct Fixture {
     const std::string libname = "libtest";
     std::string tmpdir;
     OutputFilenames output_filenames;
+    GuestABI guest_abi = GuestABI::X86_64;
 };
 
 using namespace clang::ast_matchers;
@@ -217,10 +220,12 @@ public:
 /**
  * The "silent" parameter is used to suppress non-fatal diagnostics in tests that expect failure
  */
-static void run_tool(clang::tooling::ToolAction& action, std::string_view code, bool silent = false) {
+static void run_tool(clang::tooling::ToolAction& action, std::string_view code, bool silent = false, const std::vector<std::string>& extra_args = {}) {
     const char* memory_filename = "gen_input.cpp";
     auto adjuster = clang::tooling::getClangStripDependencyFileAdjuster();
-    std::vector<std::string> args = { "clang-tool", "-fsyntax-only", "-std=c++17", "-Werror", "-I.", memory_filename };
+    std::vector<std::string> args = { "clang-tool", "-fsyntax-only", "-std=c++17", "-Werror", "-I." };
+    args.insert(args.end(), extra_args.begin(), extra_args.end());
+    args.push_back(memory_filename);
 
     const char* common_header_code = R"(namespace fexgen {
 struct returns_guest_pointer {};
@@ -228,6 +233,7 @@ struct custom_host_impl {};
 struct callback_annotation_base { bool prevent_multiple; };
 struct callback_stub : callback_annotation_base {};
 struct callback_guest : callback_annotation_base {};
+struct assume_compatible_data_layout {};
 } // namespace fexgen
 )";
 
@@ -249,8 +255,16 @@ struct callback_guest : callback_annotation_base {};
     }
 }
 
-static void run_tool(std::unique_ptr<clang::tooling::ToolAction> action, std::string_view code, bool silent = false) {
-    return run_tool(*action, code, silent);
+static void run_tool(std::unique_ptr<clang::tooling::ToolAction> action, std::string_view code, bool silent = false, const std::vector<std::string>& extra_args = {}) {
+    return run_tool(*action, code, silent, extra_args);
+}
+
+// The generator must see the interface with the guest's type sizes
+static std::vector<std::string> target_args(GuestABI guest_abi) {
+    if (guest_abi == GuestABI::X86_32) {
+        return { "--target=i686-linux-gnu" };
+    }
+    return {};
 }
 
 SourceWithAST::SourceWithAST(std::string_view input) : code(input) {
@@ -279,7 +293,7 @@ SourceWithAST::SourceWithAST(std::string_view input) : code(input) {
  */
 SourceWithAST Fixture::run_thunkgen_guest(std::string_view prelude, std::string_view code, bool silent) {
     const std::string full_code = std::string { prelude } + std::string { code };
-    run_tool(std::make_unique<GenerateThunkLibsActionFactory>(libname, output_filenames), full_code, silent);
+    run_tool(std::make_unique<GenerateThunkLibsActionFactory>(libname, output_filenames, guest_abi), full_code, silent, target_args(guest_abi));
 
     std::string result =
         "#define MAKE_THUNK(lib, name, hash) extern \"C\" int fexthunks_##lib##_##name(void*);\n"
@@ -303,7 +317,7 @@ SourceWithAST Fixture::run_thunkgen_guest(std::string_view prelude, std::string_
  */
 SourceWithAST Fixture::run_thunkgen_host(std::string_view prelude, std::string_view code, bool silent) {
     const std::string full_code = std::string { prelude } + std::string { code };
-    run_tool(std::make_unique<GenerateThunkLibsActionFactory>(libname, output_filenames), full_code, silent);
+    run_tool(std::make_unique<GenerateThunkLibsActionFactory>(libname, output_filenames, guest_abi), full_code, silent, target_args(guest_abi));
 
     std::string result =
         "#include <cstdint>\n"
@@ -320,17 +334,25 @@ SourceWithAST Fixture::run_thunkgen_host(std::string_view prelude, std::string_v
         "fexfn_type_erased_unpack(void* argsv) {\n"
         "    using args_t = typename function_traits<decltype(Fn)>::arg_t;\n"
         "    return Fn(reinterpret_cast<args_t>(argsv));\n"
-        "}\n";
+        "}\n"
+        "typedef void fex_call_callback_t(uintptr_t callback, void *arg0, void* arg1);\n"
+        "static fex_call_callback_t* call_guest;\n"
+        "struct GuestCallbackArgs { void* Data; uint32_t Size; };\n";
     for (auto& filename : {
             output_filenames.ldr_ptrs,
+            output_filenames.callback_unpacks_header,
+            output_filenames.callback_packs,
             output_filenames.function_unpacks,
             output_filenames.tab_function_unpacks,
             output_filenames.ldr,
             }) {
         bool tab_function_unpacks = (filename == output_filenames.tab_function_unpacks);
+        bool callback_unpacks_header = (filename == output_filenames.callback_unpacks_header);
         if (tab_function_unpacks) {
             result += "struct ExportEntry { uint8_t* sha256; void(*fn)(void *); };\n";
             result += "static ExportEntry exports[] = {\n";
+        } else if (callback_unpacks_header) {
+            result += "struct {\n";
         }
 
         std::ifstream file(filename);
@@ -342,6 +364,8 @@ SourceWithAST Fixture::run_thunkgen_host(std::string_view prelude, std::string_v
         if (tab_function_unpacks) {
             result += "  { nullptr, nullptr }\n";
             result += "};\n";
+        } else if (callback_unpacks_header) {
+            result += "} *callback_unpacks;\n";
         }
     }
     return SourceWithAST { std::string { prelude } + result };
@@ -537,3 +561,138 @@ TEST_CASE_METHOD(Fixture, "VariadicFunctionsWithoutAnnotation") {
         "template<auto> struct fex_gen_config {};\n"
         "template<> struct fex_gen_config<func> {};\n", true));
 }
+
+// Pointer and long arguments of 32-bit guests are unpacked from 32-bit struct members
+TEST_CASE_METHOD(Fixture, "Guest32IntegerRepacking") {
+    guest_abi = GuestABI::X86_32;
+
+    const auto output = run_thunkgen_host("",
+        "long func(unsigned long, int, char*, long*);\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> {};\n");
+
+    CHECK_THAT(output,
+        matches(functionDecl(
+            hasName("fexfn_unpack_libtest_func"),
+            parameterCountIs(1),
+            hasParameter(0, hasType(pointerType(pointee(
+                recordType(hasDeclaration(decl(
+                    has(fieldDecl(hasName("a_0"), hasType(asString("uint32_t")))),
+                    has(fieldDecl(hasName("a_1"), hasType(asString("int")))),
+                    has(fieldDecl(hasName("a_2"), hasType(asString("uint32_t")))),
+                    has(fieldDecl(hasName("a_3"), hasType(asString("uint32_t")))),
+                    has(fieldDecl(hasName("rv"), hasType(asString("int32_t"))))
+                    )))))))
+            )));
+
+    // The long pointed to by the last argument is passed through a host-sized temporary
+    CHECK_THAT(output,
+        matches(varDecl(hasName("a_3_host"), hasType(asString("long")))));
+}
+
+// Pointer-sized typedefs are int on i386 but 8 bytes on the host, so they must be repacked like long
+TEST_CASE_METHOD(Fixture, "Guest32PointerSizedTypedefs") {
+    guest_abi = GuestABI::X86_32;
+    const std::string prelude =
+        "typedef __SIZE_TYPE__ size_t;\n"
+        "typedef unsigned int guest_uint;\n";
+
+    const auto output = run_thunkgen_host(prelude,
+        "void func(size_t, size_t*, guest_uint);\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> {};\n");
+
+    CHECK_THAT(output,
+        matches(functionDecl(
+            hasName("fexfn_unpack_libtest_func"),
+            parameterCountIs(1),
+            hasParameter(0, hasType(pointerType(pointee(
+                recordType(hasDeclaration(decl(
+                    has(fieldDecl(hasName("a_0"), hasType(asString("uint32_t")))),
+                    has(fieldDecl(hasName("a_1"), hasType(asString("uint32_t")))),
+                    has(fieldDecl(hasName("a_2"), hasType(asString("unsigned int"))))
+                    )))))))
+            )));
+
+    CHECK_THAT(output,
+        matches(varDecl(hasName("a_1_host"), hasType(asString("size_t")))));
+}
+
+// Pointers to data of unknown layout are rejected for 32-bit guests unless annotated
+TEST_CASE_METHOD(Fixture, "Guest32DataLayout") {
+    guest_abi = GuestABI::X86_32;
+    const std::string prelude = "struct TestStruct { int member; };\n";
+
+    REQUIRE_THROWS(run_thunkgen_host(prelude,
+        "void func(TestStruct*);\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> {};\n", true));
+
+    REQUIRE_NOTHROW(run_thunkgen_host(prelude,
+        "#include <thunks_common.h>\n"
+        "void func(TestStruct*);\n"
+        "template<typename> struct fex_gen_type {};\n"
+        "template<> struct fex_gen_type<TestStruct> : fexgen::assume_compatible_data_layout {};\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> {};\n"));
+}
+
+// Host pointers can't be returned to 32-bit guests
+TEST_CASE_METHOD(Fixture, "Guest32ReturnPointer") {
+    guest_abi = GuestABI::X86_32;
+
+    REQUIRE_THROWS(run_thunkgen_host("",
+        "char* func(int);\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> {};\n", true));
+
+    REQUIRE_NOTHROW(run_thunkgen_host("",
+        "#include <thunks_common.h>\n"
+        "char* func(int);\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> : fexgen::returns_guest_pointer {};\n"));
+}
+
+// Host code calls 32-bit guest callbacks with arguments packed in the guest layout
+TEST_CASE_METHOD(Fixture, "Guest32Callbacks") {
+    guest_abi = GuestABI::X86_32;
+
+    const auto output = run_thunkgen_host("void fexfn_impl_libtest_func_internal(long (*)(long, char*, long long));\n",
+        "void func(long (*funcptr)(long, char*, long long));\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> {};\n");
+
+    // i386 aligns long long to 4 bytes, so rv directly follows a_2
+    CHECK_THAT(output,
+        matches(recordDecl(
+            hasName("fexfn_packed_args_libtest_funcCB"),
+            has(fieldDecl(hasName("a_0"), hasType(asString("int32_t")))),
+            has(fieldDecl(hasName("a_1"), hasType(asString("uint32_t")))),
+            has(fieldDecl(hasName("a_2"), hasType(asString("long long")))),
+            has(fieldDecl(hasName("rv"), hasType(asString("int32_t"))))
+            ).bind("args"))
+        .check_binding("args", +[](const clang::RecordDecl* decl) {
+            return decl->getASTContext().getASTRecordLayout(decl).getSize().getQuantity() == 20;
+        }));
+
+    // The packer takes the host arguments and hands a GuestCallbackArgs to FEX
+    CHECK_THAT(output,
+        matches(functionDecl(
+            hasName("fexfn_pack_libtest_funcCB"),
+            returns(asString("long")),
+            parameterCountIs(4),
+            hasDescendant(varDecl(hasName("guest_args"), hasType(asString("struct GuestCallbackArgs"))))
+            )));
+
+    // Pointers to long would point to a host temporary the guest can't see
+    REQUIRE_THROWS(run_thunkgen_host("",
+        "void func(void (*funcptr)(long*));\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> {};\n", true));
+
+    REQUIRE_NOTHROW(run_thunkgen_host("",
+        "#include <thunks_common.h>\n"
+        "void func(int (*funcptr)(char, char));\n"
+        "template<auto> struct fex_gen_config {};\n"
+        "template<> struct fex_gen_config<func> : fexgen::callback_stub {};\n"));
+}